@@ -44,6 +44,11 @@ BError Anisotropy_Biaxial::Initialize(void)
 		(MOD_)pMesh->Get_Module_Heff_Display() == MOD_ANIBI || pMesh->IsOutputDataSet_withRect(DATA_E_ANIS),
 		(MOD_)pMesh->Get_Module_Energy_Display() == MOD_ANIBI || pMesh->IsOutputDataSet_withRect(DATA_E_ANIS),
 		pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC);
+
+	//parameters read in every cell when computing the field : cache them if they must be evaluated per cell
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) pMesh->request_parameter_cache(pMesh->Ms_AFM, pMesh->K1_AFM, pMesh->K2_AFM, pMesh->mcanis_ea1, pMesh->mcanis_ea2, pMesh->mcanis_ea3);
+	else pMesh->request_parameter_cache(pMesh->Ms, pMesh->K1, pMesh->K2, pMesh->mcanis_ea1, pMesh->mcanis_ea2, pMesh->mcanis_ea3);
+
 	if (!error)	initialized = true;
 
 	return error;
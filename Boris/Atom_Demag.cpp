@@ -164,6 +164,16 @@ BError Atom_Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	return error;
 }
 
+//discard saved evaluations so the next demag field evaluation is a full one, also in the CUDA module if enabled
+void Atom_Demag::Reset_Speedup_History(void)
+{
+	DemagBase::Reset_Speedup_History();
+
+#if COMPILECUDA == 1
+	if (pModuleCUDA) dynamic_cast<Atom_DemagCUDA*>(pModuleCUDA)->Reset_Speedup_History();
+#endif
+}
+
 //Set PBC
 BError Atom_Demag::Set_PBC(INT3 demag_pbc_images_)
 {
@@ -207,7 +217,7 @@ double Atom_Demag::UpdateField(void)
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (!paMesh->pSMesh->GetEvaluationSpeedup() || (num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup() && !paMesh->pSMesh->Check_Step_Update())) {
+	if (!paMesh->pSMesh->GetEvaluationSpeedup() || (!paMesh->pSMesh->Is_Speedup_Adaptive() && num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup() && !paMesh->pSMesh->Check_Step_Update())) {
 
 		//don't use evaluation speedup
 
@@ -223,6 +233,48 @@ double Atom_Demag::UpdateField(void)
 		else energy = 0;
 	}
 
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////// ADAPTIVE EVAL SPEEDUP /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	else if (paMesh->pSMesh->Is_Speedup_Adaptive()) {
+
+		//extrapolate from previous evaluations if the estimated error is within tolerance, else recompute and save evaluation
+		double time = paMesh->pSMesh->Get_EvalStep_Time();
+
+		VEC<DBL3>* pH[EVALSPEEDUP_QUINTIC];
+		double a[EVALSPEEDUP_QUINTIC];
+		double error;
+
+		int num_terms = Adaptive_Speedup_Extrapolation(time, paMesh->pSMesh->GetSpeedupTolerance(), pH, a, error);
+
+		paMesh->pSMesh->Speedup_Evaluation_Report(num_terms > 0, error);
+
+		if (num_terms) {
+
+			//energy from extrapolated field, same convention as for a full evaluation (energy is used by some evaluation methods, e.g. NCG line search)
+			double energy_extrapolated = 0;
+
+			//construct effective field approximation
+			#pragma omp parallel for reduction(+:energy_extrapolated)
+			for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+
+				Hd[idx] = (selfDemagCoeff & M[idx]);
+				for (int term = 0; term < num_terms; term++) Hd[idx] += (*pH[term])[idx] * a[term];
+
+				energy_extrapolated += M[idx] * Hd[idx];
+			}
+
+			//add to Heff in the atomistic mesh
+			Hd.transfer_out();
+
+			//finish off energy value
+			if (non_empty_cells) energy = energy_extrapolated * -MU0 / (2 * non_empty_cells);
+			else energy = 0;
+		}
+		else Evaluate_Saved_Hdemag(Adaptive_Speedup_Storage(time, paMesh->pSMesh->GetEvaluationSpeedup()));
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////////////////// EVAL SPEEDUP /////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -417,24 +469,8 @@ double Atom_Demag::UpdateField(void)
 				}
 			}
 
-			//convolute and get "energy" value
-			if (Module_Heff.linear_size()) energy = Convolute(M, *pHdemag, true);
-			else energy = Convolute(M, *pHdemag, true, &Module_Heff, &Module_energy);
-
-			//finish off energy value
-			if (non_empty_cells) energy *= -MU0 / (2 * non_empty_cells);
-			else energy = 0;
-
-			//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
-			pHdemag->transfer_out();
-
-			//subtract self demag contribution
-			#pragma omp parallel for
-			for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-				//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-				(*pHdemag)[idx] -= (selfDemagCoeff & M[idx]);
-			}
+			//do evaluation
+			Evaluate_Saved_Hdemag(pHdemag);
 		}
 		else {
 
@@ -558,6 +594,57 @@ double Atom_Demag::UpdateField(void)
 	return energy;
 }
 
+//evaluation speedup : compute demag field into *pHdemag and transfer it to Heff, then subtract self demag contribution from *pHdemag so it can be used for extrapolation
+void Atom_Demag::Evaluate_Saved_Hdemag(VEC<DBL3>* pHdemag)
+{
+	//convolute and get "energy" value
+	if (Module_Heff.linear_size()) energy = Convolute(M, *pHdemag, true, &Module_Heff, &Module_energy);
+	else energy = Convolute(M, *pHdemag, true);
+
+	//finish off energy value
+	if (non_empty_cells) energy *= -MU0 / (2 * non_empty_cells);
+	else energy = 0;
+
+	//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
+	pHdemag->transfer_out();
+
+	//subtract self demag contribution
+	#pragma omp parallel for
+	for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+
+		//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+		(*pHdemag)[idx] -= (selfDemagCoeff & M[idx]);
+	}
+}
+
+//-------------------Task-parallel evaluation
+
+bool Atom_Demag::Can_Async_UpdateField(void)
+{
+	//same condition as for the no speedup branch in UpdateField
+	return (!paMesh->pSMesh->GetEvaluationSpeedup() || (!paMesh->pSMesh->Is_Speedup_Adaptive() && num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup() && !paMesh->pSMesh->Check_Step_Update()));
+}
+
+//convolute into Hd, but don't transfer out to Heff yet as other modules are being evaluated at the same time
+void Atom_Demag::UpdateField_Async(void)
+{
+	M.transfer_in();
+
+	if (Module_Heff.linear_size()) energy = Convolute(M, Hd, true, &Module_Heff, &Module_energy);
+	else energy = Convolute(M, Hd, true);
+
+	//finish off energy value
+	if (non_empty_cells) energy *= -MU0 / (2 * non_empty_cells);
+	else energy = 0;
+}
+
+double Atom_Demag::UpdateField_Complete(void)
+{
+	Hd.transfer_out();
+
+	return energy;
+}
+
 //-------------------Energy methods
 
 //For simple cubic mesh spin_index coincides with index in M1
@@ -44,6 +44,9 @@ private:
 	//Initialize mesh transfer from atomistic mesh to micromagnetic mesh for demag field computation
 	BError Initialize_Mesh_Transfer(void);
 
+	//evaluation speedup : compute demag field into *pHdemag and transfer it to Heff, then subtract self demag contribution from *pHdemag so it can be used for extrapolation
+	void Evaluate_Saved_Hdemag(VEC<DBL3>* pHdemag);
+
 public:
 
 	Atom_Demag(Atom_Mesh *paMesh_);
@@ -66,11 +69,20 @@ public:
 
 	double UpdateField(void);
 
+	//task-parallel evaluation : transfer in and convolution in async stage, transfer out to Heff in complete stage. Only available if not using evaluation speedup at this step.
+	bool Can_Async_UpdateField(void);
+	void UpdateField_Async(void);
+	double UpdateField_Complete(void);
+
 	//-------------------Setters
 
 	//Set PBC
 	BError Set_PBC(INT3 demag_pbc_images_);
 
+	//-------------------Evaluation speedup
+
+	void Reset_Speedup_History(void);
+
 	//-------------------Energy methods
 
 	//For simple cubic mesh spin_index coincides with index in M1
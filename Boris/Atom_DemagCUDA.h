@@ -71,6 +71,9 @@ public:
 	BError UpdateConfiguration(UPDATECONFIG_ cfgMessage);
 	void UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage) {}
 
+	//discard saved evaluations so the next demag field evaluation is a full one (called from cpu version)
+	void Reset_Speedup_History(void) { num_Hdemag_saved = 0; }
+
 	void UpdateField(void);
 };
 
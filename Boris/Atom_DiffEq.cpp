@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Atom_DiffEq.h"
 #include "Atom_Mesh.h"
+#include "CheckpointFile.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -31,4 +32,29 @@ Atom_DifferentialEquation::~Atom_DifferentialEquation()
 	}
 	pameshODECUDA = nullptr;
 #endif
-}
\ No newline at end of file
+}
+
+//save, verify or load evaluation scratch spaces, thermal field and random number generator state in binary checkpoint (chunk names start with given prefix)
+void Atom_DifferentialEquation::Checkpoint_State(CheckpointFile& cpt, std::string prefix)
+{
+	cpt.vec(prefix + "sM1", sM1);
+
+	cpt.vec(prefix + "sEval0", sEval0);
+	cpt.vec(prefix + "sEval1", sEval1);
+	cpt.vec(prefix + "sEval2", sEval2);
+	cpt.vec(prefix + "sEval3", sEval3);
+	cpt.vec(prefix + "sEval4", sEval4);
+	cpt.vec(prefix + "sEval5", sEval5);
+	cpt.vec(prefix + "sEval6", sEval6);
+
+	cpt.vec(prefix + "H_Thermal", H_Thermal);
+
+	std::vector<unsigned> prng_values, prng_periods;
+	if (cpt.is_saving()) prng.get_state(prng_values, prng_periods);
+
+	cpt.vector(prefix + "prng_values", prng_values);
+	cpt.vector(prefix + "prng_periods", prng_periods);
+
+	//if number of threads is different the generator state cannot be restored : keep current state
+	if (cpt.is_loading()) prng.set_state(prng_values, prng_periods);
+}
@@ -15,6 +15,8 @@
 #include "Atom_DiffEqCubicCUDA.h"
 #endif
 
+class CheckpointFile;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Abstract base class for Atom_DifferentialEquation type objects : used in atomistic meshes
@@ -177,6 +179,25 @@ protected:
 	virtual void RunRKDP54_Step5(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	virtual void RunLSRK43_Step0_withReductions(void) = 0;
+	virtual void RunLSRK43_Step0(void) = 0;
+	virtual void RunLSRK43_Step1(void) = 0;
+	virtual void RunLSRK43_Step2(void) = 0;
+	virtual void RunLSRK43_Step3(void) = 0;
+	virtual void RunLSRK43_Step4_withReductions(void) = 0;
+	virtual void RunLSRK43_Step4(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	virtual void RunROS2_Step0_withReductions(void) = 0;
+	virtual void RunROS2_Step0(void) = 0;
+	virtual void RunROS2_Step1_withReductions(void) = 0;
+	virtual void RunROS2_Step1(void) = 0;
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	virtual void RunSD_Start(void) = 0;
@@ -189,6 +210,16 @@ protected:
 	virtual void RunSD_Advance(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	virtual void RunNCG_Gradient_withReductions(void) = 0;
+	virtual void RunNCG_Gradient(void) = 0;
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	virtual void RunNCG_Direction(double beta) = 0;
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	virtual void RunNCG_Advance(void) = 0;
+#endif
+
 	//---------------------------------------- OTHERS
 
 	//Restore atomic moments after a failed step for adaptive time-step methods
@@ -197,6 +228,9 @@ protected:
 	//renormalize vectors to set moment length value (which could have a spatial variation)
 	virtual void RenormalizeMoments(void) = 0;
 
+	//save, verify or load evaluation scratch spaces, thermal field and random number generator state in binary checkpoint (chunk names start with given prefix)
+	virtual void Checkpoint_State(CheckpointFile& cpt, std::string prefix);
+
 	//---------------------------------------- OTHER CALCULATION METHODS
 
 	//called when using stochastic equations
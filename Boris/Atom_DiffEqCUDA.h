@@ -66,6 +66,12 @@ protected:
 	//deallocate memory before re-allocating it (depending on evaluation method previously allocated memory might not be used again, so need clean-up before)
 	virtual void CleanupMemory(bool copy_to_cpu = false) = 0;
 
+	//copy evaluation scratch spaces to cpu memory without changing gpu memory (e.g. for saving a checkpoint while running)
+	virtual void CopyMemory_to_cpu(void) = 0;
+
+	//copy evaluation scratch spaces from cpu memory to gpu memory without reallocating (e.g. after loading a checkpoint)
+	virtual void CopyMemory_to_gpu(void) = 0;
+
 	virtual void SetODEMethodPointers(void) = 0;
 
 	//---------------------------------------- EQUATIONS : these are defined as __device__ methods in ManagedAtom_DiffEq...CUDA
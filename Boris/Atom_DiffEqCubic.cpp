@@ -10,6 +10,8 @@ Atom_DifferentialEquationCubic::Atom_DifferentialEquationCubic(Atom_Mesh_Cubic *
 	Atom_DifferentialEquation(paMesh)
 {
 	error_on_create = UpdateConfiguration(UPDATECONFIG_FORCEUPDATE);
+
+	eval_blocks.resize(omp_get_num_procs());
 }
 
 Atom_DifferentialEquationCubic::~Atom_DifferentialEquationCubic()
@@ -114,9 +116,25 @@ BError Atom_DifferentialEquationCubic::AllocateMemory(void)
 		if (!sEval6.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK43:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_ROS2:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!implicit_exchange.resize(paMesh->M1)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -152,9 +170,12 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 	}
@@ -164,8 +185,11 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKF56 &&
-		evalMethod != EVAL_RKDP54) {
+		evalMethod != EVAL_RKDP54 &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 	}
@@ -201,6 +225,11 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		sEval6.clear();
 	}
 
+	if (evalMethod != EVAL_ROS2) {
+
+		implicit_exchange.clear();
+	}
+
 	//For thermal vecs only clear if not used for current set ODE
 	if (setODE != ODE_SLLG && 
 		setODE != ODE_SLLGSTT &&
@@ -226,6 +255,12 @@ BError Atom_DifferentialEquationCubic::UpdateConfiguration(UPDATECONFIG_ cfgMess
 		error = AllocateMemory();
 	}
 
+	//implicit exchange solver must have same shape as magnetization
+	if (evalMethod == EVAL_ROS2 && cfgMessage == UPDATECONFIG_MESHSHAPECHANGE) {
+
+		if (!implicit_exchange.resize(paMesh->M1)) error(BERROR_OUTOFMEMORY_CRIT);
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_ODE_MOVEMESH)) {
 
 		/*
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Atom_DiffEq.h"
+#include "DiffEq_EvalBlock.h"
+#include "DiffEq_Implicit.h"
 
 class Atom_Mesh_Cubic;
 
@@ -15,6 +17,22 @@ class Atom_DifferentialEquationCubic :
 {
 private:
 
+	//structure-of-arrays evaluation blocks, one for each OpenMP thread
+	std::vector<ODEEvalBlock> eval_blocks;
+
+	//linear solver for implicit exchange (ROS2 evaluation method only)
+	ODEImplicitExchange implicit_exchange;
+
+private:
+
+	//---------------------------------------- EQUATION HELPERS : Atom_DiffEqCubic_Equations.cpp
+
+	//Zhang-Li STT contribution to LLG, using material parameters already obtained for this cell
+	DBL3 STT_Torque(int idx, double mu_s, double alpha, double P, double beta);
+
+	//implicit exchange solver coefficients for given cell (ROS2), using LLG form equation coefficients for the current time step
+	DBL2 ROS2_Exchange_Coefficients(int idx);
+
 public:
 
 	Atom_DifferentialEquationCubic(Atom_Mesh_Cubic *paMesh);
@@ -125,6 +143,25 @@ public:
 	void RunRKDP54_Step5(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void);
+	void RunLSRK43_Step0(void);
+	void RunLSRK43_Step1(void);
+	void RunLSRK43_Step2(void);
+	void RunLSRK43_Step3(void);
+	void RunLSRK43_Step4_withReductions(void);
+	void RunLSRK43_Step4(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void);
+	void RunROS2_Step0(void);
+	void RunROS2_Step1_withReductions(void);
+	void RunROS2_Step1(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void);
@@ -137,6 +174,16 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void);
+	void RunNCG_Gradient(void);
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta);
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : Atom_DiffEqCubic_Equations.cpp and Atom_DiffEqCubic_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -154,6 +201,15 @@ public:
 	//Stochastic Landau-Lifshitz-Gilbert equation with Zhang-Li STT
 	DBL3 SLLGSTT(int idx);
 
+	//---------------------------------------- BLOCK EVALUATION : Atom_DiffEqCubic_BlockEquations.cpp
+
+	//number of blocks of ODE_EVALBLOCK cells covering the mesh
+	int Num_Eval_Blocks(void);
+
+	//evaluate set equation for all cells in given block, using the evaluation block of the calling thread, and return it so evaluations can be read
+	//empty and skipped cells evaluate to zero
+	ODEEvalBlock& Evaluate_Equation_Block(int block);
+
 	//---------------------------------------- OTHERS : DiffEqFM.cpp
 
 	void RestoreMoments(void);
@@ -308,6 +364,25 @@ public:
 	void RunRKDP54_Step5(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void) {}
+	void RunLSRK43_Step0(void) {}
+	void RunLSRK43_Step1(void) {}
+	void RunLSRK43_Step2(void) {}
+	void RunLSRK43_Step3(void) {}
+	void RunLSRK43_Step4_withReductions(void) {}
+	void RunLSRK43_Step4(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void) {}
@@ -320,6 +395,16 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void) {}
+	void RunNCG_Gradient(void) {}
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta) {}
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : Atom_DiffEqCubic_Equations.cpp and Atom_DiffEqCubic_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
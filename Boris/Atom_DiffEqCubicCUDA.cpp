@@ -275,6 +275,36 @@ void Atom_DifferentialEquationCubicCUDA::CleanupMemory(bool copy_to_cpu)
 	prng()->clear();
 }
 
+//copy evaluation scratch spaces to cpu memory without changing gpu memory (e.g. for saving a checkpoint while running)
+//only vectors allocated for the current evaluation method and equation have matching sizes, so only these are copied
+void Atom_DifferentialEquationCubicCUDA::CopyMemory_to_cpu(void)
+{
+	if (sM1()->size_cpu() == pameshODE->sM1.size()) sM1()->copy_to_cpuvec(pameshODE->sM1);
+	if (sEval0()->size_cpu() == pameshODE->sEval0.size()) sEval0()->copy_to_cpuvec(pameshODE->sEval0);
+	if (sEval1()->size_cpu() == pameshODE->sEval1.size()) sEval1()->copy_to_cpuvec(pameshODE->sEval1);
+	if (sEval2()->size_cpu() == pameshODE->sEval2.size()) sEval2()->copy_to_cpuvec(pameshODE->sEval2);
+	if (sEval3()->size_cpu() == pameshODE->sEval3.size()) sEval3()->copy_to_cpuvec(pameshODE->sEval3);
+	if (sEval4()->size_cpu() == pameshODE->sEval4.size()) sEval4()->copy_to_cpuvec(pameshODE->sEval4);
+	if (sEval5()->size_cpu() == pameshODE->sEval5.size()) sEval5()->copy_to_cpuvec(pameshODE->sEval5);
+	if (sEval6()->size_cpu() == pameshODE->sEval6.size()) sEval6()->copy_to_cpuvec(pameshODE->sEval6);
+	if (H_Thermal()->size_cpu() == pameshODE->H_Thermal.size()) H_Thermal()->copy_to_cpuvec(pameshODE->H_Thermal);
+}
+
+//copy evaluation scratch spaces from cpu memory to gpu memory without reallocating (e.g. after loading a checkpoint)
+//only vectors allocated for the current evaluation method and equation have matching sizes, so only these are copied
+void Atom_DifferentialEquationCubicCUDA::CopyMemory_to_gpu(void)
+{
+	if (sM1()->size_cpu() == pameshODE->sM1.size()) sM1()->copy_from_cpuvec(pameshODE->sM1);
+	if (sEval0()->size_cpu() == pameshODE->sEval0.size()) sEval0()->copy_from_cpuvec(pameshODE->sEval0);
+	if (sEval1()->size_cpu() == pameshODE->sEval1.size()) sEval1()->copy_from_cpuvec(pameshODE->sEval1);
+	if (sEval2()->size_cpu() == pameshODE->sEval2.size()) sEval2()->copy_from_cpuvec(pameshODE->sEval2);
+	if (sEval3()->size_cpu() == pameshODE->sEval3.size()) sEval3()->copy_from_cpuvec(pameshODE->sEval3);
+	if (sEval4()->size_cpu() == pameshODE->sEval4.size()) sEval4()->copy_from_cpuvec(pameshODE->sEval4);
+	if (sEval5()->size_cpu() == pameshODE->sEval5.size()) sEval5()->copy_from_cpuvec(pameshODE->sEval5);
+	if (sEval6()->size_cpu() == pameshODE->sEval6.size()) sEval6()->copy_from_cpuvec(pameshODE->sEval6);
+	if (H_Thermal()->size_cpu() == pameshODE->H_Thermal.size()) H_Thermal()->copy_from_cpuvec(pameshODE->H_Thermal);
+}
+
 
 BError Atom_DifferentialEquationCubicCUDA::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 {
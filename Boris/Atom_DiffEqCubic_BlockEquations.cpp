@@ -0,0 +1,151 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//------------------------------------------------------------------------------------------------------
+
+//number of blocks of ODE_EVALBLOCK cells covering the mesh
+int Atom_DifferentialEquationCubic::Num_Eval_Blocks(void)
+{
+	return (paMesh->n.dim() + ODE_EVALBLOCK - 1) / ODE_EVALBLOCK;
+}
+
+//evaluate set equation for all cells in given block, using the evaluation block of the calling thread, and return it so evaluations can be read
+//LLG and stochastic LLG type equations are evaluated using the vectorized kernels in ODEEvalBlock, with per-cell coefficients only if material parameters are not uniform. Other equations are evaluated cell by cell.
+ODEEvalBlock& Atom_DifferentialEquationCubic::Evaluate_Equation_Block(int block)
+{
+	ODEEvalBlock& eval_block = eval_blocks[omp_get_thread_num()];
+	eval_block.set_range(block, paMesh->n.dim());
+
+	auto is_evaluated = [&](int idx) -> bool { return paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx); };
+
+	//load cells to evaluate : empty and skipped cells are cleared so they evaluate to zero
+	for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+		if (is_evaluated(idx)) eval_block.load(idx, paMesh->M1[idx], paMesh->Heff1[idx]);
+		else eval_block.clear(idx);
+	}
+
+	switch (setODE) {
+
+	case ODE_LLG:
+	case ODE_LLGSA:
+	case ODE_LLGSTT:
+	{
+		if (paMesh->is_uniform_parameters(paMesh->mu_s, paMesh->alpha, paMesh->grel)) {
+
+			double mu_s = paMesh->mu_s;
+			double alpha = paMesh->alpha;
+			double grel = paMesh->grel;
+
+			double a = -GAMMA * grel / (1 + alpha * alpha);
+			eval_block.Evaluate_Transverse(a, a * alpha / mu_s);
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double mu_s = paMesh->mu_s;
+				double alpha = paMesh->alpha;
+				double grel = paMesh->grel;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->alpha, alpha, paMesh->grel, grel);
+
+				double a = -GAMMA * grel / (1 + alpha * alpha);
+				eval_block.set_coefficients(idx, a, a * alpha / mu_s);
+			}
+
+			eval_block.Evaluate_Transverse();
+		}
+
+		if (setODE == ODE_LLGSTT && paMesh->E.linear_size()) {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double mu_s = paMesh->mu_s;
+				double alpha = paMesh->alpha;
+				double P = paMesh->P;
+				double beta = paMesh->beta;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->alpha, alpha, paMesh->P, P, paMesh->beta, beta);
+
+				eval_block.add(idx, STT_Torque(idx, mu_s, alpha, P, beta));
+			}
+		}
+	}
+	break;
+
+	case ODE_LLGSTATIC:
+	case ODE_LLGSTATICSA:
+	{
+		if (paMesh->is_uniform_parameters(paMesh->mu_s, paMesh->grel)) {
+
+			double mu_s = paMesh->mu_s;
+			double grel = paMesh->grel;
+
+			eval_block.Evaluate_Transverse(0.0, -GAMMA * grel / (2 * mu_s));
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double mu_s = paMesh->mu_s;
+				double grel = paMesh->grel;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->grel, grel);
+
+				eval_block.set_coefficients(idx, 0.0, -GAMMA * grel / (2 * mu_s));
+			}
+
+			eval_block.Evaluate_Transverse();
+		}
+	}
+	break;
+
+	case ODE_SLLG:
+	case ODE_SLLGSA:
+	{
+		//thermal field includes damping contribution not included when H_Thermal was generated, so always needs per-cell values
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			double mu_s = paMesh->mu_s;
+			double alpha = paMesh->alpha;
+			double grel = paMesh->grel;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->alpha, alpha, paMesh->grel, grel);
+
+			//H_Thermal has same dimensions as M1 in atomistic meshes
+			eval_block.add_field(idx, H_Thermal[idx] * sqrt(alpha));
+
+			double a = -GAMMA * grel / (1 + alpha * alpha);
+			eval_block.set_coefficients(idx, a, a * alpha / mu_s);
+		}
+
+		eval_block.Evaluate_Transverse();
+	}
+	break;
+
+	default:
+	{
+		//no block form for this equation : evaluate cell by cell
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (is_evaluated(idx)) eval_block.add(idx, CALLFP(this, equation)(idx));
+		}
+	}
+	break;
+	}
+
+	return eval_block;
+}
+
+#endif
@@ -52,23 +52,25 @@ DBL3 Atom_DifferentialEquationCubic::LLGSTT(int idx)
 
 	DBL3 LLGSTT_Eval = (-GAMMA * grel / (1 + alpha * alpha)) * ((paMesh->M1[idx] ^ paMesh->Heff1[idx]) + alpha * ((paMesh->M1[idx] / mu_s) ^ (paMesh->M1[idx] ^ paMesh->Heff1[idx])));
 
-	if (paMesh->E.linear_size()) {
+	if (paMesh->E.linear_size()) LLGSTT_Eval += STT_Torque(idx, mu_s, alpha, P, beta);
 
-		DBL33 grad_M1 = paMesh->M1.grad_neu(idx);
+	return LLGSTT_Eval;
+}
 
-		DBL3 position = paMesh->M1.cellidx_to_position(idx);
+//Zhang-Li STT contribution to LLG, using material parameters already obtained for this cell
+DBL3 Atom_DifferentialEquationCubic::STT_Torque(int idx, double mu_s, double alpha, double P, double beta)
+{
+	DBL33 grad_M1 = paMesh->M1.grad_neu(idx);
 
-		double conv = paMesh->M1.h.dim() / MUB;
-		DBL3 u = (paMesh->elC[position] * paMesh->E.weighted_average(position, paMesh->h) * P * GMUB_2E * conv) / (mu_s * (1 + beta * beta));
+	DBL3 position = paMesh->M1.cellidx_to_position(idx);
 
-		DBL3 u_dot_del_M1 = (u.x * grad_M1.x) + (u.y * grad_M1.y) + (u.z * grad_M1.z);
+	double conv = paMesh->M1.h.dim() / MUB;
+	DBL3 u = (paMesh->elC[position] * paMesh->E.weighted_average(position, paMesh->h) * P * GMUB_2E * conv) / (mu_s * (1 + beta * beta));
 
-		LLGSTT_Eval +=
-			(((1 + alpha * beta) * u_dot_del_M1) -
-				((beta - alpha) * ((paMesh->M1[idx] / mu_s) ^ u_dot_del_M1))) / (1 + alpha * alpha);
-	}
+	DBL3 u_dot_del_M1 = (u.x * grad_M1.x) + (u.y * grad_M1.y) + (u.z * grad_M1.z);
 
-	return LLGSTT_Eval;
+	return (((1 + alpha * beta) * u_dot_del_M1) -
+		((beta - alpha) * ((paMesh->M1[idx] / mu_s) ^ u_dot_del_M1))) / (1 + alpha * alpha);
 }
 
 #endif
\ No newline at end of file
@@ -18,33 +18,39 @@ void Atom_DifferentialEquationCubic::RunABM_Predictor_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment for the next step
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//obtained maximum normalized torque term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+				//Save current moment for the next step
+				sM1[idx] = paMesh->M1[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+					//obtained maximum normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-					paMesh->M1[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
+
+						paMesh->M1[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
 
-					paMesh->M1[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						paMesh->M1[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
@@ -64,28 +70,34 @@ void Atom_DifferentialEquationCubic::RunABM_Predictor_withReductions(void)
 void Atom_DifferentialEquationCubic::RunABM_Predictor(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment for the next step
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				//Save current moment for the next step
+				sM1[idx] = paMesh->M1[idx];
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-					paMesh->M1[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
+
+						paMesh->M1[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
 
-					paMesh->M1[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						paMesh->M1[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
@@ -101,43 +113,49 @@ void Atom_DifferentialEquationCubic::RunABM_Corrector_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First save predicted moment for lte calculation
-				DBL3 saveM = paMesh->M1[idx];
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+					//First save predicted moment for lte calculation
+					DBL3 saveM = paMesh->M1[idx];
 
-					paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-				if (renormalize) {
+						paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+						paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
 
-				//obtained maximum dmdt term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
+					if (renormalize) {
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
 			}
 		}
 	}
@@ -160,38 +178,44 @@ void Atom_DifferentialEquationCubic::RunABM_Corrector(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First save predicted moment for lte calculation
-				DBL3 saveM = paMesh->M1[idx];
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+					//First save predicted moment for lte calculation
+					DBL3 saveM = paMesh->M1[idx];
 
-					paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-				if (renormalize) {
+						paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+						paMesh->M1[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
 			}
 		}
 	}
@@ -202,20 +226,26 @@ void Atom_DifferentialEquationCubic::RunABM_Corrector(void)
 void Atom_DifferentialEquationCubic::RunABM_TEuler0(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment for the next step
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				//Save current moment for the next step
+				sM1[idx] = paMesh->M1[idx];
 
-				//Now estimate moment for the next time step
-				paMesh->M1[idx] += sEval0[idx] * dT;
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+
+					//Now estimate moment for the next time step
+					paMesh->M1[idx] += sEval0[idx] * dT;
+				}
 			}
 		}
 	}
@@ -224,15 +254,21 @@ void Atom_DifferentialEquationCubic::RunABM_TEuler0(void)
 void Atom_DifferentialEquationCubic::RunABM_TEuler1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
 
-			//Now estimate moment using the second trapezoidal Euler step equation
-			paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = eval_block.eval(idx);
+
+				//Now estimate moment using the second trapezoidal Euler step equation
+				paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
+			}
 		}
 	}
 }
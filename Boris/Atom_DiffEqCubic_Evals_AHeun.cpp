@@ -21,24 +21,30 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step0_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment for the next step
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = paMesh->M1[idx].norm();
-				mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+				//Save current moment for the next step
+				sM1[idx] = paMesh->M1[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now estimate moment for the next time step
-				paMesh->M1[idx] += rhs * dT;
+					//obtained average normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//Now estimate moment for the next time step
+					paMesh->M1[idx] += rhs * dT;
+				}
 			}
 		}
 	}
@@ -58,20 +64,26 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step0(void)
 	if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Save current moment for the next step
-			sM1[idx] = paMesh->M1[idx];
+			if (paMesh->M1.is_not_empty(idx)) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+				//Save current moment for the next step
+				sM1[idx] = paMesh->M1[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now estimate moment for the next time step
-				paMesh->M1[idx] += rhs * dT;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//Now estimate moment for the next time step
+					paMesh->M1[idx] += rhs * dT;
+				}
 			}
 		}
 	}
@@ -86,35 +98,41 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step1_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First save predicted moment for lte calculation
-				DBL3 saveM = paMesh->M1[idx];
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now estimate moment using the second trapezoidal Euler step equation
-				paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				if (renormalize) {
+					//First save predicted moment for lte calculation
+					DBL3 saveM = paMesh->M1[idx];
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+					//Now estimate moment using the second trapezoidal Euler step equation
+					paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					if (renormalize) {
 
-				//obtained average dmdt term
-				double Mnorm = paMesh->M1[idx].norm();
-				dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//obtained average dmdt term
+					double Mnorm = paMesh->M1[idx].norm();
+					dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+				}
 			}
 		}
 	}
@@ -137,31 +155,37 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step1(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First save predicted moment for lte calculation
-				DBL3 saveM = paMesh->M1[idx];
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now estimate moment using the second trapezoidal Euler step equation
-				paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				if (renormalize) {
+					//First save predicted moment for lte calculation
+					DBL3 saveM = paMesh->M1[idx];
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+					//Now estimate moment using the second trapezoidal Euler step equation
+					paMesh->M1[idx] = (sM1[idx] + paMesh->M1[idx] + rhs * dT) / 2;
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
 			}
 		}
 	}
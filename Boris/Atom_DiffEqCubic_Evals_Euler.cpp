@@ -22,33 +22,39 @@ void Atom_DifferentialEquationCubic::RunEuler_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = paMesh->M1[idx].norm();
-				mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+				//Save current moment
+				sM1[idx] = paMesh->M1[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now estimate moment for the next time step
-				paMesh->M1[idx] += rhs * dT;
+					//obtained average normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
 
-				if (renormalize) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+					//Now estimate moment for the next time step
+					paMesh->M1[idx] += rhs * dT;
+
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
 
-				dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+					dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+				}
 			}
 		}
 	}
@@ -71,26 +77,32 @@ void Atom_DifferentialEquationCubic::RunEuler(void)
 	if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-			//Save current moment
-			sM1[idx] = paMesh->M1[idx];
+				//Save current moment
+				sM1[idx] = paMesh->M1[idx];
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//Now estimate moment for the next time step
-				paMesh->M1[idx] += rhs * dT;
+					//Now estimate moment for the next time step
+					paMesh->M1[idx] += rhs * dT;
 
-				if (renormalize) {
+					if (renormalize) {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
 				}
 			}
 		}
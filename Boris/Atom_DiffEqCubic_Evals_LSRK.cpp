@@ -0,0 +1,270 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (2N-storage, 4th order solution, embedded 3rd order error)
+
+//sEval0 holds the 2N register (dM), sEval1 accumulates the error estimate, sM1 only needed to restore moments for rejected steps and for dmdt.
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					paMesh->M1[idx] += sEval0[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+
+	if (paMesh->grel.get0()) {
+
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step0(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					paMesh->M1[idx] += sEval0[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step1(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A2 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E2 * dT);
+
+				paMesh->M1[idx] += sEval0[idx] * LSRK_B2;
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step2(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A3 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E3 * dT);
+
+				paMesh->M1[idx] += sEval0[idx] * LSRK_B3;
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step3(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A4 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E4 * dT);
+
+				paMesh->M1[idx] += sEval0[idx] * LSRK_B4;
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step4_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					paMesh->M1[idx] += sEval0[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+			}
+		}
+	}
+
+	if (paMesh->grel.get0()) {
+
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK43_Step4(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					paMesh->M1[idx] += sEval0[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+#endif
+#endif
@@ -19,29 +19,35 @@ void Atom_DifferentialEquationCubic::RunRK23_Step0_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//obtain maximum normalized torque term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-				//2nd order evaluation for adaptive step
-				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / Mnorm;
-				lte_reduction.reduce_max(_lte);
+					//2nd order evaluation for adaptive step
+					DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / Mnorm;
+					lte_reduction.reduce_max(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -64,24 +70,30 @@ void Atom_DifferentialEquationCubic::RunRK23_Step0(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//2nd order evaluation for adaptive step
-				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
+					//2nd order evaluation for adaptive step
+					DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -111,15 +123,21 @@ void Atom_DifferentialEquationCubic::RunRK23_Step0_Advance(void)
 void Atom_DifferentialEquationCubic::RunRK23_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate moment using RK23 midle step 1
-			paMesh->M1[idx] = sM1[idx] + 3 * sEval1[idx] * dT / 4;
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+
+				//Now estimate moment using RK23 midle step 1
+				paMesh->M1[idx] = sM1[idx] + 3 * sEval1[idx] * dT / 4;
+			}
 		}
 	}
 }
@@ -132,29 +150,35 @@ void Atom_DifferentialEquationCubic::RunRK23_Step2_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//Now calculate 3rd order evaluation
-				paMesh->M1[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				if (renormalize) {
+					//First evaluate RHS of set equation at the current time step
+					sEval2[idx] = eval_block.eval(idx);
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+					//Now calculate 3rd order evaluation
+					paMesh->M1[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+
+					if (renormalize) {
 
-				//obtained maximum dmdt term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
 			}
 		}
 	}
@@ -172,23 +196,29 @@ void Atom_DifferentialEquationCubic::RunRK23_Step2_withReductions(void)
 void Atom_DifferentialEquationCubic::RunRK23_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval2[idx] = eval_block.eval(idx);
 
-				//Now calculate 3rd order evaluation
-				paMesh->M1[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+					//Now calculate 3rd order evaluation
+					paMesh->M1[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
 
-				if (renormalize) {
+					if (renormalize) {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
 				}
 			}
 		}
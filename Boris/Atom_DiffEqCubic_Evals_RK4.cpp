@@ -25,24 +25,30 @@ void Atom_DifferentialEquationCubic::RunRK4_Step0_withReductions(void)
 		double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (paMesh->M1.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				//Save current moment for later use
-				sM1[idx] = paMesh->M1[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!paMesh->M1.is_skipcell(idx)) {
+				if (paMesh->M1.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = paMesh->M1[idx].norm();
-					mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+					//Save current moment for later use
+					sM1[idx] = paMesh->M1[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					if (!paMesh->M1.is_skipcell(idx)) {
 
-					//Now estimate moment using RK4 midle step
-					paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = paMesh->M1[idx].norm();
+						mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+
+						//Now estimate moment using RK4 midle step
+						paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -64,25 +70,31 @@ void Atom_DifferentialEquationCubic::RunRK4_Step0_withReductions(void)
 		double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (paMesh->M1.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				//Save current moment for later use
-				sM1[idx] = paMesh->M1[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!paMesh->M1.is_skipcell(idx)) {
+				if (paMesh->M1.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = paMesh->M1[idx].norm();
-					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
-					mxh_reduction.reduce_max(_mxh);
+					//Save current moment for later use
+					sM1[idx] = paMesh->M1[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					if (!paMesh->M1.is_skipcell(idx)) {
 
-					//Now estimate moment using RK4 midle step
-					paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = paMesh->M1[idx].norm();
+						double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+						mxh_reduction.reduce_max(_mxh);
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+
+						//Now estimate moment using RK4 midle step
+						paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -104,20 +116,26 @@ void Atom_DifferentialEquationCubic::RunRK4_Step0(void)
 	if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current moment for later use
-			sM1[idx] = paMesh->M1[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
 
-				//Now estimate moment using RK4 midle step
-				paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+
+					//Now estimate moment using RK4 midle step
+					paMesh->M1[idx] += sEval0[idx] * (dT / 2);
+				}
 			}
 		}
 	}
@@ -126,15 +144,21 @@ void Atom_DifferentialEquationCubic::RunRK4_Step0(void)
 void Atom_DifferentialEquationCubic::RunRK4_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
 
-			//Now estimate moment using RK4 midle step
-			paMesh->M1[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
+				//Now estimate moment using RK4 midle step
+				paMesh->M1[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
+			}
 		}
 	}
 }
@@ -142,15 +166,21 @@ void Atom_DifferentialEquationCubic::RunRK4_Step1(void)
 void Atom_DifferentialEquationCubic::RunRK4_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
 
-			//Now estimate moment using RK4 last step
-			paMesh->M1[idx] = sM1[idx] + sEval2[idx] * dT;
+				//Now estimate moment using RK4 last step
+				paMesh->M1[idx] = sM1[idx] + sEval2[idx] * dT;
+			}
 		}
 	}
 }
@@ -167,28 +197,34 @@ void Atom_DifferentialEquationCubic::RunRK4_Step3_withReductions(void)
 		double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (paMesh->M1.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				if (!paMesh->M1.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+				if (paMesh->M1.is_not_empty(idx)) {
 
-					//Now estimate moment using previous RK4 evaluations
-					paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					if (!paMesh->M1.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
 
-						double mu_s = paMesh->mu_s;
-						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-						paMesh->M1[idx].renormalize(mu_s);
-					}
+						//Now estimate moment using previous RK4 evaluations
+						paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+
+						if (renormalize) {
+
+							double mu_s = paMesh->mu_s;
+							paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+							paMesh->M1[idx].renormalize(mu_s);
+						}
 
-					//obtained maximum dmdt term
-					double Mnorm = paMesh->M1[idx].norm();
-					dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+						//obtained maximum dmdt term
+						double Mnorm = paMesh->M1[idx].norm();
+						dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+					}
 				}
 			}
 		}
@@ -210,29 +246,35 @@ void Atom_DifferentialEquationCubic::RunRK4_Step3_withReductions(void)
 		double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (paMesh->M1.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				if (!paMesh->M1.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+				if (paMesh->M1.is_not_empty(idx)) {
 
-					//Now estimate moment using previous RK4 evaluations
-					paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					if (!paMesh->M1.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
 
-						double mu_s = paMesh->mu_s;
-						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-						paMesh->M1[idx].renormalize(mu_s);
-					}
+						//Now estimate moment using previous RK4 evaluations
+						paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+
+						if (renormalize) {
 
-					//obtained maximum dmdt term
-					double Mnorm = paMesh->M1[idx].norm();
-					double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
-					dmdt_reduction.reduce_max(_dmdt);
+							double mu_s = paMesh->mu_s;
+							paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+							paMesh->M1[idx].renormalize(mu_s);
+						}
+
+						//obtained maximum dmdt term
+						double Mnorm = paMesh->M1[idx].norm();
+						double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+						dmdt_reduction.reduce_max(_dmdt);
+					}
 				}
 			}
 		}
@@ -251,23 +293,29 @@ void Atom_DifferentialEquationCubic::RunRK4_Step3_withReductions(void)
 void Atom_DifferentialEquationCubic::RunRK4_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//Now estimate moment using previous RK4 evaluations
-				paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					//Now estimate moment using previous RK4 evaluations
+					paMesh->M1[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
 
-				if (renormalize) {
+					if (renormalize) {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
 				}
 			}
 		}
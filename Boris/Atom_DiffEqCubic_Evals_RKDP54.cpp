@@ -19,29 +19,35 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//obtain maximum normalized torque term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
-				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+					//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
+					DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / Mnorm;
-				lte_reduction.reduce_max(_lte);
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / Mnorm;
+					lte_reduction.reduce_max(_lte);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -63,24 +69,30 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
-				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
+					DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -110,15 +122,21 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0_Advance(void)
 void Atom_DifferentialEquationCubic::RunRKDP54_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
 
-			//Now estimate moment using RKDP midle step 1
-			paMesh->M1[idx] = sM1[idx] + (3 * sEval0[idx] / 40 + 9 * sEval1[idx] / 40) * dT;
+				//Now estimate moment using RKDP midle step 1
+				paMesh->M1[idx] = sM1[idx] + (3 * sEval0[idx] / 40 + 9 * sEval1[idx] / 40) * dT;
+			}
 		}
 	}
 }
@@ -126,15 +144,21 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step1(void)
 void Atom_DifferentialEquationCubic::RunRKDP54_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
 
-			//Now estimate moment using RKDP midle step 2
-			paMesh->M1[idx] = sM1[idx] + (44 * sEval0[idx] / 45 - 56 * sEval1[idx] / 15 + 32 * sEval2[idx] / 9) * dT;
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
+
+				//Now estimate moment using RKDP midle step 2
+				paMesh->M1[idx] = sM1[idx] + (44 * sEval0[idx] / 45 - 56 * sEval1[idx] / 15 + 32 * sEval2[idx] / 9) * dT;
+			}
 		}
 	}
 }
@@ -142,15 +166,21 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step2(void)
 void Atom_DifferentialEquationCubic::RunRKDP54_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
+				//First evaluate RHS of set equation at the current time step
+				sEval3[idx] = eval_block.eval(idx);
 
-			//Now estimate moment using RKDP midle step 3
-			paMesh->M1[idx] = sM1[idx] + (19372 * sEval0[idx] / 6561 - 25360 * sEval1[idx] / 2187 + 64448 * sEval2[idx] / 6561 - 212 * sEval3[idx] / 729) * dT;
+				//Now estimate moment using RKDP midle step 3
+				paMesh->M1[idx] = sM1[idx] + (19372 * sEval0[idx] / 6561 - 25360 * sEval1[idx] / 2187 + 64448 * sEval2[idx] / 6561 - 212 * sEval3[idx] / 729) * dT;
+			}
 		}
 	}
 }
@@ -158,15 +188,21 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step3(void)
 void Atom_DifferentialEquationCubic::RunRKDP54_Step4(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate moment using RKDP midle step 4
-			paMesh->M1[idx] = sM1[idx] + (9017 * sEval0[idx] / 3168 - 355 * sEval1[idx] / 33 + 46732 * sEval2[idx] / 5247 + 49 * sEval3[idx] / 176 - 5103 * sEval4[idx] / 18656) * dT;
+			if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval4[idx] = eval_block.eval(idx);
+
+				//Now estimate moment using RKDP midle step 4
+				paMesh->M1[idx] = sM1[idx] + (9017 * sEval0[idx] / 3168 - 355 * sEval1[idx] / 33 + 46732 * sEval2[idx] / 5247 + 49 * sEval3[idx] / 176 - 5103 * sEval4[idx] / 18656) * dT;
+			}
 		}
 	}
 }
@@ -179,29 +215,35 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step5_withReductions(void)
 	double conversion = MUB / paMesh->h.dim();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
 
-				//RKDP54 : 5th order evaluation
-				paMesh->M1[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
+				if (!paMesh->M1.is_skipcell(idx)) {
 
-				if (renormalize) {
+					//First evaluate RHS of set equation at the current time step
+					sEval5[idx] = eval_block.eval(idx);
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
-				}
+					//RKDP54 : 5th order evaluation
+					paMesh->M1[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
 
-				//obtained maximum dmdt term
-				double Mnorm = paMesh->M1[idx].norm();
-				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
+					if (renormalize) {
+
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
 			}
 		}
 	}
@@ -219,23 +261,29 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step5_withReductions(void)
 void Atom_DifferentialEquationCubic::RunRKDP54_Step5(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (paMesh->M1.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!paMesh->M1.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval5[idx] = eval_block.eval(idx);
 
-				//RKDP54 : 5th order evaluation
-				paMesh->M1[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
+					//RKDP54 : 5th order evaluation
+					paMesh->M1[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
 
-				if (renormalize) {
+					if (renormalize) {
 
-					double mu_s = paMesh->mu_s;
-					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
-					paMesh->M1[idx].renormalize(mu_s);
+						double mu_s = paMesh->mu_s;
+						paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+						paMesh->M1[idx].renormalize(mu_s);
+					}
 				}
 			}
 		}
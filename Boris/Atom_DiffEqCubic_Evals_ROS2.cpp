@@ -0,0 +1,287 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_ROS2
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//--------------------------------------------- ROSENBROCK-W 2-STAGE (2nd order solution, embedded 1st order error), EXCHANGE FIELD IMPLICIT
+
+//sEval0 holds dM1 = dT * k1, sEval1 the right hand side of the second stage, sM1 the starting moments (used by the implicit solver as the frozen moments).
+
+//implicit exchange solver coefficients for given cell (ROS2), using LLG form equation coefficients for the current time step
+DBL2 Atom_DifferentialEquationCubic::ROS2_Exchange_Coefficients(int idx)
+{
+	double mu_s = paMesh->mu_s;
+	double alpha = paMesh->alpha;
+	double grel = paMesh->grel;
+	double J = paMesh->J;
+	paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->alpha, alpha, paMesh->grel, grel, paMesh->J, J);
+
+	if (!mu_s) return DBL2();
+
+	double a, b;
+
+	if (setODE == ODE_LLGSTATIC || setODE == ODE_LLGSTATICSA) {
+
+		a = 0.0;
+		b = -GAMMA * grel / (2 * mu_s);
+	}
+	else {
+
+		a = -GAMMA * grel / (1 + alpha * alpha);
+		b = a * alpha / mu_s;
+	}
+
+	//exchange field is J / (muB mu0 mu_s) * sum of neighbor directions, i.e. J * h^2 / (muB mu0 mu_s^2) * delsq M1 up to a term along M1 which exerts no torque (cubic cells assumed)
+	return DBL2(a, b) * (ROS2_GAMMA * dT * J * paMesh->h.x * paMesh->h.x / (MUB_MU0 * mu_s * mu_s));
+}
+
+void Atom_DifferentialEquationCubic::RunROS2_Step0_withReductions(void)
+{
+	implicit_exchange.enabled = paMesh->IsModuleSet(MOD_EXCHANGE) || paMesh->IsModuleSet(MOD_DMEXCHANGE) || paMesh->IsModuleSet(MOD_IDMEXCHANGE) || paMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange.converged = true;
+
+	mxh_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = paMesh->M1[idx].norm();
+					double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					if (implicit_exchange.enabled) implicit_exchange.coeff[idx] = ROS2_Exchange_Coefficients(idx);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	if (paMesh->grel.get0()) {
+
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			paMesh->M1[idx] = sM1[idx] + sEval0[idx];
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunROS2_Step0(void)
+{
+	implicit_exchange.enabled = paMesh->IsModuleSet(MOD_EXCHANGE) || paMesh->IsModuleSet(MOD_DMEXCHANGE) || paMesh->IsModuleSet(MOD_IDMEXCHANGE) || paMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange.converged = true;
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
+
+				if (!paMesh->M1.is_skipcell(idx)) {
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					if (implicit_exchange.enabled) implicit_exchange.coeff[idx] = ROS2_Exchange_Coefficients(idx);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			paMesh->M1[idx] = sM1[idx] + sEval0[idx];
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunROS2_Step1_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!paMesh->M1.is_skipcell(idx)) sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+				else sEval1[idx] = DBL3();
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			DBL3 dM2 = implicit_exchange.x[idx];
+
+			paMesh->M1[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+
+			//difference between 2nd order solution and embedded 1st order solution M + dM1
+			DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+
+			//projection step to preserve moment length
+			if (renormalize) {
+
+				double mu_s = paMesh->mu_s;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+				paMesh->M1[idx].renormalize(mu_s);
+			}
+
+			//obtained maximum dmdt term
+			double Mnorm = paMesh->M1[idx].norm();
+			double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+			dmdt_reduction.reduce_max(_dmdt);
+
+			//local truncation error
+			double _lte = GetMagnitude(difference) / Mnorm;
+			lte_reduction.reduce_max(_lte);
+		}
+	}
+
+	if (paMesh->grel.get0()) {
+
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+void Atom_DifferentialEquationCubic::RunROS2_Step1(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (paMesh->M1.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!paMesh->M1.is_skipcell(idx)) sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+				else sEval1[idx] = DBL3();
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			DBL3 dM2 = implicit_exchange.x[idx];
+
+			paMesh->M1[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+
+			//difference between 2nd order solution and embedded 1st order solution M + dM1
+			DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+
+			//projection step to preserve moment length
+			if (renormalize) {
+
+				double mu_s = paMesh->mu_s;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+				paMesh->M1[idx].renormalize(mu_s);
+			}
+
+			//local truncation error
+			double _lte = GetMagnitude(difference) / paMesh->M1[idx].norm();
+			lte_reduction.reduce_max(_lte);
+		}
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+#endif
+#endif
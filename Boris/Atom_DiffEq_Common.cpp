@@ -173,6 +173,9 @@ BError Atom_ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_met
 
 void Atom_ODECommon::Set_mxh(void)
 {
+	//micromagnetic multi-rate pass : atomistic meshes not iterated
+	if (multirate_pass == MULTIRATE_MICROMAGNETIC) return;
+
 	//set mxh as the maximum values from all the set meshes
 	for (int idx = 0; idx < pODE.size(); idx++) {
 
@@ -182,6 +185,9 @@ void Atom_ODECommon::Set_mxh(void)
 
 void Atom_ODECommon::Set_dmdt(void)
 {
+	//micromagnetic multi-rate pass : atomistic meshes not iterated
+	if (multirate_pass == MULTIRATE_MICROMAGNETIC) return;
+
 	//set dmdt as the maximum values from all the set meshes
 	for (int idx = 0; idx < pODE.size(); idx++) {
 
@@ -191,6 +197,9 @@ void Atom_ODECommon::Set_dmdt(void)
 
 void Atom_ODECommon::Set_lte(void)
 {
+	//micromagnetic multi-rate pass : atomistic meshes not iterated
+	if (multirate_pass == MULTIRATE_MICROMAGNETIC) return;
+
 	for (int idx = 0; idx < pODE.size(); idx++) {
 
 		if (pODE[idx]->lte_reduction.max > lte) lte = pODE[idx]->lte_reduction.max;
@@ -6,6 +6,9 @@
 //restore ODE solvers so iteration can be redone (call if AdvanceIteration has failed)
 void Atom_ODECommon::Restore(void)
 {
+	//micromagnetic multi-rate pass : atomistic meshes not iterated
+	if (multirate_pass == MULTIRATE_MICROMAGNETIC) return;
+
 	for (int idx = 0; idx < (int)pODE.size(); idx++) {
 
 		pODE[idx]->RestoreMoments();
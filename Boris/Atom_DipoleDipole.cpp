@@ -216,6 +216,16 @@ BError Atom_DipoleDipole::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	return error;
 }
 
+//discard saved evaluations so the next demag field evaluation is a full one, also in the CUDA module if enabled
+void Atom_DipoleDipole::Reset_Speedup_History(void)
+{
+	DemagBase::Reset_Speedup_History();
+
+#if COMPILECUDA == 1
+	if (pModuleCUDA) dynamic_cast<Atom_DipoleDipoleCUDA*>(pModuleCUDA)->Reset_Speedup_History();
+#endif
+}
+
 //Set PBC
 BError Atom_DipoleDipole::Set_PBC(INT3 demag_pbc_images_)
 {
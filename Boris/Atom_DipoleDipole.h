@@ -76,6 +76,10 @@ public:
 	//Set PBC
 	BError Set_PBC(INT3 demag_pbc_images_);
 
+	//-------------------Evaluation speedup
+
+	void Reset_Speedup_History(void);
+
 	//-------------------Energy methods
 
 	//For simple cubic mesh spin_index coincides with index in M1
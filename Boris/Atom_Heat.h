@@ -41,6 +41,15 @@ private:
 	//2-temperature model : itinerant electrons <-> lattice
 	void IterateHeatEquation_2TM(double dT);
 
+	//implicit time step with weight theta for the new time (0.5 : Crank-Nicolson, 1 : backward Euler) : set heatEq_diag and heatEq_RHS for current temperature (1TM or 2TM). Return false if out of memory.
+	bool PrimeHeatEquation_Implicit(double dT, double theta);
+
+	//implicit time step : residual of heat equation for current temperature values (zero in empty and CMBND cells)
+	void CalculateHeatEquation_Residual(std::vector<double>& r);
+
+	//implicit time step : after new temperature obtained, also advance lattice temperature for 2TM
+	void CompleteHeatEquation_Implicit(double dT, double theta);
+
 public:
 
 	Atom_Heat(Atom_Mesh *pMesh_);
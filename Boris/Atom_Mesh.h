@@ -61,6 +61,9 @@ public:
 	//effective field (units of A/m : easier to integrate with micromagnetic meshes in a multiscale simulation this way) - sum total field of all the added modules (first sub-lattice : used in cubic, bcc, fcc, hcp)
 	VEC<DBL3> Heff1;
 
+	//multi-rate time stepping : contribution of super-mesh modules (e.g. demag) to Heff1, saved at synchronization points and held constant over the atomistic sub-steps (empty if not used)
+	VEC<DBL3> Heff1_coupling;
+
 	//-----Electric conduction properties (Electron charge and spin Transport)
 
 	//In Meshbase
@@ -245,6 +248,15 @@ public:
 	template <typename ... MeshParam_List>
 	void update_parameters_atposition(const DBL3& position, MeshParam_List& ... params);
 
+	//UNIFORMITY CHECK - PUBLIC
+
+	//Check if all parameters in the list have the same value in every cell (no spatial dependence, and no temperature dependence if a temperature mesh is set) : the current values can then be used directly without per-cell updates
+	template <typename PType, typename SType, typename ... MeshParam_List>
+	bool is_uniform_parameters(MatP<PType, SType>& matp, MeshParam_List& ... params) { return is_uniform_parameters(matp) && is_uniform_parameters(params...); }
+
+	template <typename PType, typename SType>
+	bool is_uniform_parameters(MatP<PType, SType>& matp) { return !matp.is_sdep() && (!Temp.linear_size() || !matp.is_tdep()); }
+
 	//----------------------------------- DISPLAY-ASSOCIATED GET/SET METHODS : Atom_MeshDisplay.cpp
 
 	//Return quantity currently set to display on screen.
@@ -63,6 +63,9 @@ private:
 	//call-back method for Poisson equation to evaluate RHS
 	double Evaluate_SpinSolver_delsqV_RHS(int idx) const;
 
+	//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+	void CalculateSpinSolver_Charge_Residual(std::vector<double>& r);
+
 	//before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 	void PrimeSpinSolver_Spin(void);
 
@@ -73,6 +76,9 @@ private:
 	//call-back method for Poisson equation for S
 	DBL3 Evaluate_SpinSolver_delsqS_RHS(int idx) const;
 
+	//residual of Poisson equation for S, written in r : used by Krylov solver
+	void CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r);
+
 	//Non-homogeneous Neumann boundary condition for V' - call-back method for Poisson equation for V
 	DBL3 NHNeumann_Vdiff(int idx) const;
 
@@ -228,6 +234,9 @@ private:
 	//call-back method for Poisson equation to evaluate RHS
 	double Evaluate_SpinSolver_delsqV_RHS(int idx) const { return 0.0; }
 
+	//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+	void CalculateSpinSolver_Charge_Residual(std::vector<double>& r) {}
+
 	//solve for spin accumulation using Poisson equation for delsq_S. Use SOR. 
 	//Return un-normalized error (maximum change in quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	DBL2 IterateSpinSolver_Spin_SOR(double damping) { return DBL2(); }
@@ -238,6 +247,9 @@ private:
 	//call-back method for Poisson equation for S
 	DBL3 Evaluate_SpinSolver_delsqS_RHS(int idx) const { return DBL3(); }
 
+	//residual of Poisson equation for S, written in r : used by Krylov solver
+	void CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r) {}
+
 	//Non-homogeneous Neumann boundary condition for V' - call-back method for Poisson equation for V
 	DBL3 NHNeumann_Vdiff(int idx) const { return DBL3(); }
 
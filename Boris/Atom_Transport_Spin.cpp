@@ -20,6 +20,12 @@ DBL2 Atom_Transport::IterateSpinSolver_Charge_SOR(double damping)
 	return paMesh->V.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqV_RHS, *this, damping);
 }
 
+//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+void Atom_Transport::CalculateSpinSolver_Charge_Residual(std::vector<double>& r)
+{
+	paMesh->V.Poisson_Residual<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqV_RHS, *this, r);
+}
+
 //before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 void Atom_Transport::PrimeSpinSolver_Charge(void)
 {
@@ -147,6 +153,12 @@ DBL2 Atom_Transport::IterateSpinSolver_Spin_SOR(double damping)
 	return paMesh->S.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqS_RHS, *this, damping);
 }
 
+//residual of Poisson equation for S, written in r : used by Krylov solver
+void Atom_Transport::CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r)
+{
+	paMesh->S.Poisson_Residual<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqS_RHS, *this, r);
+}
+
 //before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 void Atom_Transport::PrimeSpinSolver_Spin(void)
 {
@@ -858,6 +858,8 @@ void Simulation::Print_Speedup_List(void)
 {
 	std::string speedup_list = "[tc1,1,1,1/tc]Evaluation speedup mode : " + MakeIO(IOI_SPEEDUPMODE) + "</c> Speedup demag field evaluation time-step: " + MakeIO(IOI_SPEEDUPDT) + "</c> Linked to ODE dT : " + MakeIO(IOI_LINKSPEEDUPDT) + "</c>\n";
 
+	if (SMesh.GetSpeedupTolerance() > 0.0) speedup_list += "[tc1,1,1,1/tc]Adaptive evaluation speedup tolerance : " + ToString(SMesh.GetSpeedupTolerance()) + "\n";
+
 	for (int idxMesh = 0; idxMesh < (int)SMesh().size(); idxMesh++) {
 
 		speedup_list += Build_Speedup_ListLine(idxMesh) + "\n";
@@ -338,6 +338,8 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization solver time step</i>"), INT2(IOI_SHOWDATA, DATA_DT));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization relaxation |mxh|</i>"), INT2(IOI_SHOWDATA, DATA_MXH));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization relaxation |dm/dt|</i>"), INT2(IOI_SHOWDATA, DATA_DMDT));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Adaptive evaluation speedup:\n<i><b>skipped demag evaluations</i>"), INT2(IOI_SHOWDATA, DATA_SPEEDUP_SKIPPED));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Adaptive evaluation speedup:\n<i><b>estimated extrapolation error</i>"), INT2(IOI_SHOWDATA, DATA_SPEEDUP_ERROR));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average magnetization</i>"), INT2(IOI_SHOWDATA, DATA_AVM));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average magnetization sub-lattice B</i>"), INT2(IOI_SHOWDATA, DATA_AVM2));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Thermodynamic average magnetization</i>"), INT2(IOI_SHOWDATA, DATA_THAVM));
@@ -409,6 +411,8 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization solver time step</i>"), INT2(IOI_DATA, DATA_DT));
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization relaxation |mxh|</i>"), INT2(IOI_DATA, DATA_MXH));
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization relaxation |dm/dt|</i>"), INT2(IOI_DATA, DATA_DMDT));
+	ioInfo.set(data_info_generic + std::string("<i><b>Adaptive evaluation speedup:\n<i><b>skipped demag evaluations</i>"), INT2(IOI_DATA, DATA_SPEEDUP_SKIPPED));
+	ioInfo.set(data_info_generic + std::string("<i><b>Adaptive evaluation speedup:\n<i><b>estimated extrapolation error</i>"), INT2(IOI_DATA, DATA_SPEEDUP_ERROR));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average magnetization</i>"), INT2(IOI_DATA, DATA_AVM));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average magnetization sub-lattice B</i>"), INT2(IOI_DATA, DATA_AVM2));
 	ioInfo.set(data_info_generic + std::string("<i><b>Thermodynamic average magnetization</i>"), INT2(IOI_DATA, DATA_THAVM));
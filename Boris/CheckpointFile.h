@@ -0,0 +1,233 @@
+#pragma once
+
+#include "BorisLib.h"
+
+#include <cstring>
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Binary checkpoint files (.bck) : a 64 byte file header followed by a sequence of chunks.
+// Each chunk has a 64 byte header (name, element size, number of elements) followed by the raw data, padded to a multiple of 64 bytes.
+// Thus the raw data of every chunk (e.g. a VEC buffer) starts at a 64 byte aligned file offset and can be memory mapped directly.
+//
+// The same traversal method is used to save, verify and load a checkpoint (see CHECKPOINT_ below) : chunks are matched by name and size when verifying or loading,
+// so a checkpoint can only be loaded into the same simulation configuration it was saved from. Verify before loading so nothing is changed if the checkpoint doesn't match.
+//
+// When saving, data is written to a temporary file first, which replaces the checkpoint file only after it was written successfully, thus a previous checkpoint is never lost.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CHECKPOINT_MAGIC	"BorisCheckpoint"
+#define CHECKPOINT_FORMAT	1
+
+//file header, chunk headers and chunk data alignment (bytes)
+#define CHECKPOINT_ALIGN	64
+
+//maximum chunk name length (including null terminator) - longer names are truncated
+#define CHECKPOINT_NAMELENGTH	48
+
+//CHECKPOINT_SAVE : write chunks
+//CHECKPOINT_VERIFY : read chunks and check they match, but do not change any values
+//CHECKPOINT_LOAD : read chunks into values
+enum CHECKPOINT_ { CHECKPOINT_SAVE = 0, CHECKPOINT_VERIFY, CHECKPOINT_LOAD };
+
+class CheckpointFile {
+
+	struct FileHeader {
+
+		char magic[16];
+		int format;
+		int program_version;
+		char reserved[CHECKPOINT_ALIGN - 16 - 2 * sizeof(int)];
+	};
+
+	struct ChunkHeader {
+
+		char name[CHECKPOINT_NAMELENGTH];
+		unsigned int element_size;
+		unsigned int reserved;
+		unsigned long long count;
+	};
+
+private:
+
+	std::ofstream bdout;
+	std::ifstream bdin;
+
+	std::string fileName;
+
+	//value from CHECKPOINT_ enum
+	int mode;
+
+	//false as soon as any chunk couldn't be written, or doesn't match when verifying or loading
+	bool success = true;
+
+	//set if the checkpoint was written for a different program version
+	bool version_mismatch = false;
+
+private:
+
+	//write chunk header and raw data, padded to alignment
+	void write_chunk(const std::string& name, const void* data, size_t element_size, size_t count)
+	{
+		ChunkHeader header;
+		memset(&header, 0, sizeof(ChunkHeader));
+		strncpy(header.name, name.c_str(), CHECKPOINT_NAMELENGTH - 1);
+		header.element_size = (unsigned int)element_size;
+		header.count = count;
+
+		bdout.write(reinterpret_cast<const char*>(&header), sizeof(ChunkHeader));
+
+		size_t bytes = element_size * count;
+		if (bytes) bdout.write(reinterpret_cast<const char*>(data), bytes);
+
+		char padding[CHECKPOINT_ALIGN] = {};
+		if (bytes % CHECKPOINT_ALIGN) bdout.write(padding, CHECKPOINT_ALIGN - bytes % CHECKPOINT_ALIGN);
+
+		if (!bdout.good()) success = false;
+	}
+
+	//read chunk header and check it has the expected name and element size : return number of elements in chunk (-1 if it doesn't match)
+	long long read_chunk_header(const std::string& name, size_t element_size)
+	{
+		ChunkHeader header;
+		if (!bdin.read(reinterpret_cast<char*>(&header), sizeof(ChunkHeader))) return -1;
+
+		header.name[CHECKPOINT_NAMELENGTH - 1] = 0;
+		if (name.substr(0, CHECKPOINT_NAMELENGTH - 1) != std::string(header.name) || header.element_size != element_size) return -1;
+
+		return (long long)header.count;
+	}
+
+	//read raw data following a chunk header (just skip over it if data is nullptr), together with the padding
+	void read_chunk_data(void* data, size_t bytes)
+	{
+		if (data && bytes) bdin.read(reinterpret_cast<char*>(data), bytes);
+		else if (bytes) bdin.seekg(bytes, std::ios::cur);
+
+		if (bytes % CHECKPOINT_ALIGN) bdin.seekg(CHECKPOINT_ALIGN - bytes % CHECKPOINT_ALIGN, std::ios::cur);
+
+		if (!bdin.good()) success = false;
+	}
+
+	//read chunk which must contain exactly count elements into data (skipped unless loading, or read_always set)
+	void read_chunk(const std::string& name, void* data, size_t element_size, size_t count, bool read_always = false)
+	{
+		if (!success) return;
+
+		if (read_chunk_header(name, element_size) != (long long)count) { success = false; return; }
+
+		read_chunk_data(mode == CHECKPOINT_LOAD || read_always ? data : nullptr, element_size * count);
+	}
+
+public:
+
+	CheckpointFile(std::string fileName_, int mode_, int program_version) :
+		fileName(fileName_), mode(mode_)
+	{
+		FileHeader header;
+		memset(&header, 0, sizeof(FileHeader));
+
+		if (mode == CHECKPOINT_SAVE) {
+
+			strncpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic) - 1);
+			header.format = CHECKPOINT_FORMAT;
+			header.program_version = program_version;
+
+			bdout.open((fileName + ".tmp").c_str(), std::ios::out | std::ios::binary);
+			if (bdout.is_open()) bdout.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+
+			success = bdout.is_open() && bdout.good();
+		}
+		else {
+
+			bdin.open(fileName.c_str(), std::ios::in | std::ios::binary);
+
+			success = bdin.is_open() && bdin.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+			header.magic[sizeof(header.magic) - 1] = 0;
+			if (success && (std::string(header.magic) != CHECKPOINT_MAGIC || header.format != CHECKPOINT_FORMAT)) success = false;
+			if (success && header.program_version != program_version) version_mismatch = true;
+		}
+	}
+
+	~CheckpointFile() { close(); }
+
+	//finish saving (replace checkpoint file with written temporary file) or loading : return true if all chunks were written, or matched when verifying or loading
+	bool close(void)
+	{
+		if (bdout.is_open()) {
+
+			bdout.close();
+
+			if (success) {
+
+				std::remove(fileName.c_str());
+				success = !std::rename((fileName + ".tmp").c_str(), fileName.c_str());
+			}
+			else std::remove((fileName + ".tmp").c_str());
+		}
+
+		if (bdin.is_open()) bdin.close();
+
+		return success && !version_mismatch;
+	}
+
+	//--------------------------------------------
+
+	bool is_saving(void) { return mode == CHECKPOINT_SAVE; }
+	bool is_loading(void) { return mode == CHECKPOINT_LOAD; }
+
+	bool good(void) { return success && !version_mismatch; }
+	bool is_version_mismatch(void) { return version_mismatch; }
+
+	//--------------------------------------------
+
+	//simple value (fundamental type, or a BorisLib type such as DBL3, INT2)
+	template <typename Type>
+	void value(const std::string& name, Type& data)
+	{
+		if (mode == CHECKPOINT_SAVE) write_chunk(name, &data, sizeof(Type), 1);
+		else read_chunk(name, &data, sizeof(Type), 1);
+	}
+
+	//simple value which is not changed when loading, but must match the saved value (e.g. mesh dimensions)
+	template <typename Type>
+	void check(const std::string& name, const Type& value)
+	{
+		if (mode == CHECKPOINT_SAVE) { write_chunk(name, &value, sizeof(Type), 1); return; }
+
+		Type saved_value;
+		read_chunk(name, &saved_value, sizeof(Type), 1, true);
+
+		if (success && memcmp(&saved_value, &value, sizeof(Type))) success = false;
+	}
+
+	//raw VEC buffer : VEC must have the same size as the saved one (both can be empty)
+	template <typename VType>
+	void vec(const std::string& name, VEC<VType>& data)
+	{
+		if (mode == CHECKPOINT_SAVE) write_chunk(name, data.data(), sizeof(VType), data.linear_size());
+		else read_chunk(name, data.data(), sizeof(VType), data.linear_size());
+	}
+
+	//std::vector of simple values : resized to saved size when loading
+	template <typename Type>
+	void vector(const std::string& name, std::vector<Type>& data)
+	{
+		if (mode == CHECKPOINT_SAVE) { write_chunk(name, data.data(), sizeof(Type), data.size()); return; }
+
+		if (!success) return;
+
+		long long count = read_chunk_header(name, sizeof(Type));
+		if (count < 0) { success = false; return; }
+
+		if (mode == CHECKPOINT_LOAD) {
+
+			if (!malloc_vector(data, count)) { success = false; return; }
+			read_chunk_data(data.data(), sizeof(Type) * count);
+		}
+		else read_chunk_data(nullptr, sizeof(Type) * count);
+	}
+};
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "Simulation.h"
+#include "DemagKernelCache.h"
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -1765,6 +1766,30 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_DEMAGTREECODE:
+		{
+			bool status;
+			double theta;
+			std::string meshName;
+
+			optional_meshname_check_focusedmeshdefault(command_fields);
+			error = commandSpec.GetParameters(command_fields, meshName, status, theta);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, meshName, status); theta = 0.0; }
+
+			if (!error) {
+
+				StopSimulation();
+				if (!err_hndl.qcall(error, &SuperMesh::Set_Demag_TreeCode, &SMesh, status, theta, meshName)) UpdateScreen();
+			}
+			else if (verbose) PrintCommandUsage(command_name);
+
+			if (script_client_connected && SMesh.contains(meshName) && SMesh[meshName]->Is_Demag_Enabled()) {
+
+				commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh[meshName]->CallModuleMethod(&DemagBase::Get_TreeCode), SMesh[meshName]->CallModuleMethod(&DemagBase::Get_TreeCode_Theta)));
+			}
+		}
+		break;
+
 		case CMD_GPUKERNELS:
 		{
 			bool status;
@@ -1802,7 +1827,8 @@ void Simulation::HandleCommand(std::string command_string)
 				ODE_ setOde = (ODE_)odeHandles.get_ID_from_value(odeHandle);
 				EVAL_ odeEval = (EVAL_)odeEvalHandles.get_ID_from_value(odeEvalHandle);
 
-				if (setOde != ODE_ERROR && odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(setOde), odeEval)) {
+				//LSRK43, ROS2 and NCG evaluation methods not available with CUDA
+				if (setOde != ODE_ERROR && odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(setOde), odeEval) && ((odeEval != EVAL_LSRK43 && odeEval != EVAL_ROS2 && odeEval != EVAL_NCG) || !cudaEnabled)) {
 
 					if (!err_hndl.call(error, &SuperMesh::SetODE, &SMesh, setOde, odeEval)) {
 
@@ -1831,7 +1857,8 @@ void Simulation::HandleCommand(std::string command_string)
 				ODE_ odeID;
 				SMesh.QueryODE(odeID);
 
-				if (setatom_Ode != ODE_ERROR && odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(setatom_Ode), odeEval) && vector_contains(odeAllowedEvals(odeID), odeEval)) {
+				//LSRK43, ROS2 and NCG evaluation methods not available with CUDA
+				if (setatom_Ode != ODE_ERROR && odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(setatom_Ode), odeEval) && vector_contains(odeAllowedEvals(odeID), odeEval) && ((odeEval != EVAL_LSRK43 && odeEval != EVAL_ROS2 && odeEval != EVAL_NCG) || !cudaEnabled)) {
 
 					if (!err_hndl.call(error, &SuperMesh::SetAtomisticODE, &SMesh, setatom_Ode, odeEval)) {
 
@@ -1860,7 +1887,8 @@ void Simulation::HandleCommand(std::string command_string)
 				SMesh.QueryODE(odeID);
 				SMesh.QueryAtomODE(atom_odeID);
 
-				if (odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(odeID), odeEval) && vector_contains(odeAllowedEvals(atom_odeID), odeEval)) {
+				//LSRK43, ROS2 and NCG evaluation methods not available with CUDA
+				if (odeEval != EVAL_ERROR && vector_contains(odeAllowedEvals(odeID), odeEval) && vector_contains(odeAllowedEvals(atom_odeID), odeEval) && ((odeEval != EVAL_LSRK43 && odeEval != EVAL_ROS2 && odeEval != EVAL_NCG) || !cudaEnabled)) {
 
 					if (!err_hndl.call(error, &SuperMesh::SetODEEval, &SMesh, odeEval)) {
 
@@ -2917,6 +2945,66 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_SAVECHECKPOINT:
+		{
+			std::string fileName;
+
+			error = commandSpec.GetParameters(command_fields, fileName);
+
+			if (error) {
+
+				error.reset();
+				fileName = checkpointFile;
+			}
+
+			ScanFileNameData(fileName);
+
+			error = SaveCheckpoint(fileName);
+
+			if (verbose && !error) BD.DisplayConsoleMessage("Checkpoint saved : " + fileName);
+		}
+		break;
+
+		case CMD_LOADCHECKPOINT:
+		{
+			std::string fileName;
+
+			error = commandSpec.GetParameters(command_fields, fileName);
+
+			if (error) {
+
+				error.reset();
+				fileName = checkpointFile;
+			}
+
+			ScanFileNameData(fileName);
+
+			if (!err_hndl.call(error, &Simulation::LoadCheckpoint, this, fileName)) {
+
+				if (verbose) BD.DisplayConsoleMessage("Checkpoint loaded : " + fileName);
+			}
+		}
+		break;
+
+		case CMD_CHECKPOINTEVERY:
+		{
+			int iterations;
+			std::string fileName;
+
+			error = commandSpec.GetParameters(command_fields, iterations, fileName);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, iterations); fileName = checkpointFile; }
+
+			if (!error) {
+
+				checkpoint_iterations = iterations;
+				checkpointFile = fileName;
+			}
+			else if (verbose) BD.DisplayConsoleListing("Checkpoint every : " + ToString(checkpoint_iterations) + " iterations (0 : disabled), file : " + checkpointFile);
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(checkpoint_iterations));
+		}
+		break;
+
 		case CMD_DEFAULT:
 		{
 			int current_cudaDeviceSelect = cudaDeviceSelect;
@@ -3681,13 +3769,16 @@ void Simulation::HandleCommand(std::string command_string)
 
 				double conv_error;
 				int iters_timeout;
+				int solver_type;
 
-				error = commandSpec.GetParameters(command_fields, conv_error, iters_timeout);
+				error = commandSpec.GetParameters(command_fields, conv_error, iters_timeout, solver_type);
+				if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, conv_error, iters_timeout); solver_type = -1; }
 				if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, conv_error); iters_timeout = 0; }
 
 				if (!error) {
 
 					SMesh.CallModuleMethod(&STransport::SetConvergenceError, conv_error, iters_timeout);
+					if (solver_type >= 0) SMesh.CallModuleMethod(&STransport::SetChargeSolverType, solver_type);
 
 					UpdateScreen();
 				}
@@ -3695,8 +3786,9 @@ void Simulation::HandleCommand(std::string command_string)
 
 				if (script_client_connected)
 					commSocket.SetSendData(commandSpec.PrepareReturnParameters(
-						DBL2(SMesh.CallModuleMethod(&STransport::GetConvergenceError),
-						SMesh.CallModuleMethod(&STransport::GetConvergenceTimeout))));
+						DBL3(SMesh.CallModuleMethod(&STransport::GetConvergenceError),
+						SMesh.CallModuleMethod(&STransport::GetConvergenceTimeout),
+						SMesh.CallModuleMethod(&STransport::GetChargeSolverType))));
 			}
 			else error(BERROR_INCORRECTACTION);
 		}
@@ -3877,13 +3969,22 @@ void Simulation::HandleCommand(std::string command_string)
 		case CMD_SETHEATDT:
 		{
 			double dT;
+			int solver_type;
+			double max_error;
 
-			error = commandSpec.GetParameters(command_fields, dT);
+			error = commandSpec.GetParameters(command_fields, dT, solver_type, max_error);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, dT, solver_type); max_error = 0.0; }
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, dT); solver_type = -1; }
+
+			//implicit heat solvers are only available without CUDA
+			if (!error && solver_type > HSOLVER_FTCS && cudaEnabled) error(BERROR_INCORRECTACTION);
 
 			if (!error) {
 
 				StopSimulation();
 				SMesh.CallModuleMethod(&SHeat::set_heat_dT, dT);
+				if (solver_type >= 0) SMesh.CallModuleMethod(&SHeat::set_heat_solver_type, solver_type);
+				if (max_error > 0.0) SMesh.CallModuleMethod(&SHeat::set_heat_dT_maxerror, max_error);
 				UpdateScreen();
 			}
 			else if (verbose) {
@@ -3893,7 +3994,8 @@ void Simulation::HandleCommand(std::string command_string)
 			}
 
 			if (script_client_connected)
-				commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.CallModuleMethod(&SHeat::get_heat_dT)));
+				commSocket.SetSendData(commandSpec.PrepareReturnParameters(
+					DBL3(SMesh.CallModuleMethod(&SHeat::get_heat_dT), SMesh.CallModuleMethod(&SHeat::get_heat_solver_type), SMesh.CallModuleMethod(&SHeat::get_heat_dT_maxerror))));
 		}
 		break;
 
@@ -4186,6 +4288,65 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_SPEEDUPTOLERANCE:
+		{
+			double tolerance;
+
+			error = commandSpec.GetParameters(command_fields, tolerance);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetSpeedupTolerance(tolerance);
+				UpdateScreen();
+			}
+			else if (verbose) Print_Speedup_List();
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetSpeedupTolerance()));
+		}
+		break;
+
+		case CMD_MULTIRATE:
+		{
+			int substeps;
+
+			error = commandSpec.GetParameters(command_fields, substeps);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetMultiRateSubsteps(substeps);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Multi-rate atomistic sub-steps : " + ToString(SMesh.GetMultiRateSubsteps()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetMultiRateSubsteps()));
+		}
+		break;
+
+		case CMD_ACTIVESET:
+		{
+			double tolerance;
+			int steps;
+
+			error = commandSpec.GetParameters(command_fields, tolerance, steps);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, tolerance); steps = SMesh.GetActiveSetSteps(); }
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetActiveSet(tolerance, steps);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Active set tolerance : " + ToString(SMesh.GetActiveSetTolerance()) + ", frozen steps : " + ToString(SMesh.GetActiveSetSteps()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetActiveSetTolerance(), SMesh.GetActiveSetSteps()));
+		}
+		break;
+
 		case CMD_CUDA:
 		{
 			bool status;
@@ -4196,7 +4357,13 @@ void Simulation::HandleCommand(std::string command_string)
 
 				if (cudaAvailable) {
 
-					if (status != cudaEnabled) {
+					ODE_ odeID;
+					EVAL_ odeEval;
+					SMesh.QueryODE(odeID, odeEval);
+
+					//LSRK43, ROS2 and NCG evaluation methods not available with CUDA : must change evaluation method first
+					if (status && (odeEval == EVAL_LSRK43 || odeEval == EVAL_ROS2 || odeEval == EVAL_NCG)) error(BERROR_INCORRECTCONFIG);
+					else if (status != cudaEnabled) {
 
 						StopSimulation();
 						
@@ -5207,6 +5374,126 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_FFTWPLANNING:
+		{
+			std::string rigor;
+
+			error = commandSpec.GetParameters(command_fields, rigor);
+
+			if (!error) {
+
+				int fftw_planning = fftwPlanningHandles.get_ID_from_value(rigor);
+
+				if (fftw_planning >= 0) {
+
+					StopSimulation();
+
+					//new rigor only applies to plans made from now on (e.g. when meshes are changed or modules re-initialized)
+					ConvolutionData::Set_FFTW_Planning(fftw_planning);
+					Save_Startup_Flags();
+
+					UpdateScreen();
+				}
+				else if (verbose) error(BERROR_INCORRECTCONFIG);
+			}
+			else if (verbose) BD.DisplayConsoleListing("FFTW planning rigor : " + fftwPlanningHandles(ConvolutionData::Get_FFTW_Planning()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(fftwPlanningHandles(ConvolutionData::Get_FFTW_Planning())));
+		}
+		break;
+
+		case CMD_FFTBLOCKING:
+		{
+			int lines;
+
+			error = commandSpec.GetParameters(command_fields, lines);
+
+			if (!error) {
+
+				StopSimulation();
+
+				ConvolutionData::Set_FFT_Block_Lines(lines);
+				Save_Startup_Flags();
+
+				//convolution modules must be set up again for the new setting to take effect
+				error = SMesh.UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE);
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("FFT blocking lines : " + ToString(ConvolutionData::Get_FFT_Block_Lines()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(ConvolutionData::Get_FFT_Block_Lines()));
+		}
+		break;
+
+		case CMD_FFTSINGLEPRECISION:
+		{
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				StopSimulation();
+
+				ConvolutionData::Set_FFT_Single_Precision(status);
+				Save_Startup_Flags();
+
+				//convolution modules must be set up again for the new setting to take effect
+				error = SMesh.UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE);
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("FFT single precision : " + ToString(ConvolutionData::Get_FFT_Single_Precision()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(ConvolutionData::Get_FFT_Single_Precision()));
+		}
+		break;
+
+		case CMD_TASKPARALLEL:
+		{
+			int threads;
+
+			error = commandSpec.GetParameters(command_fields, threads);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.Set_TaskParallel_Threads(threads);
+				Save_Startup_Flags();
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Task-parallel threads : " + ToString(SMesh.Get_TaskParallel_Threads()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.Get_TaskParallel_Threads()));
+		}
+		break;
+
+		case CMD_DEMAGKERNELCACHE:
+		{
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				DemagKernelCache::Set_Enabled(status);
+				Save_Startup_Flags();
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Demag kernel cache status : " + ToString(DemagKernelCache::Get_Enabled()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(DemagKernelCache::Get_Enabled()));
+#else
+			error(BERROR_INCORRECTACTION);
+#endif
+		}
+		break;
+
 		case CMD_SERVERPORT:
 		{
 			int port;
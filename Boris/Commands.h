@@ -12,7 +12,7 @@ enum CMD_
 	//-------------------------------------------SIMULATION AND STATE CONTROL-------------------------------------------
 
 	CMD_RUN, CMD_STOP, CMD_RESET, CMD_COMPUTEFIELDS, CMD_ISRUNNING,
-	CMD_SAVESIM, CMD_LOADSIM, CMD_DEFAULT,
+	CMD_SAVESIM, CMD_LOADSIM, CMD_SAVECHECKPOINT, CMD_LOADCHECKPOINT, CMD_CHECKPOINTEVERY, CMD_DEFAULT,
 
 	CMD_NEXTSTAGE, CMD_SETSCHEDULESTAGE, CMD_RUNSTAGE,
 
@@ -97,7 +97,7 @@ enum CMD_
 
 	//Demag computation control
 
-	CMD_MULTICONV, CMD_2DMULTICONV, CMD_NCOMMONSTATUS, CMD_NCOMMON, CMD_EXCLUDEMULTICONVDEMAG, 
+	CMD_MULTICONV, CMD_2DMULTICONV, CMD_NCOMMONSTATUS, CMD_NCOMMON, CMD_EXCLUDEMULTICONVDEMAG, CMD_DEMAGTREECODE, 
 	CMD_GPUKERNELS,
 
 	//-------------------------------------------ODE-------------------------------------------
@@ -106,7 +106,7 @@ enum CMD_
 
 	CMD_ODE, CMD_SETODE, CMD_SETODEEVAL, CMD_SETATOMODE, CMD_SETDT, CMD_ASTEPCTRL, 
 	
-	CMD_EVALSPEEDUP, CMD_SETDTSPEEDUP, CMD_LINKDTSPEEDUP,
+	CMD_EVALSPEEDUP, CMD_SETDTSPEEDUP, CMD_LINKDTSPEEDUP, CMD_SPEEDUPTOLERANCE, CMD_MULTIRATE, CMD_ACTIVESET,
 
 	//Stochasticity
 
@@ -167,7 +167,7 @@ enum CMD_
 	CMD_SCRIPTSERVER, CMD_CHECKUPDATES,
 	CMD_FLUSHERRORLOG, CMD_ERRORLOG,
 	CMD_STARTUPUPDATECHECK, CMD_STARTUPSCRIPTSERVER,
-	CMD_THREADS,
+	CMD_THREADS, CMD_FFTWPLANNING, CMD_FFTBLOCKING, CMD_FFTSINGLEPRECISION, CMD_TASKPARALLEL, CMD_DEMAGKERNELCACHE,
 	CMD_SERVERPORT, CMD_SERVERPWD, CMD_SERVERSLEEPMS,
 	CMD_NEWINSTANCE,
 
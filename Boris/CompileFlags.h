@@ -108,7 +108,10 @@
 #define ODE_EVAL_COMPILATION_RKF56
 #define ODE_EVAL_COMPILATION_RKCK
 #define ODE_EVAL_COMPILATION_RKDP
+#define ODE_EVAL_COMPILATION_LSRK
+#define ODE_EVAL_COMPILATION_ROS2
 #define ODE_EVAL_COMPILATION_SD
+#define ODE_EVAL_COMPILATION_NCG
 
 #elif ODE_EVAL_COMPILATION == ODE_EVAL_COMPILATION_TEST
 
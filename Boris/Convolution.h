@@ -38,6 +38,12 @@ private:
 
 	//Embedded (default)
 
+	//passes 2 to 6 of 3D convolutions (y and z ffts with embedded kernel multiplication, followed by z and y iffts), on F
+	//one line at a time
+	void Convolute_yz_3D_Lines(void);
+	//blocks of adjacent lines batched into panels (used if block_lines != 0)
+	void Convolute_yz_3D_Blocked(void);
+
 	//convolute In with kernels, set output in Out. 2D is for n.z == 1.
 	//If clearOut flag is true then Out is set, otherwise Out is added into.
 	//SINGLE INPUT, SINGLE OUTPUT
@@ -54,6 +60,22 @@ private:
 	double Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr);
 	double Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr);
 
+	//Embedded, single precision (used instead of the above if single_precision set)
+
+	//input value for a cell index is obtained as get_input(idx), and the output value (double precision) for a cell index is passed on as set_output(idx, value)
+	//this covers all the input / output combinations above. Return dot product of input with output.
+	template <typename GetInput, typename SetOutput>
+	double Convolute_2D_sp(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy);
+	template <typename GetInput, typename SetOutput>
+	double Convolute_3D_sp(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy);
+
+	template <typename GetInput, typename SetOutput>
+	double Convolute_sp(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy)
+	{
+		if (n.z == 1) return Convolute_2D_sp(get_input, set_output, pH, penergy);
+		else return Convolute_3D_sp(get_input, set_output, pH, penergy);
+	}
+
 	//Not embedded
 
 	//SINGLE INPUT
@@ -126,6 +148,9 @@ protected:
 	//This methods sets all values from and h, including allocating memory - call this before initializing kernels or doing any convolutions
 	BError SetDimensions(SZ3 n_, DBL3 h_, bool multiplication_embedding_ = true, INT3 pbc_images_ = INT3());
 
+	//free all memory allocated by SetDimensions (fftw memory and kernels), e.g. if the convolution is not used : SetDimensions must be called again before any convolutions
+	void FreeDimensions(void) { FreeConvolutionMemory(); static_cast<Owner*>(this)->FreeAllKernelMemory(); }
+
 	//-------------------------- CHECK
 
 	//return true only if both n_ and h_ match the current FFT dimensions (n and h); also number of pbc images must match
@@ -141,6 +166,14 @@ protected:
 	//Return dot product of In with Out
 	double Convolute(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if constexpr (Kernel::single_precision_support) {
+
+			if (single_precision) return Convolute_sp(
+				[&](int idx) -> DBL3 { return In[idx]; },
+				[&](int idx, const DBL3& value) { if (clearOut) Out[idx] = value; else Out[idx] += value; },
+				pH, penergy);
+		}
+
 		if (n.z == 1) return Convolute_2D(In, Out, clearOut, pH, penergy);
 		else return Convolute_3D(In, Out, clearOut, pH, penergy);
 	}
@@ -152,6 +185,14 @@ protected:
 	//Same as Convolution with (In1 + In2) / 2 as input.
 	double Convolute_AveragedInputs(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if constexpr (Kernel::single_precision_support) {
+
+			if (single_precision) return Convolute_sp(
+				[&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; },
+				[&](int idx, const DBL3& value) { if (clearOut) Out[idx] = value; else Out[idx] += value; },
+				pH, penergy);
+		}
+
 		if (n.z == 1) return Convolute_2D(In1, In2, Out, clearOut, pH, penergy);
 		else return Convolute_3D(In1, In2, Out, clearOut, pH, penergy);
 	}
@@ -163,6 +204,16 @@ protected:
 	//Same as Convolution with (In1 + In2) / 2 as input and output copied to both Out1 and Out2.
 	double Convolute_AveragedInputs_DuplicatedOutputs(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if constexpr (Kernel::single_precision_support) {
+
+			if (single_precision) return Convolute_sp(
+				[&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; },
+				[&](int idx, const DBL3& value) {
+					if (clearOut) { Out1[idx] = value; Out2[idx] = value; }
+					else { Out1[idx] += value; Out2[idx] += value; } },
+				pH, penergy);
+		}
+
 		if (n.z == 1) return Convolute_2D(In1, In2, Out1, Out2, clearOut, pH, penergy);
 		else return Convolute_3D(In1, In2, Out1, Out2, clearOut, pH, penergy);
 	}
@@ -249,7 +300,7 @@ BError Convolution<Owner, Kernel>::SetDimensions(SZ3 n_, DBL3 h_, bool multiplic
 {
 	BError error(__FUNCTION__);
 
-	error = SetConvolutionDimensions(n_, h_, multiplication_embedding_, pbc_images_);
+	error = SetConvolutionDimensions(n_, h_, multiplication_embedding_, pbc_images_, Kernel::single_precision_support);
 	if (!error) error = static_cast<Owner*>(this)->AllocateKernelMemory();
 
 	return error;
@@ -652,40 +703,12 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	return dot_product;
 }
 
-//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication embedded)
+//-------------------------- RUN-TIME CONVOLUTION : 3D y and z passes (multiplication embedded)
 
-//SINGLE INPUT, SINGLE OUTPUT
+//one line at a time
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
-{	
-	//3D
-
-	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
-
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
-
+void Convolution<Owner, Kernel>::Convolute_yz_3D_Lines(void)
+{
 	//2. FFTs along y
 	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
@@ -763,6 +786,168 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 			}
 		}
 	}
+}
+
+//blocks of block_lines adjacent lines (along x) gathered into panels, with one batched fft per panel
+//panels are small enough to stay in cache, and gathering / scattering panel rows accesses F contiguously rather than with large strides
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::Convolute_yz_3D_Blocked(void)
+{
+	int Nx2 = N.x / 2 + 1;
+
+	//last block may be only partially filled : the unused panel lines are transformed but not written back
+	int num_blocks = (Nx2 + block_lines - 1) / block_lines;
+
+	//2. FFTs along y
+#pragma omp parallel for
+	for (int kb = 0; kb < n.z * num_blocks; kb++) {
+
+		int tn = omp_get_thread_num();
+
+		int k = kb / num_blocks;
+		int i0 = (kb % num_blocks) * block_lines;
+		int width = minimum(block_lines, Nx2 - i0);
+
+		ReIm3* ppanel_in = reinterpret_cast<ReIm3*>(ppanel_zp_y[tn]);
+		ReIm3* ppanel_out = reinterpret_cast<ReIm3*>(ppanel[tn]);
+
+		//fetch panel from fft array (zero padding kept)
+		for (int j = 0; j < n.y; j++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) ppanel_in[j * block_lines + b] = pF[b];
+		}
+
+		//fft on panel
+		fftw_execute(plan_fwd_y_panel[tn]);
+
+		//write panel to fft array
+		for (int j = 0; j < N.y; j++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) pF[b] = ppanel_out[j * block_lines + b];
+		}
+	}
+
+	//3. FFTs along z
+#pragma omp parallel for
+	for (int jb = 0; jb < N.y * num_blocks; jb++) {
+
+		int tn = omp_get_thread_num();
+
+		int j = jb / num_blocks;
+		int i0 = (jb % num_blocks) * block_lines;
+		int width = minimum(block_lines, Nx2 - i0);
+
+		ReIm3* ppanel_in = reinterpret_cast<ReIm3*>(ppanel_zp_z[tn]);
+		ReIm3* ppanel_out = reinterpret_cast<ReIm3*>(ppanel[tn]);
+		ReIm3* pline_tn = reinterpret_cast<ReIm3*>(pline[tn]);
+
+		//fetch panel from fft array (zero padding kept)
+		for (int k = 0; k < n.z; k++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) ppanel_in[k * block_lines + b] = pF[b];
+		}
+
+		//fft on panel
+		fftw_execute(plan_fwd_z_panel[tn]);
+
+		//4. kernel multiplication on each line of panel : kernel multiplication works on contiguous lines so transpose through pline
+		for (int b = 0; b < width; b++) {
+
+			for (int k = 0; k < N.z; k++) pline_tn[k] = ppanel_out[k * block_lines + b];
+
+			static_cast<Owner*>(this)->KernelMultiplication_3D_line(pline_tn, i0 + b, j);
+
+			for (int k = 0; k < N.z; k++) ppanel_out[k * block_lines + b] = pline_tn[k];
+		}
+
+		//5. ifft on panel
+		fftw_execute(plan_inv_z_panel[tn]);
+
+		//write panel to fft array, truncating upper half
+		for (int k = 0; k < n.z; k++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) pF[b] = ppanel_out[k * block_lines + b];
+		}
+	}
+
+	//6. IFFTs along y
+#pragma omp parallel for
+	for (int kb = 0; kb < n.z * num_blocks; kb++) {
+
+		int tn = omp_get_thread_num();
+
+		int k = kb / num_blocks;
+		int i0 = (kb % num_blocks) * block_lines;
+		int width = minimum(block_lines, Nx2 - i0);
+
+		ReIm3* ppanel_out = reinterpret_cast<ReIm3*>(ppanel[tn]);
+
+		//fetch panel from fft array
+		for (int j = 0; j < N.y; j++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) ppanel_out[j * block_lines + b] = pF[b];
+		}
+
+		//ifft on panel
+		fftw_execute(plan_inv_y_panel[tn]);
+
+		//write panel to fft array, truncating upper half
+		for (int j = 0; j < n.y; j++) {
+
+			ReIm3* pF = F.data() + i0 + j * Nx2 + k * Nx2 * N.y;
+
+			for (int b = 0; b < width; b++) pF[b] = ppanel_out[j * block_lines + b];
+		}
+	}
+}
+
+//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication embedded)
+
+//SINGLE INPUT, SINGLE OUTPUT
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{	
+	//3D
+
+	//1. FFTs along x
+	for (int k = 0; k < n.z; k++) {
+#pragma omp parallel for
+		for (int j = 0; j < n.y; j++) {
+
+			int tn = omp_get_thread_num();
+
+			//write input into fft line (zero padding kept)
+			for (int i = 0; i < n.x; i++) {
+
+				int idx_in = i + j * n.x + k * n.x * n.y;
+
+				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
+			}
+
+			//fft on line
+			fftw_execute(plan_fwd_x[tn]);
+
+			//write line to fft array
+			for (int i = 0; i < N.x / 2 + 1; i++) {
+
+				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+			}
+		}
+	}
+
+	//2. - 6. FFTs along y and z with embedded kernel multiplication, then IFFTs along z and y
+	if (block_lines) Convolute_yz_3D_Blocked();
+	else Convolute_yz_3D_Lines();
 
 	double dot_product = 0;
 
@@ -870,84 +1055,120 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 		}
 	}
 
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+	//2. - 6. FFTs along y and z with embedded kernel multiplication, then IFFTs along z and y
+	if (block_lines) Convolute_yz_3D_Blocked();
+	else Convolute_yz_3D_Lines();
 
-			int tn = omp_get_thread_num();
+	double dot_product = 0;
 
-			//fetch line from fft array (zero padding kept)
+	if (clearOut) {
+
+		//7. IFFTs along x
+		for (int k = 0; k < n.z; k++) {
+#pragma omp parallel for reduction(+:dot_product)
 			for (int j = 0; j < n.y; j++) {
 
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+				int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+				//write input into fft line
+				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				}
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				//fft on line
+				fftw_execute(plan_inv_x[tn]);
+
+				//write line to output
+				for (int i = 0; i < n.x; i++) {
+
+					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+
+					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+
+					dot_product += In_val * Out_val;
+
+					//capture output effective field and energy with spatial resolution if required
+					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
+				}
 			}
 		}
 	}
+	else {
 
-	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+		//7. IFFTs along x
+		for (int k = 0; k < n.z; k++) {
+#pragma omp parallel for reduction(+:dot_product)
+			for (int j = 0; j < n.y; j++) {
 
-			int tn = omp_get_thread_num();
+				int tn = omp_get_thread_num();
 
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
+				//write input into fft line
+				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				}
 
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+				//fft on line
+				fftw_execute(plan_inv_x[tn]);
 
-			//4. kernel multiplication on line
-			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
+				//add line to output
+				for (int i = 0; i < n.x; i++) {
 
-			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
+					Out[i + j * n.x + k * n.x * n.y] += Out_val;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
+					dot_product += In_val * Out_val;
+
+					//capture output effective field and energy with spatial resolution if required
+					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
+				}
 			}
 		}
 	}
 
-	//6. IFFTs along y
+	return dot_product;
+}
+
+//AVERAGED INPUTS, DUPLICATED OUTPUTS
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	//1. FFTs along x
 	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+		for (int j = 0; j < n.y; j++) {
 
 			int tn = omp_get_thread_num();
 
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
+			//write input into fft line (zero padding kept)
+			for (int i = 0; i < n.x; i++) {
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				int idx_in = i + j * n.x + k * n.x * n.y;
+
+				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_y[tn]);
+			fftw_execute(plan_fwd_x[tn]);
 
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
+			//write line to fft array
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 			}
 		}
 	}
 
+	//2. - 6. FFTs along y and z with embedded kernel multiplication, then IFFTs along z and y
+	if (block_lines) Convolute_yz_3D_Blocked();
+	else Convolute_yz_3D_Lines();
+
 	double dot_product = 0;
 
 	if (clearOut) {
@@ -974,7 +1195,8 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
 					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
+					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
 
 					dot_product += In_val * Out_val;
 
@@ -1009,7 +1231,8 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
 					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
+					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
 
 					dot_product += In_val * Out_val;
 
@@ -1024,9 +1247,105 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	return dot_product;
 }
 
-//AVERAGED INPUTS, DUPLICATED OUTPUTS
+//-------------------------- RUN-TIME CONVOLUTION : SINGLE PRECISION (multiplication embedded)
+
+//2D
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+template <typename GetInput, typename SetOutput>
+double Convolution<Owner, Kernel>::Convolute_2D_sp(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	//1. FFTs along x
+#pragma omp parallel for
+	for (int j = 0; j < n.y; j++) {
+
+		int tn = omp_get_thread_num();
+
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
+
+			*reinterpret_cast<FLT3*>(pline_zp_x_sp[tn] + i * 3) = get_input(i + j * n.x);
+		}
+
+		//fft on line
+		fftwf_execute(plan_fwd_x_sp[tn]);
+
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
+
+			F_sp[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3);
+		}
+	}
+
+	//2. FFTs along y
+#pragma omp parallel for
+	for (int i = 0; i < (N.x / 2 + 1); i++) {
+
+		int tn = omp_get_thread_num();
+
+		//fetch line from fft array (zero padding kept)
+		for (int j = 0; j < n.y; j++) {
+
+			*reinterpret_cast<ReIm3F*>(pline_zp_y_sp[tn] + j * 3) = F_sp[i + j * (N.x / 2 + 1)];
+		}
+
+		//fft on line
+		fftwf_execute(plan_fwd_y_sp[tn]);
+
+		//3. kernel multiplication on line
+		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3F*>(pline_sp[tn]), i);
+
+		//4. ifft on line
+		fftwf_execute(plan_inv_y_sp[tn]);
+
+		//write line to fft array, truncating upper part (from n.y to N.y if different)
+		for (int j = 0; j < n.y; j++) {
+
+			F_sp[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
+		}
+	}
+
+	double dot_product = 0;
+
+	//5. IFFTs along x
+#pragma omp parallel for reduction(+:dot_product)
+	for (int j = 0; j < n.y; j++) {
+
+		int tn = omp_get_thread_num();
+
+		//write input into fft line
+		for (int i = 0; i < N.x / 2 + 1; i++) {
+
+			*reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3) = F_sp[i + j * (N.x / 2 + 1)];
+		}
+
+		//fft on line
+		fftwf_execute(plan_inv_x_sp[tn]);
+
+		//write or add line to output (normalization done in double precision)
+		for (int i = 0; i < n.x; i++) {
+
+			int idx = i + j * n.x;
+
+			DBL3 Out_val = DBL3(*reinterpret_cast<FLT3*>(pline_rev_x_sp[tn] + i * 3)) / N.dim();
+			DBL3 In_val = get_input(idx);
+
+			set_output(idx, Out_val);
+
+			dot_product += In_val * Out_val;
+
+			//capture output effective field and energy with spatial resolution if required
+			if (pH) (*pH)[idx] = Out_val;
+			if (penergy) (*penergy)[idx] = -MU0 * (In_val * Out_val) / 2;
+		}
+	}
+
+	return dot_product;
+}
+
+//3D
+template <typename Owner, typename Kernel>
+template <typename GetInput, typename SetOutput>
+double Convolution<Owner, Kernel>::Convolute_3D_sp(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. FFTs along x
 	for (int k = 0; k < n.z; k++) {
@@ -1038,18 +1357,16 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			//write input into fft line (zero padding kept)
 			for (int i = 0; i < n.x; i++) {
 
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
+				*reinterpret_cast<FLT3*>(pline_zp_x_sp[tn] + i * 3) = get_input(i + j * n.x + k * n.x * n.y);
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+			fftwf_execute(plan_fwd_x_sp[tn]);
 
 			//write line to fft array
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+				F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3);
 			}
 		}
 	}
@@ -1064,16 +1381,16 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			//fetch line from fft array (zero padding kept)
 			for (int j = 0; j < n.y; j++) {
 
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				*reinterpret_cast<ReIm3F*>(pline_zp_y_sp[tn] + j * 3) = F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+			fftwf_execute(plan_fwd_y_sp[tn]);
 
 			//write line to fft array
 			for (int j = 0; j < N.y; j++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
 			}
 		}
 	}
@@ -1088,22 +1405,22 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			//fetch line from fft array (zero padding kept)
 			for (int k = 0; k < n.z; k++) {
 
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				*reinterpret_cast<ReIm3F*>(pline_zp_z_sp[tn] + k * 3) = F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftwf_execute(plan_fwd_z_sp[tn]);
 
 			//4. kernel multiplication on line
-			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
+			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3F*>(pline_sp[tn]), i, j);
 
 			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftwf_execute(plan_inv_z_sp[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
+				F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + k * 3);
 			}
 		}
 	}
@@ -1118,91 +1435,53 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			//fetch line from fft array
 			for (int j = 0; j < N.y; j++) {
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+				*reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3) = F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_y[tn]);
+			fftwf_execute(plan_inv_y_sp[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int j = 0; j < n.y; j++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
 			}
 		}
 	}
 
 	double dot_product = 0;
 
-	if (clearOut) {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
+	//7. IFFTs along x
+	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+		for (int j = 0; j < n.y; j++) {
 
-					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
+			int tn = omp_get_thread_num();
 
-					dot_product += In_val * Out_val;
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				*reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3) = F_sp[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
-		}
-	}
-	else {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//fft on line
+			fftwf_execute(plan_inv_x_sp[tn]);
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+			//write or add line to output (normalization done in double precision)
+			for (int i = 0; i < n.x; i++) {
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+				int idx = i + j * n.x + k * n.x * n.y;
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+				DBL3 Out_val = DBL3(*reinterpret_cast<FLT3*>(pline_rev_x_sp[tn] + i * 3)) / N.dim();
+				DBL3 In_val = get_input(idx);
 
-					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
+				set_output(idx, Out_val);
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[idx] = Out_val;
+				if (penergy) (*penergy)[idx] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
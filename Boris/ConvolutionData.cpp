@@ -1,6 +1,33 @@
 #include "stdafx.h"
 #include "ConvolutionData.h"
 
+//-------------------------- FFTW PLANNING CONFIGURATION
+
+int ConvolutionData::fftw_planning = FFTWPLAN_PATIENT;
+std::string ConvolutionData::fftw_wisdom_directory = "";
+int ConvolutionData::fft_block_lines = 8;
+bool ConvolutionData::fft_single_precision = false;
+
+//fftw planner flags to use for the currently set planning rigor
+unsigned ConvolutionData::Get_FFTW_Planner_Flags(void)
+{
+	switch (fftw_planning) {
+
+	case FFTWPLAN_ESTIMATE:
+		return FFTW_ESTIMATE;
+
+	case FFTWPLAN_MEASURE:
+		return FFTW_MEASURE;
+
+	case FFTWPLAN_EXHAUSTIVE:
+		return FFTW_EXHAUSTIVE;
+
+	default:
+	case FFTWPLAN_PATIENT:
+		return FFTW_PATIENT;
+	}
+}
+
 //-------------------------- CONSTRUCTORS
 
 ConvolutionData::ConvolutionData(void)
@@ -19,6 +46,28 @@ ConvolutionData::ConvolutionData(void)
 	pline_zp_z.resize(OmpThreads);
 	pline.resize(OmpThreads);
 	pline_rev_x.resize(OmpThreads);
+
+	plan_fwd_y_panel.resize(OmpThreads);
+	plan_fwd_z_panel.resize(OmpThreads);
+	plan_inv_y_panel.resize(OmpThreads);
+	plan_inv_z_panel.resize(OmpThreads);
+
+	ppanel_zp_y.resize(OmpThreads);
+	ppanel_zp_z.resize(OmpThreads);
+	ppanel.resize(OmpThreads);
+
+	plan_fwd_x_sp.resize(OmpThreads);
+	plan_fwd_y_sp.resize(OmpThreads);
+	plan_fwd_z_sp.resize(OmpThreads);
+	plan_inv_x_sp.resize(OmpThreads);
+	plan_inv_y_sp.resize(OmpThreads);
+	plan_inv_z_sp.resize(OmpThreads);
+
+	pline_zp_x_sp.resize(OmpThreads);
+	pline_zp_y_sp.resize(OmpThreads);
+	pline_zp_z_sp.resize(OmpThreads);
+	pline_sp.resize(OmpThreads);
+	pline_rev_x_sp.resize(OmpThreads);
 }
 
 ConvolutionData::~ConvolutionData()
@@ -31,7 +80,26 @@ ConvolutionData::~ConvolutionData()
 
 void ConvolutionData::free_memory(void)
 {
-	if (fftw_plans_created) {
+	if (fftw_plans_created && single_precision) {
+
+		//clean
+		for (int idx = 0; idx < OmpThreads; idx++) {
+
+			fftwf_destroy_plan(plan_fwd_x_sp[idx]);
+			fftwf_destroy_plan(plan_fwd_y_sp[idx]);
+			fftwf_destroy_plan(plan_fwd_z_sp[idx]);
+			fftwf_destroy_plan(plan_inv_x_sp[idx]);
+			fftwf_destroy_plan(plan_inv_y_sp[idx]);
+			fftwf_destroy_plan(plan_inv_z_sp[idx]);
+
+			fftwf_free((float*)pline_zp_x_sp[idx]);
+			fftwf_free((fftwf_complex*)pline_zp_y_sp[idx]);
+			fftwf_free((fftwf_complex*)pline_zp_z_sp[idx]);
+			fftwf_free((fftwf_complex*)pline_sp[idx]);
+			fftwf_free((float*)pline_rev_x_sp[idx]);
+		}
+	}
+	else if (fftw_plans_created) {
 
 		//clean
 		for (int idx = 0; idx < OmpThreads; idx++) {
@@ -48,10 +116,39 @@ void ConvolutionData::free_memory(void)
 			fftw_free((fftw_complex*)pline_zp_z[idx]);
 			fftw_free((fftw_complex*)pline[idx]);
 			fftw_free((double*)pline_rev_x[idx]);
+
+			if (block_lines) {
+
+				fftw_destroy_plan(plan_fwd_y_panel[idx]);
+				fftw_destroy_plan(plan_fwd_z_panel[idx]);
+				fftw_destroy_plan(plan_inv_y_panel[idx]);
+				fftw_destroy_plan(plan_inv_z_panel[idx]);
+
+				fftw_free((fftw_complex*)ppanel_zp_y[idx]);
+				fftw_free((fftw_complex*)ppanel_zp_z[idx]);
+				fftw_free((fftw_complex*)ppanel[idx]);
+			}
 		}
 	}
 
 	fftw_plans_created = false;
+	block_lines = 0;
+	single_precision = false;
+}
+
+//free fftw plans, lines and scratch spaces, and clear dimensions (e.g. if the convolution is not used) : SetConvolutionDimensions must be called again before convolution
+void ConvolutionData::FreeConvolutionMemory(void)
+{
+	free_memory();
+
+	F.clear();
+	F2.clear();
+	F_sp.clear();
+
+	n = SZ3();
+	h = DBL3();
+	N = SZ3();
+	pbc_images = INT3();
 }
 
 //Allocate memory for F and F2 (if needed) scratch spaces)
@@ -59,7 +156,23 @@ BError ConvolutionData::AllocateScratchSpaces(void)
 {
 	BError error(__FUNCTION__);
 
-	if (embed_multiplication) {
+	if (single_precision) {
+
+		//single precision only used with embedded multiplication : as below, but F_sp used instead of F
+
+		if (n.z > 1) {
+
+			if (!F_sp.resize(SZ3(N.x / 2 + 1, N.y, n.z))) return error(BERROR_OUTOFMEMORY_CRIT);
+		}
+		else {
+
+			if (!F_sp.resize(SZ3(N.x / 2 + 1, n.y, 1))) return error(BERROR_OUTOFMEMORY_CRIT);
+		}
+
+		F.clear();
+		F2.clear();
+	}
+	else if (embed_multiplication) {
 
 		//if multiplication is embedded, we don't need the upper z-axis points (3D) or upper y-axis points (2D). We also don't need the F2 scratch space.
 
@@ -75,6 +188,7 @@ BError ConvolutionData::AllocateScratchSpaces(void)
 		}
 
 		F2.clear();
+		F_sp.clear();
 	}
 	else {
 
@@ -90,17 +204,88 @@ BError ConvolutionData::AllocateScratchSpaces(void)
 			if (!F.resize(SZ3(N.x / 2 + 1, N.y, 1))) return error(BERROR_OUTOFMEMORY_CRIT);
 			if (!F2.resize(SZ3(N.x / 2 + 1, N.y, 1))) return error(BERROR_OUTOFMEMORY_CRIT);
 		}
+
+		F_sp.clear();
 	}
 
 	return error;
 }
 
+//wisdom file name for current transform sizes and number of threads
+std::string ConvolutionData::Get_FFTW_Wisdom_FileName(bool single_precision_wisdom)
+{
+	return fftw_wisdom_directory + (single_precision_wisdom ? "fftwfwisdom_" : "fftwwisdom_") + ToString(N.x) + "_" + ToString(N.y) + "_" + ToString(N.z) + "_t" + ToString(OmpThreads) + ".txt";
+}
+
+//load fftw wisdom from disk for current transform sizes and number of threads, if available
+void ConvolutionData::Load_FFTW_Wisdom(void)
+{
+	fftw_wisdom_saved.clear();
+	fftwf_wisdom_saved.clear();
+
+	if (!fftw_wisdom_directory.length()) return;
+
+	//wisdom is accumulated by fftw, so importing is cheap even if already known; missing file just means we'll have to plan from scratch
+	if (fftw_import_wisdom_from_filename(Get_FFTW_Wisdom_FileName().c_str())) {
+
+		char* wisdom = fftw_export_wisdom_to_string();
+		if (wisdom) {
+
+			fftw_wisdom_saved = wisdom;
+			fftw_free(wisdom);
+		}
+	}
+
+	if (single_precision && fftwf_import_wisdom_from_filename(Get_FFTW_Wisdom_FileName(true).c_str())) {
+
+		char* wisdom = fftwf_export_wisdom_to_string();
+		if (wisdom) {
+
+			fftwf_wisdom_saved = wisdom;
+			fftwf_free(wisdom);
+		}
+	}
+}
+
+//save fftw wisdom to disk for current transform sizes and number of threads, but only if any new plans were made since last load / save
+void ConvolutionData::Save_FFTW_Wisdom(void)
+{
+	if (!fftw_wisdom_directory.length()) return;
+
+	char* wisdom = fftw_export_wisdom_to_string();
+	if (wisdom) {
+
+		if (fftw_wisdom_saved != wisdom) {
+
+			if (fftw_export_wisdom_to_filename(Get_FFTW_Wisdom_FileName().c_str())) fftw_wisdom_saved = wisdom;
+		}
+
+		fftw_free(wisdom);
+	}
+
+	if (!single_precision) return;
+
+	char* wisdom_sp = fftwf_export_wisdom_to_string();
+	if (wisdom_sp) {
+
+		if (fftwf_wisdom_saved != wisdom_sp) {
+
+			if (fftwf_export_wisdom_to_filename(Get_FFTW_Wisdom_FileName(true).c_str())) fftwf_wisdom_saved = wisdom_sp;
+		}
+
+		fftwf_free(wisdom_sp);
+	}
+}
+
 //-------------------------- CONFIGURATION
 
-BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images)
+BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images, bool single_precision_support_)
 {
 	BError error(__FUNCTION__);
 
+	//first clean any previously allocated fftw memory
+	free_memory();
+
 	this->pbc_images = pbc_images;
 
 	//Turn off multiplication embedding by setting this to false - this will allocate full space memory for F and F2 scratch spaces. embed_multiplication = true by default.
@@ -144,6 +329,9 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 		}
 	}
 
+	//single precision convolution only implemented with embedded multiplication
+	single_precision = fft_single_precision && single_precision_support_ && embed_multiplication;
+
 	//now allocate memory
 
 	//scratch spaces
@@ -151,9 +339,8 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 	if (error) return error;
 
 	//setup fftw for convolution
-	
-	//first clean any previously allocated memory
-	free_memory();
+
+	if (single_precision) return SetConvolutionDimensions_SinglePrecision();
 
 	//allocate new fft lines
 	for (int idx = 0; idx < OmpThreads; idx++) {
@@ -167,8 +354,24 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 		pline[idx] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
 	}
 
-	//zero fft lines
-	zero_fft_lines();
+	//blocked y and z ffts only used for 3D convolutions with embedded multiplication
+	if (n.z > 1 && embed_multiplication) block_lines = minimum(fft_block_lines, (int)N.x / 2 + 1);
+
+	if (block_lines) {
+
+		for (int idx = 0; idx < OmpThreads; idx++) {
+
+			ppanel_zp_y[idx] = fftw_alloc_complex(N.y * block_lines * 3);
+			ppanel_zp_z[idx] = fftw_alloc_complex(N.z * block_lines * 3);
+
+			ppanel[idx] = fftw_alloc_complex(maximum(N.y, N.z) * block_lines * 3);
+		}
+	}
+
+	//if plans for these dimensions were made before, planning will just use the stored wisdom
+	Load_FFTW_Wisdom();
+
+	unsigned planner_flags = Get_FFTW_Planner_Flags();
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
@@ -180,42 +383,168 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 		plan_fwd_x[idx] = fftw_plan_many_dft_r2c(1, dims_x, 3,
 			pline_zp_x[idx], nullptr, 3, 1,
 			pline[idx], nullptr, 3, 1,
-			FFTW_PATIENT);
+			planner_flags);
 
 		plan_fwd_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
 			pline_zp_y[idx], nullptr, 3, 1,
 			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
+			FFTW_FORWARD, planner_flags);
 
 		plan_fwd_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
 			pline_zp_z[idx], nullptr, 3, 1,
 			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
+			FFTW_FORWARD, planner_flags);
 
 		plan_inv_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
 			pline[idx], nullptr, 3, 1,
 			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
+			FFTW_BACKWARD, planner_flags);
 
 		plan_inv_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
 			pline[idx], nullptr, 3, 1,
 			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
+			FFTW_BACKWARD, planner_flags);
 
 		plan_inv_x[idx] = fftw_plan_many_dft_c2r(1, dims_x, 3,
 			pline[idx], nullptr, 3, 1,
 			pline_rev_x[idx], nullptr, 3, 1,
-			FFTW_PATIENT);
+			planner_flags);
+
+		if (block_lines) {
+
+			//each panel row holds 3 * block_lines interleaved complex values, one for each component of each line
+			plan_fwd_y_panel[idx] = fftw_plan_many_dft(1, dims_y, 3 * block_lines,
+				ppanel_zp_y[idx], nullptr, 3 * block_lines, 1,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				FFTW_FORWARD, planner_flags);
+
+			plan_fwd_z_panel[idx] = fftw_plan_many_dft(1, dims_z, 3 * block_lines,
+				ppanel_zp_z[idx], nullptr, 3 * block_lines, 1,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				FFTW_FORWARD, planner_flags);
+
+			plan_inv_z_panel[idx] = fftw_plan_many_dft(1, dims_z, 3 * block_lines,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				FFTW_BACKWARD, planner_flags);
+
+			plan_inv_y_panel[idx] = fftw_plan_many_dft(1, dims_y, 3 * block_lines,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				ppanel[idx], nullptr, 3 * block_lines, 1,
+				FFTW_BACKWARD, planner_flags);
+		}
 	}
 	
 	fftw_plans_created = true;
 
+	//zero fft lines : do this after planning, since planning (other than with FFTW_ESTIMATE) can overwrite the fft lines
+	zero_fft_lines();
+
+	Save_FFTW_Wisdom();
+
+	return error;
+}
+
+//single precision version of fftw setup in SetConvolutionDimensions, called from there if single_precision set
+BError ConvolutionData::SetConvolutionDimensions_SinglePrecision(void)
+{
+	BError error(__FUNCTION__);
+
+	//allocate new fft lines
+	for (int idx = 0; idx < OmpThreads; idx++) {
+
+		pline_zp_x_sp[idx] = fftwf_alloc_real(N.x * 3);
+		pline_rev_x_sp[idx] = fftwf_alloc_real(N.x * 3);
+
+		pline_zp_y_sp[idx] = fftwf_alloc_complex(N.y * 3);
+		pline_zp_z_sp[idx] = fftwf_alloc_complex(N.z * 3);
+
+		pline_sp[idx] = fftwf_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
+
+	Load_FFTW_Wisdom();
+
+	unsigned planner_flags = Get_FFTW_Planner_Flags();
+
+	//make fft plans
+	int dims_x[1] = { (int)N.x };
+	int dims_y[1] = { (int)N.y };
+	int dims_z[1] = { (int)N.z };
+
+	for (int idx = 0; idx < OmpThreads; idx++) {
+
+		plan_fwd_x_sp[idx] = fftwf_plan_many_dft_r2c(1, dims_x, 3,
+			pline_zp_x_sp[idx], nullptr, 3, 1,
+			pline_sp[idx], nullptr, 3, 1,
+			planner_flags);
+
+		plan_fwd_y_sp[idx] = fftwf_plan_many_dft(1, dims_y, 3,
+			pline_zp_y_sp[idx], nullptr, 3, 1,
+			pline_sp[idx], nullptr, 3, 1,
+			FFTW_FORWARD, planner_flags);
+
+		plan_fwd_z_sp[idx] = fftwf_plan_many_dft(1, dims_z, 3,
+			pline_zp_z_sp[idx], nullptr, 3, 1,
+			pline_sp[idx], nullptr, 3, 1,
+			FFTW_FORWARD, planner_flags);
+
+		plan_inv_z_sp[idx] = fftwf_plan_many_dft(1, dims_z, 3,
+			pline_sp[idx], nullptr, 3, 1,
+			pline_sp[idx], nullptr, 3, 1,
+			FFTW_BACKWARD, planner_flags);
+
+		plan_inv_y_sp[idx] = fftwf_plan_many_dft(1, dims_y, 3,
+			pline_sp[idx], nullptr, 3, 1,
+			pline_sp[idx], nullptr, 3, 1,
+			FFTW_BACKWARD, planner_flags);
+
+		plan_inv_x_sp[idx] = fftwf_plan_many_dft_c2r(1, dims_x, 3,
+			pline_sp[idx], nullptr, 3, 1,
+			pline_rev_x_sp[idx], nullptr, 3, 1,
+			planner_flags);
+	}
+
+	fftw_plans_created = true;
+
+	zero_fft_lines();
+
+	Save_FFTW_Wisdom();
+
 	return error;
 }
 
 //zero fftw memory
 void ConvolutionData::zero_fft_lines(void)
 {
+	if (single_precision) {
+
+		for (int idx = 0; idx < OmpThreads; idx++) {
+
+			for (int i = 0; i < N.x; i++) {
+
+				*reinterpret_cast<FLT3*>(pline_zp_x_sp[idx] + i * 3) = FLT3();
+				*reinterpret_cast<FLT3*>(pline_rev_x_sp[idx] + i * 3) = FLT3();
+			}
+
+			for (int j = 0; j < N.y; j++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_zp_y_sp[idx] + j * 3) = ReIm3F();
+			}
+
+			for (int k = 0; k < N.z; k++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_zp_z_sp[idx] + k * 3) = ReIm3F();
+			}
+
+			for (int i = 0; i < maximum(N.x / 2 + 1, N.y, N.z); i++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_sp[idx] + i * 3) = ReIm3F();
+			}
+		}
+
+		return;
+	}
+
 	for (int idx = 0; idx < OmpThreads; idx++) {
 
 		for (int i = 0; i < N.x; i++) {
@@ -238,6 +567,24 @@ void ConvolutionData::zero_fft_lines(void)
 
 			*reinterpret_cast<ReIm3*>(pline[idx] + i * 3) = ReIm3();
 		}
+
+		if (block_lines) {
+
+			for (int j = 0; j < N.y * block_lines; j++) {
+
+				*reinterpret_cast<ReIm3*>(ppanel_zp_y[idx] + j * 3) = ReIm3();
+			}
+
+			for (int k = 0; k < N.z * block_lines; k++) {
+
+				*reinterpret_cast<ReIm3*>(ppanel_zp_z[idx] + k * 3) = ReIm3();
+			}
+
+			for (int i = 0; i < maximum(N.y, N.z) * block_lines; i++) {
+
+				*reinterpret_cast<ReIm3*>(ppanel[idx] + i * 3) = ReIm3();
+			}
+		}
 	}
 }
 
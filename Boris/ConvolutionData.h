@@ -7,10 +7,41 @@
 #include "fftw3.h"
 
 #pragma comment(lib, "libfftw3-3.lib")
+#pragma comment(lib, "libfftw3f-3.lib")
+
+//FFTW planning rigor, set using the fftwplanning command : higher rigor means slower planning but potentially faster ffts
+enum FFTWPLAN_ { FFTWPLAN_ESTIMATE = 0, FFTWPLAN_MEASURE, FFTWPLAN_PATIENT, FFTWPLAN_EXHAUSTIVE, FFTWPLAN_NUMVALUES };
 
 class ConvolutionData
 {
 
+private:
+
+	//-------------------------- FFTW PLANNING CONFIGURATION (shared by all convolution objects)
+
+	//planning rigor used for all fftw plans (FFTWPLAN_ value)
+	static int fftw_planning;
+
+	//directory where fftw wisdom files are stored (empty to disable wisdom storage)
+	static std::string fftw_wisdom_directory;
+
+	//the fftw wisdom as last loaded from or saved to disk for the current dimensions : only save again if new plans were made since
+	std::string fftw_wisdom_saved;
+
+	//as above for single precision plans : fftwf keeps its own wisdom
+	std::string fftwf_wisdom_saved;
+
+	//number of adjacent lines (along x) gathered into panels for the y and z ffts of 3D convolutions, set using the fftblocking command. 0 to use the one line at a time fallback.
+	static int fft_block_lines;
+
+	//use single precision ffts, kernels and scratch spaces for convolutions whose kernels support it, set using the fftsingleprecision command.
+	static bool fft_single_precision;
+
+protected:
+
+	//Kernel classes which support single precision convolution redeclare this as true : they must then also provide single precision kernels and line multiplications (ReIm3F lines).
+	static constexpr bool single_precision_support = false;
+
 protected:
 	
 	int OmpThreads;
@@ -55,6 +86,19 @@ protected:
 
 	//ifft line for real output, to be truncated
 	std::vector<double*> pline_rev_x;
+
+	//number of adjacent lines in y and z fft panels as set when planning (3D with embedded multiplication only), 0 if not used : fft_block_lines, but not more than N.x / 2 + 1
+	int block_lines = 0;
+
+	//batched ffts on panels of block_lines adjacent lines : a panel holds for each position along the fft direction the block_lines adjacent values (ReIm3), i.e. for line b and position p the value is at (p * block_lines + b)
+	std::vector<fftw_plan> plan_fwd_y_panel, plan_fwd_z_panel;
+	std::vector<fftw_plan> plan_inv_y_panel, plan_inv_z_panel;
+
+	//forward fft panels with constant zero padding
+	std::vector<fftw_complex*> ppanel_zp_y, ppanel_zp_z;
+
+	//fft and ifft panel without zero padding
+	std::vector<fftw_complex*> ppanel;
 	
 	//the flow is:
 	//input -> pline_zp_x -fft-> pline -> F
@@ -63,6 +107,24 @@ protected:
 	//
 	//F -> pline -ifft-> pline -> F
 	//F -> pline -ifft-> pline_rev_x -> output
+	//
+	//with blocked y and z ffts (block_lines != 0) the F -> pline_zp_y, pline_zp_z, pline -> F steps are done on panels instead:
+	//F -> ppanel_zp_y -fft-> ppanel -> F
+	//F -> ppanel_zp_z -fft-> ppanel -> pline -*K> pline -> ppanel -ifft-> ppanel -> F
+	//F -> ppanel -ifft-> ppanel -> F
+
+	//single precision convolution in use, as set when planning : fft_single_precision set, kernel supports it and multiplication embedded
+	//in this case the single precision scratch space, plans and lines below are used instead of the double precision ones above (which are not allocated)
+	//input is converted to float when written to pline_zp_x_sp, and output converted back to double when read from pline_rev_x_sp, so the flow is as above.
+	bool single_precision = false;
+
+	VEC<ReIm3F> F_sp;
+
+	std::vector<fftwf_plan> plan_fwd_x_sp, plan_fwd_y_sp, plan_fwd_z_sp;
+	std::vector<fftwf_plan> plan_inv_x_sp, plan_inv_y_sp, plan_inv_z_sp;
+
+	std::vector<float*> pline_zp_x_sp, pline_rev_x_sp;
+	std::vector<fftwf_complex*> pline_zp_y_sp, pline_zp_z_sp, pline_sp;
 
 	bool fftw_plans_created = false;
 
@@ -76,6 +138,15 @@ private:
 	//Allocate memory for F and F2 (if needed) scratch spaces)
 	BError AllocateScratchSpaces(void);
 
+	//wisdom file name for current transform sizes and number of threads (fftwf wisdom file if single_precision_wisdom)
+	std::string Get_FFTW_Wisdom_FileName(bool single_precision_wisdom = false);
+
+	//load fftw wisdom from disk for current transform sizes and number of threads, if available
+	void Load_FFTW_Wisdom(void);
+
+	//single precision version of fftw setup in SetConvolutionDimensions, called from there if single_precision set
+	BError SetConvolutionDimensions_SinglePrecision(void);
+
 protected:
 
 	//-------------------------- CONSTRUCTORS
@@ -86,11 +157,19 @@ protected:
 
 	//-------------------------- CONFIGURATION
 
-	BError SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images = INT3());
+	//single_precision_support_ : set if the kernel supports single precision convolution (Kernel::single_precision_support)
+	BError SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images = INT3(), bool single_precision_support_ = false);
 
 	//zero fftw memory
 	void zero_fft_lines(void);
 
+	//free fftw plans, lines and scratch spaces, and clear dimensions (e.g. if the convolution is not used) : SetConvolutionDimensions must be called again before convolution
+	void FreeConvolutionMemory(void);
+
+	//save fftw wisdom to disk for current transform sizes and number of threads, but only if any new plans were made since last load / save
+	//call this after making new fftw plans (e.g. after computing kernels)
+	void Save_FFTW_Wisdom(void);
+
 	//-------------------------- GETTERS
 
 	//Get pointer to the F scratch space
@@ -101,4 +180,24 @@ protected:
 
 	//-------------------------- RUN-TIME METHODS
 
+public:
+
+	//-------------------------- FFTW PLANNING CONFIGURATION
+
+	//fftw planner flags to use for the currently set planning rigor
+	static unsigned Get_FFTW_Planner_Flags(void);
+
+	static void Set_FFTW_Planning(int fftw_planning_) { fftw_planning = fftw_planning_; }
+	static int Get_FFTW_Planning(void) { return fftw_planning; }
+
+	static void Set_FFTW_Wisdom_Directory(std::string fftw_wisdom_directory_) { fftw_wisdom_directory = fftw_wisdom_directory_; }
+	static std::string Get_FFTW_Wisdom_Directory(void) { return fftw_wisdom_directory; }
+
+	//blocked y and z ffts for 3D convolutions : applies to convolutions set up from now on
+	static void Set_FFT_Block_Lines(int fft_block_lines_) { fft_block_lines = (fft_block_lines_ > 0 ? fft_block_lines_ : 0); }
+	static int Get_FFT_Block_Lines(void) { return fft_block_lines; }
+
+	//single precision convolution : applies to convolutions set up from now on
+	static void Set_FFT_Single_Precision(bool status) { fft_single_precision = status; }
+	static bool Get_FFT_Single_Precision(void) { return fft_single_precision; }
 };
@@ -52,6 +52,11 @@ BError DMExchange::Initialize(void)
 		(MOD_)pMesh->Get_ActualModule_Heff_Display() == MOD_DMEXCHANGE || pMesh->IsOutputDataSet_withRect(DATA_E_EXCH),
 		(MOD_)pMesh->Get_ActualModule_Energy_Display() == MOD_DMEXCHANGE || pMesh->IsOutputDataSet_withRect(DATA_E_EXCH),
 		pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC);
+
+	//parameters read in every cell when computing the field : cache them if they must be evaluated per cell
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) pMesh->request_parameter_cache(pMesh->A_AFM, pMesh->Ah, pMesh->Anh, pMesh->D_AFM, pMesh->Ms_AFM, pMesh->Dh, pMesh->dh_dir);
+	else pMesh->request_parameter_cache(pMesh->A, pMesh->D, pMesh->Ms);
+
 	if (!error) initialized = true;
 
 	return error;
@@ -48,7 +48,10 @@ enum DATA_
 	//Special
 	DATA_COMMBUFFER = 58,
 
+	//Evaluation speedup data
+	DATA_SPEEDUP_SKIPPED = 65, DATA_SPEEDUP_ERROR = 66,
+
 	//Previously used by DATA_E_EXCH_MAX, now deleted
 	DATA_RESERVED = 39
 };
-//Current maximum : 64
+//Current maximum : 66
@@ -17,7 +17,7 @@
 Demag::Demag(Mesh *pMesh_) : 
 	Modules(),
 	Convolution<Demag, DemagKernel>(pMesh_->GetMeshSize(), pMesh_->GetMeshCellsize()),
-	ProgramStateNames(this, {VINFO(demag_pbc_images)}, {})
+	ProgramStateNames(this, {VINFO(demag_pbc_images), VINFO(demag_treecode), VINFO(treecode_theta)}, {})
 {
 	pMesh = pMesh_;
 
@@ -57,7 +57,12 @@ BError Demag::Initialize(void)
 
 	if (!initialized) {
 		
-		error = Calculate_Demag_Kernels();
+		if (Use_TreeCode()) error = treeCode.Initialize(pMesh->M, treecode_theta);
+		else {
+
+			treeCode.Clear();
+			error = Calculate_Demag_Kernels();
+		}
 
 		selfDemagCoeff = DemagTFunc().SelfDemag_PBC(pMesh->h, pMesh->n, demag_pbc_images);
 
@@ -103,12 +108,16 @@ BError Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	BError error(CLASS_STR(Demag));
 
 	//only need to uninitialize if n or h have changed, or pbc settings have changed
-	if (!CheckDimensions(pMesh->n, pMesh->h, demag_pbc_images) || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE) {
+	//with tree-code evaluation the FFT convolution is not used, so its memory is freed (dimensions also cleared, so it's set again if tree-code is switched off)
+	bool dimensions_changed = (Use_TreeCode() ? !treeCode.CheckDimensions(pMesh->n, pMesh->h) : !CheckDimensions(pMesh->n, pMesh->h, demag_pbc_images));
+
+	if (dimensions_changed || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE) {
 		
 		Uninitialize();
 
 		//Set convolution dimensions for embedded multiplication and required PBC conditions
-		error = SetDimensions(pMesh->n, pMesh->h, true, demag_pbc_images);
+		if (Use_TreeCode()) FreeDimensions();
+		else error = SetDimensions(pMesh->n, pMesh->h, true, demag_pbc_images);
 
 		//if memory needs to be allocated for Hdemag, it will be done through Initialize 
 		Hdemag.clear();
@@ -117,8 +126,12 @@ BError Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		Hdemag4.clear();
 		Hdemag5.clear();
 		Hdemag6.clear();
+		Hdemag_async.clear();
 	}
 
+	//tree-code is built over non-empty cells, so must be rebuilt if mesh shape changes
+	if (Use_TreeCode() && ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHSHAPECHANGE)) Uninitialize();
+
 	num_Hdemag_saved = 0;
 
 	//------------------------ CUDA UpdateConfiguration if set
@@ -133,6 +146,16 @@ BError Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	return error;
 }
 
+//discard saved evaluations so the next demag field evaluation is a full one, also in the CUDA module if enabled
+void Demag::Reset_Speedup_History(void)
+{
+	DemagBase::Reset_Speedup_History();
+
+#if COMPILECUDA == 1
+	if (pModuleCUDA) dynamic_cast<DemagCUDA*>(pModuleCUDA)->Reset_Speedup_History();
+#endif
+}
+
 //Set PBC
 BError Demag::Set_PBC(INT3 demag_pbc_images_)
 {
@@ -148,6 +171,19 @@ BError Demag::Set_PBC(INT3 demag_pbc_images_)
 	return error;
 }
 
+//Set hierarchical (tree-code) demag evaluation status and opening angle (theta not changed if zero)
+BError Demag::Set_TreeCode(bool status, double theta)
+{
+	BError error(__FUNCTION__);
+
+	demag_treecode = status;
+	if (theta > 0.0) treecode_theta = theta;
+
+	error = UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE);
+
+	return error;
+}
+
 BError Demag::MakeCUDAModule(void)
 {
 	BError error(CLASS_STR(Demag));
@@ -173,27 +209,77 @@ double Demag::UpdateField(void)
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (!pMesh->pSMesh->GetEvaluationSpeedup() || (num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup() && !pMesh->pSMesh->Check_Step_Update())) {
+	if (!pMesh->pSMesh->GetEvaluationSpeedup() || (!pMesh->pSMesh->Is_Speedup_Adaptive() && num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup() && !pMesh->pSMesh->Check_Step_Update())) {
 
 		//don't use evaluation speedup, so no need to use Hdemag (this won't have memory allocated anyway) - or else we are using speedup but don't yet have enough previous evaluations at steps where we should be extrapolating
 
 		//convolute and get "energy" value
-		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-			if (Module_Heff.linear_size()) energy = Convolute_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, pMesh->Heff, pMesh->Heff2, false, &Module_Heff, &Module_energy);
-			else energy = Convolute_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, pMesh->Heff, pMesh->Heff2, false);
-		}
-		else {
-
-			if (Module_Heff.linear_size()) energy = Convolute(pMesh->M, pMesh->Heff, false, &Module_Heff, &Module_energy);
-			else energy = Convolute(pMesh->M, pMesh->Heff, false);
-		}
+		energy = Compute_Demag_Field(pMesh->Heff, &pMesh->Heff2, false);
 
 		//finish off energy value
 		if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
 		else energy = 0;
 	}
 
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////// ADAPTIVE EVAL SPEEDUP /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	else if (pMesh->pSMesh->Is_Speedup_Adaptive()) {
+
+		//extrapolate from previous evaluations if the estimated error is within tolerance, else recompute and save evaluation
+		double time = pMesh->pSMesh->Get_EvalStep_Time();
+
+		VEC<DBL3>* pH[EVALSPEEDUP_QUINTIC];
+		double a[EVALSPEEDUP_QUINTIC];
+		double error;
+
+		int num_terms = Adaptive_Speedup_Extrapolation(time, pMesh->pSMesh->GetSpeedupTolerance(), pH, a, error);
+
+		pMesh->pSMesh->Speedup_Evaluation_Report(num_terms > 0, error);
+
+		if (num_terms) {
+
+			//energy from extrapolated field, same convention as for a full evaluation (energy is used by some evaluation methods, e.g. NCG line search)
+			double energy_extrapolated = 0;
+
+			if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+				//add contribution to Heff and Heff2
+#pragma omp parallel for reduction(+:energy_extrapolated)
+				for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+
+					DBL3 Hdemag_value = (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
+					for (int term = 0; term < num_terms; term++) Hdemag_value += (*pH[term])[idx] * a[term];
+
+					pMesh->Heff[idx] += Hdemag_value;
+					pMesh->Heff2[idx] += Hdemag_value;
+
+					energy_extrapolated += (pMesh->M[idx] + pMesh->M2[idx]) / 2 * Hdemag_value;
+				}
+			}
+			else {
+
+				//add contribution to Heff
+#pragma omp parallel for reduction(+:energy_extrapolated)
+				for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+
+					DBL3 Hdemag_value = (selfDemagCoeff & pMesh->M[idx]);
+					for (int term = 0; term < num_terms; term++) Hdemag_value += (*pH[term])[idx] * a[term];
+
+					pMesh->Heff[idx] += Hdemag_value;
+
+					energy_extrapolated += pMesh->M[idx] * Hdemag_value;
+				}
+			}
+
+			//finish off energy value
+			if (pMesh->M.get_nonempty_cells()) energy = energy_extrapolated * -MU0 / (2 * pMesh->M.get_nonempty_cells());
+			else energy = 0;
+		}
+		else Evaluate_Saved_Hdemag(Adaptive_Speedup_Storage(time, pMesh->pSMesh->GetEvaluationSpeedup()));
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////////////////// EVAL SPEEDUP /////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -389,44 +475,7 @@ double Demag::UpdateField(void)
 			}
 			
 			//do evaluation
-			if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-				if (Module_Heff.linear_size()) energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, *pHdemag, true, &Module_Heff, &Module_energy);
-				else energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, *pHdemag, true);
-			}
-			else {
-
-				if (Module_Heff.linear_size()) energy = Convolute(pMesh->M, *pHdemag, true, &Module_Heff, &Module_energy);
-				else energy = Convolute(pMesh->M, *pHdemag, true);
-			}
-
-			//finish off energy value
-			if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
-			else energy = 0;
-
-			if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-				//add contribution to Heff and Heff2
-#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-					pMesh->Heff[idx] += (*pHdemag)[idx];
-					pMesh->Heff2[idx] += (*pHdemag)[idx];
-					//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-					(*pHdemag)[idx] -= (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-				}
-			}
-			else {
-
-				//add contribution to Heff
-#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-					pMesh->Heff[idx] += (*pHdemag)[idx];
-					//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-					(*pHdemag)[idx] -= (selfDemagCoeff & pMesh->M[idx]);
-				}
-			}
+			Evaluate_Saved_Hdemag(pHdemag);
 		}
 		else {
 
@@ -610,6 +659,114 @@ double Demag::UpdateField(void)
 	return energy;
 }
 
+//evaluation speedup : compute demag field into *pHdemag and add it to Heff, then subtract self demag contribution from *pHdemag so it can be used for extrapolation
+//compute demag field into Out using FFT convolution or tree-code as configured (also set Module_Heff and Module_energy if allocated). Return dot product of input with output.
+//For antiferromagnetic meshes the input is the average of M and M2, and output is also set in *pOut2 if given.
+double Demag::Compute_Demag_Field(VEC<DBL3>& Out, VEC<DBL3>* pOut2, bool clearOut)
+{
+	VEC<DBL3>* pH = (Module_Heff.linear_size() ? &Module_Heff : nullptr);
+	VEC<double>* penergy = (Module_Heff.linear_size() ? &Module_energy : nullptr);
+
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+		if (Use_TreeCode()) {
+
+			if (pOut2) return treeCode.Evaluate_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, Out, *pOut2, clearOut, pH, penergy);
+			else return treeCode.Evaluate_AveragedInputs(pMesh->M, pMesh->M2, Out, clearOut, pH, penergy);
+		}
+		else {
+
+			if (pOut2) return Convolute_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, Out, *pOut2, clearOut, pH, penergy);
+			else return Convolute_AveragedInputs(pMesh->M, pMesh->M2, Out, clearOut, pH, penergy);
+		}
+	}
+	else {
+
+		if (Use_TreeCode()) return treeCode.Evaluate(pMesh->M, Out, clearOut, pH, penergy);
+		else return Convolute(pMesh->M, Out, clearOut, pH, penergy);
+	}
+}
+
+void Demag::Evaluate_Saved_Hdemag(VEC<DBL3>* pHdemag)
+{
+	energy = Compute_Demag_Field(*pHdemag, nullptr, true);
+
+	//finish off energy value
+	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
+	else energy = 0;
+
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+		//add contribution to Heff and Heff2
+#pragma omp parallel for
+		for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+
+			pMesh->Heff[idx] += (*pHdemag)[idx];
+			pMesh->Heff2[idx] += (*pHdemag)[idx];
+			//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+			(*pHdemag)[idx] -= (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
+		}
+	}
+	else {
+
+		//add contribution to Heff
+#pragma omp parallel for
+		for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+
+			pMesh->Heff[idx] += (*pHdemag)[idx];
+			//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+			(*pHdemag)[idx] -= (selfDemagCoeff & pMesh->M[idx]);
+		}
+	}
+}
+
+//-------------------Task-parallel evaluation
+
+bool Demag::Can_Async_UpdateField(void)
+{
+	//same condition as for the no speedup branch in UpdateField
+	if (!pMesh->pSMesh->GetEvaluationSpeedup() || (!pMesh->pSMesh->Is_Speedup_Adaptive() && num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup() && !pMesh->pSMesh->Check_Step_Update())) {
+
+		return Hdemag_async.resize(pMesh->h, pMesh->meshRect);
+	}
+	
+	return false;
+}
+
+//convolute into Hdemag_async (Heff not used here as other modules are being evaluated at the same time)
+void Demag::UpdateField_Async(void)
+{
+	energy = Compute_Demag_Field(Hdemag_async, nullptr, true);
+
+	//finish off energy value
+	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
+	else energy = 0;
+}
+
+//add Hdemag_async to Heff (and Heff2 for antiferromagnetic meshes)
+double Demag::UpdateField_Complete(void)
+{
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < Hdemag_async.linear_size(); idx++) {
+
+			pMesh->Heff[idx] += Hdemag_async[idx];
+			pMesh->Heff2[idx] += Hdemag_async[idx];
+		}
+	}
+	else {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < Hdemag_async.linear_size(); idx++) {
+
+			pMesh->Heff[idx] += Hdemag_async[idx];
+		}
+	}
+
+	return energy;
+}
+
 //-------------------Energy methods
 
 //FM mesh
@@ -20,7 +20,7 @@ class Demag :
 	public Modules,
 	public DemagBase,
 	public Convolution<Demag, DemagKernel>,
-	public ProgramState<Demag, std::tuple<INT3>, std::tuple<>>
+	public ProgramState<Demag, std::tuple<INT3, bool, double>, std::tuple<>>
 {
 
 #if COMPILECUDA == 1
@@ -32,6 +32,24 @@ private:
 	//pointer to mesh object holding this effective field module
 	Mesh *pMesh;
 
+	//demagnetizing field computed in the async stage of a task-parallel UpdateField, added to Heff when completed (memory only allocated when used)
+	VEC<DBL3> Hdemag_async;
+
+	//tree-code evaluation of demag field, used instead of FFT convolution if enabled (memory only allocated when used)
+	DemagTreeCode treeCode;
+
+private:
+
+	//tree-code used for this module? Not available with pbc, in which case FFT convolution is used.
+	bool Use_TreeCode(void) { return demag_treecode && demag_pbc_images == INT3(); }
+
+	//compute demag field into Out using FFT convolution or tree-code as configured (also set Module_Heff and Module_energy if allocated). Return dot product of input with output.
+	//For antiferromagnetic meshes the input is the average of M and M2, and output is also set in *pOut2 if given.
+	double Compute_Demag_Field(VEC<DBL3>& Out, VEC<DBL3>* pOut2, bool clearOut);
+
+	//evaluation speedup : compute demag field into *pHdemag and add it to Heff, then subtract self demag contribution from *pHdemag so it can be used for extrapolation
+	void Evaluate_Saved_Hdemag(VEC<DBL3>* pHdemag);
+
 public:
 
 	Demag(Mesh *pMesh_);
@@ -54,11 +72,23 @@ public:
 
 	double UpdateField(void);
 
+	//task-parallel evaluation : convolution in async stage, result added to Heff in complete stage. Only available if not using evaluation speedup at this step.
+	bool Can_Async_UpdateField(void);
+	void UpdateField_Async(void);
+	double UpdateField_Complete(void);
+
 	//-------------------Setters
 
 	//Set PBC
 	BError Set_PBC(INT3 demag_pbc_images_);
 
+	//-------------------Evaluation speedup
+
+	void Reset_Speedup_History(void);
+
+	//Set hierarchical (tree-code) demag evaluation status and opening angle (theta not changed if zero)
+	BError Set_TreeCode(bool status, double theta);
+
 	//-------------------Energy methods
 
 	//FM mesh
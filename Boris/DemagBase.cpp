@@ -0,0 +1,223 @@
+#include "stdafx.h"
+#include "DemagBase.h"
+#include "CheckpointFile.h"
+
+//-------------------Adaptive evaluation speedup
+
+//saved evaluation and its time, idx from 0 to 5 for Hdemag, ..., Hdemag6
+VEC<DBL3>* DemagBase::Get_Saved_Hdemag(int idx)
+{
+	switch (idx) {
+
+	case 0: return &Hdemag;
+	case 1: return &Hdemag2;
+	case 2: return &Hdemag3;
+	case 3: return &Hdemag4;
+	case 4: return &Hdemag5;
+	default: return &Hdemag6;
+	}
+}
+
+double& DemagBase::Get_Saved_Time(int idx)
+{
+	switch (idx) {
+
+	case 0: return time_demag1;
+	case 1: return time_demag2;
+	case 2: return time_demag3;
+	case 3: return time_demag4;
+	case 4: return time_demag5;
+	default: return time_demag6;
+	}
+}
+
+//Adaptive evaluation speedup : from saved evaluations estimate the relative error of extrapolating to the given time for each available order, and select order with smallest error (error set).
+//If within tolerance, set pH and a with evaluations and coefficients to use for extrapolation, and return number of terms (order + 1). Return 0 if demag field must be recomputed instead.
+int DemagBase::Adaptive_Speedup_Extrapolation(double time, double tolerance, VEC<DBL3>** pH, double* a, double& error)
+{
+	error = 0.0;
+
+	//need at least 2 evaluations to estimate an error
+	int num_saved = minimum(num_Hdemag_saved, (int)EVALSPEEDUP_QUINTIC);
+	if (num_saved < 2) return 0;
+
+	//order saved evaluations by distance from time, closest first : extrapolation of order k uses the first k + 1 of these
+	int order[EVALSPEEDUP_QUINTIC];
+	for (int idx = 0; idx < num_saved; idx++) order[idx] = idx;
+
+	std::sort(order, order + num_saved, [&](int idx1, int idx2) { return fabs(time - Get_Saved_Time(idx1)) < fabs(time - Get_Saved_Time(idx2)); });
+
+	double t[EVALSPEEDUP_QUINTIC];
+	VEC<DBL3>* pH_saved[EVALSPEEDUP_QUINTIC];
+
+	for (int idx = 0; idx < num_saved; idx++) {
+
+		t[idx] = Get_Saved_Time(order[idx]);
+		pH_saved[idx] = Get_Saved_Hdemag(order[idx]);
+	}
+
+	//already have an evaluation at this time (e.g. repeated step)
+	if (t[0] == time) {
+
+		pH[0] = pH_saved[0];
+		a[0] = 1.0;
+		return 1;
+	}
+
+	//the error estimate only compares saved evaluations, not the current magnetization, so bound its use:
+	//1) force a full evaluation after a fixed number of consecutive extrapolations
+	if (num_speedup_skips >= EVALSPEEDUP_ADAPTIVE_MAXSKIPS) return 0;
+
+	//2) don't extrapolate further from the closest evaluation than the time span covered by the saved evaluations
+	double t_min = t[0], t_max = t[0];
+	for (int idx = 1; idx < num_saved; idx++) {
+
+		t_min = minimum(t_min, t[idx]);
+		t_max = maximum(t_max, t[idx]);
+	}
+
+	if (fabs(time - t[0]) > t_max - t_min) return 0;
+
+	//Lagrange polynomial coefficients for each order
+	double coeff[EVALSPEEDUP_QUINTIC][EVALSPEEDUP_QUINTIC];
+
+	for (int k = 0; k < num_saved; k++) {
+		for (int j = 0; j <= k; j++) {
+
+			coeff[k][j] = 1.0;
+
+			for (int m = 0; m <= k; m++) {
+
+				if (m != j) coeff[k][j] *= (time - t[m]) / (t[j] - t[m]);
+			}
+		}
+	}
+
+	for (int k = 0; k < num_saved; k++) adaptive_reduction[k].new_minmax_reduction();
+
+	VEC<DBL3>& H0 = *pH_saved[0];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < H0.linear_size(); idx++) {
+
+		adaptive_reduction[0].reduce_max(H0[idx].norm());
+
+		DBL3 H_prev = H0[idx];
+
+		for (int k = 1; k < num_saved; k++) {
+
+			DBL3 H = DBL3();
+			for (int j = 0; j <= k; j++) H += (*pH_saved[j])[idx] * coeff[k][j];
+
+			adaptive_reduction[k].reduce_max((H - H_prev).norm());
+			H_prev = H;
+		}
+	}
+
+	//select order with smallest estimated error : the estimate for order k is the difference to order k - 1 extrapolation
+	double Hmax = adaptive_reduction[0].maximum();
+
+	int order_best = 1;
+	double diff_best = adaptive_reduction[1].maximum();
+
+	for (int k = 2; k < num_saved; k++) {
+
+		double diff = adaptive_reduction[k].maximum();
+
+		if (diff < diff_best) {
+
+			diff_best = diff;
+			order_best = k;
+		}
+	}
+
+	if (Hmax > 0.0) error = diff_best / Hmax;
+	else if (diff_best > 0.0) error = 1.0;
+
+	if (error > tolerance) return 0;
+
+	for (int j = 0; j <= order_best; j++) {
+
+		pH[j] = pH_saved[j];
+		a[j] = coeff[order_best][j];
+	}
+
+	num_speedup_skips++;
+
+	return order_best + 1;
+}
+
+//Adaptive evaluation speedup : storage for a demag field computed at the given time (time recorded) : an unused one if available (up to max_evaluations), else the one evaluated furthest from this time
+VEC<DBL3>* DemagBase::Adaptive_Speedup_Storage(double time, int max_evaluations)
+{
+	max_evaluations = minimum(max_evaluations, (int)EVALSPEEDUP_QUINTIC);
+
+	//full evaluation done : start counting consecutive extrapolations again
+	num_speedup_skips = 0;
+
+	int slot = -1;
+
+	//evaluation already saved at this time : replace it
+	for (int idx = 0; idx < num_Hdemag_saved; idx++) {
+
+		if (Get_Saved_Time(idx) == time) slot = idx;
+	}
+
+	if (slot < 0) {
+
+		if (num_Hdemag_saved < max_evaluations) slot = num_Hdemag_saved++;
+		else {
+
+			slot = 0;
+
+			for (int idx = 1; idx < max_evaluations; idx++) {
+
+				if (fabs(time - Get_Saved_Time(idx)) > fabs(time - Get_Saved_Time(slot))) slot = idx;
+			}
+		}
+	}
+
+	Get_Saved_Time(slot) = time;
+
+	return Get_Saved_Hdemag(slot);
+}
+
+//-------------------Checkpoint
+
+void DemagBase::Checkpoint_State(CheckpointFile& cpt, std::string prefix, bool history_valid)
+{
+	int num_saved = (history_valid ? num_Hdemag_saved : 0);
+	cpt.value(prefix + "num_Hdemag_saved", num_saved);
+
+	int num_skips = (history_valid ? num_speedup_skips : 0);
+	cpt.value(prefix + "num_speedup_skips", num_skips);
+
+	for (int idx = 0; idx < EVALSPEEDUP_QUINTIC; idx++) {
+
+		std::string name = prefix + "Hdemag" + ToString(idx + 1);
+
+		double time_saved = Get_Saved_Time(idx);
+		cpt.value(name + "_time", time_saved);
+
+		//evaluations are saved as std::vector so the checkpoint doesn't depend on allocation : empty if not valid
+		std::vector<DBL3> Hdemag_saved;
+		if (cpt.is_saving()) cpt.vector(name, idx < num_saved ? Get_Saved_Hdemag(idx)->quantity_ref() : Hdemag_saved);
+		else cpt.vector(name, Hdemag_saved);
+
+		if (cpt.is_loading() && idx < num_saved) {
+
+			if (Hdemag_saved.size() == Get_Saved_Hdemag(idx)->linear_size()) {
+
+				Get_Saved_Hdemag(idx)->quantity_ref() = Hdemag_saved;
+				Get_Saved_Time(idx) = time_saved;
+			}
+			else num_saved = 0;
+		}
+	}
+
+	if (cpt.is_loading()) {
+
+		num_Hdemag_saved = num_saved;
+		num_speedup_skips = (num_saved ? num_skips : 0);
+	}
+}
@@ -3,6 +3,10 @@
 #include "BorisLib.h"
 #include "Boris_Enums_Defs.h"
 #include "ErrorHandler.h"
+#include "DiffEq_Defs.h"
+#include "DemagTreeCode.h"
+
+class CheckpointFile;
 
 
 
@@ -28,6 +32,10 @@ protected:
 	//these pbc images are applicable in individual demag modules only
 	INT3 demag_pbc_images = INT3();
 
+	//use hierarchical (tree-code) evaluation over non-empty cells instead of FFT convolution (not used with pbc), with given opening angle
+	bool demag_treecode = false;
+	double treecode_theta = TREECODE_THETA;
+
 	//Evaluation speedup mode data
 
 	//vec for demagnetizing field polynomial extrapolation
@@ -41,6 +49,29 @@ protected:
 	//-Nxx, -Nyy, -Nzz values at r = r0
 	DBL3 selfDemagCoeff = DBL3();
 
+	//Adaptive evaluation speedup mode data
+
+	//reductions used to estimate extrapolation error : 0 for maximum field magnitude, k for maximum difference between order k and order k - 1 extrapolations
+	OmpReduction<double> adaptive_reduction[EVALSPEEDUP_QUINTIC];
+
+	//number of consecutive evaluations replaced by extrapolation since the last full evaluation (a full evaluation is forced when EVALSPEEDUP_ADAPTIVE_MAXSKIPS is reached)
+	int num_speedup_skips = 0;
+
+private:
+
+	//saved evaluation and its time, idx from 0 to 5 for Hdemag, ..., Hdemag6
+	VEC<DBL3>* Get_Saved_Hdemag(int idx);
+	double& Get_Saved_Time(int idx);
+
+protected:
+
+	//Adaptive evaluation speedup : from saved evaluations estimate the relative error of extrapolating to the given time for each available order, and select order with smallest error (error set).
+	//If within tolerance, set pH and a with evaluations and coefficients to use for extrapolation, and return number of terms (order + 1). Return 0 if demag field must be recomputed instead.
+	int Adaptive_Speedup_Extrapolation(double time, double tolerance, VEC<DBL3>** pH, double* a, double& error);
+
+	//Adaptive evaluation speedup : storage for a demag field computed at the given time (time recorded) : an unused one if available (up to max_evaluations), else the one evaluated furthest from this time
+	VEC<DBL3>* Adaptive_Speedup_Storage(double time, int max_evaluations);
+
 public:
 
 	DemagBase(void)
@@ -54,9 +85,29 @@ public:
 	//Set PBC
 	virtual BError Set_PBC(INT3 demag_pbc_images_) = 0;
 
+	//Set hierarchical (tree-code) demag evaluation status and opening angle (theta not changed if zero) : only available for modules which implement it
+	virtual BError Set_TreeCode(bool status, double theta) { BError error(__FUNCTION__); return error(BERROR_INCORRECTACTION); }
+
 	//-------------------Getters
 
 	//Get PBC images
 	INT3 Get_PBC(void) { return demag_pbc_images; }
+
+	//Get hierarchical (tree-code) demag evaluation status and opening angle
+	bool Get_TreeCode(void) { return demag_treecode; }
+	double Get_TreeCode_Theta(void) { return treecode_theta; }
+
+	//-------------------Evaluation speedup
+
+	//discard saved evaluations so the next demag field evaluation is a full one (e.g. ODE reset or new stage, since the magnetization may change abruptly)
+	//implementations also discard the saved evaluations in their CUDA module if enabled
+	virtual void Reset_Speedup_History(void) { num_Hdemag_saved = 0; num_speedup_skips = 0; }
+
+	//-------------------Checkpoint
+
+	//save, verify or load evaluation speedup history (saved demag field evaluations and their times) in binary checkpoint.
+	//history_valid false if the saved evaluations are not held in cpu memory (CUDA enabled) : no history is saved in this case, so a fresh evaluation is done after loading.
+	//When loading, if the saved evaluations don't match the current allocation a fresh evaluation is also done.
+	void Checkpoint_State(CheckpointFile& cpt, std::string prefix, bool history_valid);
 };
 
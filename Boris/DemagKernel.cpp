@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "DemagKernel.h"
+#include "DemagKernelCache.h"
 
 #if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
 
@@ -12,6 +13,12 @@ void DemagKernel::FreeAllKernelMemory(void)
 
 	Kdiag.clear();
 	Kodiag.clear();
+
+	K2D_odiag_sp.clear();
+	K2D_odiag_sp.shrink_to_fit();
+
+	Kdiag_sp.clear();
+	Kodiag_sp.clear();
 }
 
 BError DemagKernel::AllocateKernelMemory(void)
@@ -39,14 +46,15 @@ BError DemagKernel::AllocateKernelMemory(void)
 //-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
 //multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
-void DemagKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
+template <typename ReIm3Type, typename VType>
+void DemagKernel::KernelMultiplication_2D_line(ReIm3Type* pline, int i, VEC<VAL3<VType>>& Kdiag, std::vector<VType>& K2D_odiag)
 {
 	//above N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.y/2 point
 	//off-diagonal values are odd about the N.y/2 point
 
 	//j = 0
-	ReIm3 FM = pline[0];
+	ReIm3Type FM = pline[0];
 
 	int idx_start = i;
 
@@ -57,8 +65,8 @@ void DemagKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
 	//points between 1 and N.y / 2 - 1 inclusive
 	for (int j = 1; j < N.y / 2; j++) {
 
-		ReIm3 FM_l = pline[j];
-		ReIm3 FM_h = pline[N.y - j];
+		ReIm3Type FM_l = pline[j];
+		ReIm3Type FM_h = pline[N.y - j];
 
 		int ker_index = i + j * (N.x / 2 + 1);
 
@@ -82,7 +90,8 @@ void DemagKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
 }
 
 //multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
-void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
+template <typename ReIm3Type, typename VType>
+void DemagKernel::KernelMultiplication_3D_line(ReIm3Type* pline, int i, int j, VEC<VAL3<VType>>& Kdiag, VEC<VAL3<VType>>& Kodiag)
 {
 	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.z/2 and N.y/2 points
@@ -93,7 +102,7 @@ void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 	if (j <= N.y / 2) {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		ReIm3Type FM = pline[0];
 
 		int idx_start = i + j * (N.x / 2 + 1);
 
@@ -104,8 +113,8 @@ void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			ReIm3Type FM_l = pline[k];
+			ReIm3Type FM_h = pline[N.z - k];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -130,7 +139,7 @@ void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 	else {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		ReIm3Type FM = pline[0];
 
 		int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -141,8 +150,8 @@ void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			ReIm3Type FM_l = pline[k];
+			ReIm3Type FM_h = pline[N.z - k];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -166,12 +175,76 @@ void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 	}
 }
 
+void DemagKernel::KernelMultiplication_2D_line(ReIm3* pline, int i) { KernelMultiplication_2D_line(pline, i, Kdiag, K2D_odiag); }
+void DemagKernel::KernelMultiplication_2D_line(ReIm3F* pline, int i) { KernelMultiplication_2D_line(pline, i, Kdiag_sp, K2D_odiag_sp); }
+
+void DemagKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j) { KernelMultiplication_3D_line(pline, i, j, Kdiag, Kodiag); }
+void DemagKernel::KernelMultiplication_3D_line(ReIm3F* pline, int i, int j) { KernelMultiplication_3D_line(pline, i, j, Kdiag_sp, Kodiag_sp); }
+
 //-------------------------- KERNEL CALCULATION
 
+//this initializes the convolution kernels for the given mesh dimensions. 2D is for n.z == 1.
+BError DemagKernel::Calculate_Demag_Kernels(bool include_self_demag)
+{
+	BError error(__FUNCTION__);
+
+	//double precision kernels are freed after conversion to single precision, so allocate them again if recalculating
+	if (single_precision && !Kdiag.linear_size()) error = AllocateKernelMemory();
+	if (error) return error;
+
+	if (n.z == 1) error = Calculate_Demag_Kernels_2D(include_self_demag);
+	else error = Calculate_Demag_Kernels_3D(include_self_demag);
+
+	if (!error && single_precision) error = Convert_Kernels_SinglePrecision();
+
+	return error;
+}
+
+//convert computed kernels to single precision (single_precision set), freeing double precision kernels
+BError DemagKernel::Convert_Kernels_SinglePrecision(void)
+{
+	BError error(__FUNCTION__);
+
+	if (!Kdiag_sp.resize(Kdiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+	for (int idx = 0; idx < Kdiag.linear_size(); idx++) Kdiag_sp[idx] = Kdiag[idx];
+
+	if (n.z == 1) {
+
+		//2D
+		if (!malloc_vector(K2D_odiag_sp, K2D_odiag.size())) return error(BERROR_OUTOFMEMORY_CRIT);
+
+		for (int idx = 0; idx < K2D_odiag.size(); idx++) K2D_odiag_sp[idx] = (float)K2D_odiag[idx];
+	}
+	else {
+
+		//3D
+		if (!Kodiag_sp.resize(Kodiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+		for (int idx = 0; idx < Kodiag.linear_size(); idx++) Kodiag_sp[idx] = Kodiag[idx];
+	}
+
+	K2D_odiag.clear();
+	K2D_odiag.shrink_to_fit();
+
+	Kdiag.clear();
+	Kodiag.clear();
+
+	return error;
+}
+
 BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 {
 	BError error(__FUNCTION__);
 
+	//-------------- KERNEL CACHE
+
+	//if this kernel has been computed before it may be available in the kernel cache
+	std::string cache_key = DemagKernelCache::Make_Key("DemagKernel_2D", n, N, h / maximum(h.x, h.y, h.z), pbc_images, include_self_demag);
+	std::vector<std::pair<double*, size_t>> cache_arrays = { { reinterpret_cast<double*>(Kdiag.data()), Kdiag.linear_size() * 3 }, { K2D_odiag.data(), K2D_odiag.size() } };
+
+	if (DemagKernelCache::Load(cache_key, cache_arrays)) return error;
+
 	//-------------- CALCULATE DEMAG TENSOR
 
 	//Demag tensor components
@@ -212,84 +285,97 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 	}
 
 	//-------------- SETUP FFT
-	
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	double* pline_real_odiag = fftw_alloc_real(maximum(N.x, N.y, N.z));
-	fftw_complex* pline_odiag = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z));
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads), pline_real_odiag(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads), pline_odiag(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline_real_odiag[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z));
+		pline_odiag[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z));
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
-		pline_real_odiag, nullptr, 1, 1,
-		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		pline_real_odiag[0], nullptr, 1, 1,
+		pline_odiag[0], nullptr, 1, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
-		pline_real_odiag, nullptr, 1, 1,
-		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		pline_real_odiag[0], nullptr, 1, 1,
+		pline_odiag[0], nullptr, 1, 1,
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//1. FFTs along x
+#pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
 
+		int tn = omp_get_thread_num();
+
 		//write input into fft line
 		for (int i = 0; i < N.x; i++) {
 
 			int idx_in = i + j * N.x;
 
-			*reinterpret_cast<DBL3*>(pline_real + i * 3) = Ddiag[idx_in];
-			*reinterpret_cast<double*>(pline_real_odiag + i) = Dodiag[idx_in];
+			*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = Ddiag[idx_in];
+			*reinterpret_cast<double*>(pline_real_odiag[tn] + i) = Dodiag[idx_in];
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x);
-		fftw_execute(plan_fwd_x_odiag);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x_odiag, pline_real_odiag[tn], pline_odiag[tn]);
 
-		//pack into tensor for next step
+		//pack into tensor for next step (keep same row stride, so lines not yet read by other threads are not overwritten)
 		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-			ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
-			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag + i);
+			ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag[tn] + i);
 
-			Ddiag[i + j * (N.x / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
-			Dodiag[i + j * (N.x / 2 + 1)] = value_odiag.Im;
+			Ddiag[i + j * N.x] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+			Dodiag[i + j * N.x] = value_odiag.Im;
 		}
 	}
 
 	//2. FFTs along y
+#pragma omp parallel for
 	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+		int tn = omp_get_thread_num();
+
 		//fetch line from array
 		for (int j = 0; j < N.y; j++) {
 
-			*reinterpret_cast<DBL3*>(pline_real + j * 3) = Ddiag[i + j * (N.x / 2 + 1)];
-			*reinterpret_cast<double*>(pline_real_odiag + j) = Dodiag[i + j * (N.x / 2 + 1)];
+			*reinterpret_cast<DBL3*>(pline_real[tn] + j * 3) = Ddiag[i + j * N.x];
+			*reinterpret_cast<double*>(pline_real_odiag[tn] + j) = Dodiag[i + j * N.x];
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_y);
-		fftw_execute(plan_fwd_y_odiag);
+		fftw_execute_dft_r2c(plan_fwd_y, pline_real[tn], pline[tn]);
+		fftw_execute_dft_r2c(plan_fwd_y_odiag, pline_real_odiag[tn], pline_odiag[tn]);
 
 		//pack into output real kernels with reduced strides
 		for (int j = 0; j < N.y / 2 + 1; j++) {
 
-			ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
-			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag + j);
+			ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag[tn] + j);
 
 			//even w.r.t. y so output is purely real
 			Kdiag[i + j * (N.x / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
@@ -302,14 +388,24 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_x_odiag);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_y_odiag);
 
-	fftw_free((double*)pline_real);
-	fftw_free((double*)pline_real_odiag);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((double*)pline_real_odiag[tn]);
+		fftw_free((fftw_complex*)pline_odiag[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
+
+	//store kernel for next time
+	DemagKernelCache::Save(cache_key, cache_arrays);
 	
 	return error;
 }
@@ -317,6 +413,14 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 {
 	BError error(__FUNCTION__);
+
+	//-------------- KERNEL CACHE
+
+	//if this kernel has been computed before it may be available in the kernel cache
+	std::string cache_key = DemagKernelCache::Make_Key("DemagKernel_3D", n, N, h / maximum(h.x, h.y, h.z), pbc_images, include_self_demag);
+	std::vector<std::pair<double*, size_t>> cache_arrays = { { reinterpret_cast<double*>(Kdiag.data()), Kdiag.linear_size() * 3 }, { reinterpret_cast<double*>(Kodiag.data()), Kodiag.linear_size() * 3 } };
+
+	if (DemagKernelCache::Load(cache_key, cache_arrays)) return error;
 	
 	//-------------- DEMAG TENSOR
 
@@ -337,8 +441,15 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
@@ -346,19 +457,19 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 	int dims_z[1] = { (int)N.z };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -367,33 +478,36 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int j = 0; j < N.y; j++) {
 
+				int tn = omp_get_thread_num();
+
 				//write input into fft line (zero padding kept)
 				for (int i = 0; i < N.x; i++) {
 
 					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_x);
+				fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
-				//pack into tensor for next step
+				//pack into tensor for next step (keep same row and plane strides, so lines not yet read by other threads are not overwritten)
 				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 					if (!off_diagonal) {
 
 						//even w.r.t. to x so output is purely real
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
 					}
 					else {
 
 						//Dxy : odd x, Dxz : odd x, Dyz : even x
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = DBL3(value.x.Im, value.y.Im, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Im, value.y.Im, value.z.Re);
 					}
 				}
 			}
@@ -401,57 +515,63 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 
 		//2. FFTs along y
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int j = 0; j < N.y; j++) {
 
-					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
+					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + j * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + j * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_y);
+				fftw_execute_dft_r2c(plan_fwd_y, pline_real[tn], pline[tn]);
 
 				//pack into lower half of tensor column for next step (keep same row and plane strides)
 				for (int j = 0; j < N.y / 2 + 1; j++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
 					if (!off_diagonal) {
 
 						//even w.r.t. to y so output is purely real
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
 					}
 					else {
 
 						//Dxy : odd y, Dxz : even y, Dyz : odd y
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = DBL3(value.x.Im, value.y.Re, value.z.Im);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Im, value.y.Re, value.z.Im);
 					}
 				}
 			}
 		}
 
 		//3. FFTs along z
+#pragma omp parallel for
 		for (int j = 0; j < N.y / 2 + 1; j++) {
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int k = 0; k < N.z; k++) {
 
-					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
+					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + k * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + k * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_z);
+				fftw_execute_dft_r2c(plan_fwd_z, pline_real[tn], pline[tn]);
 
 				//pack into output kernels with reduced strides
 				for (int k = 0; k < N.z / 2 + 1; k++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + k * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
 
 					if (!off_diagonal) {
 
@@ -505,12 +625,21 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
+
+	//store kernel for next time
+	DemagKernelCache::Save(cache_key, cache_arrays);
 
 	//Done
 	return error;
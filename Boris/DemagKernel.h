@@ -29,9 +29,14 @@ public:
 	//Kdiag : Kx, Ky, Kz; Kodiag : Kxy, Kxz, Kyz; (real parts only, imaginary parts are zero)
 	VEC<DBL3> Kdiag, Kodiag;
 
+	//single precision kernels, used for single precision convolution : the above double precision kernels are freed once converted
+	std::vector<float> K2D_odiag_sp;
+	VEC<FLT3> Kdiag_sp, Kodiag_sp;
+
 private:
 
-	void FreeAllKernelMemory(void);
+	//convert computed kernels to single precision (single_precision set), freeing double precision kernels
+	BError Convert_Kernels_SinglePrecision(void);
 
 	//-------------------------- KERNEL CALCULATION
 
@@ -39,8 +44,21 @@ private:
 	BError Calculate_Demag_Kernels_2D(bool include_self_demag);
 	BError Calculate_Demag_Kernels_3D(bool include_self_demag);
 
+	//-------------------------- RUN-TIME KERNEL MULTIPLICATION
+
+	//line multiplications for given line and kernel precisions
+	template <typename ReIm3Type, typename VType>
+	void KernelMultiplication_2D_line(ReIm3Type* pline, int i, VEC<VAL3<VType>>& Kdiag, std::vector<VType>& K2D_odiag);
+
+	template <typename ReIm3Type, typename VType>
+	void KernelMultiplication_3D_line(ReIm3Type* pline, int i, int j, VEC<VAL3<VType>>& Kdiag, VEC<VAL3<VType>>& Kodiag);
+
 protected:
 
+	//this kernel provides single precision kernels and line multiplications
+	static constexpr bool single_precision_support = true;
+
+
 	//-------------------------- CONSTRUCTOR
 
 	DemagKernel(void) {}
@@ -52,14 +70,13 @@ protected:
 	//Called by SetDimensions in Convolution class
 	BError AllocateKernelMemory(void);
 
+	//Called by FreeDimensions in Convolution class
+	void FreeAllKernelMemory(void);
+
 	//-------------------------- KERNEL CALCULATION
 
 	//this initializes the convolution kernels for the given mesh dimensions. 2D is for n.z == 1.
-	BError Calculate_Demag_Kernels(bool include_self_demag = true)
-	{
-		if (n.z == 1) return Calculate_Demag_Kernels_2D(include_self_demag);
-		else return Calculate_Demag_Kernels_3D(include_self_demag);
-	}
+	BError Calculate_Demag_Kernels(bool include_self_demag = true);
 
 	//-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
@@ -77,9 +94,11 @@ protected:
 
 	//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
 	void KernelMultiplication_2D_line(ReIm3* pline, int i);
+	void KernelMultiplication_2D_line(ReIm3F* pline, int i);
 
 	//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
 	void KernelMultiplication_3D_line(ReIm3* pline, int i, int j);
+	void KernelMultiplication_3D_line(ReIm3F* pline, int i, int j);
 };
 
 #endif
@@ -0,0 +1,181 @@
+#include "stdafx.h"
+#include "DemagKernelCache.h"
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include "DemagTFunc_Defs.h"
+
+#include <iomanip>
+
+//magic identifier and format version for kernel files : change version if kernel calculation or storage layout changes
+#define DEMAGKERNELCACHE_MAGIC		"BORISKER"
+#define DEMAGKERNELCACHE_VERSION	1
+//array data starts on a boundary of this many bytes
+#define DEMAGKERNELCACHE_ALIGNMENT	64
+
+bool DemagKernelCache::cache_enabled = false;
+std::string DemagKernelCache::cache_directory = "";
+
+//-------------------------- HELPERS
+
+//64-bit FNV-1a hash
+uint64_t DemagKernelCache::hash_bytes(const char* data, size_t size, uint64_t hash)
+{
+	for (size_t idx = 0; idx < size; idx++) {
+
+		hash ^= (unsigned char)data[idx];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+//kernel file name for given key
+std::string DemagKernelCache::Get_FileName(const std::string& key)
+{
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << hash_bytes(key.c_str(), key.length());
+
+	return cache_directory + "demagkernel_" + ss.str() + ".bker";
+}
+
+//-------------------------- KEYS
+
+std::string DemagKernelCache::Make_Key(std::string kernel_type, SZ3 n, SZ3 N, DBL3 h_dst, INT3 pbc_images, bool include_self_demag, DBL3 h_src, DBL3 shift)
+{
+	//full precision needed for floating point values : kernels for cellsizes differing in last digits are different
+	std::stringstream ss;
+	ss << std::setprecision(17);
+
+	ss << kernel_type
+		<< ";n=" << n.x << "," << n.y << "," << n.z
+		<< ";N=" << N.x << "," << N.y << "," << N.z
+		<< ";h_dst=" << h_dst.x << "," << h_dst.y << "," << h_dst.z
+		<< ";h_src=" << h_src.x << "," << h_src.y << "," << h_src.z
+		<< ";shift=" << shift.x << "," << shift.y << "," << shift.z
+		<< ";pbc=" << pbc_images.x << "," << pbc_images.y << "," << pbc_images.z
+		<< ";self=" << include_self_demag
+		<< ";asymptotic=" << ASYMPTOTIC_DISTANCE;
+
+	return ss.str();
+}
+
+//-------------------------- LOAD / SAVE
+
+bool DemagKernelCache::Load(const std::string& key, std::vector<std::pair<double*, size_t>> arrays)
+{
+	if (!cache_enabled) return false;
+
+	std::ifstream bdin;
+	bdin.open(Get_FileName(key).c_str(), std::ios::in | std::ios::binary);
+	if (!bdin.is_open()) return false;
+
+	auto read_value = [&](auto& value) -> bool { return (bool)bdin.read(reinterpret_cast<char*>(&value), sizeof(value)); };
+
+	//magic and version
+	char magic[8];
+	if (!bdin.read(magic, 8) || std::string(magic, 8) != DEMAGKERNELCACHE_MAGIC) return false;
+
+	uint32_t version = 0;
+	if (!read_value(version) || version != DEMAGKERNELCACHE_VERSION) return false;
+
+	//key : must match exactly (hash collisions are possible)
+	uint32_t key_length = 0;
+	if (!read_value(key_length) || key_length != key.length()) return false;
+
+	std::string file_key((key_length + 7) / 8 * 8, '\0');
+	if (!bdin.read(&file_key[0], file_key.size()) || file_key.substr(0, key_length) != key) return false;
+
+	//arrays sizes
+	uint32_t num_arrays = 0, padding = 0;
+	if (!read_value(num_arrays) || !read_value(padding) || num_arrays != arrays.size()) return false;
+
+	for (int idx = 0; idx < (int)arrays.size(); idx++) {
+
+		uint64_t array_size = 0;
+		if (!read_value(array_size) || array_size != arrays[idx].second) return false;
+	}
+
+	uint64_t checksum = 0;
+	if (!read_value(checksum)) return false;
+
+	//skip to aligned data start
+	std::streamoff header_size = bdin.tellg();
+	std::streamoff data_start = (header_size + (std::streamoff)DEMAGKERNELCACHE_ALIGNMENT - 1) / DEMAGKERNELCACHE_ALIGNMENT * DEMAGKERNELCACHE_ALIGNMENT;
+	bdin.seekg(data_start);
+
+	//read array data directly into kernels, checking data integrity as we go
+	uint64_t data_checksum = hash_bytes(nullptr, 0);
+
+	for (int idx = 0; idx < (int)arrays.size(); idx++) {
+
+		size_t bytes = arrays[idx].second * sizeof(double);
+		if (!bdin.read(reinterpret_cast<char*>(arrays[idx].first), bytes)) return false;
+
+		data_checksum = hash_bytes(reinterpret_cast<char*>(arrays[idx].first), bytes, data_checksum);
+	}
+
+	bdin.close();
+
+	return data_checksum == checksum;
+}
+
+bool DemagKernelCache::Save(const std::string& key, std::vector<std::pair<double*, size_t>> arrays)
+{
+	if (!cache_enabled) return false;
+
+	//write to temporary file first then rename : other Boris instances may be reading the same kernel
+	std::string fileName = Get_FileName(key);
+	std::string fileName_temp = fileName + ".tmp" + ToString(GetSystemTickCount());
+
+	std::ofstream bdout;
+	bdout.open(fileName_temp.c_str(), std::ios::out | std::ios::binary);
+	if (!bdout.is_open()) return false;
+
+	auto write_value = [&](auto value) -> void { bdout.write(reinterpret_cast<char*>(&value), sizeof(value)); };
+
+	bdout.write(DEMAGKERNELCACHE_MAGIC, 8);
+	write_value((uint32_t)DEMAGKERNELCACHE_VERSION);
+
+	write_value((uint32_t)key.length());
+	std::string padded_key = key + std::string((key.length() + 7) / 8 * 8 - key.length(), '\0');
+	bdout.write(padded_key.c_str(), padded_key.size());
+
+	write_value((uint32_t)arrays.size());
+	write_value((uint32_t)0);
+
+	uint64_t checksum = hash_bytes(nullptr, 0);
+
+	for (int idx = 0; idx < (int)arrays.size(); idx++) {
+
+		write_value((uint64_t)arrays[idx].second);
+		checksum = hash_bytes(reinterpret_cast<char*>(arrays[idx].first), arrays[idx].second * sizeof(double), checksum);
+	}
+
+	write_value(checksum);
+
+	//pad to aligned data start
+	std::streamoff header_size = bdout.tellp();
+	std::streamoff data_start = (header_size + (std::streamoff)DEMAGKERNELCACHE_ALIGNMENT - 1) / DEMAGKERNELCACHE_ALIGNMENT * DEMAGKERNELCACHE_ALIGNMENT;
+	bdout.write(std::string(data_start - header_size, '\0').c_str(), data_start - header_size);
+
+	for (int idx = 0; idx < (int)arrays.size(); idx++) {
+
+		bdout.write(reinterpret_cast<char*>(arrays[idx].first), arrays[idx].second * sizeof(double));
+	}
+
+	bool success = (bool)bdout;
+	bdout.close();
+
+#if OPERATING_SYSTEM == OS_WIN
+	//rename doesn't replace existing files on Windows
+	if (success) std::remove(fileName.c_str());
+#endif
+
+	if (success) success = !std::rename(fileName_temp.c_str(), fileName.c_str());
+	if (!success) std::remove(fileName_temp.c_str());
+
+	return success;
+}
+
+#endif
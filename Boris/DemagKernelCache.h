@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Boris_Enums_Defs.h"
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include "BorisLib.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// On-disk cache for demag kernels, so the same kernels don't need to be recomputed every time a simulation with identical geometry is initialized
+
+//Kernels are content-addressed : the file name is a hash of a key string, which contains everything the kernel values depend on
+//(kernel type, n, N, normalized cellsizes and shifts, pbc images, self demag flag, etc.)
+//
+//File layout (all values little-endian as written by the machine) :
+//
+//char[8] : magic identifier
+//uint32 : file format version
+//uint32 : key string length, followed by key string padded to 8 bytes
+//uint32 : number of arrays, uint32 : padding
+//uint64 : number of doubles in each array
+//uint64 : checksum of array data
+//padding up to a 64 byte boundary, then raw array data (doubles), one array after the other
+//
+//Thus the array data can be memory-mapped directly if needed. When loading, all header values, the key and the checksum are validated before the kernel is accepted.
+
+class DemagKernelCache
+{
+
+private:
+
+	//cache enabled? (set using demagkernelcache command)
+	static bool cache_enabled;
+
+	//directory where kernel files are stored
+	static std::string cache_directory;
+
+private:
+
+	//64-bit FNV-1a hash
+	static uint64_t hash_bytes(const char* data, size_t size, uint64_t hash = 14695981039346656037ULL);
+
+	//kernel file name for given key
+	static std::string Get_FileName(const std::string& key);
+
+public:
+
+	//-------------------------- CONFIGURATION
+
+	static void Set_Enabled(bool status) { cache_enabled = status; }
+	static bool Get_Enabled(void) { return cache_enabled; }
+
+	static void Set_Directory(std::string cache_directory_) { cache_directory = cache_directory_; }
+	static std::string Get_Directory(void) { return cache_directory; }
+
+	//-------------------------- KEYS
+
+	//make key string from kernel parameters. Kernel values only depend on normalized cellsizes and shifts, so pass these in (h_dst, h_src, shift all normalized by the same value).
+	//kernel_type identifies the way the kernel was computed and stored (e.g. 2D or 3D, self, z shifted, full complex)
+	static std::string Make_Key(std::string kernel_type, SZ3 n, SZ3 N, DBL3 h_dst, INT3 pbc_images, bool include_self_demag, DBL3 h_src = DBL3(), DBL3 shift = DBL3());
+
+	//-------------------------- LOAD / SAVE
+
+	//load kernel arrays for given key : each pair is a pointer to an array of doubles and number of doubles expected. Return true only if all arrays loaded successfully and file validated.
+	//if this returns false the arrays may have been partially written so the kernel must be recomputed
+	static bool Load(const std::string& key, std::vector<std::pair<double*, size_t>> arrays);
+
+	//save kernel arrays with given key (only if cache enabled)
+	static bool Save(const std::string& key, std::vector<std::pair<double*, size_t>> arrays);
+};
+
+#endif
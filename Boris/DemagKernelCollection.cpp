@@ -96,6 +96,22 @@ void KerType::FreeKernels(void)
 	kernel_calculated = false;
 }
 
+//allocated kernel arrays as (pointer, number of doubles) pairs : used for the demag kernel cache
+std::vector<std::pair<double*, size_t>> KerType::Get_Kernel_Arrays(void)
+{
+	std::vector<std::pair<double*, size_t>> arrays;
+
+	if (K2D_odiag.size()) arrays.push_back({ K2D_odiag.data(), K2D_odiag.size() });
+
+	if (Kdiag_cmpl.linear_size()) arrays.push_back({ reinterpret_cast<double*>(Kdiag_cmpl.data()), Kdiag_cmpl.linear_size() * 6 });
+	if (Kodiag_cmpl.linear_size()) arrays.push_back({ reinterpret_cast<double*>(Kodiag_cmpl.data()), Kodiag_cmpl.linear_size() * 6 });
+
+	if (Kdiag_real.linear_size()) arrays.push_back({ reinterpret_cast<double*>(Kdiag_real.data()), Kdiag_real.linear_size() * 3 });
+	if (Kodiag_real.linear_size()) arrays.push_back({ reinterpret_cast<double*>(Kodiag_real.data()), Kodiag_real.linear_size() * 3 });
+
+	return arrays;
+}
+
 //-------------------------- MEMORY ALLOCATION
 
 BError DemagKernelCollection::AllocateKernelMemory(void)
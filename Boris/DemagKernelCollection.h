@@ -71,6 +71,9 @@ struct KerType {
 	BError AllocateKernels(Rect from_rect, Rect this_rect, SZ3 N_);
 
 	void FreeKernels(void);
+
+	//allocated kernel arrays as (pointer, number of doubles) pairs : used for the demag kernel cache
+	std::vector<std::pair<double*, size_t>> Get_Kernel_Arrays(void);
 };
 
 //This must be used as a template parameter in Convolution class.
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "DemagKernelCollection.h"
+#include "DemagKernelCache.h"
 
 #ifdef MODULE_COMPILATION_SDEMAG
 
@@ -55,7 +56,9 @@ BError DemagKernelCollection::Calculate_Demag_Kernels(std::vector<DemagKernelCol
 				error = kernels[index]->AllocateKernels(Rect_collection[index], this_rect, N);
 				if (error) return error;
 
-				//now compute it
+				//kernel type identifies which calculation method is used (and so also how the kernel is stored)
+				std::string kernel_type;
+
 				if (kernels[index]->internal_demag) {
 
 					kernels[index]->shift = DBL3();
@@ -63,8 +66,8 @@ BError DemagKernelCollection::Calculate_Demag_Kernels(std::vector<DemagKernelCol
 					kernels[index]->h_src = h;
 
 					//use self versions
-					if (n.z == 1) error = Calculate_Demag_Kernels_2D_Self(index);
-					else error = Calculate_Demag_Kernels_3D_Self(index);
+					if (n.z == 1) kernel_type = "Collection_2D_Self";
+					else kernel_type = "Collection_3D_Self";
 				}
 				else {
 
@@ -73,32 +76,30 @@ BError DemagKernelCollection::Calculate_Demag_Kernels(std::vector<DemagKernelCol
 					kernels[index]->h_dst = h;
 					kernels[index]->h_src = kernelCollection[index]->h;
 
-					if (n.z == 1) {
+					//z-shifted kernels, or general kernels (not z-shifted)
+					bool zshifted = IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y);
 
-						if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+					if (n.z == 1) kernel_type = (zshifted ? "Collection_2D_zShifted" : "Collection_2D_Complex_Full");
+					else kernel_type = (zshifted ? "Collection_3D_zShifted" : "Collection_3D_Complex_Full");
+				}
 
-							//z-shifted kernels for 2D
-							error = Calculate_Demag_Kernels_2D_zShifted(index);
-						}
-						else {
+				//if this kernel has been computed before (in this or a previous simulation) it may be available in the kernel cache, shared by all kernel collections
+				std::string cache_key = DemagKernelCache::Make_Key(
+					kernel_type, n, N, kernels[index]->h_dst / h_max, pbc_images, true, kernels[index]->h_src / h_max, kernels[index]->shift / h_max);
+				std::vector<std::pair<double*, size_t>> cache_arrays = kernels[index]->Get_Kernel_Arrays();
 
-							//general 2D kernels (not z-shifted)
-							error = Calculate_Demag_Kernels_2D_Complex_Full(index);
-						}
-					}
-					else {
-
-						if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+				if (!DemagKernelCache::Load(cache_key, cache_arrays)) {
 
-							//z-shifted kernels for 3D
-							error = Calculate_Demag_Kernels_3D_zShifted(index);
-						}
-						else {
+					//now compute it
+					if (kernel_type == "Collection_2D_Self") error = Calculate_Demag_Kernels_2D_Self(index);
+					else if (kernel_type == "Collection_3D_Self") error = Calculate_Demag_Kernels_3D_Self(index);
+					else if (kernel_type == "Collection_2D_zShifted") error = Calculate_Demag_Kernels_2D_zShifted(index);
+					else if (kernel_type == "Collection_2D_Complex_Full") error = Calculate_Demag_Kernels_2D_Complex_Full(index);
+					else if (kernel_type == "Collection_3D_zShifted") error = Calculate_Demag_Kernels_3D_zShifted(index);
+					else error = Calculate_Demag_Kernels_3D_Complex_Full(index);
 
-							//general 3D kernels (not z-shifted)
-							error = Calculate_Demag_Kernels_3D_Complex_Full(index);
-						}
-					}
+					//store kernel for next time
+					if (!error) DemagKernelCache::Save(cache_key, cache_arrays);
 				}
 
 				//set flag to say it's been computed so it could be reused if needed
@@ -186,83 +187,96 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Self(int index)
 	
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	double* pline_real_odiag = fftw_alloc_real(maximum(N.x, N.y, N.z));
-	fftw_complex* pline_odiag = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z));
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads), pline_real_odiag(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads), pline_odiag(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline_real_odiag[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z));
+		pline_odiag[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z));
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
-		pline_real_odiag, nullptr, 1, 1,
-		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		pline_real_odiag[0], nullptr, 1, 1,
+		pline_odiag[0], nullptr, 1, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
-		pline_real_odiag, nullptr, 1, 1,
-		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		pline_real_odiag[0], nullptr, 1, 1,
+		pline_odiag[0], nullptr, 1, 1,
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//1. FFTs along x
+#pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
 
+		int tn = omp_get_thread_num();
+
 		//write input into fft line
 		for (int i = 0; i < N.x; i++) {
 
 			int idx_in = i + j * N.x;
 
-			*reinterpret_cast<DBL3*>(pline_real + i * 3) = Ddiag[idx_in];
-			*reinterpret_cast<double*>(pline_real_odiag + i) = Dodiag[idx_in];
+			*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = Ddiag[idx_in];
+			*reinterpret_cast<double*>(pline_real_odiag[tn] + i) = Dodiag[idx_in];
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x);
-		fftw_execute(plan_fwd_x_odiag);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x_odiag, pline_real_odiag[tn], pline_odiag[tn]);
 
-		//pack into tensor for next step
+		//pack into tensor for next step (keep same row stride, so lines not yet read by other threads are not overwritten)
 		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-			ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
-			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag + i);
+			ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag[tn] + i);
 
-			Ddiag[i + j * (N.x / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
-			Dodiag[i + j * (N.x / 2 + 1)] = value_odiag.Im;
+			Ddiag[i + j * N.x] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+			Dodiag[i + j * N.x] = value_odiag.Im;
 		}
 	}
 
 	//2. FFTs along y
+#pragma omp parallel for
 	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+		int tn = omp_get_thread_num();
+
 		//fetch line from array
 		for (int j = 0; j < N.y; j++) {
 
-			*reinterpret_cast<DBL3*>(pline_real + j * 3) = Ddiag[i + j * (N.x / 2 + 1)];
-			*reinterpret_cast<double*>(pline_real_odiag + j) = Dodiag[i + j * (N.x / 2 + 1)];
+			*reinterpret_cast<DBL3*>(pline_real[tn] + j * 3) = Ddiag[i + j * N.x];
+			*reinterpret_cast<double*>(pline_real_odiag[tn] + j) = Dodiag[i + j * N.x];
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_y);
-		fftw_execute(plan_fwd_y_odiag);
+		fftw_execute_dft_r2c(plan_fwd_y, pline_real[tn], pline[tn]);
+		fftw_execute_dft_r2c(plan_fwd_y_odiag, pline_real_odiag[tn], pline_odiag[tn]);
 
 		//pack into output real kernels with reduced strides
 		for (int j = 0; j < N.y / 2 + 1; j++) {
 
-			ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
-			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag + j);
+			ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+			ReIm value_odiag = *reinterpret_cast<ReIm*>(pline_odiag[tn] + j);
 
 			//even w.r.t. y so output is purely real
 			kernels[index]->Kdiag_real[i + j * (N.x / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
@@ -275,14 +289,21 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Self(int index)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_x_odiag);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_y_odiag);
 
-	fftw_free((double*)pline_real);
-	fftw_free((double*)pline_real_odiag);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((double*)pline_real_odiag[tn]);
+		fftw_free((fftw_complex*)pline_odiag[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 
 	return error;
 }
@@ -311,22 +332,29 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_zShifted(int index)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -334,55 +362,61 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_zShifted(int index)
 	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel, bool off_diagonal) -> void {
 
 		//1. FFTs along x
+#pragma omp parallel for
 		for (int j = 0; j < N.y; j++) {
 
+			int tn = omp_get_thread_num();
+
 			//write input into fft line (zero padding kept)
 			for (int i = 0; i < N.x; i++) {
 
 				int idx_in = i + j * N.x;
 
-				*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+				*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_x);
+			fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
-			//pack into tensor for next step
+			//pack into tensor for next step (keep same row stride, so lines not yet read by other threads are not overwritten)
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+				ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 				if (!off_diagonal) {
 
 					//even w.r.t. to x so output is purely real
-					tensor[i + j * (N.x / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+					tensor[i + j * N.x] = DBL3(value.x.Re, value.y.Re, value.z.Re);
 				}
 				else {
 
 					//Dxy : odd x, Dxz : odd x, Dyz : even x
-					tensor[i + j * (N.x / 2 + 1)] = DBL3(value.x.Im, value.y.Im, value.z.Re);
+					tensor[i + j * N.x] = DBL3(value.x.Im, value.y.Im, value.z.Re);
 				}
 			}
 		}
 
 		//2. FFTs along y
+#pragma omp parallel for
 		for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+			int tn = omp_get_thread_num();
+
 			//fetch line from fft array (zero padding kept)
 			for (int j = 0; j < N.y; j++) {
 
-				int idx_in = i + j * (N.x / 2 + 1);
+				int idx_in = i + j * N.x;
 
-				*reinterpret_cast<DBL3*>(pline_real + j * 3) = tensor[idx_in];
+				*reinterpret_cast<DBL3*>(pline_real[tn] + j * 3) = tensor[idx_in];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_y);
+			fftw_execute_dft_r2c(plan_fwd_y, pline_real[tn], pline[tn]);
 
 			//pack into kernel
 			for (int j = 0; j < N.y / 2 + 1; j++) {
 
-				ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+				ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
 				if (!off_diagonal) {
 
@@ -432,11 +466,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_zShifted(int index)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 
 	//Done
 	return error;
@@ -466,22 +506,29 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Complex_Full(int index)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
-		pline, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -489,45 +536,51 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Complex_Full(int index)
 	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<ReIm3>& kernel) -> void {
 
 		//1. FFTs along x
+#pragma omp parallel for
 		for (int j = 0; j < N.y; j++) {
 
+			int tn = omp_get_thread_num();
+
 			//write input into fft line (zero padding kept)
 			for (int i = 0; i < N.x; i++) {
 
 				int idx_in = i + j * N.x;
 
-				*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+				*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_x);
+			fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
 			//pack into kernel for next step
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+				ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 				kernel[i + j * (N.x / 2 + 1)] = value;
 			}
 		}
 
 		//2. FFTs along y
+#pragma omp parallel for
 		for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+			int tn = omp_get_thread_num();
+
 			//fetch line from fft array (zero padding kept)
 			for (int j = 0; j < N.y; j++) {
 
 				int idx_in = i + j * (N.x / 2 + 1);
 
-				*reinterpret_cast<ReIm3*>(pline + j * 3) = kernel[idx_in];
+				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = kernel[idx_in];
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_y);
+			fftw_execute_dft(plan_fwd_y, pline[tn], pline[tn]);
 
 			for (int j = 0; j < N.y; j++) {
 
-				ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+				ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
 				kernel[i + j * (N.x / 2 + 1)] = value;
 			}
@@ -568,11 +621,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Complex_Full(int index)
 
 	//-------------- CLEANUP
 	
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 	
 	//Done
 	return error;
@@ -602,8 +661,15 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
@@ -611,19 +677,19 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 	int dims_z[1] = { (int)N.z };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -632,33 +698,36 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int j = 0; j < N.y; j++) {
 
+				int tn = omp_get_thread_num();
+
 				//write input into fft line (zero padding kept)
 				for (int i = 0; i < N.x; i++) {
 
 					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_x);
+				fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
-				//pack into tensor for next step
+				//pack into tensor for next step (keep same row and plane strides, so lines not yet read by other threads are not overwritten)
 				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 					if (!off_diagonal) {
 
 						//even w.r.t. to x so output is purely real
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
 					}
 					else {
 
 						//Dxy : odd x, Dxz : odd x, Dyz : even x
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = DBL3(value.x.Im, value.y.Im, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Im, value.y.Im, value.z.Re);
 					}
 				}
 			}
@@ -666,57 +735,63 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 
 		//2. FFTs along y
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int j = 0; j < N.y; j++) {
 
-					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
+					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + j * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + j * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_y);
+				fftw_execute_dft_r2c(plan_fwd_y, pline_real[tn], pline[tn]);
 
 				//pack into lower half of tensor column for next step (keep same row and plane strides)
 				for (int j = 0; j < N.y / 2 + 1; j++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
 					if (!off_diagonal) {
 
 						//even w.r.t. to y so output is purely real
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = DBL3(value.x.Re, value.y.Re, value.z.Re);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Re, value.y.Re, value.z.Re);
 					}
 					else {
 
 						//Dxy : odd y, Dxz : even y, Dyz : odd y
-						tensor[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = DBL3(value.x.Im, value.y.Re, value.z.Im);
+						tensor[i + j * N.x + k * N.x * N.y] = DBL3(value.x.Im, value.y.Re, value.z.Im);
 					}
 				}
 			}
 		}
 
 		//3. FFTs along z
+#pragma omp parallel for
 		for (int j = 0; j < N.y / 2 + 1; j++) {
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int k = 0; k < N.z; k++) {
 
-					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
+					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + k * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + k * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_z);
+				fftw_execute_dft_r2c(plan_fwd_z, pline_real[tn], pline[tn]);
 
 				//pack into output kernels with reduced strides
 				for (int k = 0; k < N.z / 2 + 1; k++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + k * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
 
 					if (!off_diagonal) {
 
@@ -773,12 +848,18 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 
 	//Done
 	return error;
@@ -808,8 +889,15 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
@@ -817,19 +905,19 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 	int dims_z[1] = { (int)N.z };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
-		pline, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
-		pline, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -838,23 +926,26 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int j = 0; j < N.y; j++) {
 
+				int tn = omp_get_thread_num();
+
 				//write input into fft line (zero padding kept)
 				for (int i = 0; i < N.x; i++) {
 
 					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_x);
+				fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
 				//pack into scratch space
 				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 					F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = value;
 				}
@@ -863,48 +954,54 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 
 		//2. FFTs along y
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int j = 0; j < N.y; j++) {
 
 					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-					*reinterpret_cast<ReIm3*>(pline + j * 3) = F[idx_in];
+					*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_y);
+				fftw_execute_dft(plan_fwd_y, pline[tn], pline[tn]);
 
-				//pack into scratch space
+				//pack into scratch space (keep same plane stride, so planes not yet read by other threads are not overwritten)
 				for (int j = 0; j < N.y / 2 + 1; j++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
-					F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = value;
+					F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = value;
 				}
 			}
 		}
 
 		//3. FFTs along z
+#pragma omp parallel for
 		for (int j = 0; j < N.y / 2 + 1; j++) {
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int k = 0; k < N.z; k++) {
 
-					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
+					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-					*reinterpret_cast<ReIm3*>(pline + k * 3) = F[idx_in];
+					*reinterpret_cast<ReIm3*>(pline[tn] + k * 3) = F[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_z);
+				fftw_execute_dft(plan_fwd_z, pline[tn], pline[tn]);
 
 				//pack into output kernels with reduced strides
 				for (int k = 0; k < N.z / 2 + 1; k++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + k * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
 
 					kernel[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1)] = value;
 				}
@@ -949,12 +1046,18 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 
 	//Done
 	return error;
@@ -984,8 +1087,15 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 
 	//-------------- SETUP FFT
 
-	double* pline_real = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
-	fftw_complex* pline = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	//fft lines for each thread so tensor lines can be transformed in parallel : plans are made on the first lines, then executed on each thread's own lines
+	std::vector<double*> pline_real(OmpThreads);
+	std::vector<fftw_complex*> pline(OmpThreads);
+
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		pline_real[tn] = fftw_alloc_real(maximum(N.x, N.y, N.z) * 3);
+		pline[tn] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
 
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
@@ -993,19 +1103,19 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 	int dims_z[1] = { (int)N.z };
 
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
-		pline_real, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		pline_real[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
-		pline, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
-		pline, nullptr, 3, 1,
-		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1014,23 +1124,26 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int j = 0; j < N.y; j++) {
 
+				int tn = omp_get_thread_num();
+
 				//write input into fft line (zero padding kept)
 				for (int i = 0; i < N.x; i++) {
 
 					int idx_in = i + j * N.x + k * N.x * N.y;
 
-					*reinterpret_cast<DBL3*>(pline_real + i * 3) = tensor[idx_in];
+					*reinterpret_cast<DBL3*>(pline_real[tn] + i * 3) = tensor[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_x);
+				fftw_execute_dft_r2c(plan_fwd_x, pline_real[tn], pline[tn]);
 
 				//pack into scratch space
 				for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + i * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 
 					F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = value;
 				}
@@ -1039,23 +1152,26 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 
 		//2. FFTs along y
 		for (int k = 0; k < N.z; k++) {
+#pragma omp parallel for
 			for (int i = 0; i < (N.x / 2 + 1); i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int j = 0; j < N.y; j++) {
 
 					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-					*reinterpret_cast<ReIm3*>(pline + j * 3) = F[idx_in];
+					*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_y);
+				fftw_execute_dft(plan_fwd_y, pline[tn], pline[tn]);
 
 				//pack into scratch space
 				for (int j = 0; j < N.y; j++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + j * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
 
 					F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = value;
 				}
@@ -1063,24 +1179,27 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 		}
 
 		//3. FFTs along z
+#pragma omp parallel for
 		for (int j = 0; j < N.y; j++) {
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
+				int tn = omp_get_thread_num();
+
 				//fetch line from fft array (zero padding kept)
 				for (int k = 0; k < N.z; k++) {
 
 					int idx_in = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-					*reinterpret_cast<ReIm3*>(pline + k * 3) = F[idx_in];
+					*reinterpret_cast<ReIm3*>(pline[tn] + k * 3) = F[idx_in];
 				}
 
 				//fft on line
-				fftw_execute(plan_fwd_z);
+				fftw_execute_dft(plan_fwd_z, pline[tn], pline[tn]);
 
 				//pack into output kernels with reduced strides
 				for (int k = 0; k < N.z; k++) {
 
-					ReIm3 value = *reinterpret_cast<ReIm3*>(pline + k * 3);
+					ReIm3 value = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
 
 					kernel[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = value;
 				}
@@ -1121,12 +1240,18 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
 
-	fftw_free((double*)pline_real);
-	fftw_free((fftw_complex*)pline);
+	for (int tn = 0; tn < OmpThreads; tn++) {
+
+		fftw_free((double*)pline_real[tn]);
+		fftw_free((fftw_complex*)pline[tn]);
+	}
 
 	//Done
 	return error;
@@ -0,0 +1,395 @@
+#include "stdafx.h"
+#include "DemagTreeCode.h"
+
+#include "DemagTFunc.h"
+
+//build tree over non-empty cells of M, interaction lists, and near-field demag tensor
+BError DemagTreeCode::Initialize(VEC_VC<DBL3>& M, double theta_)
+{
+	BError error(__FUNCTION__);
+
+	Clear();
+
+	n = M.n;
+	h = M.h;
+	hRatios = h / maximum(h.x, h.y, h.z);
+	theta = theta_;
+
+	//------------------------ Collect non-empty cells
+
+	int num_cells = M.get_nonempty_cells();
+
+	if (!malloc_vector(cells, num_cells) || !malloc_vector(cells_ijk, num_cells) || !malloc_vector(cells_in, num_cells)) { Clear(); return error(BERROR_OUTOFMEMORY_NCRIT); }
+
+	int cidx = 0;
+	for (int idx = 0; idx < M.linear_size() && cidx < num_cells; idx++) {
+
+		if (M.is_not_empty(idx)) {
+
+			cells[cidx] = idx;
+			cells_ijk[cidx] = INT3(idx % n.x, (idx / n.x) % n.y, idx / (n.x * n.y));
+			cidx++;
+		}
+	}
+
+	if (!num_cells) return error;
+
+	//------------------------ Build tree
+
+	TreeNode root;
+	root.start = 0;
+	root.end = num_cells;
+	nodes.push_back(root);
+
+	Build_Node(0);
+
+	if (!malloc_vector(moment, nodes.size()) || !malloc_vector(quadrupole, nodes.size())) { Clear(); return error(BERROR_OUTOFMEMORY_NCRIT); }
+
+	//------------------------ Interaction lists
+
+	near_list.resize(leaves.size());
+	far_list.resize(leaves.size());
+
+#pragma omp parallel for schedule(dynamic)
+	for (int leaf_idx = 0; leaf_idx < (int)leaves.size(); leaf_idx++) {
+
+		Build_Lists(leaf_idx, 0);
+	}
+
+	//------------------------ Near-field demag tensor
+
+	//largest cell offset between any target leaf and its near-field source leaves
+	near_n = INT3(1, 1, 1);
+
+	for (int leaf_idx = 0; leaf_idx < (int)leaves.size(); leaf_idx++) {
+
+		TreeNode& target = nodes[leaves[leaf_idx]];
+
+		for (int source_idx : near_list[leaf_idx]) {
+
+			TreeNode& source = nodes[source_idx];
+
+			near_n = INT3(
+				maximum(near_n.i, abs(target.cell_max.i - source.cell_min.i) + 1, abs(source.cell_max.i - target.cell_min.i) + 1),
+				maximum(near_n.j, abs(target.cell_max.j - source.cell_min.j) + 1, abs(source.cell_max.j - target.cell_min.j) + 1),
+				maximum(near_n.k, abs(target.cell_max.k - source.cell_min.k) + 1, abs(source.cell_max.k - target.cell_min.k) + 1));
+		}
+	}
+
+	INT3 N = near_n * 2;
+
+	if (!Ddiag.resize(SZ3(N.i, N.j, N.k)) || !Dodiag.resize(SZ3(N.i, N.j, N.k))) { Clear(); return error(BERROR_OUTOFMEMORY_NCRIT); }
+
+	//no need to pass the actual cellsize values, just normalized values will do
+	DemagTFunc dtf;
+
+	if (!dtf.CalcDiagTens3D(Ddiag, near_n, N, hRatios) || !dtf.CalcOffDiagTens3D(Dodiag, near_n, N, hRatios)) { Clear(); return error(BERROR_OUTOFMEMORY_NCRIT); }
+
+	return error;
+}
+
+//free all memory
+void DemagTreeCode::Clear(void)
+{
+	n = SZ3();
+	h = DBL3();
+
+	cells.clear();
+	cells.shrink_to_fit();
+	cells_ijk.clear();
+	cells_ijk.shrink_to_fit();
+	cells_in.clear();
+	cells_in.shrink_to_fit();
+
+	nodes.clear();
+	nodes.shrink_to_fit();
+	leaves.clear();
+	leaves.shrink_to_fit();
+
+	near_list.clear();
+	near_list.shrink_to_fit();
+	far_list.clear();
+	far_list.shrink_to_fit();
+
+	moment.clear();
+	moment.shrink_to_fit();
+	quadrupole.clear();
+	quadrupole.shrink_to_fit();
+
+	Ddiag.clear();
+	Dodiag.clear();
+}
+
+//recursively build tree from given node, splitting it into octants until leaf size criteria are satisfied
+void DemagTreeCode::Build_Node(int node_idx)
+{
+	int start = nodes[node_idx].start;
+	int end = nodes[node_idx].end;
+
+	//bounding box of contained cells
+	INT3 cell_min = cells_ijk[start], cell_max = cells_ijk[start];
+
+	for (int cidx = start + 1; cidx < end; cidx++) {
+
+		cell_min = INT3(minimum(cell_min.i, cells_ijk[cidx].i), minimum(cell_min.j, cells_ijk[cidx].j), minimum(cell_min.k, cells_ijk[cidx].k));
+		cell_max = INT3(maximum(cell_max.i, cells_ijk[cidx].i), maximum(cell_max.j, cells_ijk[cidx].j), maximum(cell_max.k, cells_ijk[cidx].k));
+	}
+
+	INT3 extent = cell_max - cell_min + INT3(1, 1, 1);
+
+	nodes[node_idx].cell_min = cell_min;
+	nodes[node_idx].cell_max = cell_max;
+	nodes[node_idx].centre = DBL3((cell_min.i + cell_max.i + 1) * hRatios.x, (cell_min.j + cell_max.j + 1) * hRatios.y, (cell_min.k + cell_max.k + 1) * hRatios.z) / 2;
+	nodes[node_idx].radius = (DBL3(extent.i, extent.j, extent.k) & hRatios).norm() / 2;
+
+	//leaf?
+	if (end - start <= TREECODE_LEAFCELLS && maximum(extent.i, extent.j, extent.k) <= TREECODE_LEAFEXTENT) {
+
+		leaves.push_back(node_idx);
+		return;
+	}
+
+	//split about bounding box mid-point : along any dimension with extent greater than 1 both halves contain cells, since bounding box is tight
+	INT3 mid = (cell_min + cell_max) / 2;
+
+	auto get_octant = [&](const INT3& ijk) -> int { return (ijk.i > mid.i) + 2 * (ijk.j > mid.j) + 4 * (ijk.k > mid.k); };
+
+	//sort cells in this node by octant (counting sort)
+	int octant_count[8] = {};
+	for (int cidx = start; cidx < end; cidx++) octant_count[get_octant(cells_ijk[cidx])]++;
+
+	int octant_start[8];
+	octant_start[0] = 0;
+	for (int oct = 1; oct < 8; oct++) octant_start[oct] = octant_start[oct - 1] + octant_count[oct - 1];
+
+	std::vector<int> sorted_cells(end - start);
+	std::vector<INT3> sorted_cells_ijk(end - start);
+
+	int octant_fill[8];
+	std::copy(octant_start, octant_start + 8, octant_fill);
+
+	for (int cidx = start; cidx < end; cidx++) {
+
+		int oct = get_octant(cells_ijk[cidx]);
+
+		sorted_cells[octant_fill[oct]] = cells[cidx];
+		sorted_cells_ijk[octant_fill[oct]] = cells_ijk[cidx];
+		octant_fill[oct]++;
+	}
+
+	std::copy(sorted_cells.begin(), sorted_cells.end(), cells.begin() + start);
+	std::copy(sorted_cells_ijk.begin(), sorted_cells_ijk.end(), cells_ijk.begin() + start);
+
+	//make children for non-empty octants (stored contiguously), then build them
+	int first_child = nodes.size();
+	int num_children = 0;
+
+	for (int oct = 0; oct < 8; oct++) {
+
+		if (!octant_count[oct]) continue;
+
+		TreeNode child;
+		child.start = start + octant_start[oct];
+		child.end = child.start + octant_count[oct];
+		nodes.push_back(child);
+
+		num_children++;
+	}
+
+	nodes[node_idx].first_child = first_child;
+	nodes[node_idx].num_children = num_children;
+
+	for (int child_idx = first_child; child_idx < first_child + num_children; child_idx++) Build_Node(child_idx);
+}
+
+//recursively build interaction lists for given leaf, starting at given source node
+void DemagTreeCode::Build_Lists(int leaf_idx, int node_idx)
+{
+	TreeNode& target = nodes[leaves[leaf_idx]];
+	TreeNode& source = nodes[node_idx];
+
+	//closest distance from a target cell centre to the source node centre
+	double distance = (source.centre - target.centre).norm() - target.radius;
+
+	//well-separated : use multipole expansion
+	if (distance > 0.0 && source.radius < theta * distance) far_list[leaf_idx].push_back(node_idx);
+	//leaf too close : use exact tensor
+	else if (!source.num_children) near_list[leaf_idx].push_back(node_idx);
+	//too close but can be refined
+	else {
+
+		for (int child_idx = source.first_child; child_idx < source.first_child + source.num_children; child_idx++) Build_Lists(leaf_idx, child_idx);
+	}
+}
+
+//far-field contribution at relative position R from the centre of given source node
+DBL3 DemagTreeCode::FarField(const DBL3& R, int node_idx)
+{
+	const DBL3& m = moment[node_idx];
+	const DBL33& Q = quadrupole[node_idx];
+
+	double R2 = R * R;
+	double R3inv = 1.0 / (R2 * sqrt(R2));
+	double R5inv = R3inv / R2;
+
+	//dipole term : G * m, with G_ab = (3 R_a R_b / R^5 - delta_ab / R^3) / 4pi
+	DBL3 H = (3 * (m * R) * R5inv) * R - m * R3inv;
+
+	//quadrupole term : -dG_ab/dR_c * Q_bc
+	DBL3 QR = Q * R;
+	double trQ = Q.x.x + Q.y.y + Q.z.z;
+
+	H -= (3 * R5inv) * ((Q | R) + QR + trQ * R) - (15 * (R * QR) * R5inv / R2) * R;
+
+	return H / (4 * PI);
+}
+
+//set input values in tree order and compute multipole expansions for all nodes (upward pass)
+template <typename GetInput>
+void DemagTreeCode::Compute_Expansions(GetInput get_input)
+{
+	//normalized cell volume
+	double volume = hRatios.x * hRatios.y * hRatios.z;
+
+	//leaves
+#pragma omp parallel for
+	for (int leaf_idx = 0; leaf_idx < (int)leaves.size(); leaf_idx++) {
+
+		int node_idx = leaves[leaf_idx];
+		TreeNode& node = nodes[node_idx];
+
+		DBL3 m0 = DBL3();
+		DBL33 Q = DBL33();
+
+		for (int cidx = node.start; cidx < node.end; cidx++) {
+
+			cells_in[cidx] = get_input(cells[cidx]);
+
+			DBL3 m = cells_in[cidx] * volume;
+			m0 += m;
+			Q += m | (cell_position(cells_ijk[cidx]) - node.centre);
+		}
+
+		moment[node_idx] = m0;
+		quadrupole[node_idx] = Q;
+	}
+
+	//internal nodes : children always have larger indexes than their parent, so traversing in reverse order they are ready when needed
+	for (int node_idx = (int)nodes.size() - 1; node_idx >= 0; node_idx--) {
+
+		TreeNode& node = nodes[node_idx];
+		if (!node.num_children) continue;
+
+		DBL3 m0 = DBL3();
+		DBL33 Q = DBL33();
+
+		for (int child_idx = node.first_child; child_idx < node.first_child + node.num_children; child_idx++) {
+
+			//shift child expansion to parent centre
+			m0 += moment[child_idx];
+			Q += quadrupole[child_idx] + (moment[child_idx] | (nodes[child_idx].centre - node.centre));
+		}
+
+		moment[node_idx] = m0;
+		quadrupole[node_idx] = Q;
+	}
+}
+
+//evaluate field at all non-empty cells for given input / output access. Return dot product of input with output. Also set pH and penergy if given, as for convolution methods.
+template <typename GetInput, typename SetOutput>
+double DemagTreeCode::Evaluate(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	if (!leaves.size()) return 0.0;
+
+	Compute_Expansions(get_input);
+
+	int I = Ddiag.n.x;
+	int J = Ddiag.n.y;
+	int K = Ddiag.n.z;
+
+	double dot_product = 0.0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+:dot_product)
+	for (int leaf_idx = 0; leaf_idx < (int)leaves.size(); leaf_idx++) {
+
+		TreeNode& target = nodes[leaves[leaf_idx]];
+		std::vector<int>& near_sources = near_list[leaf_idx];
+		std::vector<int>& far_sources = far_list[leaf_idx];
+
+		for (int tidx = target.start; tidx < target.end; tidx++) {
+
+			INT3 ijk = cells_ijk[tidx];
+			DBL3 Out_val = DBL3();
+
+			//near field : exact tensor
+			for (int sidx = 0; sidx < near_sources.size(); sidx++) {
+
+				TreeNode& source = nodes[near_sources[sidx]];
+
+				for (int cidx = source.start; cidx < source.end; cidx++) {
+
+					INT3 offset = ijk - cells_ijk[cidx];
+					int tens_idx = ((offset.i + I) % I) + ((offset.j + J) % J) * I + ((offset.k + K) % K) * I * J;
+
+					DBL3& D = Ddiag[tens_idx];
+					DBL3& OD = Dodiag[tens_idx];
+					DBL3& In_val = cells_in[cidx];
+
+					Out_val += DBL3(
+						D.x * In_val.x + OD.x * In_val.y + OD.y * In_val.z,
+						OD.x * In_val.x + D.y * In_val.y + OD.z * In_val.z,
+						OD.y * In_val.x + OD.z * In_val.y + D.z * In_val.z);
+				}
+			}
+
+			//far field : multipole expansions
+			DBL3 position = cell_position(ijk);
+
+			for (int sidx = 0; sidx < far_sources.size(); sidx++) {
+
+				Out_val += FarField(position - nodes[far_sources[sidx]].centre, far_sources[sidx]);
+			}
+
+			int idx = cells[tidx];
+			DBL3& In_val = cells_in[tidx];
+
+			set_output(idx, Out_val);
+
+			dot_product += In_val * Out_val;
+
+			if (pH) (*pH)[idx] = Out_val;
+			if (penergy) (*penergy)[idx] = -MU0 * (In_val * Out_val) / 2;
+		}
+	}
+
+	return dot_product;
+}
+
+//Evaluate demag field for non-empty cells (Out values in empty cells are not changed). Return dot product of In with Out.
+double DemagTreeCode::Evaluate(VEC<DBL3>& In, VEC<DBL3>& Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	return Evaluate(
+		[&](int idx) -> DBL3 { return In[idx]; },
+		[&](int idx, const DBL3& value) { if (clearOut) Out[idx] = value; else Out[idx] += value; },
+		pH, penergy);
+}
+
+//As above, but input is (In1 + In2) / 2
+double DemagTreeCode::Evaluate_AveragedInputs(VEC<DBL3>& In1, VEC<DBL3>& In2, VEC<DBL3>& Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	return Evaluate(
+		[&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; },
+		[&](int idx, const DBL3& value) { if (clearOut) Out[idx] = value; else Out[idx] += value; },
+		pH, penergy);
+}
+
+//As above, but output set in both Out1 and Out2
+double DemagTreeCode::Evaluate_AveragedInputs_DuplicatedOutputs(VEC<DBL3>& In1, VEC<DBL3>& In2, VEC<DBL3>& Out1, VEC<DBL3>& Out2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	return Evaluate(
+		[&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; },
+		[&](int idx, const DBL3& value) {
+			if (clearOut) { Out1[idx] = value; Out2[idx] = value; }
+			else { Out1[idx] += value; Out2[idx] += value; } },
+		pH, penergy);
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "BorisLib.h"
+#include "ErrorHandler.h"
+
+//default opening angle for tree-code demag evaluation
+#define TREECODE_THETA	0.5
+
+//maximum number of cells in a tree leaf
+#define TREECODE_LEAFCELLS	16
+
+//maximum extent of a tree leaf (number of cells along any dimension)
+#define TREECODE_LEAFEXTENT	8
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Hierarchical (tree-code) evaluation of the demagnetizing field : alternative to FFT convolution for sparse geometries (mostly empty meshes).
+//
+//	An octree is built over the non-empty cells only, so computation cost scales with the number of magnetic cells rather than the mesh volume.
+//	Near-field cell-cell interactions use the exact demag tensor (DemagTFunc, as for the FFT kernels). Well-separated clusters of cells are treated using their dipole and quadrupole moments.
+//	A source node is well-separated from a target leaf if (source radius) < theta * (distance between centres - target radius), where theta is the opening angle : smaller values are more accurate.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class DemagTreeCode {
+
+	struct TreeNode {
+
+		//range of cells (in tree order) contained in this node
+		int start = 0, end = 0;
+
+		//children are stored contiguously from first_child; node is a leaf if it has no children
+		int first_child = -1, num_children = 0;
+
+		//bounding box of contained cells (cell indexes)
+		INT3 cell_min, cell_max;
+
+		//centre of bounding box and radius enclosing all contained cells (normalized units)
+		DBL3 centre;
+		double radius = 0.0;
+	};
+
+private:
+
+	//mesh dimensions and cellsize for which the tree was built
+	SZ3 n;
+	DBL3 h;
+
+	//normalized cellsize (h divided by largest component), as used for demag tensor calculations
+	DBL3 hRatios;
+
+	//opening angle
+	double theta = TREECODE_THETA;
+
+	//mesh indexes of non-empty cells in tree order, such that each node contains a contiguous range
+	std::vector<int> cells;
+
+	//cell indexes (i, j, k) of cells, in tree order
+	std::vector<INT3> cells_ijk;
+
+	//input values (e.g. magnetization) of cells, in tree order - set at the start of each evaluation
+	std::vector<DBL3> cells_in;
+
+	//tree nodes : root at index 0, and children always have larger indexes than their parent
+	std::vector<TreeNode> nodes;
+
+	//node indexes of leaves
+	std::vector<int> leaves;
+
+	//for each leaf : near-field source leaves (exact tensor) and far-field source nodes (multipole expansions)
+	std::vector<std::vector<int>> near_list, far_list;
+
+	//multipole expansions for each node : total moment and first moment of distribution about node centre (Q_bc = sum of m_b * d_c with d cell displacement from centre)
+	std::vector<DBL3> moment;
+	std::vector<DBL33> quadrupole;
+
+	//near-field demag tensor (-N), diagonal and off-diagonal (xy, xz, yz) elements, for offsets up to near_n - 1, with wrap-around indexing on a 2 * near_n grid (as for FFT kernels)
+	INT3 near_n;
+	VEC<DBL3> Ddiag, Dodiag;
+
+private:
+
+	//position of cell centre in normalized units
+	DBL3 cell_position(const INT3& ijk) { return DBL3((ijk.i + 0.5) * hRatios.x, (ijk.j + 0.5) * hRatios.y, (ijk.k + 0.5) * hRatios.z); }
+
+	//recursively build tree from given node, splitting it into octants until leaf size criteria are satisfied
+	void Build_Node(int node_idx);
+
+	//recursively build interaction lists for given leaf, starting at given source node
+	void Build_Lists(int leaf_idx, int node_idx);
+
+	//far-field contribution at relative position R from the centre of given source node
+	DBL3 FarField(const DBL3& R, int node_idx);
+
+	//set input values in tree order and compute multipole expansions for all nodes (upward pass)
+	template <typename GetInput>
+	void Compute_Expansions(GetInput get_input);
+
+	//evaluate field at all non-empty cells for given input / output access. Return dot product of input with output. Also set pH and penergy if given, as for convolution methods.
+	template <typename GetInput, typename SetOutput>
+	double Evaluate(GetInput get_input, SetOutput set_output, VEC<DBL3>* pH, VEC<double>* penergy);
+
+public:
+
+	DemagTreeCode(void) {}
+	~DemagTreeCode() {}
+
+	//build tree over non-empty cells of M, interaction lists, and near-field demag tensor
+	BError Initialize(VEC_VC<DBL3>& M, double theta_);
+
+	//free all memory
+	void Clear(void);
+
+	//check if tree was built for given mesh dimensions
+	bool CheckDimensions(SZ3 n_, DBL3 h_) { return n == n_ && h == h_; }
+
+	//Evaluate demag field for non-empty cells (Out values in empty cells are not changed). Return dot product of In with Out.
+	double Evaluate(VEC<DBL3>& In, VEC<DBL3>& Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr);
+
+	//As above, but input is (In1 + In2) / 2
+	double Evaluate_AveragedInputs(VEC<DBL3>& In1, VEC<DBL3>& In2, VEC<DBL3>& Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr);
+
+	//As above, but output set in both Out1 and Out2
+	double Evaluate_AveragedInputs_DuplicatedOutputs(VEC<DBL3>& In1, VEC<DBL3>& In2, VEC<DBL3>& Out1, VEC<DBL3>& Out2, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr);
+};
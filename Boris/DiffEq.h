@@ -16,6 +16,8 @@
 #include "DiffEqAFMCUDA.h"
 #endif
 
+class CheckpointFile;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Abstract base class for DifferentialEquation type objects, e.g. for ferromagnetic or antiferromagnetic meshes.
@@ -70,6 +72,15 @@ protected:
 	DifferentialEquationCUDA *pmeshODECUDA = nullptr;
 #endif
 
+	//active set : for each block of ODE_EVALBLOCK cells, number of time steps remaining before frozen block is re-checked (0 if block is active)
+	std::vector<int> activeset_frozen;
+
+	//active set : blocks with torque above activeset_tolerance at last update (frozen neighbouring blocks are reactivated)
+	std::vector<char> activeset_hot;
+
+	//active set : cells whose skip cell flag was set by the active set (other skip cells, e.g. moving mesh ends, are left untouched)
+	std::vector<char> activeset_skipcells;
+
 protected:
 
 	//---------------------------------------- SOLVER METHODS : DiffEq_Evals.cpp
@@ -177,6 +188,25 @@ protected:
 	virtual void RunRKDP54_Step5(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	virtual void RunLSRK43_Step0_withReductions(void) = 0;
+	virtual void RunLSRK43_Step0(void) = 0;
+	virtual void RunLSRK43_Step1(void) = 0;
+	virtual void RunLSRK43_Step2(void) = 0;
+	virtual void RunLSRK43_Step3(void) = 0;
+	virtual void RunLSRK43_Step4_withReductions(void) = 0;
+	virtual void RunLSRK43_Step4(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	virtual void RunROS2_Step0_withReductions(void) = 0;
+	virtual void RunROS2_Step0(void) = 0;
+	virtual void RunROS2_Step1_withReductions(void) = 0;
+	virtual void RunROS2_Step1(void) = 0;
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	virtual void RunSD_Start(void) = 0;
@@ -189,6 +219,31 @@ protected:
 	virtual void RunSD_Advance(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	virtual void RunNCG_Gradient_withReductions(void) = 0;
+	virtual void RunNCG_Gradient(void) = 0;
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	virtual void RunNCG_Direction(double beta) = 0;
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	virtual void RunNCG_Advance(void) = 0;
+#endif
+
+	//---------------------------------------- ACTIVE SET : DiffEq_ActiveSet.cpp
+
+	//update active set at the start of a time step : freeze blocks with maximum torque below activeset_tolerance for activeset_steps time steps (cells in frozen blocks marked as skip cells),
+	//re-check frozen blocks when their countdown expires, and reactivate frozen blocks next to active blocks. Return true if any cells were frozen or reactivated.
+	bool Update_ActiveSet(void);
+
+	//reactivate all blocks and clear skip cell flags set by the active set
+	void Clear_ActiveSet(void);
+
+	//clear (suspend = true) or set again (suspend = false) skip cell flags in frozen blocks, keeping the active set state : used so flags are not saved with the magnetization
+	void Suspend_ActiveSet(bool suspend);
+
+	//all cells in frozen blocks are skipped, so block evaluation can be bypassed
+	bool Is_Block_Frozen(int block) { return block < (int)activeset_frozen.size() && activeset_frozen[block] > 0; }
+
 	//---------------------------------------- OTHERS
 
 	//Restore magnetization after a failed step for adaptive time-step methods
@@ -197,6 +252,9 @@ protected:
 	//renormalize vectors to set magnetization length value (which could have a spatial variation)
 	virtual void RenormalizeMagnetization(void) = 0;
 
+	//save, verify or load evaluation scratch spaces, thermal fields and random number generator state in binary checkpoint (chunk names start with given prefix)
+	virtual void Checkpoint_State(CheckpointFile& cpt, std::string prefix);
+
 	//---------------------------------------- OTHER CALCULATION METHODS
 
 	//called when using stochastic equations
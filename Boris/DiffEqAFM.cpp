@@ -4,6 +4,7 @@
 #ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
 
 #include "Mesh_AntiFerromagnetic.h"
+#include "CheckpointFile.h"
 
 DifferentialEquationAFM::DifferentialEquationAFM(AFMesh *pMesh) :
 	DifferentialEquation(pMesh)
@@ -13,6 +14,9 @@ DifferentialEquationAFM::DifferentialEquationAFM(AFMesh *pMesh) :
 	OmpThreads = omp_get_num_procs();
 
 	Equation_Eval_2.resize(OmpThreads);
+
+	eval_blocks.resize(OmpThreads);
+	eval_blocks_2.resize(OmpThreads);
 }
 
 DifferentialEquationAFM::~DifferentialEquationAFM()
@@ -49,6 +53,25 @@ void DifferentialEquationAFM::RenormalizeMagnetization(void)
 	}
 }
 
+//checkpoint also includes sub-lattice B scratch spaces and thermal fields
+void DifferentialEquationAFM::Checkpoint_State(CheckpointFile& cpt, std::string prefix)
+{
+	DifferentialEquation::Checkpoint_State(cpt, prefix);
+
+	cpt.vec(prefix + "sM1_2", sM1_2);
+
+	cpt.vec(prefix + "sEval0_2", sEval0_2);
+	cpt.vec(prefix + "sEval1_2", sEval1_2);
+	cpt.vec(prefix + "sEval2_2", sEval2_2);
+	cpt.vec(prefix + "sEval3_2", sEval3_2);
+	cpt.vec(prefix + "sEval4_2", sEval4_2);
+	cpt.vec(prefix + "sEval5_2", sEval5_2);
+	cpt.vec(prefix + "sEval6_2", sEval6_2);
+
+	cpt.vec(prefix + "H_Thermal_2", H_Thermal_2);
+	cpt.vec(prefix + "Torque_Thermal_2", Torque_Thermal_2);
+}
+
 //---------------------------------------- SET-UP METHODS
 
 BError DifferentialEquationAFM::AllocateMemory(void)
@@ -153,10 +176,32 @@ BError DifferentialEquationAFM::AllocateMemory(void)
 		if (!sEval6_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK43:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_ROS2:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!implicit_exchange.resize(pMesh->M)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!implicit_exchange_2.resize(pMesh->M2)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -203,9 +248,12 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 		sEval0_2.clear();
@@ -216,13 +264,19 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 		sEval1_2.clear();
 	}
 
+	//LSRK43 only uses sEval1 for the error estimate (evaluated on sub-lattice A)
+	if (evalMethod == EVAL_LSRK43) sEval1_2.clear();
+
 	if (evalMethod != EVAL_RK4 &&
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
@@ -259,6 +313,12 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		sEval6_2.clear();
 	}
 
+	if (evalMethod != EVAL_ROS2) {
+
+		implicit_exchange.clear();
+		implicit_exchange_2.clear();
+	}
+
 	//For thermal vecs only clear if not used for current set ODE
 	if (setODE != ODE_SLLG &&
 		setODE != ODE_SLLGSTT &&
@@ -293,6 +353,9 @@ BError DifferentialEquationAFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE, UPDATECONFIG_ODE_SOLVER)) {
 
+		//active set blocks no longer valid
+		Clear_ActiveSet();
+
 		if (pMesh->link_stochastic) {
 
 			pMesh->h_s = pMesh->h;
@@ -310,6 +373,12 @@ BError DifferentialEquationAFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		error = AllocateMemory();
 	}
 
+	//implicit exchange solvers must have same shape as magnetization
+	if (evalMethod == EVAL_ROS2 && cfgMessage == UPDATECONFIG_MESHSHAPECHANGE) {
+
+		if (!implicit_exchange.resize(pMesh->M) || !implicit_exchange_2.resize(pMesh->M2)) error(BERROR_OUTOFMEMORY_CRIT);
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_ODE_MOVEMESH)) {
 
 		/*
@@ -342,6 +411,9 @@ BError DifferentialEquationAFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	if (cfgMessage == UPDATECONFIG_PARAMVALUECHANGED_MLENGTH) RenormalizeMagnetization();
 
+	//parameters read in every cell by the equations : cache them if they must be evaluated per cell
+	pMesh->request_parameter_cache(pMesh->Ms_AFM, pMesh->alpha_AFM, pMesh->grel_AFM, pMesh->susrel_AFM, pMesh->P, pMesh->beta, pMesh->A_AFM);
+
 	//----------------------- CUDA mirroring
 
 #if COMPILECUDA == 1
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "DiffEq.h"
+#include "DiffEq_EvalBlock.h"
+#include "DiffEq_Implicit.h"
 
 class AFMesh;
 
@@ -37,6 +39,25 @@ private:
 	//The additional sub-lattice B value is set here so we can read it
 	std::vector<DBL3> Equation_Eval_2;
 
+	//structure-of-arrays evaluation blocks for sub-lattices A and B, one for each OpenMP thread
+	std::vector<ODEEvalBlock> eval_blocks, eval_blocks_2;
+
+	//linear solvers for implicit exchange on sub-lattices A and B (ROS2 evaluation method only)
+	ODEImplicitExchange implicit_exchange, implicit_exchange_2;
+
+private:
+
+	//---------------------------------------- EQUATION HELPERS : DiffEqAFM_Equations.cpp
+
+	//Zhang-Li STT contribution to LLG on both sub-lattices, using material parameters already obtained for this cell
+	void STT_Torque(int idx, const DBL2& Ms_AFM, const DBL2& alpha_AFM, double P, double beta, DBL3& STT_A, DBL3& STT_B);
+
+	//LLB coefficients for given cell on both sub-lattices (i for A, j for B), such that LLB evaluates to a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M
+	void LLB_Coefficients(int idx, DBL2& a, DBL2& b, DBL2& c, DBL2& d);
+
+	//implicit exchange solver coefficients for given cell on sub-lattices A and B (ROS2), using LLG form equation coefficients for the current time step
+	void ROS2_Exchange_Coefficients(int idx, DBL2& coeff_A, DBL2& coeff_B);
+
 public:
 
 	DifferentialEquationAFM(AFMesh *pMesh);
@@ -147,6 +168,25 @@ public:
 	void RunRKDP54_Step5(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void);
+	void RunLSRK43_Step0(void);
+	void RunLSRK43_Step1(void);
+	void RunLSRK43_Step2(void);
+	void RunLSRK43_Step3(void);
+	void RunLSRK43_Step4_withReductions(void);
+	void RunLSRK43_Step4(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void);
+	void RunROS2_Step0(void);
+	void RunROS2_Step1_withReductions(void);
+	void RunROS2_Step1(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void);
@@ -159,6 +199,16 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void);
+	void RunNCG_Gradient(void);
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta);
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -188,6 +238,18 @@ public:
 	//Stochastic Landau-Lifshitz-Bloch equation with Zhang-Li STT
 	DBL3 SLLBSTT(int idx);
 
+	//---------------------------------------- BLOCK EVALUATION : DiffEqAFM_BlockEquations.cpp
+
+	//number of blocks of ODE_EVALBLOCK cells covering the mesh
+	int Num_Eval_Blocks(void);
+
+	//evaluate set equation for all cells in given block, using the evaluation blocks of the calling thread, and return the sub-lattice A block so evaluations can be read
+	//the sub-lattice B block is obtained with Equation_Block_2. Empty and skipped cells evaluate to zero.
+	ODEEvalBlock& Evaluate_Equation_Block(int block);
+
+	//sub-lattice B evaluation block of the calling thread, set by Evaluate_Equation_Block
+	ODEEvalBlock& Equation_Block_2(void) { return eval_blocks_2[omp_get_thread_num()]; }
+
 	//---------------------------------------- OTHERS : DiffEqFM.cpp
 
 	void RestoreMagnetization(void);
@@ -195,6 +257,9 @@ public:
 	//renormalize vectors to set magnetization length value (which could have a spatial variation)
 	void RenormalizeMagnetization(void);
 
+	//checkpoint also includes sub-lattice B scratch spaces and thermal fields
+	void Checkpoint_State(CheckpointFile& cpt, std::string prefix);
+
 	//---------------------------------------- OTHER CALCULATION METHODS : DiffEqFM_SEquations.cpp
 
 	//called when using stochastic equations
@@ -342,6 +407,25 @@ public:
 	void RunRKDP54_Step5(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void) {}
+	void RunLSRK43_Step0(void) {}
+	void RunLSRK43_Step1(void) {}
+	void RunLSRK43_Step2(void) {}
+	void RunLSRK43_Step3(void) {}
+	void RunLSRK43_Step4_withReductions(void) {}
+	void RunLSRK43_Step4(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void) {}
@@ -354,6 +438,16 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void) {}
+	void RunNCG_Gradient(void) {}
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta) {}
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
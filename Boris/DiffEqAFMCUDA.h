@@ -137,6 +137,12 @@ public:
 	//deallocate memory before re-allocating it (depending on evaluation method previously allocated memory might not be used again, so need clean-up before)
 	void CleanupMemory(bool copy_to_cpu = false);
 
+	//copy evaluation scratch spaces to cpu memory without changing gpu memory (e.g. for saving a checkpoint while running)
+	void CopyMemory_to_cpu(void);
+
+	//copy evaluation scratch spaces from cpu memory to gpu memory without reallocating (e.g. after loading a checkpoint)
+	void CopyMemory_to_gpu(void);
+
 	void SetODEMethodPointers(void);
 
 	BError UpdateConfiguration(UPDATECONFIG_ cfgMessage);
@@ -276,6 +282,12 @@ public:
 	//deallocate memory before re-allocating it (depending on evaluation method previously allocated memory might not be used again, so need clean-up before)
 	void CleanupMemory(bool copy_to_cpu = false) {}
 
+	//copy evaluation scratch spaces to cpu memory without changing gpu memory (e.g. for saving a checkpoint while running)
+	void CopyMemory_to_cpu(void) {}
+
+	//copy evaluation scratch spaces from cpu memory to gpu memory without reallocating (e.g. after loading a checkpoint)
+	void CopyMemory_to_gpu(void) {}
+
 	void SetODEMethodPointers(void) {}
 
 	BError UpdateConfiguration(UPDATECONFIG_ cfgMessage) { return BError(); }
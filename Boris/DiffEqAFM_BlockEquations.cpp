@@ -0,0 +1,210 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//------------------------------------------------------------------------------------------------------
+
+//number of blocks of ODE_EVALBLOCK cells covering the mesh
+int DifferentialEquationAFM::Num_Eval_Blocks(void)
+{
+	return (pMesh->n.dim() + ODE_EVALBLOCK - 1) / ODE_EVALBLOCK;
+}
+
+//evaluate set equation for all cells in given block, using the evaluation blocks of the calling thread, and return the sub-lattice A block so evaluations can be read
+//LLG, LLB and stochastic LLG type equations are evaluated using the vectorized kernels in ODEEvalBlock, with per-cell coefficients only if material parameters are not uniform. Other equations are evaluated cell by cell.
+ODEEvalBlock& DifferentialEquationAFM::Evaluate_Equation_Block(int block)
+{
+	int tn = omp_get_thread_num();
+
+	ODEEvalBlock& eval_block = eval_blocks[tn];
+	ODEEvalBlock& eval_block_2 = eval_blocks_2[tn];
+	eval_block.set_range(block, pMesh->n.dim());
+	eval_block_2.set_range(block, pMesh->n.dim());
+
+	auto is_evaluated = [&](int idx) -> bool { return pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx); };
+
+	//all cells in blocks frozen by the active set are skipped
+	if (Is_Block_Frozen(block)) {
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			eval_block.clear(idx);
+			eval_block_2.clear(idx);
+		}
+
+		return eval_block;
+	}
+
+	//load cells to evaluate : empty and skipped cells are cleared so they evaluate to zero
+	for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+		if (is_evaluated(idx)) {
+
+			eval_block.load(idx, pMesh->M[idx], pMesh->Heff[idx]);
+			eval_block_2.load(idx, pMesh->M2[idx], pMesh->Heff2[idx]);
+		}
+		else {
+
+			eval_block.clear(idx);
+			eval_block_2.clear(idx);
+		}
+	}
+
+	switch (setODE) {
+
+	case ODE_LLG:
+	case ODE_LLGSA:
+	case ODE_LLGSTT:
+	{
+		if (pMesh->is_uniform_parameters(pMesh->Ms_AFM, pMesh->alpha_AFM, pMesh->grel_AFM)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 alpha_AFM = pMesh->alpha_AFM;
+			DBL2 grel_AFM = pMesh->grel_AFM;
+
+			DBL2 a = DBL2(-GAMMA * grel_AFM.i / (1 + alpha_AFM.i * alpha_AFM.i), -GAMMA * grel_AFM.j / (1 + alpha_AFM.j * alpha_AFM.j));
+			eval_block.Evaluate_Transverse(a.i, a.i * alpha_AFM.i / Ms_AFM.i);
+			eval_block_2.Evaluate_Transverse(a.j, a.j * alpha_AFM.j / Ms_AFM.j);
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 alpha_AFM = pMesh->alpha_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->grel_AFM, grel_AFM);
+
+				DBL2 a = DBL2(-GAMMA * grel_AFM.i / (1 + alpha_AFM.i * alpha_AFM.i), -GAMMA * grel_AFM.j / (1 + alpha_AFM.j * alpha_AFM.j));
+				eval_block.set_coefficients(idx, a.i, a.i * alpha_AFM.i / Ms_AFM.i);
+				eval_block_2.set_coefficients(idx, a.j, a.j * alpha_AFM.j / Ms_AFM.j);
+			}
+
+			eval_block.Evaluate_Transverse();
+			eval_block_2.Evaluate_Transverse();
+		}
+
+		if (setODE == ODE_LLGSTT && pMesh->E.linear_size()) {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 alpha_AFM = pMesh->alpha_AFM;
+				double P = pMesh->P;
+				double beta = pMesh->beta;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->P, P, pMesh->beta, beta);
+
+				DBL3 STT_A, STT_B;
+				STT_Torque(idx, Ms_AFM, alpha_AFM, P, beta, STT_A, STT_B);
+
+				eval_block.add(idx, STT_A);
+				eval_block_2.add(idx, STT_B);
+			}
+		}
+	}
+	break;
+
+	case ODE_LLGSTATIC:
+	case ODE_LLGSTATICSA:
+	{
+		if (pMesh->is_uniform_parameters(pMesh->Ms_AFM, pMesh->grel_AFM)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 grel_AFM = pMesh->grel_AFM;
+
+			eval_block.Evaluate_Transverse(0.0, -GAMMA * grel_AFM.i / (2 * Ms_AFM.i));
+			eval_block_2.Evaluate_Transverse(0.0, -GAMMA * grel_AFM.j / (2 * Ms_AFM.j));
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+				eval_block.set_coefficients(idx, 0.0, -GAMMA * grel_AFM.i / (2 * Ms_AFM.i));
+				eval_block_2.set_coefficients(idx, 0.0, -GAMMA * grel_AFM.j / (2 * Ms_AFM.j));
+			}
+
+			eval_block.Evaluate_Transverse();
+			eval_block_2.Evaluate_Transverse();
+		}
+	}
+	break;
+
+	case ODE_SLLG:
+	case ODE_SLLGSA:
+	{
+		//thermal fields include damping contribution not included when H_Thermal was generated, so always needs per-cell values
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 alpha_AFM = pMesh->alpha_AFM;
+			DBL2 grel_AFM = pMesh->grel_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->grel_AFM, grel_AFM);
+
+			DBL3 position = pMesh->M.cellidx_to_position(idx);
+			eval_block.add_field(idx, H_Thermal[position] * sqrt(alpha_AFM.i));
+			eval_block_2.add_field(idx, H_Thermal_2[position] * sqrt(alpha_AFM.j));
+
+			DBL2 a = DBL2(-GAMMA * grel_AFM.i / (1 + alpha_AFM.i * alpha_AFM.i), -GAMMA * grel_AFM.j / (1 + alpha_AFM.j * alpha_AFM.j));
+			eval_block.set_coefficients(idx, a.i, a.i * alpha_AFM.i / Ms_AFM.i);
+			eval_block_2.set_coefficients(idx, a.j, a.j * alpha_AFM.j / Ms_AFM.j);
+		}
+
+		eval_block.Evaluate_Transverse();
+		eval_block_2.Evaluate_Transverse();
+	}
+	break;
+
+	case ODE_LLB:
+	case ODE_LLBSA:
+	{
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			DBL2 a, b, c, d;
+			LLB_Coefficients(idx, a, b, c, d);
+
+			eval_block.set_coefficients(idx, a.i, b.i, c.i, d.i);
+			eval_block_2.set_coefficients(idx, a.j, b.j, c.j, d.j);
+		}
+
+		eval_block.Evaluate_Full();
+		eval_block_2.Evaluate_Full();
+	}
+	break;
+
+	default:
+	{
+		//no block form for this equation : evaluate cell by cell
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			eval_block.add(idx, CALLFP(this, equation)(idx));
+			eval_block_2.add(idx, Equation_Eval_2[tn]);
+		}
+	}
+	break;
+	}
+
+	return eval_block;
+}
+
+#endif
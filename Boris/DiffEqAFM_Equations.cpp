@@ -70,24 +70,11 @@ DBL3 DifferentialEquationAFM::LLGSTT(int idx)
 
 	if (pMesh->E.linear_size()) {
 
-		DBL33 grad_M_A = pMesh->M.grad_neu(idx);
-		DBL33 grad_M_B = pMesh->M2.grad_neu(idx);
-
-		DBL3 position = pMesh->M.cellidx_to_position(idx);
+		DBL3 STT_A, STT_B;
+		STT_Torque(idx, Ms_AFM, alpha_AFM, P, beta, STT_A, STT_B);
 
-		DBL3 u_A = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.i * (1 + beta * beta));
-		DBL3 u_B = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.j * (1 + beta * beta));
-
-		DBL3 u_dot_del_M_A = (u_A.x * grad_M_A.x) + (u_A.y * grad_M_A.y) + (u_A.z * grad_M_A.z);
-		DBL3 u_dot_del_M_B = (u_B.x * grad_M_B.x) + (u_B.y * grad_M_B.y) + (u_B.z * grad_M_B.z);
-
-		LLGSTT_Eval_A +=
-			(((1 + alpha_AFM.i * alpha_AFM.i) * u_dot_del_M_A) -
-			((beta - alpha_AFM.i) * ((pMesh->M[idx] / Ms_AFM.i) ^ u_dot_del_M_A))) / (1 + alpha_AFM.i * alpha_AFM.i);
-
-		LLGSTT_Eval_B +=
-			(((1 + alpha_AFM.j * alpha_AFM.j) * u_dot_del_M_B) -
-			((beta - alpha_AFM.j) * ((pMesh->M2[idx] / Ms_AFM.j) ^ u_dot_del_M_B))) / (1 + alpha_AFM.j * alpha_AFM.j);
+		LLGSTT_Eval_A += STT_A;
+		LLGSTT_Eval_B += STT_B;
 	}
 
 	//sub-lattice B value so we can read it after
@@ -99,10 +86,52 @@ DBL3 DifferentialEquationAFM::LLGSTT(int idx)
 
 //------------------------------------------------------------------------------------------------------
 
+//Zhang-Li STT contribution to LLG on both sub-lattices, using material parameters already obtained for this cell
+void DifferentialEquationAFM::STT_Torque(int idx, const DBL2& Ms_AFM, const DBL2& alpha_AFM, double P, double beta, DBL3& STT_A, DBL3& STT_B)
+{
+	DBL33 grad_M_A = pMesh->M.grad_neu(idx);
+	DBL33 grad_M_B = pMesh->M2.grad_neu(idx);
+
+	DBL3 position = pMesh->M.cellidx_to_position(idx);
+
+	DBL3 u_A = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.i * (1 + beta * beta));
+	DBL3 u_B = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.j * (1 + beta * beta));
+
+	DBL3 u_dot_del_M_A = (u_A.x * grad_M_A.x) + (u_A.y * grad_M_A.y) + (u_A.z * grad_M_A.z);
+	DBL3 u_dot_del_M_B = (u_B.x * grad_M_B.x) + (u_B.y * grad_M_B.y) + (u_B.z * grad_M_B.z);
+
+	STT_A =
+		(((1 + alpha_AFM.i * alpha_AFM.i) * u_dot_del_M_A) -
+		((beta - alpha_AFM.i) * ((pMesh->M[idx] / Ms_AFM.i) ^ u_dot_del_M_A))) / (1 + alpha_AFM.i * alpha_AFM.i);
+
+	STT_B =
+		(((1 + alpha_AFM.j * alpha_AFM.j) * u_dot_del_M_B) -
+		((beta - alpha_AFM.j) * ((pMesh->M2[idx] / Ms_AFM.j) ^ u_dot_del_M_B))) / (1 + alpha_AFM.j * alpha_AFM.j);
+}
+
+//------------------------------------------------------------------------------------------------------
+
 DBL3 DifferentialEquationAFM::LLB(int idx)
 {
 	int tn = omp_get_thread_num();
 
+	DBL2 a, b, c, d;
+	LLB_Coefficients(idx, a, b, c, d);
+
+	DBL3 MxH_A = pMesh->M[idx] ^ pMesh->Heff[idx];
+	DBL3 MxH_B = pMesh->M2[idx] ^ pMesh->Heff2[idx];
+
+	//sub-lattice B value so we can read it after
+	Equation_Eval_2[tn] = a.j * MxH_B + b.j * (pMesh->M2[idx] ^ MxH_B) + (c.j * (pMesh->M2[idx] * pMesh->Heff2[idx]) + d.j) * pMesh->M2[idx];
+
+	//return the sub-lattice A value as normal
+	return a.i * MxH_A + b.i * (pMesh->M[idx] ^ MxH_A) + (c.i * (pMesh->M[idx] * pMesh->Heff[idx]) + d.i) * pMesh->M[idx];
+}
+
+//LLB coefficients for given cell on both sub-lattices (i for A, j for B), such that LLB evaluates to a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M
+//The longitudinal relaxation fields are proportional to M on the respective sub-lattice so they are included in d.
+void DifferentialEquationAFM::LLB_Coefficients(int idx, DBL2& a, DBL2& b, DBL2& c, DBL2& d)
+{
 	double T_Curie = pMesh->GetCurieTemperature();
 
 	//cell temperature : the base temperature if uniform temperature, else get the temperature from Temp
@@ -127,8 +156,8 @@ DBL3 DifferentialEquationAFM::LLB(int idx)
 
 	DBL2 alpha_par;
 
-	//the longitudinal relaxation field - an effective field contribution, but only need to add it to the longitudinal relaxation term as the others involve cross products with pMesh->M[idx]
-	DBL3 Hl_1, Hl_2;
+	//the longitudinal relaxation fields are Hl_1 = k.i * M and Hl_2 = k.j * M2
+	DBL2 k;
 
 	if (Temperature < T_Curie) {
 
@@ -146,8 +175,8 @@ DBL3 DifferentialEquationAFM::LLB(int idx)
 		DBL2 me = Ms / Ms0;
 		DBL2 r = m / me;
 
-		Hl_1 = (pMesh->M[idx] / (2 * MU0 * Ms0.i)) * ((1.0 - r.i * r.i) / susrel.i + (3 * tau_ij.i * T_Curie * (BOLTZMANN / MUB) / mu.i) * ((susrel.j / susrel.i) * (1 - r.i * r.i) + (me.j / me.i) * (1 - r.j * r.j)));
-		Hl_2 = (pMesh->M2[idx] / (2 * MU0 * Ms0.j)) * ((1.0 - r.j * r.j) / susrel.j + (3 * tau_ij.j * T_Curie * (BOLTZMANN / MUB) / mu.j) * ((susrel.i / susrel.j) * (1 - r.j * r.j) + (me.i / me.j) * (1 - r.i * r.i)));
+		k.i = ((1.0 - r.i * r.i) / susrel.i + (3 * tau_ij.i * T_Curie * (BOLTZMANN / MUB) / mu.i) * ((susrel.j / susrel.i) * (1 - r.i * r.i) + (me.j / me.i) * (1 - r.j * r.j))) / (2 * MU0 * Ms0.i);
+		k.j = ((1.0 - r.j * r.j) / susrel.j + (3 * tau_ij.j * T_Curie * (BOLTZMANN / MUB) / mu.j) * ((susrel.i / susrel.j) * (1 - r.j * r.j) + (me.i / me.j) * (1 - r.i * r.i))) / (2 * MU0 * Ms0.j);
 	}
 	else {
 
@@ -161,20 +190,15 @@ DBL3 DifferentialEquationAFM::LLB(int idx)
 
 		alpha_par = alpha;
 
-		DBL2 me = Ms / Ms0;
-
 		//Note, the parallel susceptibility is related to susrel by : susrel = suspar / mu0Ms
-		Hl_1 = -1 * (pMesh->M[idx] / (MU0 * Ms0.i)) * ((1.0 / susrel.i) + (3 * tau_ij.i * T_Curie * (BOLTZMANN / MUB) / mu.i) * ((susrel.j / susrel.i) + 1));
-		Hl_2 = -1 * (pMesh->M2[idx] / (MU0 * Ms0.j)) * ((1.0 / susrel.j) + (3 * tau_ij.j * T_Curie * (BOLTZMANN / MUB) / mu.j) * ((susrel.i / susrel.j) + 1));
+		k.i = -1 * ((1.0 / susrel.i) + (3 * tau_ij.i * T_Curie * (BOLTZMANN / MUB) / mu.i) * ((susrel.j / susrel.i) + 1)) / (MU0 * Ms0.i);
+		k.j = -1 * ((1.0 / susrel.j) + (3 * tau_ij.j * T_Curie * (BOLTZMANN / MUB) / mu.j) * ((susrel.i / susrel.j) + 1)) / (MU0 * Ms0.j);
 	}
 
-	//sub-lattice B value so we can read it after
-	Equation_Eval_2[tn] = (-GAMMA * grel.j * msq.j / (msq.j + alpha.j * alpha.j)) * (pMesh->M2[idx] ^ pMesh->Heff2[idx]) + (-GAMMA * grel.j * m.j * alpha.j / (msq.j + alpha.j * alpha.j)) * ((pMesh->M2[idx] / M.j) ^ (pMesh->M2[idx] ^ pMesh->Heff2[idx])) +
-		GAMMA * grel.j * alpha_par.j * Ms0.j * ((pMesh->M2[idx] / M.j) * (pMesh->Heff2[idx] + Hl_2)) * (pMesh->M2[idx] / M.j);
-
-	//return the sub-lattice A value as normal
-	return (-GAMMA * grel.i * msq.i / (msq.i + alpha.i * alpha.i)) * (pMesh->M[idx] ^ pMesh->Heff[idx]) + (-GAMMA * grel.i * m.i * alpha.i / (msq.i + alpha.i * alpha.i)) * ((pMesh->M[idx] / M.i) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])) +
-		GAMMA * grel.i * alpha_par.i * Ms0.i * ((pMesh->M[idx] / M.i) * (pMesh->Heff[idx] + Hl_1)) * (pMesh->M[idx] / M.i);
+	a = DBL2(-GAMMA * grel.i * msq.i / (msq.i + alpha.i * alpha.i), -GAMMA * grel.j * msq.j / (msq.j + alpha.j * alpha.j));
+	b = DBL2(-GAMMA * grel.i * m.i * alpha.i / ((msq.i + alpha.i * alpha.i) * M.i), -GAMMA * grel.j * m.j * alpha.j / ((msq.j + alpha.j * alpha.j) * M.j));
+	c = DBL2(GAMMA * grel.i * alpha_par.i * Ms0.i / (M.i * M.i), GAMMA * grel.j * alpha_par.j * Ms0.j / (M.j * M.j));
+	d = DBL2(GAMMA * grel.i * alpha_par.i * Ms0.i * k.i, GAMMA * grel.j * alpha_par.j * Ms0.j * k.j);
 }
 
 //------------------------------------------------------------------------------------------------------
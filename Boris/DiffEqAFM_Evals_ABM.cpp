@@ -15,41 +15,48 @@ void DifferentialEquationAFM::RunABM_Predictor_withReductions(void)
 	mxh_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+					//obtained maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-					pMesh->M2[idx] += dT * (3 * rhs_2 - sEval0_2[idx]) / 2;
-					sEval1_2[idx] = rhs_2;
-				}
-				else {
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
 
-					pMesh->M2[idx] += dT * (3 * rhs_2 - sEval1_2[idx]) / 2;
-					sEval0_2[idx] = rhs_2;
+						pMesh->M2[idx] += dT * (3 * rhs_2 - sEval0_2[idx]) / 2;
+						sEval1_2[idx] = rhs_2;
+					}
+					else {
+
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+
+						pMesh->M2[idx] += dT * (3 * rhs_2 - sEval1_2[idx]) / 2;
+						sEval0_2[idx] = rhs_2;
+					}
 				}
 			}
 		}
@@ -69,36 +76,43 @@ void DifferentialEquationAFM::RunABM_Predictor_withReductions(void)
 void DifferentialEquationAFM::RunABM_Predictor(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-					pMesh->M2[idx] += dT * (3 * rhs_2 - sEval0_2[idx]) / 2;
-					sEval1_2[idx] = rhs_2;
-				}
-				else {
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
+
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						pMesh->M2[idx] += dT * (3 * rhs_2 - sEval0_2[idx]) / 2;
+						sEval1_2[idx] = rhs_2;
+					}
+					else {
 
-					pMesh->M2[idx] += dT * (3 * rhs_2 - sEval1_2[idx]) / 2;
-					sEval0_2[idx] = rhs_2;
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+
+						pMesh->M2[idx] += dT * (3 * rhs_2 - sEval1_2[idx]) / 2;
+						sEval0_2[idx] = rhs_2;
+					}
 				}
 			}
 		}
@@ -111,55 +125,62 @@ void DifferentialEquationAFM::RunABM_Corrector_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-					pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval1_2[idx]) / 2;
-				}
-				else {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-					pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval0_2[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+						pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval1_2[idx]) / 2;
+					}
+					else {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+						pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval0_2[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
 
-				if (renormalize) {
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -182,50 +203,57 @@ void DifferentialEquationAFM::RunABM_Corrector(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-					pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval1_2[idx]) / 2;
-				}
-				else {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-					pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval0_2[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-				if (renormalize) {
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+						pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval1_2[idx]) / 2;
+					}
+					else {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+						pMesh->M2[idx] = sM1_2[idx] + dT * (rhs_2 + sEval0_2[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -236,23 +264,30 @@ void DifferentialEquationAFM::RunABM_Corrector(void)
 void DifferentialEquationAFM::RunABM_TEuler0(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
-				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+					sEval0_2[idx] = eval_block_2.eval(idx);
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += sEval0[idx] * dT;
-				pMesh->M2[idx] += sEval0_2[idx] * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += sEval0[idx] * dT;
+					pMesh->M2[idx] += sEval0_2[idx] * dT;
+				}
 			}
 		}
 	}
@@ -261,17 +296,24 @@ void DifferentialEquationAFM::RunABM_TEuler0(void)
 void DifferentialEquationAFM::RunABM_TEuler1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			DBL3 rhs = CALLFP(this, equation)(idx);
-			DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using the second trapezoidal Euler step equation
-			pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
-			pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = eval_block.eval(idx);
+				DBL3 rhs_2 = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using the second trapezoidal Euler step equation
+				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+				pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+			}
 		}
 	}
 }
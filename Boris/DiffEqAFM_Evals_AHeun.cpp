@@ -19,27 +19,34 @@ void DifferentialEquationAFM::RunAHeun_Step0_withReductions(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+				}
 			}
 		}
 	}
@@ -60,23 +67,30 @@ void DifferentialEquationAFM::RunAHeun_Step0(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+				}
 			}
 		}
 	}
@@ -88,46 +102,53 @@ void DifferentialEquationAFM::RunAHeun_Step1_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
-				pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				if (renormalize) {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
+
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//obtained average dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-
-				//obtained average dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -150,42 +171,49 @@ void DifferentialEquationAFM::RunAHeun_Step1(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
-				pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
 
-				if (renormalize) {
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
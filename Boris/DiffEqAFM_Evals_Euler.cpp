@@ -20,44 +20,51 @@ void DifferentialEquationAFM::RunEuler_withReductions(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
-				if (renormalize) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -83,25 +90,39 @@ void DifferentialEquationAFM::RunEuler(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				if (renormalize) {
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
@@ -109,13 +130,6 @@ void DifferentialEquationAFM::RunEuler(void)
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
-			}
 		}
 	}
 }
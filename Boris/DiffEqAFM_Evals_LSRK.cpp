@@ -0,0 +1,312 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (2N-storage, 4th order solution, embedded 3rd order error)
+
+//sEval0 and sEval0_2 hold the 2N registers (dM), sEval1 accumulates the error estimate (sub-lattice A), sM1 only needed to restore magnetization for rejected steps and for dmdt.
+
+void DifferentialEquationAFM::RunLSRK43_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval0_2[idx] = rhs_2 * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					pMesh->M[idx] += sEval0[idx] * LSRK_B1;
+					pMesh->M2[idx] += sEval0_2[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step0(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval0_2[idx] = rhs_2 * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					pMesh->M[idx] += sEval0[idx] * LSRK_B1;
+					pMesh->M2[idx] += sEval0_2[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step1(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+				DBL3 rhs_2 = eval_block_2.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A2 + rhs * dT;
+				sEval0_2[idx] = sEval0_2[idx] * LSRK_A2 + rhs_2 * dT;
+				sEval1[idx] += rhs * (LSRK_E2 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B2;
+				pMesh->M2[idx] += sEval0_2[idx] * LSRK_B2;
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step2(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+				DBL3 rhs_2 = eval_block_2.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A3 + rhs * dT;
+				sEval0_2[idx] = sEval0_2[idx] * LSRK_A3 + rhs_2 * dT;
+				sEval1[idx] += rhs * (LSRK_E3 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B3;
+				pMesh->M2[idx] += sEval0_2[idx] * LSRK_B3;
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step3(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+				DBL3 rhs_2 = eval_block_2.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A4 + rhs * dT;
+				sEval0_2[idx] = sEval0_2[idx] * LSRK_A4 + rhs_2 * dT;
+				sEval1[idx] += rhs * (LSRK_E4 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B4;
+				pMesh->M2[idx] += sEval0_2[idx] * LSRK_B4;
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step4_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					sEval0_2[idx] = sEval0_2[idx] * LSRK_A5 + rhs_2 * dT;
+					pMesh->M[idx] += sEval0[idx] * LSRK_B5;
+					pMesh->M2[idx] += sEval0_2[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+}
+
+void DifferentialEquationAFM::RunLSRK43_Step4(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					sEval0_2[idx] = sEval0_2[idx] * LSRK_A5 + rhs_2 * dT;
+					pMesh->M[idx] += sEval0[idx] * LSRK_B5;
+					pMesh->M2[idx] += sEval0_2[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+#endif
+#endif
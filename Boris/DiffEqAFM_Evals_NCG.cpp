@@ -0,0 +1,200 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//Nonlinear conjugate gradient minimizer on the unit sphere (Polak-Ribiere+ with restarts), line search over evaluations controlled in ODECommon_Base::Iterate.
+//Both sub-lattices are included in the same gradient and search direction vectors (i.e. sums are taken over both).
+
+//sM1 and sM1_2 hold the magnetization at the accepted point, sEval0 and sEval0_2 the gradient G = (gamma/2) * grel * m x (m x Heff), sEval1 and sEval1_2 the search direction d.
+
+//--------------------------------------------- Nonlinear Conjugate Gradient Solver
+
+//0. gradient at accepted point of the line search
+void DifferentialEquationAFM::RunNCG_Gradient_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	double _g_sq = 0.0;
+	double _g_dot_gold = 0.0;
+
+#pragma omp parallel for reduction(+:_g_sq, _g_dot_gold)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+				DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+				DBL3 H = pMesh->Heff[idx];
+
+				DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+				DBL3 H2 = pMesh->Heff2[idx];
+
+				//obtained maximum normalized torque term
+				if (IsNZ(grel_AFM.i)) {
+
+					double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+					mxh_reduction.reduce_max(_mxh);
+				}
+
+				//obtained maximum dmdt term over the accepted step
+				if (calculate_dmdt && IsNZ(grel_AFM.i)) {
+
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * grel_AFM.i * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+
+				//gradient at accepted point, and previous gradient transported to it
+				DBL3 G = (GAMMA * grel_AFM.i / 2) * (m ^ (m ^ H));
+				DBL3 G2 = (GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ H2));
+				DBL3 G_old = sEval0[idx] - m * (m * sEval0[idx]);
+				DBL3 G2_old = sEval0_2[idx] - m2 * (m2 * sEval0_2[idx]);
+
+				_g_sq += G * G + G2 * G2;
+				_g_dot_gold += G * G_old + G2 * G2_old;
+
+				sEval0[idx] = G;
+				sEval0_2[idx] = G2;
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+
+	//accumulate across all meshes -> remember these should have been set to zero before starting a run across all meshes
+	ncg_g_sq += _g_sq;
+	ncg_g_dot_gold += _g_dot_gold;
+}
+
+void DifferentialEquationAFM::RunNCG_Gradient(void)
+{
+	double _g_sq = 0.0;
+	double _g_dot_gold = 0.0;
+
+#pragma omp parallel for reduction(+:_g_sq, _g_dot_gold)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+				DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+				DBL3 H = pMesh->Heff[idx];
+
+				DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+				DBL3 H2 = pMesh->Heff2[idx];
+
+				//gradient at accepted point, and previous gradient transported to it
+				DBL3 G = (GAMMA * grel_AFM.i / 2) * (m ^ (m ^ H));
+				DBL3 G2 = (GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ H2));
+				DBL3 G_old = sEval0[idx] - m * (m * sEval0[idx]);
+				DBL3 G2_old = sEval0_2[idx] - m2 * (m2 * sEval0_2[idx]);
+
+				_g_sq += G * G + G2 * G2;
+				_g_dot_gold += G * G_old + G2 * G2_old;
+
+				sEval0[idx] = G;
+				sEval0_2[idx] = G2;
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	//accumulate across all meshes -> remember these should have been set to zero before starting a run across all meshes
+	ncg_g_sq += _g_sq;
+	ncg_g_dot_gold += _g_dot_gold;
+}
+
+//1. new search direction d = -G + beta * d_old
+void DifferentialEquationAFM::RunNCG_Direction(double beta)
+{
+	double _d_dot_g = 0.0;
+
+#pragma omp parallel for reduction(+:_d_dot_g)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//previous search direction transported to accepted point
+			DBL3 m = sM1[idx].normalized();
+			DBL3 m2 = sM1_2[idx].normalized();
+			DBL3 d_old = sEval1[idx] - m * (m * sEval1[idx]);
+			DBL3 d2_old = sEval1_2[idx] - m2 * (m2 * sEval1_2[idx]);
+
+			sEval1[idx] = d_old * beta - sEval0[idx];
+			sEval1_2[idx] = d2_old * beta - sEval0_2[idx];
+
+			_d_dot_g += sEval1[idx] * sEval0[idx] + sEval1_2[idx] * sEval0_2[idx];
+		}
+	}
+
+	//accumulate across all meshes -> remember this should have been set to zero before starting a run across all meshes
+	ncg_d_dot_g += _d_dot_g;
+}
+
+//2. set magnetization at line search trial point
+void DifferentialEquationAFM::RunNCG_Advance(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+			DBL3 m = sM1[idx].normalized();
+			DBL3 m2 = sM1_2[idx].normalized();
+			DBL3 d = sEval1[idx];
+			DBL3 d2 = sEval1_2[idx];
+			double dnorm = d.norm();
+			double d2norm = d2.norm();
+
+			//geodesic step : rotate m towards d (in tangent plane) by angle dT * |d|
+			if (dnorm) m = m * cos(dT * dnorm) + d * (sin(dT * dnorm) / dnorm);
+			if (d2norm) m2 = m2 * cos(dT * d2norm) + d2 * (sin(dT * d2norm) / d2norm);
+
+			pMesh->M[idx] = m * Ms_AFM.i;
+			pMesh->M2[idx] = m2 * Ms_AFM.j;
+			pMesh->M[idx].renormalize(Ms_AFM.i);
+			pMesh->M2[idx].renormalize(Ms_AFM.j);
+		}
+	}
+}
+
+#endif
+#endif
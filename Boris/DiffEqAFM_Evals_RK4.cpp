@@ -23,27 +23,34 @@ void DifferentialEquationAFM::RunRK4_Step0_withReductions(void)
 		mxh_av_reduction.new_average_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+			ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-				//Save current magnetization for later use
-				sM1[idx] = pMesh->M[idx];
-				sM1_2[idx] = pMesh->M2[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!pMesh->M.is_skipcell(idx)) {
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = pMesh->M[idx].norm();
-					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+					//Save current magnetization for later use
+					sM1[idx] = pMesh->M[idx];
+					sM1_2[idx] = pMesh->M2[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
-					sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					//Now estimate magnetization using RK4 midle step
-					pMesh->M[idx] += sEval0[idx] * (dT / 2);
-					pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = pMesh->M[idx].norm();
+						mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+						sEval0_2[idx] = eval_block_2.eval(idx);
+
+						//Now estimate magnetization using RK4 midle step
+						pMesh->M[idx] += sEval0[idx] * (dT / 2);
+						pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -63,28 +70,35 @@ void DifferentialEquationAFM::RunRK4_Step0_withReductions(void)
 		mxh_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+			ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-				//Save current magnetization for later use
-				sM1[idx] = pMesh->M[idx];
-				sM1_2[idx] = pMesh->M2[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!pMesh->M.is_skipcell(idx)) {
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = pMesh->M[idx].norm();
-					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-					mxh_reduction.reduce_max(_mxh);
+					//Save current magnetization for later use
+					sM1[idx] = pMesh->M[idx];
+					sM1_2[idx] = pMesh->M2[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
-					sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					//Now estimate magnetization using RK4 midle step
-					pMesh->M[idx] += sEval0[idx] * (dT / 2);
-					pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = pMesh->M[idx].norm();
+						double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+						mxh_reduction.reduce_max(_mxh);
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+						sEval0_2[idx] = eval_block_2.eval(idx);
+
+						//Now estimate magnetization using RK4 midle step
+						pMesh->M[idx] += sEval0[idx] * (dT / 2);
+						pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -108,23 +122,30 @@ void DifferentialEquationAFM::RunRK4_Step0(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for later use
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
-				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//Now estimate magnetization using RK4 midle step
-				pMesh->M[idx] += sEval0[idx] * (dT / 2);
-				pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+					sEval0_2[idx] = eval_block_2.eval(idx);
+
+					//Now estimate magnetization using RK4 midle step
+					pMesh->M[idx] += sEval0[idx] * (dT / 2);
+					pMesh->M2[idx] += sEval0_2[idx] * (dT / 2);
+				}
 			}
 		}
 	}
@@ -133,17 +154,24 @@ void DifferentialEquationAFM::RunRK4_Step0(void)
 void DifferentialEquationAFM::RunRK4_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
-			sEval1_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+				sEval1_2[idx] = eval_block_2.eval(idx);
 
-			//Now estimate magnetization using RK4 midle step
-			pMesh->M[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
-			pMesh->M2[idx] = sM1_2[idx] + sEval1_2[idx] * (dT / 2);
+				//Now estimate magnetization using RK4 midle step
+				pMesh->M[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
+				pMesh->M2[idx] = sM1_2[idx] + sEval1_2[idx] * (dT / 2);
+			}
 		}
 	}
 }
@@ -151,17 +179,24 @@ void DifferentialEquationAFM::RunRK4_Step1(void)
 void DifferentialEquationAFM::RunRK4_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
-			sEval2_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate magnetization using RK4 last step
-			pMesh->M[idx] = sM1[idx] + sEval2[idx] * dT;
-			pMesh->M2[idx] = sM1_2[idx] + sEval2_2[idx] * dT;
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
+				sEval2_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RK4 last step
+				pMesh->M[idx] = sM1[idx] + sEval2[idx] * dT;
+				pMesh->M2[idx] = sM1_2[idx] + sEval2_2[idx] * dT;
+			}
 		}
 	}
 }
@@ -175,38 +210,45 @@ void DifferentialEquationAFM::RunRK4_Step3_withReductions(void)
 		dmdt_av_reduction.new_average_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+			ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-				if (!pMesh->M.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
-					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//Now estimate magnetization using previous RK4 evaluations
-					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
-					pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
+						DBL3 rhs_2 = eval_block_2.eval(idx);
+
+						//Now estimate magnetization using previous RK4 evaluations
+						pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+						pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
+
+						if (renormalize) {
+
+							DBL2 Ms_AFM = pMesh->Ms_AFM;
+							pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+							pMesh->M[idx].renormalize(Ms_AFM.i);
+							pMesh->M2[idx].renormalize(Ms_AFM.j);
+						}
+
+						//obtained maximum dmdt term
+						double Mnorm = pMesh->M[idx].norm();
+						dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+					}
+					else {
 
 						DBL2 Ms_AFM = pMesh->Ms_AFM;
 						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 						pMesh->M[idx].renormalize(Ms_AFM.i);
 						pMesh->M2[idx].renormalize(Ms_AFM.j);
 					}
-
-					//obtained maximum dmdt term
-					double Mnorm = pMesh->M[idx].norm();
-					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-				}
-				else {
-
-					DBL2 Ms_AFM = pMesh->Ms_AFM;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-					pMesh->M[idx].renormalize(Ms_AFM.i);
-					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
 		}
@@ -226,39 +268,46 @@ void DifferentialEquationAFM::RunRK4_Step3_withReductions(void)
 		dmdt_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+			ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-				if (!pMesh->M.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
-					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//Now estimate magnetization using previous RK4 evaluations
-					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
-					pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
+						DBL3 rhs_2 = eval_block_2.eval(idx);
+
+						//Now estimate magnetization using previous RK4 evaluations
+						pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+						pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
+
+						if (renormalize) {
+
+							DBL2 Ms_AFM = pMesh->Ms_AFM;
+							pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+							pMesh->M[idx].renormalize(Ms_AFM.i);
+							pMesh->M2[idx].renormalize(Ms_AFM.j);
+						}
+
+						//obtained maximum dmdt term
+						double Mnorm = pMesh->M[idx].norm();
+						double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+						dmdt_reduction.reduce_max(_dmdt);
+					}
+					else {
 
 						DBL2 Ms_AFM = pMesh->Ms_AFM;
 						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 						pMesh->M[idx].renormalize(Ms_AFM.i);
 						pMesh->M2[idx].renormalize(Ms_AFM.j);
 					}
-
-					//obtained maximum dmdt term
-					double Mnorm = pMesh->M[idx].norm();
-					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-					dmdt_reduction.reduce_max(_dmdt);
-				}
-				else {
-
-					DBL2 Ms_AFM = pMesh->Ms_AFM;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-					pMesh->M[idx].renormalize(Ms_AFM.i);
-					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
 		}
@@ -278,21 +327,35 @@ void DifferentialEquationAFM::RunRK4_Step3_withReductions(void)
 void DifferentialEquationAFM::RunRK4_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
+
+					//Now estimate magnetization using previous RK4 evaluations
+					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
 
-				//Now estimate magnetization using previous RK4 evaluations
-				pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
-				pMesh->M2[idx] = sM1_2[idx] + (sEval0_2[idx] + 2 * sEval1_2[idx] + 2 * sEval2_2[idx] + rhs_2) * (dT / 6);
+					if (renormalize) {
 
-				if (renormalize) {
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
@@ -300,13 +363,6 @@ void DifferentialEquationAFM::RunRK4_Step3(void)
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
-			}
 		}
 	}
 }
@@ -16,31 +16,38 @@ void DifferentialEquationAFM::RunRKDP54_Step0_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//obtain maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
-				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - prediction) / Mnorm;
-				lte_reduction.reduce_max(_lte);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
-				sEval0_2[idx] = rhs_2;
+					//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
+					DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - prediction) / Mnorm;
+					lte_reduction.reduce_max(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+					sEval0_2[idx] = rhs_2;
+				}
 			}
 		}
 	}
@@ -63,26 +70,33 @@ void DifferentialEquationAFM::RunRKDP54_Step0(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
-				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - prediction) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
-				sEval0_2[idx] = rhs_2;
+					//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
+					DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - prediction) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+					sEval0_2[idx] = rhs_2;
+				}
 			}
 		}
 	}
@@ -114,17 +128,24 @@ void DifferentialEquationAFM::RunRKDP54_Step0_Advance(void)
 void DifferentialEquationAFM::RunRKDP54_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
-			sEval1_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+				sEval1_2[idx] = eval_block_2.eval(idx);
 
-			//Now estimate magnetization using RKDP midle step 1
-			pMesh->M[idx] = sM1[idx] + (3 * sEval0[idx] / 40 + 9 * sEval1[idx] / 40) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (3 * sEval0_2[idx] / 40 + 9 * sEval1_2[idx] / 40) * dT;
+				//Now estimate magnetization using RKDP midle step 1
+				pMesh->M[idx] = sM1[idx] + (3 * sEval0[idx] / 40 + 9 * sEval1[idx] / 40) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (3 * sEval0_2[idx] / 40 + 9 * sEval1_2[idx] / 40) * dT;
+			}
 		}
 	}
 }
@@ -132,17 +153,24 @@ void DifferentialEquationAFM::RunRKDP54_Step1(void)
 void DifferentialEquationAFM::RunRKDP54_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
-			sEval2_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using RKDP midle step 2
-			pMesh->M[idx] = sM1[idx] + (44 * sEval0[idx] / 45 - 56 * sEval1[idx] / 15 + 32 * sEval2[idx] / 9) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (44 * sEval0_2[idx] / 45 - 56 * sEval1_2[idx] / 15 + 32 * sEval2_2[idx] / 9) * dT;
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
+				sEval2_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKDP midle step 2
+				pMesh->M[idx] = sM1[idx] + (44 * sEval0[idx] / 45 - 56 * sEval1[idx] / 15 + 32 * sEval2[idx] / 9) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (44 * sEval0_2[idx] / 45 - 56 * sEval1_2[idx] / 15 + 32 * sEval2_2[idx] / 9) * dT;
+			}
 		}
 	}
 }
@@ -150,17 +178,24 @@ void DifferentialEquationAFM::RunRKDP54_Step2(void)
 void DifferentialEquationAFM::RunRKDP54_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
-			sEval3_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval3[idx] = eval_block.eval(idx);
+				sEval3_2[idx] = eval_block_2.eval(idx);
 
-			//Now estimate magnetization using RKDP midle step 3
-			pMesh->M[idx] = sM1[idx] + (19372 * sEval0[idx] / 6561 - 25360 * sEval1[idx] / 2187 + 64448 * sEval2[idx] / 6561 - 212 * sEval3[idx] / 729) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (19372 * sEval0_2[idx] / 6561 - 25360 * sEval1_2[idx] / 2187 + 64448 * sEval2_2[idx] / 6561 - 212 * sEval3_2[idx] / 729) * dT;
+				//Now estimate magnetization using RKDP midle step 3
+				pMesh->M[idx] = sM1[idx] + (19372 * sEval0[idx] / 6561 - 25360 * sEval1[idx] / 2187 + 64448 * sEval2[idx] / 6561 - 212 * sEval3[idx] / 729) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (19372 * sEval0_2[idx] / 6561 - 25360 * sEval1_2[idx] / 2187 + 64448 * sEval2_2[idx] / 6561 - 212 * sEval3_2[idx] / 729) * dT;
+			}
 		}
 	}
 }
@@ -168,17 +203,24 @@ void DifferentialEquationAFM::RunRKDP54_Step3(void)
 void DifferentialEquationAFM::RunRKDP54_Step4(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
-			sEval4_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate magnetization using RKDP midle step 4
-			pMesh->M[idx] = sM1[idx] + (9017 * sEval0[idx] / 3168 - 355 * sEval1[idx] / 33 + 46732 * sEval2[idx] / 5247 + 49 * sEval3[idx] / 176 - 5103 * sEval4[idx] / 18656) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (9017 * sEval0_2[idx] / 3168 - 355 * sEval1_2[idx] / 33 + 46732 * sEval2_2[idx] / 5247 + 49 * sEval3_2[idx] / 176 - 5103 * sEval4_2[idx] / 18656) * dT;
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval4[idx] = eval_block.eval(idx);
+				sEval4_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKDP midle step 4
+				pMesh->M[idx] = sM1[idx] + (9017 * sEval0[idx] / 3168 - 355 * sEval1[idx] / 33 + 46732 * sEval2[idx] / 5247 + 49 * sEval3[idx] / 176 - 5103 * sEval4[idx] / 18656) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (9017 * sEval0_2[idx] / 3168 - 355 * sEval1_2[idx] / 33 + 46732 * sEval2_2[idx] / 5247 + 49 * sEval3_2[idx] / 176 - 5103 * sEval4_2[idx] / 18656) * dT;
+			}
 		}
 	}
 }
@@ -188,39 +230,46 @@ void DifferentialEquationAFM::RunRKDP54_Step5_withReductions(void)
 	dmdt_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
-				sEval5_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval5[idx] = eval_block.eval(idx);
+					sEval5_2[idx] = eval_block_2.eval(idx);
+
+					//RKDP54 : 5th order evaluation
+					pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
+					pMesh->M2[idx] = sM1_2[idx] + (35 * sEval0_2[idx] / 384 + 500 * sEval2_2[idx] / 1113 + 125 * sEval3_2[idx] / 192 - 2187 * sEval4_2[idx] / 6784 + 11 * sEval5_2[idx] / 84) * dT;
+
+					if (renormalize) {
 
-				//RKDP54 : 5th order evaluation
-				pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
-				pMesh->M2[idx] = sM1_2[idx] + (35 * sEval0_2[idx] / 384 + 500 * sEval2_2[idx] / 1113 + 125 * sEval3_2[idx] / 192 - 2187 * sEval4_2[idx] / 6784 + 11 * sEval5_2[idx] / 84) * dT;
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
 
-				if (renormalize) {
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -239,21 +288,35 @@ void DifferentialEquationAFM::RunRKDP54_Step5_withReductions(void)
 void DifferentialEquationAFM::RunRKDP54_Step5(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
-				sEval5_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//RKDP54 : 5th order evaluation
-				pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
-				pMesh->M2[idx] = sM1_2[idx] + (35 * sEval0_2[idx] / 384 + 500 * sEval2_2[idx] / 1113 + 125 * sEval3_2[idx] / 192 - 2187 * sEval4_2[idx] / 6784 + 11 * sEval5_2[idx] / 84) * dT;
+					//First evaluate RHS of set equation at the current time step
+					sEval5[idx] = eval_block.eval(idx);
+					sEval5_2[idx] = eval_block_2.eval(idx);
 
-				if (renormalize) {
+					//RKDP54 : 5th order evaluation
+					pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
+					pMesh->M2[idx] = sM1_2[idx] + (35 * sEval0_2[idx] / 384 + 500 * sEval2_2[idx] / 1113 + 125 * sEval3_2[idx] / 192 - 2187 * sEval4_2[idx] / 6784 + 11 * sEval5_2[idx] / 84) * dT;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
@@ -261,13 +324,6 @@ void DifferentialEquationAFM::RunRKDP54_Step5(void)
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
-			}
 		}
 	}
 }
@@ -15,28 +15,35 @@ void DifferentialEquationAFM::RunRKF56_Step0_withReductions(void)
 	mxh_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for later use
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtain maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
-				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-				//Now estimate magnetization using RKF first step
-				pMesh->M[idx] += sEval0[idx] * (dT / 6);
-				pMesh->M2[idx] += sEval0_2[idx] * (dT / 6);
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+					sEval0_2[idx] = eval_block_2.eval(idx);
+
+					//Now estimate magnetization using RKF first step
+					pMesh->M[idx] += sEval0[idx] * (dT / 6);
+					pMesh->M2[idx] += sEval0_2[idx] * (dT / 6);
+				}
 			}
 		}
 	}
@@ -55,23 +62,30 @@ void DifferentialEquationAFM::RunRKF56_Step0_withReductions(void)
 void DifferentialEquationAFM::RunRKF56_Step0(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//Save current magnetization for later use
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
-				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+					sEval0_2[idx] = eval_block_2.eval(idx);
 
-				//Now estimate magnetization using RKF first step
-				pMesh->M[idx] += sEval0[idx] * (dT / 6);
-				pMesh->M2[idx] += sEval0_2[idx] * (dT / 6);
+					//Now estimate magnetization using RKF first step
+					pMesh->M[idx] += sEval0[idx] * (dT / 6);
+					pMesh->M2[idx] += sEval0_2[idx] * (dT / 6);
+				}
 			}
 		}
 	}
@@ -80,17 +94,24 @@ void DifferentialEquationAFM::RunRKF56_Step0(void)
 void DifferentialEquationAFM::RunRKF56_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
-			sEval1_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+				sEval1_2[idx] = eval_block_2.eval(idx);
 
-			//Now estimate magnetization using RKF midle step 1
-			pMesh->M[idx] = sM1[idx] + (4 * sEval0[idx] + 16 * sEval1[idx]) * dT / 75;
-			pMesh->M2[idx] = sM1_2[idx] + (4 * sEval0_2[idx] + 16 * sEval1_2[idx]) * dT / 75;
+				//Now estimate magnetization using RKF midle step 1
+				pMesh->M[idx] = sM1[idx] + (4 * sEval0[idx] + 16 * sEval1[idx]) * dT / 75;
+				pMesh->M2[idx] = sM1_2[idx] + (4 * sEval0_2[idx] + 16 * sEval1_2[idx]) * dT / 75;
+			}
 		}
 	}
 }
@@ -98,17 +119,24 @@ void DifferentialEquationAFM::RunRKF56_Step1(void)
 void DifferentialEquationAFM::RunRKF56_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
-			sEval2_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using RKF midle step 2
-			pMesh->M[idx] = sM1[idx] + (5 * sEval0[idx] / 6 - 8 * sEval1[idx] / 3 + 5 * sEval2[idx] / 2) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (5 * sEval0_2[idx] / 6 - 8 * sEval1_2[idx] / 3 + 5 * sEval2_2[idx] / 2) * dT;
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
+				sEval2_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKF midle step 2
+				pMesh->M[idx] = sM1[idx] + (5 * sEval0[idx] / 6 - 8 * sEval1[idx] / 3 + 5 * sEval2[idx] / 2) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (5 * sEval0_2[idx] / 6 - 8 * sEval1_2[idx] / 3 + 5 * sEval2_2[idx] / 2) * dT;
+			}
 		}
 	}
 }
@@ -116,17 +144,24 @@ void DifferentialEquationAFM::RunRKF56_Step2(void)
 void DifferentialEquationAFM::RunRKF56_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
-			sEval3_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using RKF midle step 3
-			pMesh->M[idx] = sM1[idx] + (-8 * sEval0[idx] / 5 + 144 * sEval1[idx] / 25 - 4 * sEval2[idx] + 16 * sEval3[idx] / 25) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (-8 * sEval0_2[idx] / 5 + 144 * sEval1_2[idx] / 25 - 4 * sEval2_2[idx] + 16 * sEval3_2[idx] / 25) * dT;
+				//First evaluate RHS of set equation at the current time step
+				sEval3[idx] = eval_block.eval(idx);
+				sEval3_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKF midle step 3
+				pMesh->M[idx] = sM1[idx] + (-8 * sEval0[idx] / 5 + 144 * sEval1[idx] / 25 - 4 * sEval2[idx] + 16 * sEval3[idx] / 25) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (-8 * sEval0_2[idx] / 5 + 144 * sEval1_2[idx] / 25 - 4 * sEval2_2[idx] + 16 * sEval3_2[idx] / 25) * dT;
+			}
 		}
 	}
 }
@@ -134,17 +169,24 @@ void DifferentialEquationAFM::RunRKF56_Step3(void)
 void DifferentialEquationAFM::RunRKF56_Step4(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
-			sEval4_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate magnetization using RKF midle step 4
-			pMesh->M[idx] = sM1[idx] + (361 * sEval0[idx] / 320 - 18 * sEval1[idx] / 5 + 407 * sEval2[idx] / 128 - 11 * sEval3[idx] / 80 + 55 * sEval4[idx] / 128) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (361 * sEval0_2[idx] / 320 - 18 * sEval1_2[idx] / 5 + 407 * sEval2_2[idx] / 128 - 11 * sEval3_2[idx] / 80 + 55 * sEval4_2[idx] / 128) * dT;
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval4[idx] = eval_block.eval(idx);
+				sEval4_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKF midle step 4
+				pMesh->M[idx] = sM1[idx] + (361 * sEval0[idx] / 320 - 18 * sEval1[idx] / 5 + 407 * sEval2[idx] / 128 - 11 * sEval3[idx] / 80 + 55 * sEval4[idx] / 128) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (361 * sEval0_2[idx] / 320 - 18 * sEval1_2[idx] / 5 + 407 * sEval2_2[idx] / 128 - 11 * sEval3_2[idx] / 80 + 55 * sEval4_2[idx] / 128) * dT;
+			}
 		}
 	}
 }
@@ -152,17 +194,24 @@ void DifferentialEquationAFM::RunRKF56_Step4(void)
 void DifferentialEquationAFM::RunRKF56_Step5(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval5[idx] = CALLFP(this, equation)(idx);
-			sEval5_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				//First evaluate RHS of set equation at the current time step
+				sEval5[idx] = eval_block.eval(idx);
+				sEval5_2[idx] = eval_block_2.eval(idx);
 
-			//Now estimate magnetization using RKF midle step 4
-			pMesh->M[idx] = sM1[idx] + (-11 * sEval0[idx] / 640 + 11 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 11 * sEval4[idx] / 256) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (-11 * sEval0_2[idx] / 640 + 11 * sEval2_2[idx] / 256 - 11 * sEval3_2[idx] / 160 + 11 * sEval4_2[idx] / 256) * dT;
+				//Now estimate magnetization using RKF midle step 4
+				pMesh->M[idx] = sM1[idx] + (-11 * sEval0[idx] / 640 + 11 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 11 * sEval4[idx] / 256) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (-11 * sEval0_2[idx] / 640 + 11 * sEval2_2[idx] / 256 - 11 * sEval3_2[idx] / 160 + 11 * sEval4_2[idx] / 256) * dT;
+			}
 		}
 	}
 }
@@ -170,17 +219,24 @@ void DifferentialEquationAFM::RunRKF56_Step5(void)
 void DifferentialEquationAFM::RunRKF56_Step6(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			//First evaluate RHS of set equation at the current time step
-			sEval6[idx] = CALLFP(this, equation)(idx);
-			sEval6_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Now estimate magnetization using RKF midle step 4
-			pMesh->M[idx] = sM1[idx] + (93 * sEval0[idx] / 640 - 18 * sEval1[idx] / 5 + 803 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 99 * sEval4[idx] / 256 + sEval6[idx]) * dT;
-			pMesh->M2[idx] = sM1_2[idx] + (93 * sEval0_2[idx] / 640 - 18 * sEval1_2[idx] / 5 + 803 * sEval2_2[idx] / 256 - 11 * sEval3_2[idx] / 160 + 99 * sEval4_2[idx] / 256 + sEval6_2[idx]) * dT;
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				sEval6[idx] = eval_block.eval(idx);
+				sEval6_2[idx] = eval_block_2.eval(idx);
+
+				//Now estimate magnetization using RKF midle step 4
+				pMesh->M[idx] = sM1[idx] + (93 * sEval0[idx] / 640 - 18 * sEval1[idx] / 5 + 803 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 99 * sEval4[idx] / 256 + sEval6[idx]) * dT;
+				pMesh->M2[idx] = sM1_2[idx] + (93 * sEval0_2[idx] / 640 - 18 * sEval1_2[idx] / 5 + 803 * sEval2_2[idx] / 256 - 11 * sEval3_2[idx] / 160 + 99 * sEval4_2[idx] / 256 + sEval6_2[idx]) * dT;
+			}
 		}
 	}
 }
@@ -191,46 +247,53 @@ void DifferentialEquationAFM::RunRKF56_Step7_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//5th order evaluation
-				pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
-				pMesh->M2[idx] = sM1_2[idx] + (31 * sEval0_2[idx] / 384 + 1125 * sEval2_2[idx] / 2816 + 9 * sEval3_2[idx] / 32 + 125 * sEval4_2[idx] / 768 + 5 * sEval5_2[idx] / 66) * dT;
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//local truncation error from 5th order evaluation and 6th order evaluation
-				DBL3 lte_diff = 5 * (sEval0[idx] + sEval5[idx] - sEval6[idx] - rhs) * dT / 66;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				if (renormalize) {
+					//5th order evaluation
+					pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
+					pMesh->M2[idx] = sM1_2[idx] + (31 * sEval0_2[idx] / 384 + 1125 * sEval2_2[idx] / 2816 + 9 * sEval3_2[idx] / 32 + 125 * sEval4_2[idx] / 768 + 5 * sEval5_2[idx] / 66) * dT;
+
+					//local truncation error from 5th order evaluation and 6th order evaluation
+					DBL3 lte_diff = 5 * (sEval0[idx] + sEval5[idx] - sEval6[idx] - rhs) * dT / 66;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(lte_diff) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(lte_diff) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
@@ -253,41 +316,48 @@ void DifferentialEquationAFM::RunRKF56_Step7(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+					DBL3 rhs_2 = eval_block_2.eval(idx);
 
-				//5th order evaluation
-				pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
-				pMesh->M2[idx] = sM1_2[idx] + (31 * sEval0_2[idx] / 384 + 1125 * sEval2_2[idx] / 2816 + 9 * sEval3_2[idx] / 32 + 125 * sEval4_2[idx] / 768 + 5 * sEval5_2[idx] / 66) * dT;
+					//5th order evaluation
+					pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
+					pMesh->M2[idx] = sM1_2[idx] + (31 * sEval0_2[idx] / 384 + 1125 * sEval2_2[idx] / 2816 + 9 * sEval3_2[idx] / 32 + 125 * sEval4_2[idx] / 768 + 5 * sEval5_2[idx] / 66) * dT;
 
-				//local truncation error from 5th order evaluation and 6th order evaluation
-				DBL3 lte_diff = 5 * (sEval0[idx] + sEval5[idx] - sEval6[idx] - rhs) * dT / 66;
+					//local truncation error from 5th order evaluation and 6th order evaluation
+					DBL3 lte_diff = 5 * (sEval0[idx] + sEval5[idx] - sEval6[idx] - rhs) * dT / 66;
 
-				if (renormalize) {
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(lte_diff) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(lte_diff) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
 	}
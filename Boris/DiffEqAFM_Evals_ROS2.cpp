@@ -0,0 +1,358 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_ROS2
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//--------------------------------------------- ROSENBROCK-W 2-STAGE (2nd order solution, embedded 1st order error), EXCHANGE FIELD IMPLICIT
+
+//sEval0 and sEval0_2 hold dM1 = dT * k1, sEval1 and sEval1_2 the right hand sides of the second stage, sM1 and sM1_2 the starting magnetization (used by the implicit solvers as the frozen magnetization).
+//Each sub-lattice has its own implicit solver using the intra-lattice exchange only : the inter-lattice exchange terms remain in the explicit part.
+
+//implicit exchange solver coefficients for given cell on sub-lattices A and B (ROS2), using LLG form equation coefficients for the current time step
+void DifferentialEquationAFM::ROS2_Exchange_Coefficients(int idx, DBL2& coeff_A, DBL2& coeff_B)
+{
+	DBL2 Ms_AFM = pMesh->Ms_AFM;
+	DBL2 alpha_AFM = pMesh->alpha_AFM;
+	DBL2 grel_AFM = pMesh->grel_AFM;
+	DBL2 A_AFM = pMesh->A_AFM;
+	pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->grel_AFM, grel_AFM, pMesh->A_AFM, A_AFM);
+
+	if (!Ms_AFM.i || !Ms_AFM.j) {
+
+		coeff_A = DBL2();
+		coeff_B = DBL2();
+		return;
+	}
+
+	DBL2 a, b;
+
+	if (setODE == ODE_LLGSTATIC || setODE == ODE_LLGSTATICSA) {
+
+		a = DBL2();
+		b = DBL2(-GAMMA * grel_AFM.i / (2 * Ms_AFM.i), -GAMMA * grel_AFM.j / (2 * Ms_AFM.j));
+	}
+	else {
+
+		a = DBL2(-GAMMA * grel_AFM.i / (1 + alpha_AFM.i * alpha_AFM.i), -GAMMA * grel_AFM.j / (1 + alpha_AFM.j * alpha_AFM.j));
+		b = DBL2(a.i * alpha_AFM.i / Ms_AFM.i, a.j * alpha_AFM.j / Ms_AFM.j);
+	}
+
+	//intra-lattice exchange field is 2A / (mu0 Ms^2) * delsq M on each sub-lattice
+	coeff_A = DBL2(a.i, b.i) * (ROS2_GAMMA * dT * 2 * A_AFM.i / (MU0 * Ms_AFM.i * Ms_AFM.i));
+	coeff_B = DBL2(a.j, b.j) * (ROS2_GAMMA * dT * 2 * A_AFM.j / (MU0 * Ms_AFM.j * Ms_AFM.j));
+}
+
+void DifferentialEquationAFM::RunROS2_Step0_withReductions(void)
+{
+	implicit_exchange.enabled = pMesh->IsModuleSet(MOD_EXCHANGE) || pMesh->IsModuleSet(MOD_DMEXCHANGE) || pMesh->IsModuleSet(MOD_IDMEXCHANGE) || pMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange_2.enabled = implicit_exchange.enabled;
+	implicit_exchange.converged = true;
+	implicit_exchange_2.converged = true;
+
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					sEval0_2[idx] = eval_block_2.eval(idx) * dT;
+					if (implicit_exchange.enabled) ROS2_Exchange_Coefficients(idx, implicit_exchange.coeff[idx], implicit_exchange_2.coeff[idx]);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					sEval0_2[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+					implicit_exchange_2.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+	implicit_exchange_2.solve(sEval0_2, sM1_2);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			sEval0_2[idx] = implicit_exchange_2.x[idx];
+			pMesh->M[idx] = sM1[idx] + sEval0[idx];
+			pMesh->M2[idx] = sM1_2[idx] + sEval0_2[idx];
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunROS2_Step0(void)
+{
+	implicit_exchange.enabled = pMesh->IsModuleSet(MOD_EXCHANGE) || pMesh->IsModuleSet(MOD_DMEXCHANGE) || pMesh->IsModuleSet(MOD_IDMEXCHANGE) || pMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange_2.enabled = implicit_exchange.enabled;
+	implicit_exchange.converged = true;
+	implicit_exchange_2.converged = true;
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					sEval0_2[idx] = eval_block_2.eval(idx) * dT;
+					if (implicit_exchange.enabled) ROS2_Exchange_Coefficients(idx, implicit_exchange.coeff[idx], implicit_exchange_2.coeff[idx]);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					sEval0_2[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+					implicit_exchange_2.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+	implicit_exchange_2.solve(sEval0_2, sM1_2);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			sEval0_2[idx] = implicit_exchange_2.x[idx];
+			pMesh->M[idx] = sM1[idx] + sEval0[idx];
+			pMesh->M2[idx] = sM1_2[idx] + sEval0_2[idx];
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunROS2_Step1_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+					sEval1_2[idx] = eval_block_2.eval(idx) * dT - sEval0_2[idx] * 2;
+				}
+				else {
+
+					sEval1[idx] = DBL3();
+					sEval1_2[idx] = DBL3();
+				}
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+	implicit_exchange_2.solve(sEval1_2, sM1_2);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL3 dM2 = implicit_exchange.x[idx];
+				DBL3 dM2_2 = implicit_exchange_2.x[idx];
+
+				pMesh->M[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+				pMesh->M2[idx] = sM1_2[idx] + sEval0_2[idx] * 1.5 + dM2_2 * 0.5;
+
+				//difference between 2nd order solution and embedded 1st order solution M + dM1
+				DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+				DBL3 difference_2 = (sEval0_2[idx] + dM2_2) * 0.5;
+
+				//projection step to preserve magnetization length
+				if (renormalize) {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+
+				//local truncation error : largest of the two sub-lattices
+				double _lte = maximum(GetMagnitude(difference) / Mnorm, GetMagnitude(difference_2) / pMesh->M2[idx].norm());
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged || !implicit_exchange_2.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+void DifferentialEquationAFM::RunROS2_Step1(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+		ODEEvalBlock& eval_block_2 = Equation_Block_2();
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+					sEval1_2[idx] = eval_block_2.eval(idx) * dT - sEval0_2[idx] * 2;
+				}
+				else {
+
+					sEval1[idx] = DBL3();
+					sEval1_2[idx] = DBL3();
+				}
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+	implicit_exchange_2.solve(sEval1_2, sM1_2);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL3 dM2 = implicit_exchange.x[idx];
+				DBL3 dM2_2 = implicit_exchange_2.x[idx];
+
+				pMesh->M[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+				pMesh->M2[idx] = sM1_2[idx] + sEval0_2[idx] * 1.5 + dM2_2 * 0.5;
+
+				//difference between 2nd order solution and embedded 1st order solution M + dM1
+				DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+				DBL3 difference_2 = (sEval0_2[idx] + dM2_2) * 0.5;
+
+				//projection step to preserve magnetization length
+				if (renormalize) {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+
+				//local truncation error : largest of the two sub-lattices
+				double _lte = maximum(GetMagnitude(difference) / pMesh->M[idx].norm(), GetMagnitude(difference_2) / pMesh->M2[idx].norm());
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged || !implicit_exchange_2.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+#endif
+#endif
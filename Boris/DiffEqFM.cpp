@@ -10,6 +10,8 @@ DifferentialEquationFM::DifferentialEquationFM(FMesh *pMesh):
 	DifferentialEquation(pMesh)
 {
 	error_on_create = UpdateConfiguration(UPDATECONFIG_FORCEUPDATE);
+
+	eval_blocks.resize(omp_get_num_procs());
 }
 
 DifferentialEquationFM::~DifferentialEquationFM()
@@ -114,9 +116,25 @@ BError DifferentialEquationFM::AllocateMemory(void)
 		if (!sEval6.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK43:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_ROS2:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!implicit_exchange.resize(pMesh->M)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -159,9 +177,12 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 	}
@@ -171,8 +192,11 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
+		evalMethod != EVAL_LSRK43 &&
+		evalMethod != EVAL_ROS2 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 	}
@@ -208,6 +232,11 @@ void DifferentialEquationFM::CleanupMemory(void)
 		sEval6.clear();
 	}
 
+	if (evalMethod != EVAL_ROS2) {
+
+		implicit_exchange.clear();
+	}
+
 	//For thermal vecs only clear if not used for current set ODE
 	if (setODE != ODE_SLLG &&
 		setODE != ODE_SLLGSTT &&
@@ -239,6 +268,9 @@ BError DifferentialEquationFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE, UPDATECONFIG_ODE_SOLVER)) {
 
+		//active set blocks no longer valid
+		Clear_ActiveSet();
+
 		if (pMesh->link_stochastic) {
 
 			pMesh->h_s = pMesh->h;
@@ -256,8 +288,17 @@ BError DifferentialEquationFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		error = AllocateMemory();
 	}
 
+	//implicit exchange solver must have same shape as magnetization
+	if (evalMethod == EVAL_ROS2 && cfgMessage == UPDATECONFIG_MESHSHAPECHANGE) {
+
+		if (!implicit_exchange.resize(pMesh->M)) error(BERROR_OUTOFMEMORY_CRIT);
+	}
+
 	if (cfgMessage == UPDATECONFIG_PARAMVALUECHANGED_MLENGTH) RenormalizeMagnetization();
 
+	//parameters read in every cell by the equations : cache them if they must be evaluated per cell
+	pMesh->request_parameter_cache(pMesh->Ms, pMesh->alpha, pMesh->grel, pMesh->susrel, pMesh->P, pMesh->beta, pMesh->A);
+
 	//----------------------- CUDA mirroring
 
 #if COMPILECUDA == 1
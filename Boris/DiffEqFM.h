@@ -1,6 +1,8 @@
 #pragma once
 
 #include "DiffEq.h"
+#include "DiffEq_EvalBlock.h"
+#include "DiffEq_Implicit.h"
 
 class FMesh;
 
@@ -15,6 +17,25 @@ class DifferentialEquationFM :
 {
 private:
 
+	//structure-of-arrays evaluation blocks, one for each OpenMP thread
+	std::vector<ODEEvalBlock> eval_blocks;
+
+	//linear solver for implicit exchange (ROS2 evaluation method only)
+	ODEImplicitExchange implicit_exchange;
+
+private:
+
+	//---------------------------------------- EQUATION HELPERS : DiffEqFM_Equations.cpp
+
+	//Zhang-Li STT contribution to LLG, using material parameters already obtained for this cell
+	DBL3 STT_Torque(int idx, double Ms, double alpha, double P, double beta);
+
+	//LLB coefficients for given cell, such that LLB evaluates to a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M
+	void LLB_Coefficients(int idx, double& a, double& b, double& c, double& d);
+
+	//implicit exchange solver coefficients for given cell (ROS2), using LLG form equation coefficients for the current time step
+	DBL2 ROS2_Exchange_Coefficients(int idx);
+
 public:
 
 	DifferentialEquationFM(FMesh *pMesh);
@@ -125,6 +146,25 @@ public:
 	void RunRKDP54_Step5(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void);
+	void RunLSRK43_Step0(void);
+	void RunLSRK43_Step1(void);
+	void RunLSRK43_Step2(void);
+	void RunLSRK43_Step3(void);
+	void RunLSRK43_Step4_withReductions(void);
+	void RunLSRK43_Step4(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void);
+	void RunROS2_Step0(void);
+	void RunROS2_Step1_withReductions(void);
+	void RunROS2_Step1(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void);
@@ -137,6 +177,16 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void);
+	void RunNCG_Gradient(void);
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta);
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -166,6 +216,15 @@ public:
 	//Stochastic Landau-Lifshitz-Bloch equation with Zhang-Li STT
 	DBL3 SLLBSTT(int idx);
 
+	//---------------------------------------- BLOCK EVALUATION : DiffEqFM_BlockEquations.cpp
+
+	//number of blocks of ODE_EVALBLOCK cells covering the mesh
+	int Num_Eval_Blocks(void);
+
+	//evaluate set equation for all cells in given block, using the evaluation block of the calling thread, and return it so evaluations can be read
+	//empty and skipped cells evaluate to zero
+	ODEEvalBlock& Evaluate_Equation_Block(int block);
+
 	//---------------------------------------- OTHERS : DiffEqFM.cpp
 
 	void RestoreMagnetization(void);
@@ -318,6 +377,25 @@ public:
 	void RunRKDP54_Step5(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK43
+	void RunLSRK43_Step0_withReductions(void) {}
+	void RunLSRK43_Step0(void) {}
+	void RunLSRK43_Step1(void) {}
+	void RunLSRK43_Step2(void) {}
+	void RunLSRK43_Step3(void) {}
+	void RunLSRK43_Step4_withReductions(void) {}
+	void RunLSRK43_Step4(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void) {}
@@ -330,6 +408,16 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//0. gradient at accepted point of the line search : save magnetization and gradient, accumulate ncg_g_sq and ncg_g_dot_gold -> must reset the static ncg_... quantities before running these across all meshes
+	void RunNCG_Gradient_withReductions(void) {}
+	void RunNCG_Gradient(void) {}
+	//1. new search direction d = -G + beta * d_old, accumulate ncg_d_dot_g
+	void RunNCG_Direction(double beta) {}
+	//2. set magnetization at line search trial point : geodesic step along search direction from accepted point
+	void RunNCG_Advance(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
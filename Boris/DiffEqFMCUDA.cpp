@@ -297,6 +297,38 @@ void DifferentialEquationFMCUDA::CleanupMemory(bool copy_to_cpu)
 	prng()->clear();
 }
 
+//copy evaluation scratch spaces to cpu memory without changing gpu memory (e.g. for saving a checkpoint while running)
+//only vectors allocated for the current evaluation method and equation have matching sizes, so only these are copied
+void DifferentialEquationFMCUDA::CopyMemory_to_cpu(void)
+{
+	if (sM1()->size_cpu() == pmeshODE->sM1.size()) sM1()->copy_to_cpuvec(pmeshODE->sM1);
+	if (sEval0()->size_cpu() == pmeshODE->sEval0.size()) sEval0()->copy_to_cpuvec(pmeshODE->sEval0);
+	if (sEval1()->size_cpu() == pmeshODE->sEval1.size()) sEval1()->copy_to_cpuvec(pmeshODE->sEval1);
+	if (sEval2()->size_cpu() == pmeshODE->sEval2.size()) sEval2()->copy_to_cpuvec(pmeshODE->sEval2);
+	if (sEval3()->size_cpu() == pmeshODE->sEval3.size()) sEval3()->copy_to_cpuvec(pmeshODE->sEval3);
+	if (sEval4()->size_cpu() == pmeshODE->sEval4.size()) sEval4()->copy_to_cpuvec(pmeshODE->sEval4);
+	if (sEval5()->size_cpu() == pmeshODE->sEval5.size()) sEval5()->copy_to_cpuvec(pmeshODE->sEval5);
+	if (sEval6()->size_cpu() == pmeshODE->sEval6.size()) sEval6()->copy_to_cpuvec(pmeshODE->sEval6);
+	if (H_Thermal()->size_cpu() == pmeshODE->H_Thermal.size()) H_Thermal()->copy_to_cpuvec(pmeshODE->H_Thermal);
+	if (Torque_Thermal()->size_cpu() == pmeshODE->Torque_Thermal.size()) Torque_Thermal()->copy_to_cpuvec(pmeshODE->Torque_Thermal);
+}
+
+//copy evaluation scratch spaces from cpu memory to gpu memory without reallocating (e.g. after loading a checkpoint)
+//only vectors allocated for the current evaluation method and equation have matching sizes, so only these are copied
+void DifferentialEquationFMCUDA::CopyMemory_to_gpu(void)
+{
+	if (sM1()->size_cpu() == pmeshODE->sM1.size()) sM1()->copy_from_cpuvec(pmeshODE->sM1);
+	if (sEval0()->size_cpu() == pmeshODE->sEval0.size()) sEval0()->copy_from_cpuvec(pmeshODE->sEval0);
+	if (sEval1()->size_cpu() == pmeshODE->sEval1.size()) sEval1()->copy_from_cpuvec(pmeshODE->sEval1);
+	if (sEval2()->size_cpu() == pmeshODE->sEval2.size()) sEval2()->copy_from_cpuvec(pmeshODE->sEval2);
+	if (sEval3()->size_cpu() == pmeshODE->sEval3.size()) sEval3()->copy_from_cpuvec(pmeshODE->sEval3);
+	if (sEval4()->size_cpu() == pmeshODE->sEval4.size()) sEval4()->copy_from_cpuvec(pmeshODE->sEval4);
+	if (sEval5()->size_cpu() == pmeshODE->sEval5.size()) sEval5()->copy_from_cpuvec(pmeshODE->sEval5);
+	if (sEval6()->size_cpu() == pmeshODE->sEval6.size()) sEval6()->copy_from_cpuvec(pmeshODE->sEval6);
+	if (H_Thermal()->size_cpu() == pmeshODE->H_Thermal.size()) H_Thermal()->copy_from_cpuvec(pmeshODE->H_Thermal);
+	if (Torque_Thermal()->size_cpu() == pmeshODE->Torque_Thermal.size()) Torque_Thermal()->copy_from_cpuvec(pmeshODE->Torque_Thermal);
+}
+
 
 BError DifferentialEquationFMCUDA::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 {
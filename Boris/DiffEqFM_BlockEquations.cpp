@@ -0,0 +1,174 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//------------------------------------------------------------------------------------------------------
+
+//number of blocks of ODE_EVALBLOCK cells covering the mesh
+int DifferentialEquationFM::Num_Eval_Blocks(void)
+{
+	return (pMesh->n.dim() + ODE_EVALBLOCK - 1) / ODE_EVALBLOCK;
+}
+
+//evaluate set equation for all cells in given block, using the evaluation block of the calling thread, and return it so evaluations can be read
+//LLG, LLB and stochastic LLG type equations are evaluated using the vectorized kernels in ODEEvalBlock, with per-cell coefficients only if material parameters are not uniform. Other equations are evaluated cell by cell.
+ODEEvalBlock& DifferentialEquationFM::Evaluate_Equation_Block(int block)
+{
+	ODEEvalBlock& eval_block = eval_blocks[omp_get_thread_num()];
+	eval_block.set_range(block, pMesh->n.dim());
+
+	auto is_evaluated = [&](int idx) -> bool { return pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx); };
+
+	//all cells in blocks frozen by the active set are skipped
+	if (Is_Block_Frozen(block)) {
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) eval_block.clear(idx);
+
+		return eval_block;
+	}
+
+	//load cells to evaluate : empty and skipped cells are cleared so they evaluate to zero
+	for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+		if (is_evaluated(idx)) eval_block.load(idx, pMesh->M[idx], pMesh->Heff[idx]);
+		else eval_block.clear(idx);
+	}
+
+	switch (setODE) {
+
+	case ODE_LLG:
+	case ODE_LLGSA:
+	case ODE_LLGSTT:
+	{
+		if (pMesh->is_uniform_parameters(pMesh->Ms, pMesh->alpha, pMesh->grel)) {
+
+			double Ms = pMesh->Ms;
+			double alpha = pMesh->alpha;
+			double grel = pMesh->grel;
+
+			double a = -GAMMA * grel / (1 + alpha * alpha);
+			eval_block.Evaluate_Transverse(a, a * alpha / Ms);
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double Ms = pMesh->Ms;
+				double alpha = pMesh->alpha;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha, pMesh->grel, grel);
+
+				double a = -GAMMA * grel / (1 + alpha * alpha);
+				eval_block.set_coefficients(idx, a, a * alpha / Ms);
+			}
+
+			eval_block.Evaluate_Transverse();
+		}
+
+		if (setODE == ODE_LLGSTT && pMesh->E.linear_size()) {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double Ms = pMesh->Ms;
+				double alpha = pMesh->alpha;
+				double P = pMesh->P;
+				double beta = pMesh->beta;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha, pMesh->P, P, pMesh->beta, beta);
+
+				eval_block.add(idx, STT_Torque(idx, Ms, alpha, P, beta));
+			}
+		}
+	}
+	break;
+
+	case ODE_LLGSTATIC:
+	case ODE_LLGSTATICSA:
+	{
+		if (pMesh->is_uniform_parameters(pMesh->Ms, pMesh->grel)) {
+
+			double Ms = pMesh->Ms;
+			double grel = pMesh->grel;
+
+			eval_block.Evaluate_Transverse(0.0, -GAMMA * grel / (2 * Ms));
+		}
+		else {
+
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+				if (!is_evaluated(idx)) continue;
+
+				double Ms = pMesh->Ms;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+				eval_block.set_coefficients(idx, 0.0, -GAMMA * grel / (2 * Ms));
+			}
+
+			eval_block.Evaluate_Transverse();
+		}
+	}
+	break;
+
+	case ODE_SLLG:
+	case ODE_SLLGSA:
+	{
+		//thermal field includes damping contribution not included when H_Thermal was generated, so always needs per-cell values
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			double Ms = pMesh->Ms;
+			double alpha = pMesh->alpha;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha);
+
+			eval_block.add_field(idx, H_Thermal[pMesh->M.cellidx_to_position(idx)] * sqrt(alpha));
+
+			double a = -GAMMA * pMesh->grel / (1 + alpha * alpha);
+			eval_block.set_coefficients(idx, a, a * alpha / Ms);
+		}
+
+		eval_block.Evaluate_Transverse();
+	}
+	break;
+
+	case ODE_LLB:
+	case ODE_LLBSA:
+	{
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (!is_evaluated(idx)) continue;
+
+			double a, b, c, d;
+			LLB_Coefficients(idx, a, b, c, d);
+
+			eval_block.set_coefficients(idx, a, b, c, d);
+		}
+
+		eval_block.Evaluate_Full();
+	}
+	break;
+
+	default:
+	{
+		//no block form for this equation : evaluate cell by cell
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (is_evaluated(idx)) eval_block.add(idx, CALLFP(this, equation)(idx));
+		}
+	}
+	break;
+	}
+
+	return eval_block;
+}
+
+#endif
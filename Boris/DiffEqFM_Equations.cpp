@@ -53,22 +53,24 @@ DBL3 DifferentialEquationFM::LLGSTT(int idx)
 
 	DBL3 LLGSTT_Eval = (-GAMMA * grel / (1 + alpha*alpha)) * ((pMesh->M[idx] ^ pMesh->Heff[idx]) + alpha * ((pMesh->M[idx] / Ms) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])));
 
-	if (pMesh->E.linear_size()) {
+	if (pMesh->E.linear_size()) LLGSTT_Eval += STT_Torque(idx, Ms, alpha, P, beta);
 
-		DBL33 grad_M = pMesh->M.grad_neu(idx);
+	return LLGSTT_Eval;
+}
 
-		DBL3 position = pMesh->M.cellidx_to_position(idx);
+//Zhang-Li STT contribution to LLG, using material parameters already obtained for this cell
+DBL3 DifferentialEquationFM::STT_Torque(int idx, double Ms, double alpha, double P, double beta)
+{
+	DBL33 grad_M = pMesh->M.grad_neu(idx);
 
-		DBL3 u = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms * (1 + beta*beta));
+	DBL3 position = pMesh->M.cellidx_to_position(idx);
 
-		DBL3 u_dot_del_M = (u.x * grad_M.x) + (u.y * grad_M.y) + (u.z * grad_M.z);
+	DBL3 u = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms * (1 + beta*beta));
 
-		LLGSTT_Eval +=
-			(((1 + alpha * beta) * u_dot_del_M) -
-			((beta - alpha) * ((pMesh->M[idx] / Ms) ^ u_dot_del_M))) / (1 + alpha * alpha);
-	}
+	DBL3 u_dot_del_M = (u.x * grad_M.x) + (u.y * grad_M.y) + (u.z * grad_M.z);
 
-	return LLGSTT_Eval;
+	return (((1 + alpha * beta) * u_dot_del_M) -
+		((beta - alpha) * ((pMesh->M[idx] / Ms) ^ u_dot_del_M))) / (1 + alpha * alpha);
 }
 
 //------------------------------------------------------------------------------------------------------
@@ -89,6 +91,18 @@ DBL3 DifferentialEquationFM::LLB(int idx)
 	//alpha = alpha0 * (1 - T/3Tc) up to Tc, alpha = (2*alpha0*T/3Tc) above Tc
 	//For Ms and suspar see literature (e.g. S.Lepadatu, JAP 120, 163908 (2016))
 
+	double a, b, c, d;
+	LLB_Coefficients(idx, a, b, c, d);
+
+	DBL3 MxH = pMesh->M[idx] ^ pMesh->Heff[idx];
+
+	return a * MxH + b * (pMesh->M[idx] ^ MxH) + (c * (pMesh->M[idx] * pMesh->Heff[idx]) + d) * pMesh->M[idx];
+}
+
+//LLB coefficients for given cell, such that LLB evaluates to a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M
+//The longitudinal relaxation field is proportional to M so it is included in d.
+void DifferentialEquationFM::LLB_Coefficients(int idx, double& a, double& b, double& c, double& d)
+{
 	double T_Curie = pMesh->GetCurieTemperature();
 
 	//cell temperature : the base temperature if uniform temperature, else get the temperature from Temp
@@ -109,8 +123,8 @@ DBL3 DifferentialEquationFM::LLB(int idx)
 
 	double alpha_par;
 
-	//the longitudinal relaxation field - an effective field contribution, but only need to add it to the longitudinal relaxation term as the others involve cross products with pMesh->M[idx]
-	DBL3 Hl;
+	//the longitudinal relaxation field is Hl = k * M
+	double k;
 
 	if (Temperature <= T_Curie) {
 
@@ -126,7 +140,7 @@ DBL3 DifferentialEquationFM::LLB(int idx)
 		alpha_par = 2 * (pMesh->alpha.get0() - alpha);
 
 		//Note, the parallel susceptibility is related to susrel by : susrel = suspar / mu0Ms
-		Hl = pMesh->M[idx] * ((1 - (M / Ms) * (M / Ms)) / (2 * susrel * MU0 * Ms0));
+		k = (1 - (M / Ms) * (M / Ms)) / (2 * susrel * MU0 * Ms0);
 	}
 	else {
 
@@ -141,11 +155,13 @@ DBL3 DifferentialEquationFM::LLB(int idx)
 		alpha_par = alpha;
 
 		//Note, the parallel susceptibility is related to susrel by : susrel = suspar / mu0Ms
-		Hl = -1.0 * (pMesh->M[idx] / (susrel * MU0 * Ms0)) * (1 + 3 * msq * T_Curie / (5 * (Temperature - T_Curie)));
+		k = -1.0 * (1 + 3 * msq * T_Curie / (5 * (Temperature - T_Curie))) / (susrel * MU0 * Ms0);
 	}
 
-	return (-GAMMA * grel * msq / (msq + alpha * alpha)) * (pMesh->M[idx] ^ pMesh->Heff[idx]) + (-GAMMA * grel * m * alpha / (msq + alpha * alpha)) * ((pMesh->M[idx] / M) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])) +
-		GAMMA * grel * alpha_par * Ms0 * ((pMesh->M[idx] / M) * (pMesh->Heff[idx] + Hl)) * (pMesh->M[idx] / M);
+	a = -GAMMA * grel * msq / (msq + alpha * alpha);
+	b = -GAMMA * grel * m * alpha / ((msq + alpha * alpha) * M);
+	c = GAMMA * grel * alpha_par * Ms0 / (M * M);
+	d = GAMMA * grel * alpha_par * Ms0 * k;
 }
 
 //------------------------------------------------------------------------------------------------------
@@ -15,33 +15,39 @@ void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 	mxh_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+					//obtained maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
+
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
+
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
@@ -61,28 +67,34 @@ void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 void DifferentialEquationFM::RunABM_Predictor(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
+
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
@@ -95,49 +107,55 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
 
-				if (renormalize) {
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
@@ -160,44 +178,50 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-				if (renormalize) {
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
+
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
@@ -208,20 +232,26 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 void DifferentialEquationFM::RunABM_TEuler0(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += sEval0[idx] * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += sEval0[idx] * dT;
+				}
 			}
 		}
 	}
@@ -230,15 +260,21 @@ void DifferentialEquationFM::RunABM_TEuler0(void)
 void DifferentialEquationFM::RunABM_TEuler1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using the second trapezoidal Euler step equation
-			pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = eval_block.eval(idx);
+
+				//Now estimate magnetization using the second trapezoidal Euler step equation
+				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+			}
 		}
 	}
 }
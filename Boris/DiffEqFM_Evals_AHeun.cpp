@@ -19,24 +19,30 @@ void DifferentialEquationFM::RunAHeun_Step0_withReductions(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+				}
 			}
 		}
 	}
@@ -57,20 +63,26 @@ void DifferentialEquationFM::RunAHeun_Step0(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+				}
 			}
 		}
 	}
@@ -82,41 +94,47 @@ void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				if (renormalize) {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//obtained average dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-
-				//obtained average dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
@@ -139,37 +157,43 @@ void DifferentialEquationFM::RunAHeun_Step1(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
 
-				if (renormalize) {
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
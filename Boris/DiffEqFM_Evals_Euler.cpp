@@ -20,39 +20,45 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
-				if (renormalize) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
+					pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 				}
-
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 			}
 		}
 	}
@@ -78,34 +84,40 @@ void DifferentialEquationFM::RunEuler(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (pMesh->M.is_not_empty(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				if (renormalize) {
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
+					pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 				}
 			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
-			}
 		}
 	}
 }
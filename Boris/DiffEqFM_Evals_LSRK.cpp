@@ -0,0 +1,278 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (2N-storage, 4th order solution, embedded 3rd order error)
+
+//sEval0 holds the 2N register (dM), sEval1 accumulates the error estimate, sM1 only needed to restore magnetization for rejected steps and for dmdt.
+
+void DifferentialEquationFM::RunLSRK43_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					pMesh->M[idx] += sEval0[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunLSRK43_Step0(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
+
+					//first stage (A1 = 0)
+					sEval0[idx] = rhs * dT;
+					sEval1[idx] = rhs * (LSRK_E1 * dT);
+
+					pMesh->M[idx] += sEval0[idx] * LSRK_B1;
+				}
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK43_Step1(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A2 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E2 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B2;
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK43_Step2(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A3 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E3 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B3;
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK43_Step3(void)
+{
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				DBL3 rhs = eval_block.eval(idx);
+
+				sEval0[idx] = sEval0[idx] * LSRK_A4 + rhs * dT;
+				sEval1[idx] += rhs * (LSRK_E4 * dT);
+
+				pMesh->M[idx] += sEval0[idx] * LSRK_B4;
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK43_Step4_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					pMesh->M[idx] += sEval0[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+}
+
+void DifferentialEquationFM::RunLSRK43_Step4(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					DBL3 rhs = eval_block.eval(idx);
+
+					//last stage : 4th order evaluation
+					sEval0[idx] = sEval0[idx] * LSRK_A5 + rhs * dT;
+					pMesh->M[idx] += sEval0[idx] * LSRK_B5;
+
+					//difference between 4th order and embedded 3rd order solutions
+					DBL3 difference = sEval1[idx] + rhs * (LSRK_E5 * dT);
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error
+					double _lte = GetMagnitude(difference) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+#endif
+#endif
@@ -0,0 +1,175 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//Nonlinear conjugate gradient minimizer on the unit sphere (Polak-Ribiere+ with restarts), line search over evaluations controlled in ODECommon_Base::Iterate.
+//Vectors at the previous accepted point (gradient, search direction) are transported to the current point by projection onto its tangent plane; steps follow geodesics on the sphere.
+
+//sM1 holds the magnetization at the accepted point, sEval0 the gradient G = (gamma/2) * grel * m x (m x Heff), sEval1 the search direction d.
+
+//--------------------------------------------- Nonlinear Conjugate Gradient Solver
+
+//0. gradient at accepted point of the line search
+void DifferentialEquationFM::RunNCG_Gradient_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	double _g_sq = 0.0;
+	double _g_dot_gold = 0.0;
+
+#pragma omp parallel for reduction(+:_g_sq, _g_dot_gold)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				double Ms = pMesh->Ms;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+				DBL3 m = pMesh->M[idx] / Ms;
+				DBL3 H = pMesh->Heff[idx];
+
+				//obtained maximum normalized torque term
+				if (IsNZ(grel)) {
+
+					double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+					mxh_reduction.reduce_max(_mxh);
+				}
+
+				//obtained maximum dmdt term over the accepted step
+				if (calculate_dmdt && IsNZ(grel)) {
+
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * grel * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+
+				//gradient at accepted point, and previous gradient transported to it
+				DBL3 G = (GAMMA * grel / 2) * (m ^ (m ^ H));
+				DBL3 G_old = sEval0[idx] - m * (m * sEval0[idx]);
+
+				_g_sq += G * G;
+				_g_dot_gold += G * G_old;
+
+				sEval0[idx] = G;
+				sM1[idx] = pMesh->M[idx];
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+
+	//accumulate across all meshes -> remember these should have been set to zero before starting a run across all meshes
+	ncg_g_sq += _g_sq;
+	ncg_g_dot_gold += _g_dot_gold;
+}
+
+void DifferentialEquationFM::RunNCG_Gradient(void)
+{
+	double _g_sq = 0.0;
+	double _g_dot_gold = 0.0;
+
+#pragma omp parallel for reduction(+:_g_sq, _g_dot_gold)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				double Ms = pMesh->Ms;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+				DBL3 m = pMesh->M[idx] / Ms;
+				DBL3 H = pMesh->Heff[idx];
+
+				//gradient at accepted point, and previous gradient transported to it
+				DBL3 G = (GAMMA * grel / 2) * (m ^ (m ^ H));
+				DBL3 G_old = sEval0[idx] - m * (m * sEval0[idx]);
+
+				_g_sq += G * G;
+				_g_dot_gold += G * G_old;
+
+				sEval0[idx] = G;
+				sM1[idx] = pMesh->M[idx];
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	//accumulate across all meshes -> remember these should have been set to zero before starting a run across all meshes
+	ncg_g_sq += _g_sq;
+	ncg_g_dot_gold += _g_dot_gold;
+}
+
+//1. new search direction d = -G + beta * d_old
+void DifferentialEquationFM::RunNCG_Direction(double beta)
+{
+	double _d_dot_g = 0.0;
+
+#pragma omp parallel for reduction(+:_d_dot_g)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//previous search direction transported to accepted point
+			DBL3 m = sM1[idx].normalized();
+			DBL3 d_old = sEval1[idx] - m * (m * sEval1[idx]);
+
+			sEval1[idx] = d_old * beta - sEval0[idx];
+
+			_d_dot_g += sEval1[idx] * sEval0[idx];
+		}
+	}
+
+	//accumulate across all meshes -> remember this should have been set to zero before starting a run across all meshes
+	ncg_d_dot_g += _d_dot_g;
+}
+
+//2. set magnetization at line search trial point
+void DifferentialEquationFM::RunNCG_Advance(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+			DBL3 m = sM1[idx].normalized();
+			DBL3 d = sEval1[idx];
+			double dnorm = d.norm();
+
+			//geodesic step : rotate m towards d (in tangent plane) by angle dT * |d|
+			if (dnorm) m = m * cos(dT * dnorm) + d * (sin(dT * dnorm) / dnorm);
+
+			pMesh->M[idx] = m * Ms;
+			pMesh->M[idx].renormalize(Ms);
+		}
+	}
+}
+
+#endif
+#endif
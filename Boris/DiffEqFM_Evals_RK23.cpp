@@ -16,29 +16,35 @@ void DifferentialEquationFM::RunRK23_Step0_withReductions(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//obtain maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//2nd order evaluation for adaptive step
-				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
+					//2nd order evaluation for adaptive step
+					DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - prediction) / Mnorm;
-				lte_reduction.reduce_max(_lte);
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - prediction) / Mnorm;
+					lte_reduction.reduce_max(_lte);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -62,24 +68,30 @@ void DifferentialEquationFM::RunRK23_Step0(void)
 	lte_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//2nd order evaluation for adaptive step
-				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - prediction) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				//save evaluation for later use
-				sEval0[idx] = rhs;
+					//2nd order evaluation for adaptive step
+					DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - prediction) / pMesh->M[idx].norm();
+					lte_reduction.reduce_max(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
 			}
 		}
 	}
@@ -109,15 +121,21 @@ void DifferentialEquationFM::RunRK23_Step0_Advance(void)
 void DifferentialEquationFM::RunRK23_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using RK23 midle step 1
-			pMesh->M[idx] = sM1[idx] + 3 * sEval1[idx] * dT / 4;
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+
+				//Now estimate magnetization using RK23 midle step 1
+				pMesh->M[idx] = sM1[idx] + 3 * sEval1[idx] * dT / 4;
+			}
 		}
 	}
 }
@@ -127,35 +145,41 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 	dmdt_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval2[idx] = eval_block.eval(idx);
+
+					//Now calculate 3rd order evaluation
+					pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
 
-				//Now calculate 3rd order evaluation
-				pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+					if (renormalize) {
 
-				if (renormalize) {
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
@@ -174,31 +198,37 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 void DifferentialEquationFM::RunRK23_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now calculate 3rd order evaluation
-				pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+					//First evaluate RHS of set equation at the current time step
+					sEval2[idx] = eval_block.eval(idx);
 
-				if (renormalize) {
+					//Now calculate 3rd order evaluation
+					pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
-			}
 		}
 	}
 }
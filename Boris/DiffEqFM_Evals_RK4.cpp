@@ -25,24 +25,30 @@ void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
 		mxh_av_reduction.new_average_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				//Save current magnetization for later use
-				sM1[idx] = pMesh->M[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!pMesh->M.is_skipcell(idx)) {
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = pMesh->M[idx].norm();
-					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+					//Save current magnetization for later use
+					sM1[idx] = pMesh->M[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					//Now estimate magnetization using RK4 midle step
-					pMesh->M[idx] += sEval0[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = pMesh->M[idx].norm();
+						mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+
+						//Now estimate magnetization using RK4 midle step
+						pMesh->M[idx] += sEval0[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -65,25 +71,31 @@ void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
 		mxh_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				//Save current magnetization for later use
-				sM1[idx] = pMesh->M[idx];
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				if (!pMesh->M.is_skipcell(idx)) {
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//obtained maximum normalized torque term
-					double Mnorm = pMesh->M[idx].norm();
-					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-					mxh_reduction.reduce_max(_mxh);
+					//Save current magnetization for later use
+					sM1[idx] = pMesh->M[idx];
 
-					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					//Now estimate magnetization using RK4 midle step
-					pMesh->M[idx] += sEval0[idx] * (dT / 2);
+						//obtained maximum normalized torque term
+						double Mnorm = pMesh->M[idx].norm();
+						double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+						mxh_reduction.reduce_max(_mxh);
+
+						//First evaluate RHS of set equation at the current time step
+						sEval0[idx] = eval_block.eval(idx);
+
+						//Now estimate magnetization using RK4 midle step
+						pMesh->M[idx] += sEval0[idx] * (dT / 2);
+					}
 				}
 			}
 		}
@@ -107,20 +119,26 @@ void DifferentialEquationFM::RunRK4_Step0(void)
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			//Save current magnetization for later use
-			sM1[idx] = pMesh->M[idx];
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
 
-				//Now estimate magnetization using RK4 midle step
-				pMesh->M[idx] += sEval0[idx] * (dT / 2);
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = eval_block.eval(idx);
+
+					//Now estimate magnetization using RK4 midle step
+					pMesh->M[idx] += sEval0[idx] * (dT / 2);
+				}
 			}
 		}
 	}
@@ -129,15 +147,21 @@ void DifferentialEquationFM::RunRK4_Step0(void)
 void DifferentialEquationFM::RunRK4_Step1(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//Now estimate magnetization using RK4 midle step
-			pMesh->M[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
+				//First evaluate RHS of set equation at the current time step
+				sEval1[idx] = eval_block.eval(idx);
+
+				//Now estimate magnetization using RK4 midle step
+				pMesh->M[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
+			}
 		}
 	}
 }
@@ -145,15 +169,21 @@ void DifferentialEquationFM::RunRK4_Step1(void)
 void DifferentialEquationFM::RunRK4_Step2(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+				//First evaluate RHS of set equation at the current time step
+				sEval2[idx] = eval_block.eval(idx);
 
-			//Now estimate magnetization using RK4 last step
-			pMesh->M[idx] = sM1[idx] + sEval2[idx] * dT;
+				//Now estimate magnetization using RK4 last step
+				pMesh->M[idx] = sM1[idx] + sEval2[idx] * dT;
+			}
 		}
 	}
 }
@@ -169,34 +199,40 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 		dmdt_av_reduction.new_average_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				if (!pMesh->M.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//Now estimate magnetization using previous RK4 evaluations
-					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
+
+						//Now estimate magnetization using previous RK4 evaluations
+						pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+
+						if (renormalize) {
+
+							double Ms = pMesh->Ms;
+							pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+							pMesh->M[idx].renormalize(Ms);
+						}
+
+						//obtained maximum dmdt term
+						double Mnorm = pMesh->M[idx].norm();
+						dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+					}
+					else {
 
 						double Ms = pMesh->Ms;
 						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 						pMesh->M[idx].renormalize(Ms);
 					}
-
-					//obtained maximum dmdt term
-					double Mnorm = pMesh->M[idx].norm();
-					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-				}
-				else {
-
-					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 		}
@@ -218,35 +254,41 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 		dmdt_reduction.new_minmax_reduction();
 
 #pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
+			//evaluate RHS of set equation for all cells in this block
+			ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-				if (!pMesh->M.is_skipcell(idx)) {
+			for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+				if (pMesh->M.is_not_empty(idx)) {
 
-					//Now estimate magnetization using previous RK4 evaluations
-					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					if (!pMesh->M.is_skipcell(idx)) {
 
-					if (renormalize) {
+						//First evaluate RHS of set equation at the current time step
+						DBL3 rhs = eval_block.eval(idx);
+
+						//Now estimate magnetization using previous RK4 evaluations
+						pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+
+						if (renormalize) {
+
+							double Ms = pMesh->Ms;
+							pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+							pMesh->M[idx].renormalize(Ms);
+						}
+
+						//obtained maximum dmdt term
+						double Mnorm = pMesh->M[idx].norm();
+						double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+						dmdt_reduction.reduce_max(_dmdt);
+					}
+					else {
 
 						double Ms = pMesh->Ms;
 						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 						pMesh->M[idx].renormalize(Ms);
 					}
-
-					//obtained maximum dmdt term
-					double Mnorm = pMesh->M[idx].norm();
-					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-					dmdt_reduction.reduce_max(_dmdt);
-				}
-				else {
-
-					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 		}
@@ -266,31 +308,37 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 void DifferentialEquationFM::RunRK4_Step3(void)
 {
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
 
-			if (!pMesh->M.is_skipcell(idx)) {
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//Now estimate magnetization using previous RK4 evaluations
-				pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = eval_block.eval(idx);
 
-				if (renormalize) {
+					//Now estimate magnetization using previous RK4 evaluations
+					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
-			}
 		}
 	}
 }
@@ -0,0 +1,301 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_ROS2
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//--------------------------------------------- ROSENBROCK-W 2-STAGE (2nd order solution, embedded 1st order error), EXCHANGE FIELD IMPLICIT
+
+//sEval0 holds dM1 = dT * k1, sEval1 the right hand side of the second stage, sM1 the starting magnetization (used by the implicit solver as the frozen magnetization).
+
+//implicit exchange solver coefficients for given cell (ROS2), using LLG form equation coefficients for the current time step
+DBL2 DifferentialEquationFM::ROS2_Exchange_Coefficients(int idx)
+{
+	double Ms = pMesh->Ms;
+	double alpha = pMesh->alpha;
+	double grel = pMesh->grel;
+	double A = pMesh->A;
+	pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha, pMesh->grel, grel, pMesh->A, A);
+
+	if (!Ms) return DBL2();
+
+	double a, b;
+
+	if (setODE == ODE_LLGSTATIC || setODE == ODE_LLGSTATICSA) {
+
+		a = 0.0;
+		b = -GAMMA * grel / (2 * Ms);
+	}
+	else {
+
+		a = -GAMMA * grel / (1 + alpha * alpha);
+		b = a * alpha / Ms;
+	}
+
+	//exchange field is 2A / (mu0 Ms^2) * delsq M
+	return DBL2(a, b) * (ROS2_GAMMA * dT * 2 * A / (MU0 * Ms * Ms));
+}
+
+void DifferentialEquationFM::RunROS2_Step0_withReductions(void)
+{
+	implicit_exchange.enabled = pMesh->IsModuleSet(MOD_EXCHANGE) || pMesh->IsModuleSet(MOD_DMEXCHANGE) || pMesh->IsModuleSet(MOD_IDMEXCHANGE) || pMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange.converged = true;
+
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					if (implicit_exchange.enabled) implicit_exchange.coeff[idx] = ROS2_Exchange_Coefficients(idx);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			pMesh->M[idx] = sM1[idx] + sEval0[idx];
+		}
+	}
+}
+
+void DifferentialEquationFM::RunROS2_Step0(void)
+{
+	implicit_exchange.enabled = pMesh->IsModuleSet(MOD_EXCHANGE) || pMesh->IsModuleSet(MOD_DMEXCHANGE) || pMesh->IsModuleSet(MOD_IDMEXCHANGE) || pMesh->IsModuleSet(MOD_VIDMEXCHANGE);
+	implicit_exchange.converged = true;
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//right hand side of first stage
+					sEval0[idx] = eval_block.eval(idx) * dT;
+					if (implicit_exchange.enabled) implicit_exchange.coeff[idx] = ROS2_Exchange_Coefficients(idx);
+				}
+				else {
+
+					sEval0[idx] = DBL3();
+					implicit_exchange.coeff[idx] = DBL2();
+				}
+			}
+		}
+	}
+
+	//first stage : (I - gamma * dT * J) dM1 = dT * f(M)
+	implicit_exchange.solve(sEval0, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval0[idx] = implicit_exchange.x[idx];
+			pMesh->M[idx] = sM1[idx] + sEval0[idx];
+		}
+	}
+}
+
+void DifferentialEquationFM::RunROS2_Step1_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!pMesh->M.is_skipcell(idx)) sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+				else sEval1[idx] = DBL3();
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL3 dM2 = implicit_exchange.x[idx];
+
+				pMesh->M[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+
+				//difference between 2nd order solution and embedded 1st order solution M + dM1
+				DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+
+				//projection step to preserve magnetization length
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+
+				//local truncation error
+				double _lte = GetMagnitude(difference) / Mnorm;
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+void DifferentialEquationFM::RunROS2_Step1(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int block = 0; block < Num_Eval_Blocks(); block++) {
+
+		//evaluate RHS of set equation for all cells in this block
+		ODEEvalBlock& eval_block = Evaluate_Equation_Block(block);
+
+		for (int idx = eval_block.start; idx < eval_block.end; idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//right hand side of second stage
+				if (!pMesh->M.is_skipcell(idx)) sEval1[idx] = eval_block.eval(idx) * dT - sEval0[idx] * 2;
+				else sEval1[idx] = DBL3();
+			}
+		}
+	}
+
+	//second stage : (I - gamma * dT * J) dM2 = dT * f(M + dM1) - 2 * dM1
+	implicit_exchange.solve(sEval1, sM1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL3 dM2 = implicit_exchange.x[idx];
+
+				pMesh->M[idx] = sM1[idx] + sEval0[idx] * 1.5 + dM2 * 0.5;
+
+				//difference between 2nd order solution and embedded 1st order solution M + dM1
+				DBL3 difference = (sEval0[idx] + dM2) * 0.5;
+
+				//projection step to preserve magnetization length
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+
+				//local truncation error
+				double _lte = GetMagnitude(difference) / pMesh->M[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+
+	//implicit exchange solver didn't converge in either stage : reject time step
+	if (!implicit_exchange.converged) lte_reduction.max = Get_Reject_LTE(ROS2_DTDECREASE_FAIL);
+}
+
+#endif
+#endif
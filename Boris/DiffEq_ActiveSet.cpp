@@ -0,0 +1,170 @@
+#include "stdafx.h"
+#include "DiffEq.h"
+#include "Mesh.h"
+
+//----------------------------------- Active Set
+
+//Blocks of ODE_EVALBLOCK cells (same blocks as used for equation evaluation) are frozen when the maximum torque |M x Heff| / |M|^2 in the block drops below activeset_tolerance.
+//Frozen blocks have all their cells marked as skip cells, so the evaluation methods leave them unchanged. Effective fields are still computed everywhere, thus frozen blocks can be re-checked.
+
+//update active set at the start of a time step : freeze blocks with maximum torque below activeset_tolerance for activeset_steps time steps (cells in frozen blocks marked as skip cells),
+//re-check frozen blocks when their countdown expires, and reactivate frozen blocks next to active blocks. Return true if any cells were frozen or reactivated.
+bool DifferentialEquation::Update_ActiveSet(void)
+{
+	int num_cells = pMesh->n.dim();
+	int num_blocks = (num_cells + ODE_EVALBLOCK - 1) / ODE_EVALBLOCK;
+
+	//sub-lattice B included if set (antiferromagnetic meshes)
+	bool two_sublattice = pMesh->M2.linear_size() == pMesh->M.linear_size();
+
+	//(re)start active set if mesh dimensions changed
+	if ((int)activeset_frozen.size() != num_blocks || (int)activeset_skipcells.size() != num_cells) {
+
+		Clear_ActiveSet();
+
+		activeset_frozen.assign(num_blocks, 0);
+		activeset_hot.assign(num_blocks, false);
+		activeset_skipcells.assign(num_cells, false);
+	}
+
+	//maximum torque in given block, ignoring cells skipped for other reasons
+	auto block_torque = [&](int block) -> double {
+
+		double torque = 0.0;
+
+		for (int idx = block * ODE_EVALBLOCK; idx < (block + 1) * ODE_EVALBLOCK && idx < num_cells; idx++) {
+
+			if (pMesh->M.is_empty(idx) || (pMesh->M.is_skipcell(idx) && !activeset_skipcells[idx])) continue;
+
+			double Mnorm = pMesh->M[idx].norm();
+			if (Mnorm) torque = maximum(torque, GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+			if (two_sublattice) {
+
+				double M2norm = pMesh->M2[idx].norm();
+				if (M2norm) torque = maximum(torque, GetMagnitude(pMesh->M2[idx] ^ pMesh->Heff2[idx]) / (M2norm * M2norm));
+			}
+		}
+
+		return torque;
+	};
+
+	//1. check active blocks, and frozen blocks whose countdown has expired
+#pragma omp parallel for
+	for (int block = 0; block < num_blocks; block++) {
+
+		activeset_hot[block] = false;
+
+		if (activeset_frozen[block] > 0 && --activeset_frozen[block] > 0) continue;
+
+		if (block_torque(block) < activeset_tolerance) activeset_frozen[block] = activeset_steps;
+		else activeset_hot[block] = true;
+	}
+
+	//2. reactivate frozen blocks next to active blocks : neighbours are the blocks containing cells adjacent to this block's cells along x, y and z
+	int neighbor_offsets[3] = { 1, pMesh->n.x, pMesh->n.x * pMesh->n.y };
+
+	auto is_near_hot = [&](int block) -> bool {
+
+		int start = block * ODE_EVALBLOCK;
+		int end = (start + ODE_EVALBLOCK < num_cells ? start + ODE_EVALBLOCK : num_cells);
+
+		for (int offset : neighbor_offsets) {
+
+			for (int sign = -1; sign <= 1; sign += 2) {
+
+				int first = start + sign * offset;
+				int last = end - 1 + sign * offset;
+
+				if (last < 0 || first >= num_cells) continue;
+
+				for (int nblock = (first > 0 ? first : 0) / ODE_EVALBLOCK; nblock <= (last < num_cells ? last : num_cells - 1) / ODE_EVALBLOCK; nblock++) {
+
+					if (activeset_hot[nblock]) return true;
+				}
+			}
+		}
+
+		return false;
+	};
+
+#pragma omp parallel for
+	for (int block = 0; block < num_blocks; block++) {
+
+		if (activeset_frozen[block] > 0 && is_near_hot(block)) activeset_frozen[block] = 0;
+	}
+
+	//3. set skip cell flags in frozen blocks, and clear them in active blocks (only those set here)
+	int changed_cells = 0;
+
+#pragma omp parallel for reduction(+:changed_cells)
+	for (int block = 0; block < num_blocks; block++) {
+
+		bool frozen = activeset_frozen[block] > 0;
+
+		for (int idx = block * ODE_EVALBLOCK; idx < (block + 1) * ODE_EVALBLOCK && idx < num_cells; idx++) {
+
+			if (frozen) {
+
+				if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+					pMesh->M.set_skipcell(idx);
+					if (two_sublattice) pMesh->M2.set_skipcell(idx);
+					activeset_skipcells[idx] = true;
+					changed_cells++;
+				}
+			}
+			else if (activeset_skipcells[idx]) {
+
+				pMesh->M.set_skipcell(idx, false);
+				if (two_sublattice) pMesh->M2.set_skipcell(idx, false);
+				activeset_skipcells[idx] = false;
+				changed_cells++;
+			}
+		}
+	}
+
+	return changed_cells > 0;
+}
+
+//reactivate all blocks and clear skip cell flags set by the active set
+void DifferentialEquation::Clear_ActiveSet(void)
+{
+	//if mesh dimensions have changed the flags have been recalculated already
+	if (activeset_skipcells.size() == pMesh->M.linear_size()) {
+
+		bool two_sublattice = pMesh->M2.linear_size() == pMesh->M.linear_size();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)activeset_skipcells.size(); idx++) {
+
+			if (activeset_skipcells[idx]) {
+
+				pMesh->M.set_skipcell(idx, false);
+				if (two_sublattice) pMesh->M2.set_skipcell(idx, false);
+			}
+		}
+	}
+
+	activeset_frozen.clear();
+	activeset_hot.clear();
+	activeset_skipcells.clear();
+}
+
+//clear (suspend = true) or set again (suspend = false) skip cell flags in frozen blocks, keeping the active set state : used so flags are not saved with the magnetization
+void DifferentialEquation::Suspend_ActiveSet(bool suspend)
+{
+	if (activeset_skipcells.size() != pMesh->M.linear_size()) return;
+
+	bool two_sublattice = pMesh->M2.linear_size() == pMesh->M.linear_size();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < (int)activeset_skipcells.size(); idx++) {
+
+		if (activeset_skipcells[idx]) {
+
+			pMesh->M.set_skipcell(idx, !suspend);
+			if (two_sublattice) pMesh->M2.set_skipcell(idx, !suspend);
+		}
+	}
+}
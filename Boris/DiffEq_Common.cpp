@@ -48,7 +48,7 @@ ODECommon::ODECommon(bool called_from_derived) :
 			VINFO(dT), VINFO(dTstoch), VINFO(time_stoch), VINFO(link_dTstoch),
 			VINFO(dTspeedup), VINFO(time_speedup), VINFO(link_dTspeedup),
 			VINFO(err_high_fail), VINFO(err_high), VINFO(err_low), VINFO(dT_increase), VINFO(dT_min), VINFO(dT_max), VINFO(eval_method_order),
-			VINFO(use_evaluation_speedup),
+			VINFO(use_evaluation_speedup), VINFO(speedup_tolerance), VINFO(multirate_substeps), VINFO(activeset_tolerance), VINFO(activeset_steps),
 			VINFO(moving_mesh), VINFO(moving_mesh_antisymmetric), VINFO(moving_mesh_threshold), VINFO(moving_mesh_dwshift)
 		}, {})
 {
@@ -233,6 +233,9 @@ void ODECommon::Set_dmdt(void)
 
 void ODECommon::Set_lte(void)
 {
+	//atomistic multi-rate pass : micromagnetic meshes not iterated
+	if (multirate_pass == MULTIRATE_ATOMISTIC) return;
+
 	//set lte as the maximum values from all the set meshes
 	for (int idx = 0; idx < pODE.size(); idx++) {
 
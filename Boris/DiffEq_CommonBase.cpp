@@ -36,6 +36,27 @@ double ODECommon_Base::dTspeedup = 0.0;
 double ODECommon_Base::time_speedup = 0.0;
 bool ODECommon_Base::link_dTspeedup = true;
 
+double ODECommon_Base::speedup_tolerance = 0.0;
+int ODECommon_Base::speedup_skipped = 0;
+double ODECommon_Base::speedup_error = 0.0;
+
+int ODECommon_Base::multirate_substeps = 1;
+int ODECommon_Base::multirate_pass = (int)MULTIRATE_NONE;
+
+double ODECommon_Base::multirate_time = 0.0;
+double ODECommon_Base::multirate_stagetime = 0.0;
+double ODECommon_Base::multirate_dT = 0.0;
+double ODECommon_Base::multirate_dT_last = 0.0;
+int ODECommon_Base::multirate_iteration = 0;
+int ODECommon_Base::multirate_stageiteration = 0;
+bool ODECommon_Base::multirate_calculate_mxh = false;
+bool ODECommon_Base::multirate_calculate_dmdt = false;
+double ODECommon_Base::multirate_atom_dT = 0.0;
+double ODECommon_Base::multirate_last_substep_dT = 0.0;
+
+double ODECommon_Base::activeset_tolerance = 0.0;
+int ODECommon_Base::activeset_steps = ACTIVESET_DEFAULT_STEPS;
+
 //-----------------------------------Evaluation Method Data
 
 bool ODECommon_Base::available = true;
@@ -78,6 +99,16 @@ bool ODECommon_Base::primed = false;
 
 int ODECommon_Base::sd_reset_consecutive_iters = 0;
 
+double ODECommon_Base::minimizer_energy = 0.0;
+double ODECommon_Base::ncg_energy = 0.0;
+
+double ODECommon_Base::ncg_g_sq = 0.0;
+double ODECommon_Base::ncg_g_dot_gold = 0.0;
+double ODECommon_Base::ncg_d_dot_g = 0.0;
+
+double ODECommon_Base::ncg_g_sq_old = 0.0;
+double ODECommon_Base::ncg_d_dot_g_old = 0.0;
+
 //-----------------------------------Moving mesh data
 
 bool ODECommon_Base::moving_mesh = false;
@@ -174,6 +205,9 @@ BError ODECommon_Base::SwitchCUDAState(bool cudaState)
 
 	primed = false;
 
+	//active set only used without CUDA : make sure its skip cell flags are not copied to gpu memory
+	ClearActiveSet();
+
 #endif
 
 	return error;
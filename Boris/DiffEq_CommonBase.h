@@ -22,6 +22,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 class SuperMesh;
+class CheckpointFile;
 
 class ODECommon;
 class Atom_ODECommon;
@@ -76,6 +77,47 @@ protected:
 	//by default dTspeedup = dT, but if this flag is set to false dTspeedup can be independently set
 	static bool link_dTspeedup;
 
+	//adaptive evaluation speedup : if greater than zero, demag modules which support it (cuda 0) decide at every evaluation whether to recompute the demag field or extrapolate it from previous evaluations,
+	//and at which order (up to that set by use_evaluation_speedup), by estimating the relative extrapolation error and comparing it to this tolerance. dTspeedup is not used by these modules in this mode.
+	static double speedup_tolerance;
+	//number of demag field evaluations replaced by extrapolation in adaptive evaluation speedup mode (since last reset)
+	static int speedup_skipped;
+	//estimated relative extrapolation error for the last demag field evaluation in adaptive evaluation speedup mode
+	static double speedup_error;
+
+	//-----------------------------------Multi-rate time stepping
+
+	//if greater than 1, and both micromagnetic and atomistic meshes have ODE solvers set, the atomistic meshes are advanced with this number of equal sub-steps for every micromagnetic time step.
+	//with adaptive evaluation methods the atomistic sub-steps are error controlled (so more sub-steps may be needed), and the micromagnetic time step is limited to multirate_substeps atomistic time steps.
+	//coupling fields computed on the super-mesh are exchanged at synchronization points (start of each micromagnetic time step) and held constant over the sub-steps.
+	static int multirate_substeps;
+
+	//currently iterated pass : value from MULTIRATE_ enum
+	static int multirate_pass;
+
+	//values saved at the start of the atomistic pass, restored at the end so the micromagnetic time step carries on as normal
+	static double multirate_time, multirate_stagetime;
+	static double multirate_dT, multirate_dT_last;
+	static int multirate_iteration, multirate_stageiteration;
+
+	//calculate_mxh and calculate_dmdt flags at the start of the micromagnetic pass : reductions must be computed for the atomistic meshes also
+	static bool multirate_calculate_mxh, multirate_calculate_dmdt;
+
+	//atomistic pass : time step set by the atomistic error control (before the last sub-step is shortened to end at the synchronization point)
+	static double multirate_atom_dT;
+
+	//atomistic pass : duration of the sub-step ending at the synchronization point, zero until it is started
+	static double multirate_last_substep_dT;
+
+	//-----------------------------------Active set
+
+	//if greater than zero, blocks of cells in micromagnetic meshes with maximum normalized torque (mxh) below this tolerance are frozen during relaxation, i.e. not evaluated for activeset_steps time steps
+	//after which they are re-checked. Frozen blocks next to active blocks are reactivated.
+	static double activeset_tolerance;
+
+	//number of time steps a frozen block remains frozen before being re-checked
+	static int activeset_steps;
+
 	//-----------------------------------Evaluation Method Data
 
 	//flag to indicate if evaluation method has completed a full iteration
@@ -144,6 +186,16 @@ protected:
 	//when we have to reset steepest descent keep track of it, so we can increase the reset time if we have to reset every iteration: can get stuck otherwise
 	static int sd_reset_consecutive_iters;
 
+	//nonlinear conjugate gradient minimizer (NCG) : total energy density at the current evaluation (set before each iteration), and at the last accepted point of the line search
+	static double minimizer_energy;
+	static double ncg_energy;
+
+	//NCG : sums over all meshes of G.G, G.G_old (with G_old transported to the current point), d.G, where G is the gradient and d the search direction. Reset before running across all meshes.
+	static double ncg_g_sq, ncg_g_dot_gold, ncg_d_dot_g;
+
+	//NCG : G.G and d.G values at the previous accepted point
+	static double ncg_g_sq_old, ncg_d_dot_g_old;
+
 	//-----------------------------------Moving mesh data
 
 	//use moving mesh algorithm?
@@ -165,6 +217,11 @@ protected:
 	static bool solve_spin_current_mm;
 	static bool solve_spin_current_a;
 
+	//----------------------------------- Runtime Iteration Helpers (used in ODE solvers)
+
+	//local truncation error value for which SetAdaptiveTimeStep rejects the time step and reduces it by given factor (e.g. if an implicit solver didn't converge)
+	double Get_Reject_LTE(double dT_factor) { return err_high_fail * 0.8 / pow(dT_factor, eval_method_order + 1); }
+
 private:
 
 	//----------------------------------- Runtime Iteration Helpers
@@ -174,6 +231,10 @@ private:
 	//this uses a 2 level error threshold -> above the high threshold fail, adjust step based on max_error / error ratio. Below the low error threshold increase step by a small constant factor.
 	bool SetAdaptiveTimeStep(void);
 
+	//number of micromagnetic and atomistic ODE solvers to iterate in the current multi-rate pass (all of them if not in multi-rate mode)
+	int Num_ODE_Iterated(void);
+	int Num_Atom_ODE_Iterated(void);
+
 protected:
 	
 	//----------------------------------- Runtime Iteration Helpers
@@ -231,6 +292,12 @@ public:
 	//get total time with evaluation step resolution level
 	double Get_EvalStep_Time(void);
 
+	//adaptive evaluation speedup mode is on if a tolerance is set, and at least 2 previous evaluations can be used (linear)
+	bool Is_Speedup_Adaptive(void) { return speedup_tolerance > 0.0 && use_evaluation_speedup >= EVALSPEEDUP_LINEAR; }
+
+	//demag modules call this in adaptive evaluation speedup mode after deciding to recompute (skipped = false) or extrapolate (skipped = true), with the estimated relative extrapolation error
+	void Speedup_Evaluation_Report(bool skipped, double error) { if (skipped) speedup_skipped++; speedup_error = error; }
+
 	//----------------------------------- Evaluation Method and Control: DiffEq_CommonBase_Control.cpp
 
 	BError SetEvaluationMethod(EVAL_ evalMethod_);
@@ -251,6 +318,64 @@ public:
 
 	void SetEvaluationSpeedup(int status) { if (status >= EVALSPEEDUP_NONE && status < EVALSPEEDUP_NUMENTRIES) use_evaluation_speedup = status; }
 
+	void SetSpeedupTolerance(double tolerance) { speedup_tolerance = (tolerance > 0.0 ? tolerance : 0.0); }
+
+	//energy minimizers which use a line search (NCG) need the total energy density for the current evaluation : set before each iteration
+	void Set_Minimizer_Energy(double energy_density) { minimizer_energy = energy_density; }
+
+	//----------------------------------- Multi-rate time stepping : DiffEq_CommonBase_MultiRate.cpp
+
+	//multi-rate time stepping is used if set, both micromagnetic and atomistic ODE solvers are active, and the evaluation method supports it (not with ABM since the previous evaluations are not kept per pass, nor with the energy minimizers)
+	bool Use_MultiRate(void);
+
+	//start micromagnetic pass : iterate only micromagnetic ODE solvers, with the full time step (adaptive if the evaluation method is)
+	void MultiRate_Begin_Micromagnetic(void);
+
+	//start atomistic pass : micromagnetic time step has been solved, now cover it with atomistic sub-steps, starting with multirate_substeps equal sub-steps
+	void MultiRate_Begin_Atomistic(void);
+
+	//call before every atomistic sub-step : the sub-step is shortened if needed to end at the synchronization point
+	void MultiRate_Begin_Substep(void);
+
+	//atomistic pass has reached the synchronization point (end of micromagnetic time step)
+	bool MultiRate_Atomistic_Done(void);
+
+	//evaluation methods with adaptive time step : atomistic sub-steps are error controlled
+	bool MultiRate_Adaptive(void);
+
+	//atomistic pass finished : restore time, iteration and time step values from the micromagnetic pass
+	void MultiRate_End(void);
+
+	//coupling fields to hold over atomistic sub-steps are computed at the start of the micromagnetic time step
+	bool Is_MultiRate_SyncPoint(void) { return multirate_pass == MULTIRATE_MICROMAGNETIC && evalStep == 0; }
+
+	int Get_MultiRate_Pass(void) { return multirate_pass; }
+
+	void SetMultiRateSubsteps(int substeps) { multirate_substeps = (substeps > 1 ? substeps : 1); }
+	int GetMultiRateSubsteps(void) { return multirate_substeps; }
+
+	//----------------------------------- Active set : DiffEq_CommonBase_ActiveSet.cpp
+
+	//set active set tolerance (0 disables the active set) and number of time steps frozen blocks remain frozen before being re-checked
+	void SetActiveSet(double tolerance, int steps);
+
+	double GetActiveSetTolerance(void) { return activeset_tolerance; }
+	int GetActiveSetSteps(void) { return activeset_steps; }
+
+	//update active set in all micromagnetic meshes : call at the start of a time step
+	void ActiveSetAlgorithm(void);
+
+	//reactivate all blocks in all micromagnetic meshes
+	void ClearActiveSet(void);
+
+	//clear (suspend = true) or set again (suspend = false) skip cell flags of frozen blocks in all micromagnetic meshes, keeping the active set state
+	void SuspendActiveSet(bool suspend);
+
+	//----------------------------------- Checkpoint : DiffEq_CommonBase_Checkpoint.cpp
+
+	//save, verify or load ODE solver state in binary checkpoint : common values (time, stage and time step control, evaluation method state), then evaluation scratch spaces in all meshes with an ODE set
+	void Checkpoint_State(CheckpointFile& cpt, SuperMesh* pSMesh);
+
 	//----------------------------------- Moving Mesh Methods : DiffEq_CommonBase_MovingMesh.cpp
 
 	void SetMoveMeshTrigger(bool status, int meshId = -1);
@@ -294,6 +419,11 @@ public:
 
 	int GetEvaluationSpeedup(void) { return use_evaluation_speedup; }
 
+	double GetSpeedupTolerance(void) { return speedup_tolerance; }
+
+	int Get_Speedup_Skipped(void) { return speedup_skipped; }
+	double Get_Speedup_Error(void) { return speedup_error; }
+
 	//----------------------------------- Value Getters
 
 	double Get_mxh(void);
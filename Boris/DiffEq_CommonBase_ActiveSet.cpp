@@ -0,0 +1,51 @@
+#include "stdafx.h"
+#include "DiffEq_CommonBase.h"
+
+#include "DiffEq_Common.h"
+#include "DiffEq.h"
+
+//----------------------------------- Active set
+
+//set active set tolerance (0 disables the active set) and number of time steps frozen blocks remain frozen before being re-checked
+void ODECommon_Base::SetActiveSet(double tolerance, int steps)
+{
+	activeset_tolerance = (tolerance > 0.0 ? tolerance : 0.0);
+	activeset_steps = (steps > 1 ? steps : 1);
+
+	if (activeset_tolerance == 0.0) ClearActiveSet();
+}
+
+//update active set in all micromagnetic meshes : call at the start of a time step
+//Not used with moving mesh (frozen blocks would be shifted), nor before the first time step in a stage (effective fields must be up to date).
+void ODECommon_Base::ActiveSetAlgorithm(void)
+{
+	if (activeset_tolerance <= 0.0 || moving_mesh || stageiteration == 0) return;
+
+	bool changed = false;
+
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		changed |= podeSolver->pODE[idx]->Update_ActiveSet();
+	}
+
+	//evaluation methods which keep previous evaluations (or sums over all cells) between time steps must start again
+	if (changed) primed = false;
+}
+
+//reactivate all blocks in all micromagnetic meshes
+void ODECommon_Base::ClearActiveSet(void)
+{
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		podeSolver->pODE[idx]->Clear_ActiveSet();
+	}
+}
+
+//clear (suspend = true) or set again (suspend = false) skip cell flags of frozen blocks in all micromagnetic meshes, keeping the active set state
+void ODECommon_Base::SuspendActiveSet(bool suspend)
+{
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		podeSolver->pODE[idx]->Suspend_ActiveSet(suspend);
+	}
+}
@@ -0,0 +1,124 @@
+#include "stdafx.h"
+#include "DiffEq_CommonBase.h"
+
+#include "DiffEq_Common.h"
+#include "Atom_DiffEq_Common.h"
+
+#include "DiffEq.h"
+#include "Atom_DiffEq.h"
+
+#include "SuperMesh.h"
+#include "CheckpointFile.h"
+
+//----------------------------------- Checkpoint
+
+//save, verify or load ODE solver state in binary checkpoint : common values (time, stage and time step control, evaluation method state), then evaluation scratch spaces in all meshes with an ODE set
+void ODECommon_Base::Checkpoint_State(CheckpointFile& cpt, SuperMesh* pSMesh)
+{
+	//evaluation method state only meaningful for same equations and evaluation method
+	cpt.check("evalMethod", evalMethod);
+	cpt.check("setODE", podeSolver->setODE);
+	cpt.check("atom_setODE", patom_odeSolver->setODE);
+
+	//primary data
+	cpt.value("iteration", iteration);
+	cpt.value("stageiteration", stageiteration);
+	cpt.value("time", time);
+	cpt.value("stagetime", stagetime);
+
+	//time step, stochastic field and evaluation speedup timing
+	cpt.value("dT", dT);
+	cpt.value("dT_last", dT_last);
+	cpt.value("dTstoch", dTstoch);
+	cpt.value("time_stoch", time_stoch);
+	cpt.value("dTspeedup", dTspeedup);
+	cpt.value("time_speedup", time_speedup);
+	cpt.value("speedup_skipped", speedup_skipped);
+	cpt.value("speedup_error", speedup_error);
+
+	//evaluation method data
+	cpt.value("available", available);
+	cpt.value("evalStep", evalStep);
+
+	cpt.value("mxh", mxh);
+	cpt.value("dmdt", dmdt);
+	cpt.value("calculate_mxh", calculate_mxh);
+	cpt.value("calculate_dmdt", calculate_dmdt);
+
+	//adaptive time step control
+	cpt.value("lte", lte);
+	cpt.value("dT_min", dT_min);
+	cpt.value("dT_max", dT_max);
+
+	//special evaluation values (ABM, SD, NCG)
+	cpt.value("alternator", alternator);
+	cpt.value("primed", primed);
+	cpt.value("sd_reset_consecutive_iters", sd_reset_consecutive_iters);
+	cpt.value("ncg_energy", ncg_energy);
+	cpt.value("ncg_g_sq_old", ncg_g_sq_old);
+	cpt.value("ncg_d_dot_g_old", ncg_d_dot_g_old);
+
+	cpt.value("delta_m_sq", podeSolver->delta_m_sq);
+	cpt.value("delta_m2_sq", podeSolver->delta_m2_sq);
+	cpt.value("delta_G_sq", podeSolver->delta_G_sq);
+	cpt.value("delta_G2_sq", podeSolver->delta_G2_sq);
+	cpt.value("delta_m_dot_delta_G", podeSolver->delta_m_dot_delta_G);
+	cpt.value("delta_m2_dot_delta_G2", podeSolver->delta_m2_dot_delta_G2);
+
+	cpt.value("atom_delta_m_sq", patom_odeSolver->delta_m_sq);
+	cpt.value("atom_delta_m2_sq", patom_odeSolver->delta_m2_sq);
+	cpt.value("atom_delta_G_sq", patom_odeSolver->delta_G_sq);
+	cpt.value("atom_delta_G2_sq", patom_odeSolver->delta_G2_sq);
+	cpt.value("atom_delta_m_dot_delta_G", patom_odeSolver->delta_m_dot_delta_G);
+	cpt.value("atom_delta_m2_dot_delta_G2", patom_odeSolver->delta_m2_dot_delta_G2);
+
+	//moving mesh
+	cpt.value("moving_mesh_dwshift", moving_mesh_dwshift);
+
+	//evaluation scratch spaces in meshes with an ODE set, in super-mesh order (chunks named using mesh names)
+	for (int idx_mesh = 0; idx_mesh < pSMesh->size(); idx_mesh++) {
+
+		std::string prefix = pSMesh->key_from_meshIdx(idx_mesh) + "/";
+
+		for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+			if (podeSolver->pODE[idx]->pMesh == (*pSMesh)[idx_mesh]) {
+
+#if COMPILECUDA == 1
+				//with CUDA enabled the scratch spaces are held in gpu memory : copy them to cpu memory first without changing the gpu state
+				if (cpt.is_saving() && podeSolver->pODE[idx]->pmeshODECUDA) podeSolver->pODE[idx]->pmeshODECUDA->CopyMemory_to_cpu();
+#endif
+				podeSolver->pODE[idx]->Checkpoint_State(cpt, prefix);
+
+#if COMPILECUDA == 1
+				//loaded in cpu memory : copy to gpu memory without reallocating, so the evaluation method state is kept
+				if (cpt.is_loading() && podeSolver->pODE[idx]->pmeshODECUDA) podeSolver->pODE[idx]->pmeshODECUDA->CopyMemory_to_gpu();
+#endif
+			}
+		}
+
+		for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+			if (patom_odeSolver->pODE[idx]->paMesh == (*pSMesh)[idx_mesh]) {
+
+#if COMPILECUDA == 1
+				if (cpt.is_saving() && patom_odeSolver->pODE[idx]->pameshODECUDA) patom_odeSolver->pODE[idx]->pameshODECUDA->CopyMemory_to_cpu();
+#endif
+				patom_odeSolver->pODE[idx]->Checkpoint_State(cpt, prefix);
+
+#if COMPILECUDA == 1
+				if (cpt.is_loading() && patom_odeSolver->pODE[idx]->pameshODECUDA) patom_odeSolver->pODE[idx]->pameshODECUDA->CopyMemory_to_gpu();
+#endif
+			}
+		}
+	}
+
+#if COMPILECUDA == 1
+	//time, time step and evaluation method values loaded in cpu memory : make sure the gpu copies match
+	if (cpt.is_loading()) {
+
+		if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
+		if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
+	}
+#endif
+}
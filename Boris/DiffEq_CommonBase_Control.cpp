@@ -83,6 +83,16 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	}
 	break;
 
+	case EVAL_NCG:
+	{
+		//starting trial step for the line search, after which trial steps are estimated from the previous accepted step
+		dT = NCG_DEFAULT_DT;
+		dT_min = NCG_MINDT;
+		dT_max = NCG_MAXDT;
+		eval_method_order = 1;
+	}
+	break;
+
 	default:
 	case EVAL_RKF45:
 	{
@@ -131,6 +141,32 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 		eval_method_order = 6;
 	}
 	break;
+
+	case EVAL_LSRK43:
+	{
+		dT = LSRK_DEFAULT_DT;
+
+		err_high_fail = LSRK_RELERRFAIL;
+		dT_increase = LSRK_DTINCREASE;
+		dT_max = LSRK_MAXDT;
+		dT_min = LSRK_MINDT;
+		//4th order solution, but error estimate is from embedded 3rd order solution
+		eval_method_order = 3;
+	}
+	break;
+
+	case EVAL_ROS2:
+	{
+		dT = ROS2_DEFAULT_DT;
+
+		err_high_fail = ROS2_RELERRFAIL;
+		dT_increase = ROS2_DTINCREASE;
+		dT_max = ROS2_MAXDT;
+		dT_min = ROS2_MINDT;
+		//2nd order solution with embedded 1st order solution, as for AHEUN
+		eval_method_order = 2;
+	}
+	break;
 	}
 
 	//initial settings
@@ -169,6 +205,9 @@ void ODECommon_Base::Reset(void)
 
 	time_speedup = 0.0;
 
+	speedup_skipped = 0;
+	speedup_error = 0.0;
+
 	mxh = 1.0;
 	dmdt = 1.0;
 
@@ -183,6 +222,8 @@ void ODECommon_Base::Reset(void)
 
 	moving_mesh_dwshift = 0.0;
 
+	ClearActiveSet();
+
 #if COMPILECUDA == 1
 	if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
 	if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
@@ -206,6 +247,8 @@ void ODECommon_Base::NewStage(void)
 	calculate_mxh = true;
 	calculate_dmdt = true;
 
+	ClearActiveSet();
+
 #if COMPILECUDA == 1
 	if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
 	if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
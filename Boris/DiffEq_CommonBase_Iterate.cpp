@@ -72,12 +72,12 @@ void ODECommon_Base::Iterate(void)
 #ifdef ODE_EVAL_COMPILATION_EULER
 		if (calculate_mxh || calculate_dmdt) {
 
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunEuler_withReductions();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunEuler_withReductions();
 			}
@@ -100,12 +100,12 @@ void ODECommon_Base::Iterate(void)
 		}
 		else {
 
-			for (int idx = 0; idx < (int)podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunEuler();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunEuler();
 			}
@@ -126,12 +126,12 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunTEuler_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunTEuler_Step0_withReductions();
 				}
@@ -143,12 +143,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunTEuler_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunTEuler_Step0();
 				}
@@ -161,12 +161,12 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunTEuler_Step1_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunTEuler_Step1_withReductions();
 				}
@@ -178,12 +178,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunTEuler_Step1();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunTEuler_Step1();
 				}
@@ -208,12 +208,12 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunAHeun_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunAHeun_Step0_withReductions();
 				}
@@ -225,12 +225,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunAHeun_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunAHeun_Step0();
 				}
@@ -243,12 +243,12 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunAHeun_Step1_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunAHeun_Step1_withReductions();
 				}
@@ -260,12 +260,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunAHeun_Step1();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunAHeun_Step1();
 				}
@@ -303,12 +303,12 @@ void ODECommon_Base::Iterate(void)
 
 				if (calculate_mxh) {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 						podeSolver->pODE[idx]->RunABM_Predictor_withReductions();
 					}
 
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 						patom_odeSolver->pODE[idx]->RunABM_Predictor_withReductions();
 					}
@@ -321,12 +321,12 @@ void ODECommon_Base::Iterate(void)
 				}
 				else {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 						podeSolver->pODE[idx]->RunABM_Predictor();
 					}
 
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 						patom_odeSolver->pODE[idx]->RunABM_Predictor();
 					}
@@ -339,12 +339,12 @@ void ODECommon_Base::Iterate(void)
 
 				if (calculate_dmdt) {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 						podeSolver->pODE[idx]->RunABM_Corrector_withReductions();
 					}
 
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 						patom_odeSolver->pODE[idx]->RunABM_Corrector_withReductions();
 					}
@@ -357,12 +357,12 @@ void ODECommon_Base::Iterate(void)
 				}
 				else {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 						podeSolver->pODE[idx]->RunABM_Corrector();
 					}
 
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 						patom_odeSolver->pODE[idx]->RunABM_Corrector();
 					}
@@ -396,12 +396,12 @@ void ODECommon_Base::Iterate(void)
 
 			if (evalStep == 0) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunABM_TEuler0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunABM_TEuler0();
 				}
@@ -411,12 +411,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunABM_TEuler1();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunABM_TEuler1();
 				}
@@ -446,12 +446,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK23_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK23_Step0_withReductions();
 				}
@@ -463,12 +463,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK23_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK23_Step0();
 				}
@@ -498,12 +498,12 @@ void ODECommon_Base::Iterate(void)
 			else primed = true;
 
 			//Advance with new stepsize
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRK23_Step0_Advance();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRK23_Step0_Advance();
 			}
@@ -514,12 +514,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRK23_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRK23_Step1();
 			}
@@ -532,12 +532,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK23_Step2_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK23_Step2_withReductions();
 				}
@@ -549,12 +549,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK23_Step2();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK23_Step2();
 				}
@@ -582,12 +582,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK4_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK4_Step0_withReductions();
 				}
@@ -599,12 +599,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK4_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK4_Step0();
 				}
@@ -617,12 +617,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRK4_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRK4_Step1();
 			}
@@ -633,12 +633,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRK4_Step2();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRK4_Step2();
 			}
@@ -651,12 +651,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK4_Step3_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK4_Step3_withReductions();
 				}
@@ -668,12 +668,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRK4_Step3();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRK4_Step3();
 				}
@@ -702,12 +702,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF45_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF45_Step0_withReductions();
 				}
@@ -719,12 +719,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF45_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF45_Step0();
 				}
@@ -737,12 +737,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF45_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF45_Step1();
 			}
@@ -753,12 +753,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF45_Step2();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF45_Step2();
 			}
@@ -769,12 +769,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF45_Step3();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF45_Step3();
 			}
@@ -785,12 +785,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF45_Step4();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF45_Step4();
 			}
@@ -803,12 +803,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF45_Step5_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF45_Step5_withReductions();
 				}
@@ -820,12 +820,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF45_Step5();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF45_Step5();
 				}
@@ -864,12 +864,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF56_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF56_Step0_withReductions();
 				}
@@ -881,12 +881,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF56_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF56_Step0();
 				}
@@ -899,12 +899,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step1();
 			}
@@ -915,12 +915,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step2();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step2();
 			}
@@ -931,12 +931,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step3();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step3();
 			}
@@ -947,12 +947,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step4();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step4();
 			}
@@ -963,12 +963,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 5:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step5();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step5();
 			}
@@ -979,12 +979,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 6:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKF56_Step6();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKF56_Step6();
 			}
@@ -997,12 +997,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF56_Step7_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF56_Step7_withReductions();
 				}
@@ -1014,12 +1014,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKF56_Step7();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKF56_Step7();
 				}
@@ -1058,12 +1058,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKCK45_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKCK45_Step0_withReductions();
 				}
@@ -1075,12 +1075,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKCK45_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKCK45_Step0();
 				}
@@ -1093,12 +1093,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKCK45_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKCK45_Step1();
 			}
@@ -1109,12 +1109,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKCK45_Step2();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKCK45_Step2();
 			}
@@ -1125,12 +1125,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKCK45_Step3();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKCK45_Step3();
 			}
@@ -1141,12 +1141,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKCK45_Step4();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKCK45_Step4();
 			}
@@ -1159,12 +1159,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKCK45_Step5_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKCK45_Step5_withReductions();
 				}
@@ -1176,12 +1176,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKCK45_Step5();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKCK45_Step5();
 				}
@@ -1220,12 +1220,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKDP54_Step0_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKDP54_Step0_withReductions();
 				}
@@ -1237,12 +1237,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKDP54_Step0();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKDP54_Step0();
 				}
@@ -1272,12 +1272,12 @@ void ODECommon_Base::Iterate(void)
 			else primed = true;
 
 			//Advance magnetization with new stepsize
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKDP54_Step0_Advance();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKDP54_Step0_Advance();
 			}
@@ -1288,12 +1288,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKDP54_Step1();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKDP54_Step1();
 			}
@@ -1304,12 +1304,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKDP54_Step2();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKDP54_Step2();
 			}
@@ -1320,12 +1320,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKDP54_Step3();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKDP54_Step3();
 			}
@@ -1336,12 +1336,12 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunRKDP54_Step4();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunRKDP54_Step4();
 			}
@@ -1354,12 +1354,12 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKDP54_Step5_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKDP54_Step5_withReductions();
 				}
@@ -1371,12 +1371,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunRKDP54_Step5();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunRKDP54_Step5();
 				}
@@ -1397,6 +1397,244 @@ void ODECommon_Base::Iterate(void)
 	}
 	break;
 
+	case EVAL_LSRK43:
+	{
+#ifdef ODE_EVAL_COMPILATION_LSRK
+		switch (evalStep) {
+
+		case 0:
+		{
+			if (calculate_mxh) {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK43_Step0_withReductions();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK43_Step0_withReductions();
+				}
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK43_Step0();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK43_Step0();
+				}
+			}
+
+			evalStep++;
+			available = false;
+		}
+		break;
+
+		case 1:
+		{
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK43_Step1();
+			}
+
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK43_Step1();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 2:
+		{
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK43_Step2();
+			}
+
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK43_Step2();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 3:
+		{
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK43_Step3();
+			}
+
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK43_Step3();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 4:
+		{
+			if (calculate_dmdt) {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK43_Step4_withReductions();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK43_Step4_withReductions();
+				}
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK43_Step4();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK43_Step4();
+				}
+			}
+
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
+
+			dT_last = dT;
+			lte = 0.0;
+			podeSolver->Set_lte();
+			patom_odeSolver->Set_lte();
+
+			if (!SetAdaptiveTimeStep()) {
+
+				podeSolver->Restore();
+				patom_odeSolver->Restore();
+			}
+		}
+		break;
+		}
+#endif
+	}
+	break;
+
+	case EVAL_ROS2:
+	{
+#ifdef ODE_EVAL_COMPILATION_ROS2
+		if (evalStep == 0) {
+
+			if (calculate_mxh) {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunROS2_Step0_withReductions();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunROS2_Step0_withReductions();
+				}
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunROS2_Step0();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunROS2_Step0();
+				}
+			}
+
+			evalStep = 1;
+			available = false;
+		}
+		else {
+
+			if (calculate_dmdt) {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunROS2_Step1_withReductions();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunROS2_Step1_withReductions();
+				}
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunROS2_Step1();
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunROS2_Step1();
+				}
+			}
+
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
+
+			dT_last = dT;
+			lte = 0.0;
+			podeSolver->Set_lte();
+			patom_odeSolver->Set_lte();
+
+			if (!SetAdaptiveTimeStep()) {
+
+				podeSolver->Restore();
+				patom_odeSolver->Restore();
+			}
+		}
+#endif
+	}
+	break;
+
 	case EVAL_SD:
 	{
 #ifdef ODE_EVAL_COMPILATION_SD
@@ -1418,12 +1656,12 @@ void ODECommon_Base::Iterate(void)
 			patom_odeSolver->delta_G_sq = 0.0;
 			patom_odeSolver->delta_m_dot_delta_G = 0.0;
 
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunSD_BB();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunSD_BB();
 			}
@@ -1459,12 +1697,12 @@ void ODECommon_Base::Iterate(void)
 			//3. set new magnetization vectors
 			if (calculate_mxh || calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunSD_Advance_withReductions();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunSD_Advance_withReductions();
 				}
@@ -1487,12 +1725,12 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 					podeSolver->pODE[idx]->RunSD_Advance();
 				}
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 					patom_odeSolver->pODE[idx]->RunSD_Advance();
 				}
@@ -1508,12 +1746,12 @@ void ODECommon_Base::Iterate(void)
 			dT = dT_min;
 
 			//0. prime the SD solver
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
 
 				podeSolver->pODE[idx]->RunSD_Start();
 			}
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
 
 				patom_odeSolver->pODE[idx]->RunSD_Start();
 			}
@@ -1529,6 +1767,175 @@ void ODECommon_Base::Iterate(void)
 #endif
 	}
 	break;
+
+	case EVAL_NCG:
+	{
+#ifdef ODE_EVAL_COMPILATION_NCG
+		//Nonlinear conjugate gradient (Polak-Ribiere+) on the unit sphere, with gradient G = (gamma/2) m x (m x Heff) as for the SD solver, so dT is the line search step with units of time.
+		//The line search is done over evaluations : every iteration evaluates the total energy at a trial point along the search direction. If the energy decreased the trial point is accepted and a new search direction is set,
+		//else the trial step is reduced and the iteration is repeated (available = false, so only accepted points count as iterations).
+		if (primed) {
+
+			if (minimizer_energy <= ncg_energy || dT <= dT_min) {
+
+				//accepted : if no further backtracking was possible the direction is not trusted, so restart with steepest descent
+				bool restart = (minimizer_energy > ncg_energy);
+				ncg_energy = minimizer_energy;
+
+				time += dT;
+				stagetime += dT;
+
+				//1. gradient at accepted point
+				ncg_g_sq = 0.0;
+				ncg_g_dot_gold = 0.0;
+
+				if (calculate_mxh || calculate_dmdt) {
+
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+						podeSolver->pODE[idx]->RunNCG_Gradient_withReductions();
+					}
+
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+						patom_odeSolver->pODE[idx]->RunNCG_Gradient_withReductions();
+					}
+
+					if (calculate_mxh) {
+
+						calculate_mxh = false;
+						mxh = 0.0;
+						podeSolver->Set_mxh();
+						patom_odeSolver->Set_mxh();
+					}
+
+					if (calculate_dmdt) {
+
+						calculate_dmdt = false;
+						dmdt = 0.0;
+						podeSolver->Set_dmdt();
+						patom_odeSolver->Set_dmdt();
+					}
+				}
+				else {
+
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+						podeSolver->pODE[idx]->RunNCG_Gradient();
+					}
+
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+						patom_odeSolver->pODE[idx]->RunNCG_Gradient();
+					}
+				}
+
+				//2. new search direction with Polak-Ribiere+ beta, restarting with steepest descent if not a descent direction
+				double beta = 0.0;
+				if (!restart && ncg_g_sq_old) beta = maximum((ncg_g_sq - ncg_g_dot_gold) / ncg_g_sq_old, 0.0);
+
+				ncg_d_dot_g = 0.0;
+
+				for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+					podeSolver->pODE[idx]->RunNCG_Direction(beta);
+				}
+
+				for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunNCG_Direction(beta);
+				}
+
+				if (beta && ncg_d_dot_g >= 0.0) {
+
+					ncg_d_dot_g = 0.0;
+
+					for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+						podeSolver->pODE[idx]->RunNCG_Direction(0.0);
+					}
+
+					for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+						patom_odeSolver->pODE[idx]->RunNCG_Direction(0.0);
+					}
+				}
+
+				//3. first trial step along new direction : keep the same first order energy change as for the previous accepted step (d.G values are negative)
+				if (ncg_d_dot_g < 0.0 && ncg_d_dot_g_old < 0.0) {
+
+					double dT_new = dT * ncg_d_dot_g_old / ncg_d_dot_g;
+					dT = (dT_new < dT * NCG_DTINCREASE ? dT_new : dT * NCG_DTINCREASE);
+				}
+
+				if (dT < dT_min) dT = dT_min;
+				if (dT > dT_max) dT = dT_max;
+
+				ncg_g_sq_old = ncg_g_sq;
+				ncg_d_dot_g_old = ncg_d_dot_g;
+
+				iteration++;
+				stageiteration++;
+				available = true;
+			}
+			else {
+
+				//rejected : backtrack along same search direction
+				dT *= NCG_BACKTRACK;
+				if (dT < dT_min) dT = dT_min;
+
+				available = false;
+			}
+
+			//4. set trial point
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+				podeSolver->pODE[idx]->RunNCG_Advance();
+			}
+
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunNCG_Advance();
+			}
+		}
+		else {
+
+			if (dT < dT_min) dT = dT_min;
+			if (dT > dT_max) dT = dT_max;
+
+			ncg_energy = minimizer_energy;
+
+			//0. prime the NCG solver : start with steepest descent direction
+			ncg_g_sq = 0.0;
+			ncg_g_dot_gold = 0.0;
+			ncg_d_dot_g = 0.0;
+
+			for (int idx = 0; idx < Num_ODE_Iterated(); idx++) {
+
+				podeSolver->pODE[idx]->RunNCG_Gradient();
+				podeSolver->pODE[idx]->RunNCG_Direction(0.0);
+				podeSolver->pODE[idx]->RunNCG_Advance();
+			}
+
+			for (int idx = 0; idx < Num_Atom_ODE_Iterated(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunNCG_Gradient();
+				patom_odeSolver->pODE[idx]->RunNCG_Direction(0.0);
+				patom_odeSolver->pODE[idx]->RunNCG_Advance();
+			}
+
+			ncg_g_sq_old = ncg_g_sq;
+			ncg_d_dot_g_old = ncg_d_dot_g;
+
+			evalStep = 0;
+			iteration++;
+			stageiteration++;
+			available = true;
+			primed = true;
+		}
+#endif
+	}
+	break;
 	}
 }
 
@@ -1562,6 +1969,9 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 	//RKDP54
 	static double evaltime_rkdp54[6] = { 0.0, 0.2, 0.3, 0.8, 8.0 / 9, 1.0 };
 
+	//LSRK43
+	static double evaltime_lsrk43[5] = { 0.0, 0.14965902199922912, 0.37040095736420475, 0.62225576313444320, 0.95828213067469026 };
+
 	switch (evalMethod) {
 
 	case EVAL_EULER:
@@ -1606,6 +2016,12 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 	}
 	break;
 
+	case EVAL_NCG:
+	{
+		return time;
+	}
+	break;
+
 	case EVAL_RKF45:
 	{
 		return time + dT * evaltime_rkf45[evalStep];
@@ -1629,6 +2045,18 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 		return time + dT * evaltime_rkdp54[evalStep];
 	}
 	break;
+
+	case EVAL_LSRK43:
+	{
+		return time + dT * evaltime_lsrk43[evalStep];
+	}
+	break;
+
+	case EVAL_ROS2:
+	{
+		return time + dT * evaltime_teuler[evalStep];
+	}
+	break;
 	}
 
 	return time;
@@ -0,0 +1,128 @@
+#include "stdafx.h"
+#include "DiffEq_CommonBase.h"
+
+#include "DiffEq_Common.h"
+#include "Atom_DiffEq_Common.h"
+
+//----------------------------------- Multi-rate time stepping
+
+//multi-rate time stepping is used if set, both micromagnetic and atomistic ODE solvers are active, and the evaluation method supports it (not with ABM since the previous evaluations are not kept per pass, nor with the energy minimizers)
+bool ODECommon_Base::Use_MultiRate(void)
+{
+	if (multirate_substeps <= 1) return false;
+	if (!podeSolver->pODE.size() || !patom_odeSolver->pODE.size()) return false;
+	if (evalMethod == EVAL_ABM || evalMethod == EVAL_SD || evalMethod == EVAL_NCG) return false;
+
+	return true;
+}
+
+//start micromagnetic pass : iterate only micromagnetic ODE solvers, with the full time step (adaptive if the evaluation method is)
+void ODECommon_Base::MultiRate_Begin_Micromagnetic(void)
+{
+	//the micromagnetic pass will clear these flags, but the atomistic pass must also compute reductions
+	multirate_calculate_mxh = calculate_mxh;
+	multirate_calculate_dmdt = calculate_dmdt;
+
+	multirate_pass = MULTIRATE_MICROMAGNETIC;
+}
+
+//start atomistic pass : micromagnetic time step has been solved, now cover it with atomistic sub-steps, starting with multirate_substeps equal sub-steps
+void ODECommon_Base::MultiRate_Begin_Atomistic(void)
+{
+	//micromagnetic time step just solved has dT_last duration, and dT is now the next micromagnetic time step
+	multirate_time = time;
+	multirate_stagetime = stagetime;
+	multirate_dT = dT;
+	multirate_dT_last = dT_last;
+	multirate_iteration = iteration;
+	multirate_stageiteration = stageiteration;
+
+	//atomistic sub-steps start at the same time as the micromagnetic step
+	time -= dT_last;
+	stagetime -= dT_last;
+
+	//with adaptive methods the atomistic error control then adjusts the sub-steps (rejecting them if needed) within dT_min, dT_max limits : sub-steps which are too large for the atomistic solver are not accepted
+	dT = dT_last / multirate_substeps;
+	if (MultiRate_Adaptive()) dT = maximum(dT_min, minimum(dT_max, dT));
+
+	multirate_atom_dT = dT;
+	multirate_last_substep_dT = 0.0;
+
+	calculate_mxh = multirate_calculate_mxh;
+	calculate_dmdt = false;
+
+	multirate_pass = MULTIRATE_ATOMISTIC;
+}
+
+//call before every atomistic sub-step : the sub-step is shortened if needed to end at the synchronization point
+void ODECommon_Base::MultiRate_Begin_Substep(void)
+{
+	//time step set by the atomistic error control from the last accepted sub-step (not the shortened one ending at the synchronization point)
+	if (MultiRate_Adaptive()) multirate_atom_dT = dT;
+	else dT = multirate_atom_dT;
+
+	double remaining = multirate_time - time;
+
+	//don't leave a sub-step shorter than rounding errors at the end
+	if (dT * (1.0 + MULTIRATE_ENDTOLERANCE) >= remaining) {
+
+		dT = remaining;
+		multirate_last_substep_dT = dT;
+
+		//dmdt only needed for the sub-step which ends at the synchronization point
+		calculate_dmdt = multirate_calculate_dmdt;
+	}
+}
+
+//atomistic pass has reached the synchronization point (end of micromagnetic time step)
+bool ODECommon_Base::MultiRate_Atomistic_Done(void)
+{
+	//done if the last accepted sub-step is the one ending at the synchronization point (dT_last is the accepted sub-step, which differs if it was rejected and shortened)
+	return multirate_last_substep_dT > 0.0 && dT_last == multirate_last_substep_dT;
+}
+
+//atomistic pass finished : restore time, iteration and time step values from the micromagnetic pass
+void ODECommon_Base::MultiRate_End(void)
+{
+	time = multirate_time;
+	stagetime = multirate_stagetime;
+	dT = multirate_dT;
+	dT_last = multirate_dT_last;
+	iteration = multirate_iteration;
+	stageiteration = multirate_stageiteration;
+
+	//next micromagnetic time step must not be longer than multirate_substeps atomistic time steps allowed by the atomistic error control
+	if (MultiRate_Adaptive()) dT = maximum(dT_min, minimum(dT, multirate_substeps * multirate_atom_dT));
+
+	multirate_pass = MULTIRATE_NONE;
+}
+
+//evaluation methods with adaptive time step : atomistic sub-steps are error controlled
+bool ODECommon_Base::MultiRate_Adaptive(void)
+{
+	switch (evalMethod) {
+
+	case EVAL_AHEUN:
+	case EVAL_RK23:
+	case EVAL_RKF45:
+	case EVAL_RKF56:
+	case EVAL_RKCK45:
+	case EVAL_RKDP54:
+	case EVAL_LSRK43:
+	case EVAL_ROS2:
+		return dT_min < dT_max;
+	}
+
+	return false;
+}
+
+//number of micromagnetic and atomistic ODE solvers to iterate in the current multi-rate pass (all of them if not in multi-rate mode)
+int ODECommon_Base::Num_ODE_Iterated(void)
+{
+	return (multirate_pass == MULTIRATE_ATOMISTIC ? 0 : (int)podeSolver->pODE.size());
+}
+
+int ODECommon_Base::Num_Atom_ODE_Iterated(void)
+{
+	return (multirate_pass == MULTIRATE_MICROMAGNETIC ? 0 : (int)patom_odeSolver->pODE.size());
+}
@@ -62,11 +62,73 @@
 #define RKDP_MINDT	1e-15
 #define RKDP_DEFAULT_DT	0.5e-12
 
+//fixed parameters for LSRK43 adaptive time step
+#define LSRK_RELERRFAIL	1e-4
+#define LSRK_DTINCREASE	2
+#define LSRK_MAXDT	3e-12
+#define LSRK_MINDT	1e-15
+#define LSRK_DEFAULT_DT	0.5e-12
+
+//LSRK43 : Carpenter-Kennedy 2N-storage 5-stage 4th order scheme. Stage i : dM = A_i * dM + dT * f_i, M += B_i * dM.
+#define LSRK_A2	(-567301805773.0 / 1357537059087.0)
+#define LSRK_A3	(-2404267990393.0 / 2016746695238.0)
+#define LSRK_A4	(-3550918686646.0 / 2091501179385.0)
+#define LSRK_A5	(-1275806237668.0 / 842570457699.0)
+
+#define LSRK_B1	(1432997174477.0 / 9575080441755.0)
+#define LSRK_B2	(5161836677717.0 / 13612068292357.0)
+#define LSRK_B3	(1720146321549.0 / 2090206949498.0)
+#define LSRK_B4	(3134564353537.0 / 4481467310338.0)
+#define LSRK_B5	(2277821191437.0 / 14882151754819.0)
+
+//LSRK43 error weights : difference between the 4th order weights and embedded 3rd order weights (minimum norm 3rd order solution using the same stages). Error accumulated as dT * sum(E_i * f_i).
+#define LSRK_E1	-0.10621564510023723
+#define LSRK_E2	0.22837965272001509
+#define LSRK_E3	-0.16168951666556422
+#define LSRK_E4	0.036204637199672422
+#define LSRK_E5	0.0033208718461139562
+
+//fixed parameters for ROS2 adaptive time step
+#define ROS2_RELERRFAIL	1e-4
+#define ROS2_DTINCREASE	2
+#define ROS2_MAXDT	5e-12
+#define ROS2_MINDT	1e-15
+#define ROS2_DEFAULT_DT	0.5e-12
+
+//ROS2 : 2-stage linearly implicit Rosenbrock-W scheme, 2nd order for any Jacobian approximation, with the exchange field treated implicitly. Stages : (I - gamma * dT * J) k1 = f(M), (I - gamma * dT * J) k2 = f(M + dT * k1) - 2 * k1
+#define ROS2_GAMMA	1.7071067811865475
+
+//relative residual tolerance and maximum number of iterations for the implicit exchange solver
+#define ROS2_TOLERANCE	1e-6
+#define ROS2_MAXITERATIONS	1000
+
+//time step reduction factor if the implicit exchange solver didn't converge (time step rejected)
+#define ROS2_DTDECREASE_FAIL	0.5
+
 //default dT -> for the SD solver this acts as the starting timestep and the value it resets to when needed
 #define SD_DEFAULT_DT	1e-15
 #define SD_MAXDT	1e-9
 #define SD_MINDT	SD_DEFAULT_DT
 
+//default dT -> for the NCG minimizer this is the first line search trial step, subsequent trial steps are estimated from the previous accepted step
+#define NCG_DEFAULT_DT	1e-15
+#define NCG_MAXDT	1e-9
+#define NCG_MINDT	1e-17
+
+//line search : factor to reduce trial step by when rejected (energy increased), and maximum increase of trial step for a new search direction
+#define NCG_BACKTRACK	0.5
+#define NCG_DTINCREASE	4
+
+//number of cells in a block used for structure-of-arrays evaluation of equations (see DiffEq_EvalBlock.h)
+#define ODE_EVALBLOCK	64
+
+//adaptive evaluation speedup : maximum number of consecutive demag field evaluations replaced by extrapolation before a full evaluation is forced
+//the extrapolation error estimate only uses saved evaluations, so this bounds the time a stale history can be used for (e.g. when the saved evaluations are all the same)
+#define EVALSPEEDUP_ADAPTIVE_MAXSKIPS	20
+
+//default number of time steps a converged block remains frozen before being re-checked (active set)
+#define ACTIVESET_DEFAULT_STEPS	20
+
 //difficult to simulate when temperature is very close to the Curie temperature due to numerical instability, especially with stochastic equations. instead use an epsilon approach (units of Kelvin).
 #define TCURIE_EPSILON	0.5
 
@@ -113,13 +175,28 @@ enum EVAL_ {
 	//Adaptive embedded error estimator, 5th order
 	EVAL_RKDP54 = 9, EVAL_RKF56 = 10,
 
+	//Adaptive embedded error estimator, 4th order, low storage
+	EVAL_LSRK43 = 11,
+
+	//Adaptive embedded error estimator, 2nd order, linearly implicit exchange
+	EVAL_ROS2 = 12,
+
 	//Energy minimizers
-	EVAL_SD = 6
+	EVAL_SD = 6, EVAL_NCG = 13
 
-}; //Current maximum : 10
+}; //Current maximum : 13
 
 //EVALSPEEDUP_NONE : evaluate all fields every step (default)
 //EVALSPEEDUP_STEP : use previously computed demag field
 //EVALSPEEDUP_LINEAR : linear interpolation using 2 previously computed demag fields
 //EVALSPEEDUP_QUADRATIC : quadratic (polynomial) interpolation using 3 previously computed demag fields
-enum EVALSPEEDUP_ { EVALSPEEDUP_NONE = 0, EVALSPEEDUP_STEP, EVALSPEEDUP_LINEAR, EVALSPEEDUP_QUADRATIC, EVALSPEEDUP_CUBIC, EVALSPEEDUP_QUARTIC, EVALSPEEDUP_QUINTIC, EVALSPEEDUP_NUMENTRIES };
\ No newline at end of file
+enum EVALSPEEDUP_ { EVALSPEEDUP_NONE = 0, EVALSPEEDUP_STEP, EVALSPEEDUP_LINEAR, EVALSPEEDUP_QUADRATIC, EVALSPEEDUP_CUBIC, EVALSPEEDUP_QUARTIC, EVALSPEEDUP_QUINTIC, EVALSPEEDUP_NUMENTRIES };
+
+//multi-rate time stepping pass currently being iterated (mixed micromagnetic and atomistic supermeshes)
+//MULTIRATE_NONE : all ODE solvers iterated together (default)
+//MULTIRATE_MICROMAGNETIC : only micromagnetic ODE solvers iterated, with the full time step
+//MULTIRATE_ATOMISTIC : only atomistic ODE solvers iterated, with sub-steps covering the last micromagnetic time step
+enum MULTIRATE_ { MULTIRATE_NONE = 0, MULTIRATE_MICROMAGNETIC, MULTIRATE_ATOMISTIC };
+
+//multi-rate time stepping : relative tolerance used to extend an atomistic sub-step up to the synchronization point (rounding errors)
+#define MULTIRATE_ENDTOLERANCE	1e-6
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "BorisLib.h"
+
+#include "DiffEq_Defs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Block of cells for evaluation of magnetization equations in structure-of-arrays form.
+//
+//	The LLG and LLB type equations (including stochastic versions) can all be written as E = a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M, where the coefficients depend on the equation and material parameters.
+//	Cell values in a block are loaded in separate arrays for each component, so the kernels below are loops over ODE_EVALBLOCK values without dependencies, which the compiler vectorizes for the target instruction set (SSE2, AVX2, AVX-512).
+//	Empty and skipped cells have M and coefficients set to zero so they evaluate to zero.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ODEEvalBlock {
+
+	//range of cell indexes in this block : start to end - 1
+	int start = 0, end = 0;
+
+	//magnetization and effective field
+	double Mx[ODE_EVALBLOCK], My[ODE_EVALBLOCK], Mz[ODE_EVALBLOCK];
+	double Hx[ODE_EVALBLOCK], Hy[ODE_EVALBLOCK], Hz[ODE_EVALBLOCK];
+
+	//equation coefficients (not used by kernels with uniform coefficients)
+	double a[ODE_EVALBLOCK], b[ODE_EVALBLOCK], c[ODE_EVALBLOCK], d[ODE_EVALBLOCK];
+
+	//equation evaluation : kernels add to these values, which are set to zero when cells are loaded
+	double Ex[ODE_EVALBLOCK], Ey[ODE_EVALBLOCK], Ez[ODE_EVALBLOCK];
+
+	//---------------------------------------- SET-UP
+
+	//set range of cell indexes for given block number
+	void set_range(int block, int num_cells)
+	{
+		start = block * ODE_EVALBLOCK;
+		end = (start + ODE_EVALBLOCK < num_cells ? start + ODE_EVALBLOCK : num_cells);
+	}
+
+	//load magnetization and effective field for cell to be evaluated
+	void load(int idx, const DBL3& M, const DBL3& H)
+	{
+		int i = idx - start;
+
+		Mx[i] = M.x; My[i] = M.y; Mz[i] = M.z;
+		Hx[i] = H.x; Hy[i] = H.y; Hz[i] = H.z;
+		a[i] = 0.0; b[i] = 0.0; c[i] = 0.0; d[i] = 0.0;
+		Ex[i] = 0.0; Ey[i] = 0.0; Ez[i] = 0.0;
+	}
+
+	//cell not evaluated (empty or skipped)
+	void clear(int idx) { load(idx, DBL3(), DBL3()); }
+
+	//set coefficients for cell already loaded
+	void set_coefficients(int idx, double a_, double b_, double c_ = 0.0, double d_ = 0.0)
+	{
+		int i = idx - start;
+
+		a[i] = a_; b[i] = b_; c[i] = c_; d[i] = d_;
+	}
+
+	//add a field contribution for cell already loaded (e.g. thermal field)
+	void add_field(int idx, const DBL3& H)
+	{
+		int i = idx - start;
+
+		Hx[i] += H.x; Hy[i] += H.y; Hz[i] += H.z;
+	}
+
+	//add a contribution to evaluation which doesn't fit the general form (e.g. STT), or set evaluation directly (cell not evaluated by kernels, e.g. M cleared)
+	void add(int idx, const DBL3& value)
+	{
+		int i = idx - start;
+
+		Ex[i] += value.x; Ey[i] += value.y; Ez[i] += value.z;
+	}
+
+	//---------------------------------------- KERNELS
+
+	//E += a * (M x H) + b * M x (M x H) with coefficients uniform in the block
+	void Evaluate_Transverse(double a_, double b_)
+	{
+		int num_cells = end - start;
+
+		for (int i = 0; i < num_cells; i++) {
+
+			double MxH_x = My[i] * Hz[i] - Mz[i] * Hy[i];
+			double MxH_y = Mz[i] * Hx[i] - Mx[i] * Hz[i];
+			double MxH_z = Mx[i] * Hy[i] - My[i] * Hx[i];
+
+			Ex[i] += a_ * MxH_x + b_ * (My[i] * MxH_z - Mz[i] * MxH_y);
+			Ey[i] += a_ * MxH_y + b_ * (Mz[i] * MxH_x - Mx[i] * MxH_z);
+			Ez[i] += a_ * MxH_z + b_ * (Mx[i] * MxH_y - My[i] * MxH_x);
+		}
+	}
+
+	//E += a * (M x H) + b * M x (M x H) with coefficients set per cell
+	void Evaluate_Transverse(void)
+	{
+		int num_cells = end - start;
+
+		for (int i = 0; i < num_cells; i++) {
+
+			double MxH_x = My[i] * Hz[i] - Mz[i] * Hy[i];
+			double MxH_y = Mz[i] * Hx[i] - Mx[i] * Hz[i];
+			double MxH_z = Mx[i] * Hy[i] - My[i] * Hx[i];
+
+			Ex[i] += a[i] * MxH_x + b[i] * (My[i] * MxH_z - Mz[i] * MxH_y);
+			Ey[i] += a[i] * MxH_y + b[i] * (Mz[i] * MxH_x - Mx[i] * MxH_z);
+			Ez[i] += a[i] * MxH_z + b[i] * (Mx[i] * MxH_y - My[i] * MxH_x);
+		}
+	}
+
+	//E += a * (M x H) + b * M x (M x H) + (c * (M.H) + d) * M with coefficients set per cell
+	void Evaluate_Full(void)
+	{
+		int num_cells = end - start;
+
+		for (int i = 0; i < num_cells; i++) {
+
+			double MxH_x = My[i] * Hz[i] - Mz[i] * Hy[i];
+			double MxH_y = Mz[i] * Hx[i] - Mx[i] * Hz[i];
+			double MxH_z = Mx[i] * Hy[i] - My[i] * Hx[i];
+
+			double l = c[i] * (Mx[i] * Hx[i] + My[i] * Hy[i] + Mz[i] * Hz[i]) + d[i];
+
+			Ex[i] += a[i] * MxH_x + b[i] * (My[i] * MxH_z - Mz[i] * MxH_y) + l * Mx[i];
+			Ey[i] += a[i] * MxH_y + b[i] * (Mz[i] * MxH_x - Mx[i] * MxH_z) + l * My[i];
+			Ez[i] += a[i] * MxH_z + b[i] * (Mx[i] * MxH_y - My[i] * MxH_x) + l * Mz[i];
+		}
+	}
+
+	//---------------------------------------- GET
+
+	//evaluation for given cell index (must be in this block)
+	DBL3 eval(int idx) const
+	{
+		int i = idx - start;
+
+		return DBL3(Ex[i], Ey[i], Ez[i]);
+	}
+};
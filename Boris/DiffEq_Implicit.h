@@ -0,0 +1,156 @@
+#pragma once
+
+#include "BorisLib.h"
+
+#include "DiffEq_Defs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Linear solver for the implicit exchange part of the ROS2 evaluation method.
+//
+//	Solves (I - J delsq) x = rhs, where J y = a * (M x y) + b * M x (M x y) is the LLG form torque Jacobian with respect to the exchange field, with magnetization M frozen at the start of the time step,
+//	and per-cell coefficients a, b including the time step and exchange stiffness (i.e. exchange field is c * delsq M, and a, b are the equation coefficients multiplied by ROS2_GAMMA * dT * c).
+//	delsq is evaluated with the same boundary conditions as the exchange field (shape, Neumann, pbc), since the solution VECs copy the magnetization shape and pbc flags.
+//
+//	Solved by Jacobi iteration, with the cell matrix I + lambda * J inverted analytically (lambda is the delsq diagonal for interior cells) :
+//	J has no component along M, and in the plane perpendicular to M it acts as multiplication by a complex number, so the iteration converges for any time step.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ODEImplicitExchange {
+
+	//solution and Jacobi iteration work space
+	VEC_VC<DBL3> x, x_work;
+
+	//per-cell coefficients (a, b) as described above
+	VEC<DBL2> coeff;
+
+	//delsq diagonal for interior cells : 2 / h^2 summed over dimensions with more than one cell (or pbc)
+	double lambda = 0.0;
+
+	//set at the start of each time step : false if the mesh has no exchange module, so the solution is just the explicit one
+	bool enabled = false;
+
+	//number of Jacobi iterations used for the last solve
+	int iterations = 0;
+
+	//false if any solve since it was last set to true didn't converge (maximum number of iterations reached) : set at the start of each time step
+	bool converged = true;
+
+	OmpReduction<double> reduction;
+
+	//---------------------------------------- SET-UP
+
+	//size to magnetization, copying its shape and pbc flags : call again if mesh shape changes
+	bool resize(VEC_VC<DBL3>& M)
+	{
+		if (!x.resize(M.h, M.rect, M)) return false;
+		if (!x_work.resize(M.h, M.rect, M)) return false;
+		if (!coeff.resize(M.h, M.rect)) return false;
+
+		x.set_pbc(M.is_pbc_x(), M.is_pbc_y(), M.is_pbc_z());
+		x_work.set_pbc(M.is_pbc_x(), M.is_pbc_y(), M.is_pbc_z());
+
+		lambda = 0.0;
+		if (M.n.x > 1 || M.is_pbc_x()) lambda += 2.0 / (M.h.x * M.h.x);
+		if (M.n.y > 1 || M.is_pbc_y()) lambda += 2.0 / (M.h.y * M.h.y);
+		if (M.n.z > 1 || M.is_pbc_z()) lambda += 2.0 / (M.h.z * M.h.z);
+
+		return true;
+	}
+
+	void clear(void)
+	{
+		x.clear();
+		x_work.clear();
+		coeff.clear();
+	}
+
+	//---------------------------------------- SOLVER
+
+	//solve with given right hand side and magnetization at the start of the time step (coeff must be set if enabled) : solution in x
+	//return false if not converged (also clears the converged flag)
+	bool solve(VEC<DBL3>& rhs, VEC<DBL3>& M0)
+	{
+		//explicit solution as initial guess
+#pragma omp parallel for
+		for (int idx = 0; idx < x.linear_size(); idx++) {
+
+			x[idx] = (x.is_not_empty(idx) ? rhs[idx] : DBL3());
+		}
+
+		iterations = 0;
+		if (!enabled || !lambda) return true;
+
+		reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < x.linear_size(); idx++) {
+
+			reduction.reduce_max(GetMagnitude(x[idx]));
+		}
+
+		reduction.maximum();
+		double rhs_max = reduction.max;
+		if (!rhs_max) return true;
+
+		//iterations done in pairs so solution ends up in x
+		while (iterations < ROS2_MAXITERATIONS) {
+
+			Jacobi_Iteration(x, x_work, rhs, M0);
+			double residual = Jacobi_Iteration(x_work, x, rhs, M0);
+			iterations += 2;
+
+			if (residual < ROS2_TOLERANCE * rhs_max) return true;
+		}
+
+		converged = false;
+		return false;
+	}
+
+private:
+
+	//one Jacobi iteration from src to dst, returning maximum residual magnitude for src
+	double Jacobi_Iteration(VEC_VC<DBL3>& src, VEC_VC<DBL3>& dst, VEC<DBL3>& rhs, VEC<DBL3>& M0)
+	{
+		reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < src.linear_size(); idx++) {
+
+			if (!src.is_not_empty(idx)) {
+
+				dst[idx] = DBL3();
+				continue;
+			}
+
+			DBL3 m = M0[idx];
+			double a = coeff[idx].i;
+			double b = coeff[idx].j;
+
+			DBL3 delsq_src = src.delsq_neu(idx);
+			DBL3 residual = rhs[idx] - src[idx] + (m ^ delsq_src) * a + (m ^ (m ^ delsq_src)) * b;
+			reduction.reduce_max(GetMagnitude(residual));
+
+			double Mnorm = m.norm();
+
+			if (Mnorm) {
+
+				//invert I + lambda * J : component along M unchanged, perpendicular component divided by p + iq, where i is the rotation u x
+				DBL3 u = m / Mnorm;
+				DBL3 residual_par = u * (u * residual);
+				DBL3 residual_perp = residual - residual_par;
+
+				double p = 1.0 - lambda * b * Mnorm * Mnorm;
+				double q = lambda * a * Mnorm;
+
+				dst[idx] = src[idx] + residual_par + (residual_perp * p - (u ^ residual_perp) * q) / (p * p + q * q);
+			}
+			else dst[idx] = src[idx] + residual;
+		}
+
+		reduction.maximum();
+
+		return reduction.max;
+	}
+};
@@ -6,6 +6,9 @@
 //restore ODE solvers so iteration can be redone (call if AdvanceIteration has failed)
 void ODECommon::Restore(void)
 {
+	//atomistic multi-rate pass : micromagnetic meshes not iterated
+	if (multirate_pass == MULTIRATE_ATOMISTIC) return;
+
 	for (int idx = 0; idx < (int)pODE.size(); idx++) {
 
 		pODE[idx]->RestoreMagnetization();
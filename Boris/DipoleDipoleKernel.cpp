@@ -12,6 +12,12 @@ void DipoleDipoleKernel::FreeAllKernelMemory(void)
 
 	Kdiag.clear();
 	Kodiag.clear();
+
+	K2D_odiag_sp.clear();
+	K2D_odiag_sp.shrink_to_fit();
+
+	Kdiag_sp.clear();
+	Kodiag_sp.clear();
 }
 
 BError DipoleDipoleKernel::AllocateKernelMemory(void)
@@ -39,14 +45,15 @@ BError DipoleDipoleKernel::AllocateKernelMemory(void)
 //-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
 //multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
-void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
+template <typename ReIm3Type, typename VType>
+void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3Type* pline, int i, VEC<VAL3<VType>>& Kdiag, std::vector<VType>& K2D_odiag)
 {
 	//above N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.y/2 point
 	//off-diagonal values are odd about the N.y/2 point
 
 	//j = 0
-	ReIm3 FM = pline[0];
+	ReIm3Type FM = pline[0];
 
 	int idx_start = i;
 
@@ -57,8 +64,8 @@ void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
 	//points between 1 and N.y / 2 - 1 inclusive
 	for (int j = 1; j < N.y / 2; j++) {
 
-		ReIm3 FM_l = pline[j];
-		ReIm3 FM_h = pline[N.y - j];
+		ReIm3Type FM_l = pline[j];
+		ReIm3Type FM_h = pline[N.y - j];
 
 		int ker_index = i + j * (N.x / 2 + 1);
 
@@ -82,7 +89,8 @@ void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
 }
 
 //multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
-void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
+template <typename ReIm3Type, typename VType>
+void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3Type* pline, int i, int j, VEC<VAL3<VType>>& Kdiag, VEC<VAL3<VType>>& Kodiag)
 {
 	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.z/2 and N.y/2 points
@@ -93,7 +101,7 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 	if (j <= N.y / 2) {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		ReIm3Type FM = pline[0];
 
 		int idx_start = i + j * (N.x / 2 + 1);
 
@@ -104,8 +112,8 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			ReIm3Type FM_l = pline[k];
+			ReIm3Type FM_h = pline[N.z - k];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -130,7 +138,7 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 	else {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		ReIm3Type FM = pline[0];
 
 		int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -141,8 +149,8 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			ReIm3Type FM_l = pline[k];
+			ReIm3Type FM_h = pline[N.z - k];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -166,8 +174,64 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 	}
 }
 
+void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i) { KernelMultiplication_2D_line(pline, i, Kdiag, K2D_odiag); }
+void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3F* pline, int i) { KernelMultiplication_2D_line(pline, i, Kdiag_sp, K2D_odiag_sp); }
+
+void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j) { KernelMultiplication_3D_line(pline, i, j, Kdiag, Kodiag); }
+void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3F* pline, int i, int j) { KernelMultiplication_3D_line(pline, i, j, Kdiag_sp, Kodiag_sp); }
+
 //-------------------------- KERNEL CALCULATION
 
+//this initializes the convolution kernels for the given mesh dimensions. 2D is for n.z == 1.
+BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels(bool include_self_demag)
+{
+	BError error(__FUNCTION__);
+
+	//double precision kernels are freed after conversion to single precision, so allocate them again if recalculating
+	if (single_precision && !Kdiag.linear_size()) error = AllocateKernelMemory();
+	if (error) return error;
+
+	if (n.z == 1) error = Calculate_DipoleDipole_Kernels_2D(include_self_demag);
+	else error = Calculate_DipoleDipole_Kernels_3D(include_self_demag);
+
+	if (!error && single_precision) error = Convert_Kernels_SinglePrecision();
+
+	return error;
+}
+
+//convert computed kernels to single precision (single_precision set), freeing double precision kernels
+BError DipoleDipoleKernel::Convert_Kernels_SinglePrecision(void)
+{
+	BError error(__FUNCTION__);
+
+	if (!Kdiag_sp.resize(Kdiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+	for (int idx = 0; idx < Kdiag.linear_size(); idx++) Kdiag_sp[idx] = Kdiag[idx];
+
+	if (n.z == 1) {
+
+		//2D
+		if (!malloc_vector(K2D_odiag_sp, K2D_odiag.size())) return error(BERROR_OUTOFMEMORY_CRIT);
+
+		for (int idx = 0; idx < K2D_odiag.size(); idx++) K2D_odiag_sp[idx] = (float)K2D_odiag[idx];
+	}
+	else {
+
+		//3D
+		if (!Kodiag_sp.resize(Kodiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+		for (int idx = 0; idx < Kodiag.linear_size(); idx++) Kodiag_sp[idx] = Kodiag[idx];
+	}
+
+	K2D_odiag.clear();
+	K2D_odiag.shrink_to_fit();
+
+	Kdiag.clear();
+	Kodiag.clear();
+
+	return error;
+}
+
 BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_2D(bool include_self_demag)
 {
 	BError error(__FUNCTION__);
@@ -224,22 +288,22 @@ BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_2D(bool include_self_d
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -301,6 +365,9 @@ BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_2D(bool include_self_d
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_x_odiag);
 	fftw_destroy_plan(plan_fwd_y);
@@ -347,17 +414,17 @@ BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_3D(bool include_self_d
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -504,6 +571,9 @@ BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_3D(bool include_self_d
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
@@ -59,6 +59,8 @@ enum BWARNING_
 	BWARNING_NONE = 0,
 	BWARNING_INCORRECTCELLSIZE,				//cellsize set is incorrect
 	BWARNING_NOGPUINITIALIZATION,			//could not initialize on GPU ... initialized on CPU instead
+	BWARNING_HEATSOLVERCUDA,				//implicit heat solvers not available with CUDA ... FTCS heat solver used instead
+	BWARNING_HEATSOLVERCONVERGENCE,			//implicit heat solver didn't converge in an accepted time step
 	BWARNING_ENUMSIZE
 };
 
@@ -399,6 +401,8 @@ ErrorHandler<Owner>::ErrorHandler(Owner* pOwner_) :
 
 	warnings[BWARNING_INCORRECTCELLSIZE] = std::string("Working with incorrect cellsize.");
 	warnings[BWARNING_NOGPUINITIALIZATION] = std::string("Could not initialize on GPU. Initialized on CPU instead.");
+	warnings[BWARNING_HEATSOLVERCONVERGENCE] = std::string("Implicit heat solver did not converge in a time step. Reduce heat equation time step, or use adaptive time step.");
+	warnings[BWARNING_HEATSOLVERCUDA] = std::string("Implicit heat solvers not available with CUDA. Set FTCS heat solver instead : check heat equation time step.");
 
 	/////////////////////////////////////////////////////////////////////////////////////
 }
\ No newline at end of file
@@ -63,6 +63,11 @@ BError Exch_6ngbr_Neu::Initialize(void)
 		(MOD_)pMesh->Get_Module_Heff_Display() == MOD_EXCHANGE || pMesh->IsOutputDataSet_withRect(DATA_E_EXCH), 
 		(MOD_)pMesh->Get_Module_Energy_Display() == MOD_EXCHANGE || pMesh->IsOutputDataSet_withRect(DATA_E_EXCH),
 		pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC);
+
+	//parameters read in every cell when computing the field : cache them if they must be evaluated per cell
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) pMesh->request_parameter_cache(pMesh->A_AFM, pMesh->Ah, pMesh->Anh, pMesh->Ms_AFM);
+	else pMesh->request_parameter_cache(pMesh->A, pMesh->Ms);
+
 	if (!error) initialized = true;
 
 	return error;
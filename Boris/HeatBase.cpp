@@ -15,6 +15,62 @@ HeatBase::HeatBase(MeshBase *pMeshBase_) :
 	pMeshBase = pMeshBase_;
 }
 
+//-------------------Calculation Methods
+
+//if Q_equation is separable make sure Q_equation_space is up to date and return true, else return false
+bool HeatBase::UpdateSeparableQCache(void)
+{
+	if (!Q_equation.is_separable()) {
+
+		//not separable : release cache memory if any
+		if (Q_equation_space.linear_size()) Q_equation_space.clear();
+		Q_equation_space_version = -1;
+
+		return false;
+	}
+
+	//cached spatial factor is out of date if the equation was remade (e.g. user constants changed) or the mesh discretisation changed
+	if (Q_equation_space_version == Q_equation.get_version() && Q_equation_space.n == pMeshBase->n_t && Q_equation_space.h == pMeshBase->h_t) return true;
+
+	if (!Q_equation_space.resize(pMeshBase->h_t, pMeshBase->meshRect) || Q_equation_space.n != pMeshBase->n_t) {
+
+		Q_equation_space.clear();
+		Q_equation_space_version = -1;
+
+		return false;
+	}
+
+#pragma omp parallel
+	{
+		std::vector<double> relpos_x(pMeshBase->n_t.x);
+		for (int i = 0; i < pMeshBase->n_t.x; i++) relpos_x[i] = (i + 0.5) * pMeshBase->h_t.x;
+
+#pragma omp for
+		for (int row = 0; row < pMeshBase->n_t.y * pMeshBase->n_t.z; row++) {
+
+			int j = row % pMeshBase->n_t.y;
+			int k = row / pMeshBase->n_t.y;
+
+			Q_equation.evaluate_separable_space_batch(pMeshBase->n_t.x, &Q_equation_space[row * pMeshBase->n_t.x], relpos_x.data(), (j + 0.5) * pMeshBase->h_t.y, (k + 0.5) * pMeshBase->h_t.z, 0.0);
+		}
+	}
+
+	Q_equation_space_version = Q_equation.get_version();
+
+	return true;
+}
+
+//evaluate Q_equation for the row of temperature cells (j, k) along x
+void HeatBase::EvaluateQEquation_Row(int j, int k, double time, bool separable, double Q_time, std::vector<double>& relpos_x, std::vector<double>& Q_row)
+{
+	if (separable) {
+
+		int idx_row = j * pMeshBase->n_t.x + k * pMeshBase->n_t.x*pMeshBase->n_t.y;
+		for (int i = 0; i < pMeshBase->n_t.x; i++) Q_row[i] = Q_equation_space[idx_row + i] * Q_time;
+	}
+	else Q_equation.evaluate_batch(pMeshBase->n_t.x, Q_row.data(), relpos_x.data(), (j + 0.5) * pMeshBase->h_t.y, (k + 0.5) * pMeshBase->h_t.z, time);
+}
+
 //-------------------Setters
 
 void HeatBase::SetAmbientTemperature(double T_ambient_)
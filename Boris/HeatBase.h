@@ -31,6 +31,18 @@ protected:
 	//evaluate heat equation and store result here. After this is done advance time for temperature based on values stored here.
 	std::vector<double> heatEq_RHS;
 
+	//implicit heat solvers : the heat equation for the new temperature is written as -delsq T + heatEq_diag * T - heatEq_RHS = 0, with heatEq_RHS holding all known terms
+	std::vector<double> heatEq_diag;
+
+	//implicit heat solvers : thermal conductivity evaluated at the start of the time step, kept fixed during the solve so the equation is linear in the new temperature
+	std::vector<double> heatEq_K;
+
+	//implicit heat solvers : set from PrimeHeatEquation_Implicit until CompleteHeatEquation_Implicit, so CMBND values set during the solve also use heatEq_K
+	bool heatEq_K_frozen = false;
+
+	//implicit heat solvers with 2TM : new lattice temperature is Temp_l = heatEq_Tl0 + heatEq_Tl1 * Temp (coefficients evaluated at the start of the time step)
+	std::vector<double> heatEq_Tl0, heatEq_Tl1;
+
 	//ambient temperature and alpha boundary value used in Robin boundary conditions (Newton's law of cooling):
 	//Flux in direction of surface normal = alpha_boundary * (T_boundary - T_ambient)
 	//Note : alpha_boundary = 0 results in insulating boundary
@@ -49,6 +61,12 @@ protected:
 	//A number of constants are always present : mesh dimensions in m (Lx, Ly, Lz)
 	TEquation<double, double, double, double> Q_equation;
 
+	//if Q_equation is separable as f(x, y, z) * g(t) then the spatial factor is cached here (on the temperature mesh), so only g(t) needs evaluating at each step
+	VEC<double> Q_equation_space;
+
+	//Q_equation version for which Q_equation_space was computed
+	int Q_equation_space_version = -1;
+
 protected:
 
 	//-------------------Calculation Methods (pure virtual)
@@ -59,6 +77,26 @@ protected:
 	//2-temperature model : itinerant electrons <-> lattice
 	virtual void IterateHeatEquation_2TM(double dT) = 0;
 
+	//implicit time step with weight theta for the new time (0.5 : Crank-Nicolson, 1 : backward Euler) : set heatEq_diag and heatEq_RHS for current temperature (1TM or 2TM). Return false if out of memory.
+	virtual bool PrimeHeatEquation_Implicit(double dT, double theta) = 0;
+
+	//implicit time step : residual of heat equation for current temperature values (zero in empty and CMBND cells)
+	virtual void CalculateHeatEquation_Residual(std::vector<double>& r) = 0;
+
+	//implicit time step : after new temperature obtained, also advance lattice temperature for 2TM
+	virtual void CompleteHeatEquation_Implicit(double dT, double theta) = 0;
+
+	//-------------------Calculation Methods
+
+	//if Q_equation is separable make sure Q_equation_space is up to date and return true, else return false
+	bool UpdateSeparableQCache(void);
+
+	//evaluate Q_equation for the row of temperature cells (j, k) along x
+	void EvaluateQEquation_Row(int j, int k, double time, bool separable, double Q_time, std::vector<double>& relpos_x, std::vector<double>& Q_row);
+
+	//implicit time step : thermal conductivity from the start of the time step in given cell while solving, else zero (also zero for empty cells or if out of range)
+	double get_frozen_K(int idx) const { return (heatEq_K_frozen && idx >= 0 && idx < (int)heatEq_K.size() ? heatEq_K[idx] : 0.0); }
+
 	//------------------Others
 
 	void SetRobinBoundaryConditions(void);
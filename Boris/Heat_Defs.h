@@ -14,3 +14,34 @@ enum TMTYPE_ {
 	TMTYPE_2TM,
 	TMTYPE_NUMMODELS
 };
+
+//heat equation time stepping scheme
+
+enum HSOLVER_ {
+
+	//forward time centred space (explicit, default) : heat_dT limited by stability
+	HSOLVER_FTCS = 0,
+	//Crank-Nicolson (implicit, second order)
+	HSOLVER_CN,
+	//backward Euler (implicit, first order, damps stiff modes)
+	HSOLVER_BE,
+	//Crank-Nicolson with adaptive time step : error estimated from embedded backward Euler solution
+	HSOLVER_ADAPTIVE,
+	HSOLVER_NUMOPTIONS
+};
+
+//default heat equation time step (s), also used as upper limit when reverting to FTCS from an implicit solver
+#define HSOLVER_FTCS_DEFAULTDT	0.2e-12
+
+//implicit heat solvers : convergence tolerance (normalized residual) and maximum number of iterations for each time step
+#define HSOLVER_IMPLICIT_TOLERANCE	1e-10
+#define HSOLVER_IMPLICIT_MAXITERS	1000
+
+//adaptive heat time step : default maximum temperature error in each time step (K)
+#define HSOLVER_ADAPTIVE_MAXERROR	0.1
+//adaptive heat time step : minimum time step (s) - error control is not applied below this
+#define HSOLVER_ADAPTIVE_MINDT	1e-16
+//adaptive heat time step : safety factor, and limits for time step change factor
+#define HSOLVER_ADAPTIVE_SAFETY	0.9
+#define HSOLVER_ADAPTIVE_MINFACTOR	0.2
+#define HSOLVER_ADAPTIVE_MAXFACTOR	5.0
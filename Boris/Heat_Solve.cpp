@@ -24,98 +24,179 @@ void Heat::IterateHeatEquation_1TM(double dT)
 {
 	//FTCS:
 
-	/////////////////////////////////////////
-	// Fixed Q set (which could be zero)
-	/////////////////////////////////////////
+	//heat source set using text equation : evaluated a row of cells at a time along x, and for separable equations only the time factor needs evaluating here
+	bool Q_equation_set = Q_equation.is_set();
+	double time = pSMesh->GetStageTime();
+	bool separable = (Q_equation_set ? UpdateSeparableQCache() : false);
+	double Q_time = (separable ? Q_equation.evaluate_separable_time(time) : 0.0);
+
+	bool Q_param_set = IsNZ(pMesh->Q.get0());
+	bool joule_heating = pMesh->E.linear_size();
+
+	//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
+	//All contributions are added in a single pass over rows of cells along x
+#pragma omp parallel
+	{
+		std::vector<double> relpos_x, Q_row;
+
+		if (Q_equation_set) {
+
+			relpos_x.resize(pMesh->n_t.x);
+			Q_row.resize(pMesh->n_t.x);
+			for (int i = 0; i < pMesh->n_t.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h_t.x;
+		}
 
-	if (!Q_equation.is_set()) {
+#pragma omp for
+		for (int row = 0; row < pMesh->n_t.y * pMesh->n_t.z; row++) {
 
-		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
+			int j = row % pMesh->n_t.y;
+			int k = row / pMesh->n_t.y;
 
-			if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) continue;
+			if (Q_equation_set) EvaluateQEquation_Row(j, k, time, separable, Q_time, relpos_x, Q_row);
 
-			double density = pMesh->density;
-			double shc = pMesh->shc;
-			double thermCond = pMesh->thermCond;
-			pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
+			for (int i = 0; i < pMesh->n_t.x; i++) {
 
-			double cro = density * shc;
-			double K = thermCond;
+				int idx = i + row * pMesh->n_t.x;
 
-			//heat equation with Robin boundaries (based on Newton's law of cooling)
-			heatEq_RHS[idx] = pMesh->Temp.delsq_robin(idx, K) * K / cro;
+				if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) continue;
 
-			//add Joule heating if set
-			if (pMesh->E.linear_size()) {
+				double density = pMesh->density;
+				double shc = pMesh->shc;
+				double thermCond = pMesh->thermCond;
+				pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
 
-				DBL3 position = pMesh->Temp.cellidx_to_position(idx);
+				double cro = density * shc;
+				double K = thermCond;
 
-				double elC_value = pMesh->elC.weighted_average(position, pMesh->Temp.h);
-				DBL3 E_value = pMesh->E.weighted_average(position, pMesh->Temp.h);
+				//heat equation with Robin boundaries (based on Newton's law of cooling)
+				double value = pMesh->Temp.delsq_robin(idx, K) * K;
 
-				//add Joule heating source term
-				heatEq_RHS[idx] += (elC_value * E_value * E_value) / cro;
-			}
+				//add Joule heating if set : direct lookup if electrical and thermal meshes have the same discretisation
+				if (joule_heating) {
 
-			//add heat source contribution if set
-			if (IsNZ(pMesh->Q.get0())) {
+					double elC_value = pMesh->elC.weighted_average(INT3(i, j, k), pMesh->h_t);
+					DBL3 E_value = pMesh->E.weighted_average(INT3(i, j, k), pMesh->h_t);
+
+					//add Joule heating source term
+					value += elC_value * E_value * E_value;
+				}
 
-				double Q = pMesh->Q;
-				pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
+				//add heat source contribution if set
+				if (Q_equation_set) value += Q_row[i];
+				else if (Q_param_set) {
+
+					double Q = pMesh->Q;
+					pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
+
+					value += Q;
+				}
 
-				heatEq_RHS[idx] += Q / cro;
+				heatEq_RHS[idx] = value / cro;
 			}
 		}
 	}
 
-	/////////////////////////////////////////
-	// Q set using text equation
-	/////////////////////////////////////////
+	//2. Now use forward time to advance by dT:
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
 
-	else {
+		if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) continue;
 
-		double time = pSMesh->GetStageTime();
+		pMesh->Temp[idx] += dT * heatEq_RHS[idx];
+	}
+}
 
-		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
-		for (int j = 0; j < pMesh->n_t.y; j++) {
-			for (int k = 0; k < pMesh->n_t.z; k++) {
-				for (int i = 0; i < pMesh->n_t.x; i++) {
+//////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////// 2-TEMPERATURE MODEL ////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
 
-					int idx = i + j * pMesh->n_t.x + k * pMesh->n_t.x*pMesh->n_t.y;
+//2-temperature model : itinerant electrons <-> lattice
+void Heat::IterateHeatEquation_2TM(double dT)
+{
+	//FTCS:
+
+	//heat source set using text equation : evaluated a row of cells at a time along x, and for separable equations only the time factor needs evaluating here
+	bool Q_equation_set = Q_equation.is_set();
+	double time = pSMesh->GetStageTime();
+	bool separable = (Q_equation_set ? UpdateSeparableQCache() : false);
+	double Q_time = (separable ? Q_equation.evaluate_separable_time(time) : 0.0);
+
+	bool Q_param_set = IsNZ(pMesh->Q.get0());
+	bool joule_heating = pMesh->E.linear_size();
+
+	//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
+	//All contributions are added in a single pass over rows of cells along x
+#pragma omp parallel
+	{
+		std::vector<double> relpos_x, Q_row;
+
+		if (Q_equation_set) {
+
+			relpos_x.resize(pMesh->n_t.x);
+			Q_row.resize(pMesh->n_t.x);
+			for (int i = 0; i < pMesh->n_t.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h_t.x;
+		}
+
+#pragma omp for
+		for (int row = 0; row < pMesh->n_t.y * pMesh->n_t.z; row++) {
+
+			int j = row % pMesh->n_t.y;
+			int k = row / pMesh->n_t.y;
+
+			if (Q_equation_set) EvaluateQEquation_Row(j, k, time, separable, Q_time, relpos_x, Q_row);
+
+			for (int i = 0; i < pMesh->n_t.x; i++) {
+
+				int idx = i + row * pMesh->n_t.x;
 
-					if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) continue;
+				if (!pMesh->Temp.is_not_empty(idx)) continue;
 
-					double density = pMesh->density;
-					double shc = pMesh->shc;
-					double thermCond = pMesh->thermCond;
-					pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
+				double density = pMesh->density;
+				double shc = pMesh->shc;
+				double shc_e = pMesh->shc_e;
+				double G_el = pMesh->G_e;
+				double thermCond = pMesh->thermCond;
+				pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->shc_e, shc_e, pMesh->G_e, G_el, pMesh->thermCond, thermCond);
 
-					double cro = density * shc;
-					double K = thermCond;
+				double cro_e = density * shc_e;
+				double K = thermCond;
 
-					//heat equation with Robin boundaries (based on Newton's law of cooling)
-					heatEq_RHS[idx] = pMesh->Temp.delsq_robin(idx, K) * K / cro;
+				//1. Itinerant Electrons Temperature
 
-					//add Joule heating if set
-					if (pMesh->E.linear_size()) {
+				if (pMesh->Temp.is_not_cmbnd(idx)) {
 
-						DBL3 position = pMesh->Temp.cellidx_to_position(idx);
+					//heat equation with Robin boundaries (based on Newton's law of cooling) and coupling to lattice
+					double value = pMesh->Temp.delsq_robin(idx, K) * K - G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]);
 
-						double elC_value = pMesh->elC.weighted_average(position, pMesh->Temp.h);
-						DBL3 E_value = pMesh->E.weighted_average(position, pMesh->Temp.h);
+					//add Joule heating if set : direct lookup if electrical and thermal meshes have the same discretisation
+					if (joule_heating) {
+
+						double elC_value = pMesh->elC.weighted_average(INT3(i, j, k), pMesh->h_t);
+						DBL3 E_value = pMesh->E.weighted_average(INT3(i, j, k), pMesh->h_t);
 
 						//add Joule heating source term
-						heatEq_RHS[idx] += (elC_value * E_value * E_value) / cro;
+						value += elC_value * E_value * E_value;
 					}
 
-					//add heat source contribution
-					DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h_t;
-					double Q = Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+					//add heat source contribution if set
+					if (Q_equation_set) value += Q_row[i];
+					else if (Q_param_set) {
+
+						double Q = pMesh->Q;
+						pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
+
+						value += Q;
+					}
 
-					heatEq_RHS[idx] += Q / cro;
+					heatEq_RHS[idx] = value / cro_e;
 				}
+
+				//2. Lattice Temperature
+
+				//lattice specific heat capacity + electron specific heat capacity gives the total specific heat capacity
+				double cro_l = density * (shc - shc_e);
+
+				pMesh->Temp_l[idx] += dT * G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]) / cro_l;
 			}
 		}
 	}
@@ -131,145 +212,157 @@ void Heat::IterateHeatEquation_1TM(double dT)
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
-///////////////////////////////// 2-TEMPERATURE MODEL ////////////////////////////////////////////
+///////////////////////////////// IMPLICIT TIME STEPPING /////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
-//2-temperature model : itinerant electrons <-> lattice
-void Heat::IterateHeatEquation_2TM(double dT)
+//implicit time step with weight theta for the new time (0.5 : Crank-Nicolson, 1 : backward Euler) : set heatEq_diag and heatEq_RHS for current temperature (1TM or 2TM). Return false if out of memory.
+bool Heat::PrimeHeatEquation_Implicit(double dT, double theta)
 {
-	//FTCS:
+	//theta-method for the heat equation (electron temperature for 2TM) : cro * (T' - T) / dT = theta * (K * delsq T' + C') + (1 - theta) * (K * delsq T + C) + S
+	//S : Joule heating and heat source; C : coupling to lattice for 2TM, -G_el * (T - Temp_l)
+	//For 2TM the lattice equation is also discretised using the theta-method, and solved for Temp_l' in terms of T' : Temp_l' = c0 + c1 * T', thus C' = -G_el * ((1 - c1) * T' - c0)
+	//Dividing by theta * K gives the form -delsq T' + heatEq_diag * T' - heatEq_RHS = 0
+	//All material parameters (including K) are evaluated at the start of the time step and kept fixed during the solve. Cells with K = 0 have no Laplacian term and are not divided by K.
 
-	/////////////////////////////////////////
-	// Fixed Q set (which could be zero)
-	/////////////////////////////////////////
+	bool success = true;
 
-	if (!Q_equation.is_set()) {
+	if (heatEq_diag.size() != pMesh->n_t.dim()) success &= malloc_vector(heatEq_diag, pMesh->n_t.dim(), 0.0);
+	if (heatEq_K.size() != pMesh->n_t.dim()) success &= malloc_vector(heatEq_K, pMesh->n_t.dim(), 0.0);
+	if (tmtype == TMTYPE_2TM && heatEq_Tl0.size() != pMesh->n_t.dim()) success &= malloc_vector(heatEq_Tl0, pMesh->n_t.dim(), 0.0);
+	if (tmtype == TMTYPE_2TM && heatEq_Tl1.size() != pMesh->n_t.dim()) success &= malloc_vector(heatEq_Tl1, pMesh->n_t.dim(), 0.0);
+	if (!success) return false;
 
-		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
+	double time = pSMesh->GetStageTime();
 
-			if (!pMesh->Temp.is_not_empty(idx)) continue;
+	//for separable equations only the time factor needs evaluating here
+	bool Q_equation_set = Q_equation.is_set();
+	bool separable = (Q_equation_set ? UpdateSeparableQCache() : false);
+	double Q_time = (separable ? Q_equation.evaluate_separable_time(time) : 0.0);
 
-			double density = pMesh->density;
-			double shc = pMesh->shc;
-			double shc_e = pMesh->shc_e;
-			double G_el = pMesh->G_e;
-			double thermCond = pMesh->thermCond;
-			pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->shc_e, shc_e, pMesh->G_e, G_el, pMesh->thermCond, thermCond);
+#pragma omp parallel
+	{
+		//the heat source equation is evaluated a row of cells at a time along x
+		std::vector<double> relpos_x(pMesh->n_t.x);
+		std::vector<double> Q_row(pMesh->n_t.x);
+		for (int i = 0; i < pMesh->n_t.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h_t.x;
 
-			double cro_e = density * shc_e;
-			double K = thermCond;
+#pragma omp for
+		for (int row = 0; row < pMesh->n_t.y * pMesh->n_t.z; row++) {
 
-			//1. Itinerant Electrons Temperature
+			int j = row % pMesh->n_t.y;
+			int k = row / pMesh->n_t.y;
 
-			if (pMesh->Temp.is_not_cmbnd(idx)) {
+			if (Q_equation_set) EvaluateQEquation_Row(j, k, time, separable, Q_time, relpos_x, Q_row);
 
-				//heat equation with Robin boundaries (based on Newton's law of cooling) and coupling to lattice
-				heatEq_RHS[idx] = (pMesh->Temp.delsq_robin(idx, K) * K - G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx])) / cro_e;
+			for (int i = 0; i < pMesh->n_t.x; i++) {
 
-				//add Joule heating if set
-				if (pMesh->E.linear_size()) {
+				int idx = i + row * pMesh->n_t.x;
 
-					DBL3 position = pMesh->Temp.cellidx_to_position(idx);
+				if (!pMesh->Temp.is_not_empty(idx)) continue;
 
-					double elC_value = pMesh->elC.weighted_average(position, pMesh->Temp.h);
-					DBL3 E_value = pMesh->E.weighted_average(position, pMesh->Temp.h);
+				double density = pMesh->density;
+				double shc = pMesh->shc;
+				double shc_e = pMesh->shc_e;
+				double G_el = pMesh->G_e;
+				double thermCond = pMesh->thermCond;
+				if (tmtype == TMTYPE_2TM) pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->shc_e, shc_e, pMesh->G_e, G_el, pMesh->thermCond, thermCond);
+				else pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
 
-					//add Joule heating source term
-					heatEq_RHS[idx] += (elC_value * E_value * E_value) / cro_e;
-				}
+				double cro = (tmtype == TMTYPE_2TM ? density * shc_e : density * shc);
+				double K = thermCond;
+				heatEq_K[idx] = K;
 
-				//add heat source contribution if set
-				if (IsNZ(pMesh->Q.get0())) {
+				//coupling to lattice : diagonal contribution and known terms
+				double diag_coupling = 0.0, coupling = 0.0;
 
-					double Q = pMesh->Q;
-					pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
-
-					heatEq_RHS[idx] += Q / cro_e;
-				}
-			}
+				if (tmtype == TMTYPE_2TM) {
 
-			//2. Lattice Temperature
+					//lattice specific heat capacity + electron specific heat capacity gives the total specific heat capacity
+					double cro_l = density * (shc - shc_e);
+					double a = dT * G_el / cro_l;
 
-			//lattice specific heat capacity + electron specific heat capacity gives the total specific heat capacity
-			double cro_l = density * (shc - shc_e);
+					double c1 = a * theta / (1 + a * theta);
+					heatEq_Tl1[idx] = c1;
+					heatEq_Tl0[idx] = (pMesh->Temp_l[idx] + a * (1 - theta) * (pMesh->Temp[idx] - pMesh->Temp_l[idx])) / (1 + a * theta);
 
-			pMesh->Temp_l[idx] += dT * G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]) / cro_l;
-		}
-	}
+					diag_coupling = theta * G_el * (1 - c1);
+					coupling = theta * G_el * heatEq_Tl0[idx] - (1 - theta) * G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]);
+				}
 
-	/////////////////////////////////////////
-	// Q set using text equation
-	/////////////////////////////////////////
+				if (!pMesh->Temp.is_not_cmbnd(idx)) continue;
 
-	else {
+				//explicit part of Laplacian not needed for backward Euler
+				double explicit_delsq = (theta < 1.0 && K > 0.0 ? (1 - theta) * K * pMesh->Temp.delsq_robin(idx, K) : 0.0);
 
-		double time = pSMesh->GetStageTime();
+				double source = 0.0;
 
-		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
-		for (int j = 0; j < pMesh->n_t.y; j++) {
-			for (int k = 0; k < pMesh->n_t.z; k++) {
-				for (int i = 0; i < pMesh->n_t.x; i++) {
+				//add Joule heating if set
+				if (pMesh->E.linear_size()) {
 
-					int idx = i + j * pMesh->n_t.x + k * pMesh->n_t.x*pMesh->n_t.y;
+					double elC_value = pMesh->elC.weighted_average(INT3(i, j, k), pMesh->h_t);
+					DBL3 E_value = pMesh->E.weighted_average(INT3(i, j, k), pMesh->h_t);
 
-					if (!pMesh->Temp.is_not_empty(idx)) continue;
+					source = elC_value * E_value * E_value;
+				}
 
-					double density = pMesh->density;
-					double shc = pMesh->shc;
-					double shc_e = pMesh->shc_e;
-					double G_el = pMesh->G_e;
-					double thermCond = pMesh->thermCond;
-					pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->shc_e, shc_e, pMesh->G_e, G_el, pMesh->thermCond, thermCond);
+				//add heat source contribution
+				if (Q_equation_set) source += Q_row[i];
+				else if (IsNZ(pMesh->Q.get0())) {
 
-					double cro_e = density * shc_e;
-					double K = thermCond;
+					double Q = pMesh->Q;
+					pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
 
-					//1. Itinerant Electrons Temperature
+					source += Q;
+				}
 
-					if (pMesh->Temp.is_not_cmbnd(idx)) {
+				//without thermal conduction the cell equation has no Laplacian term, so is not divided by theta * K
+				double scaling = (K > 0.0 ? theta * K : 1.0);
 
-						//heat equation with Robin boundaries (based on Newton's law of cooling) and coupling to lattice
-						heatEq_RHS[idx] = (pMesh->Temp.delsq_robin(idx, K) * K - G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx])) / cro_e;
+				heatEq_diag[idx] = (cro / dT + diag_coupling) / scaling;
+				heatEq_RHS[idx] = (cro * pMesh->Temp[idx] / dT + explicit_delsq + coupling + source) / scaling;
+			}
+		}
+	}
 
-						//add Joule heating if set
-						if (pMesh->E.linear_size()) {
+	//CMBND values set during the solve also use heatEq_K
+	heatEq_K_frozen = true;
 
-							DBL3 position = pMesh->Temp.cellidx_to_position(idx);
+	return true;
+}
 
-							double elC_value = pMesh->elC.weighted_average(position, pMesh->Temp.h);
-							DBL3 E_value = pMesh->E.weighted_average(position, pMesh->Temp.h);
+//implicit time step : residual of heat equation for current temperature values (zero in empty and CMBND cells)
+void Heat::CalculateHeatEquation_Residual(std::vector<double>& r)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
 
-							//add Joule heating source term
-							heatEq_RHS[idx] += (elC_value * E_value * E_value) / cro_e;
-						}
+		if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) {
 
-						//add heat source contribution
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h_t;
-						double Q = Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+			r[idx] = 0.0;
+			continue;
+		}
 
-						heatEq_RHS[idx] += Q / cro_e;
-					}
+		//use K from the start of the time step (not evaluated for the current iterate), so the residual is affine in the temperature
+		double delsq = (heatEq_K[idx] > 0.0 ? pMesh->Temp.delsq_robin(idx, heatEq_K[idx]) : 0.0);
 
-					//2. Lattice Temperature
+		r[idx] = heatEq_diag[idx] * pMesh->Temp[idx] - delsq - heatEq_RHS[idx];
+	}
+}
 
-					//lattice specific heat capacity + electron specific heat capacity gives the total specific heat capacity
-					double cro_l = density * (shc - shc_e);
+//implicit time step : after new temperature obtained, also advance lattice temperature for 2TM
+void Heat::CompleteHeatEquation_Implicit(double dT, double theta)
+{
+	//solve done : CMBND values set outside of the implicit solve use the current thermal conductivity again
+	heatEq_K_frozen = false;
 
-					pMesh->Temp_l[idx] += dT * G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]) / cro_l;
-				}
-			}
-		}
-	}
+	if (tmtype != TMTYPE_2TM) return;
 
-	//2. Now use forward time to advance by dT:
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
 
-		if (!pMesh->Temp.is_not_empty(idx) || !pMesh->Temp.is_not_cmbnd(idx)) continue;
+		if (!pMesh->Temp.is_not_empty(idx)) continue;
 
-		pMesh->Temp[idx] += dT * heatEq_RHS[idx];
+		pMesh->Temp_l[idx] = heatEq_Tl0[idx] + heatEq_Tl1[idx] * pMesh->Temp[idx];
 	}
 }
 
@@ -290,16 +383,26 @@ double Heat::Heat::afunc_pri(int cell1_idx, int cell2_idx, DBL3 shift) const
 
 double Heat::bfunc_sec(DBL3 relpos_m1, DBL3 shift, DBL3 stencil) const
 {
-	double thermCond = pMesh->thermCond;
-	pMesh->update_parameters_atposition(relpos_m1, pMesh->thermCond, thermCond);
+	//implicit solve : use thermal conductivity from the start of the time step, as for the interior cells
+	double thermCond = get_frozen_K(pMesh->Temp.position_to_cellidx(relpos_m1));
+	if (thermCond <= 0.0) {
+
+		thermCond = pMesh->thermCond;
+		pMesh->update_parameters_atposition(relpos_m1, pMesh->thermCond, thermCond);
+	}
 
 	return -1.0 * thermCond;
 }
 
 double Heat::bfunc_pri(int cell1_idx, int cell2_idx) const
 {
-	double thermCond = pMesh->thermCond;
-	pMesh->update_parameters_tcoarse(cell1_idx, pMesh->thermCond, thermCond);
+	//implicit solve : use thermal conductivity from the start of the time step, as for the interior cells
+	double thermCond = get_frozen_K(cell1_idx);
+	if (thermCond <= 0.0) {
+
+		thermCond = pMesh->thermCond;
+		pMesh->update_parameters_tcoarse(cell1_idx, pMesh->thermCond, thermCond);
+	}
 
 	return -1.0 * thermCond;
 }
@@ -307,13 +410,15 @@ double Heat::bfunc_pri(int cell1_idx, int cell2_idx) const
 //second order differential of T at cells either side of the boundary; delsq T = -Jc^2 / K * elC - Q / K - many-temperature model coupling terms / K
 double Heat::diff2_sec(DBL3 relpos_m1, DBL3 stencil, DBL3 shift) const
 {
-	double thermCond = pMesh->thermCond;
+	if (!pMesh->E.linear_size() && !IsNZ(pMesh->Q.get0())) return 0.0;
 
-	if (pMesh->E.linear_size() || IsNZ(pMesh->Q.get0())) {
+	//implicit solve : use thermal conductivity from the start of the time step, as for the interior cells
+	double thermCond = get_frozen_K(pMesh->Temp.position_to_cellidx(relpos_m1));
+	if (thermCond <= 0.0) {
 
+		thermCond = pMesh->thermCond;
 		pMesh->update_parameters_atposition(relpos_m1, pMesh->thermCond, thermCond);
 	}
-	else return 0.0;
 
 	double value = 0.0;
 
@@ -356,13 +461,15 @@ double Heat::diff2_sec(DBL3 relpos_m1, DBL3 stencil, DBL3 shift) const
 
 double Heat::diff2_pri(int cell1_idx, DBL3 shift) const
 {
-	double thermCond = pMesh->thermCond;
+	if (!pMesh->E.linear_size() && !IsNZ(pMesh->Q.get0())) return 0.0;
 
-	if (pMesh->E.linear_size() || IsNZ(pMesh->Q.get0())) {
+	//implicit solve : use thermal conductivity from the start of the time step, as for the interior cells
+	double thermCond = get_frozen_K(cell1_idx);
+	if (thermCond <= 0.0) {
 
+		thermCond = pMesh->thermCond;
 		pMesh->update_parameters_tcoarse(cell1_idx, pMesh->thermCond, thermCond);
 	}
-	else return 0.0;
 
 	double value = 0.0;
 
@@ -102,6 +102,15 @@ private:
 	//spatial scaling setting info : text with ";" separators. First field is the scaling set type (e.g. none, custom, random, jagged, etc.); The other fields are parameters for spatial generators.
 	std::string s_scaling_info = vargenerator_descriptor.get_key_from_ID(MATPVAR_NONE);
 
+	//per-cell output values (including spatial variation and temperature dependence) for each M cell of the owning mesh : filled by update_cache (see Mesh::update_parameter_cache)
+	std::vector<PType> cached_values;
+
+	//set by modules which read this parameter in every M cell during computations (request_cache) : only these parameters are cached
+	bool cache_requested = false;
+
+	//cached_values are up to date : cleared when this parameter changes, or by the owning mesh when temperature changes
+	bool cache_valid = false;
+
 private:
 
 	//---------Output value update : CUDA helpers
@@ -371,6 +380,44 @@ public:
 	//does it have a spatial dependence specified using a text equation?
 	bool is_s_equation_set(void) const { return Sscaling_eq.is_set(); }
 
+	//---------Per-cell cache
+
+	//request per-cell caching of output values : call from modules which read this parameter in every M cell
+	void request_cache(void) { cache_requested = true; }
+
+	//are cached values up to date? If so use get_cached instead of get (M cell index)
+	bool is_cached(void) const { return cache_valid; }
+	PType get_cached(int mcell_idx) const { return cached_values[mcell_idx]; }
+
+	void invalidate_cache(void) { cache_valid = false; }
+
+	//calculate output values in all cells of M if caching was requested and the parameter must be evaluated per cell, i.e. it has a spatial variation, or a temperature dependence with non-uniform temperature.
+	//Spatial variations set using a text equation are not cached since they can depend on the stage time.
+	template <typename VType>
+	void update_cache(VEC_VC<VType>& M, VEC_VC<double>& Temp)
+	{
+		if (cache_valid) return;
+
+		bool cacheable = cache_requested && !is_s_equation_set() && (is_sdep() || (is_tdep() && Temp.linear_size()));
+
+		if (!cacheable || !malloc_vector(cached_values, M.linear_size())) {
+
+			clear_vector(cached_values);
+			return;
+		}
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)M.linear_size(); idx++) {
+
+			DBL3 position = M.cellidx_to_position(idx);
+
+			if (Temp.linear_size()) cached_values[idx] = (is_sdep() ? get(position, 0.0, Temp[position]) : get(Temp[position]));
+			else cached_values[idx] = get(position, 0.0);
+		}
+
+		cache_valid = true;
+	}
+
 	//---------Comparison operators
 
 	//Not currently needed
@@ -498,6 +545,8 @@ public:
 template <typename PType, typename SType>
 MatP<PType, SType>& MatP<PType, SType>::operator=(const MatP<PType, SType>& copy_this)
 {
+	cache_valid = false;
+
 	//copy value at 0K:
 	value_at_0K = copy_this.value_at_0K;
 
@@ -937,6 +986,7 @@ template <typename PType, typename SType>
 void MatP<PType, SType>::update(double Temperature)
 {
 	current_value = get(Temperature);
+	cache_valid = false;
 
 #if COMPILECUDA == 1
 	if (p_cu_obj_mpcuda) update_cuda_value();
@@ -957,6 +1007,7 @@ MatP<PType, SType>& MatP<PType, SType>::operator=(PType set_value)
 {
 	value_at_0K = set_value;
 	current_value = value_at_0K;	//default to 0K value when using this
+	cache_valid = false;
 
 #if COMPILECUDA == 1
 	if (p_cu_obj_mpcuda) update_cuda_value();
@@ -1004,6 +1055,8 @@ bool MatP<PType, SType>::update_equations(const vector_key<double>& userConstant
 {
 	bool success = true;
 
+	cache_valid = false;
+
 	std::vector<std::pair<std::string, double>> constants(userConstants.size());
 	for (int idx = 0; idx < constants.size(); idx++) {
 
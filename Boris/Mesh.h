@@ -209,6 +209,16 @@ public:
 	//set/get mesh base temperature; by default any text equation dependence will be cleared unless indicated specifically not to (e.g. called when setting base temperature value after evaluating the text equation)
 	void SetBaseTemperature(double Temperature, bool clear_equation = true);
 
+	//per-cell cache of material parameters requested by modules (MatP::request_cache), used by update_parameters_mcoarse.
+	//update_parameter_cache recalculates out of date cached values (called before updating modules). invalidate_parameter_cache marks all cached values out of date : call when Temp changes.
+	//Changes to parameters (values, temperature dependence, spatial variation) mark their own cached values out of date, also done for all parameters on UpdateConfiguration.
+	void update_parameter_cache(void);
+	void invalidate_parameter_cache(void);
+
+	//request per-cell caching for all parameters in the list : call from modules which read these parameters in every M cell
+	template <typename ... MeshParam_List>
+	void request_parameter_cache(MeshParam_List& ... params) { (params.request_cache(), ...); }
+
 	//others	
 
 	//copy all parameters from another Mesh
@@ -246,6 +256,15 @@ public:
 	template <typename ... MeshParam_List>
 	void update_parameters_atposition(const DBL3& position, MeshParam_List& ... params);
 
+	//UNIFORMITY CHECK - PUBLIC
+
+	//Check if all parameters in the list have the same value in every cell (no spatial dependence, and no temperature dependence if a temperature mesh is set) : the current values can then be used directly without per-cell updates
+	template <typename PType, typename SType, typename ... MeshParam_List>
+	bool is_uniform_parameters(MatP<PType, SType>& matp, MeshParam_List& ... params) { return is_uniform_parameters(matp) && is_uniform_parameters(params...); }
+
+	template <typename PType, typename SType>
+	bool is_uniform_parameters(MatP<PType, SType>& matp) { return !matp.is_sdep() && (!Temp.linear_size() || !matp.is_tdep()); }
+
 	//----------------------------------- DISPLAY-ASSOCIATED GET/SET METHODS : MeshDisplay.cpp
 
 	//Return quantity currently set to display on screen.
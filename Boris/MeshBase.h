@@ -335,6 +335,9 @@ public:
 	//update computational state of all modules in this mesh; return total energy density -> each module will have a contribution, so sum it
 	double UpdateModules(void);
 
+	//task-parallel evaluation : mark modules which split UpdateField for this iteration (see Modules::UpdateField_Async), adding them to pAsync. These are then skipped by UpdateModules.
+	void Set_Async_Modules(std::vector<Modules*>& pAsync);
+
 	//update MOD_TRANSPORT module only if set
 	virtual void UpdateTransportSolver(void) = 0;
 
@@ -354,6 +357,10 @@ public:
 	virtual void SetBaseTemperature(double Temperature, bool clear_equation = true) = 0;
 	double GetBaseTemperature(void) { return base_temperature; }
 
+	//per-cell material parameters cache (micromagnetic meshes only, see Mesh) : recalculate out of date cached values, or mark all cached values out of date (e.g. temperature changed)
+	virtual void update_parameter_cache(void) {}
+	virtual void invalidate_parameter_cache(void) {}
+
 	//set text equation for base temperature : when iterating, the base temperature will be evaluated and set using the text equation
 	BError SetBaseTemperatureEquation(std::string equation_string, int step);
 	void UpdateTEquationUserConstants(void);
@@ -81,12 +81,18 @@ double MeshBase::UpdateModules(void)
 		SetBaseTemperature(T_equation.evaluate(pSMesh->GetStageTime()), false);
 	}
 
+	//recalculate any out of date cached material parameters before they're used by modules
+	update_parameter_cache();
+
 	//total energy density
 	double energy = 0;
 
 	//Update effective field by adding in contributions from each set module
 	for (int idx = 0; idx < (int)pMod.size(); idx++) {
 
+		//modules split for task-parallel evaluation are completed separately
+		if (pMod[idx]->Is_Async_Update()) continue;
+
 		//if for a module it doesn't make sense to contribute to the total energy density, then it should return zero.
 		energy += pMod[idx]->UpdateField();
 	}
@@ -94,6 +100,15 @@ double MeshBase::UpdateModules(void)
 	return energy;
 }
 
+//task-parallel evaluation : mark modules which split UpdateField for this iteration, adding them to pAsync
+void MeshBase::Set_Async_Modules(std::vector<Modules*>& pAsync)
+{
+	for (int idx = 0; idx < (int)pMod.size(); idx++) {
+
+		if (pMod[idx]->Set_Async_Update(true)) pAsync.push_back(pMod[idx]);
+	}
+}
+
 #if COMPILECUDA == 1
 void MeshBase::UpdateModulesCUDA(void)
 {
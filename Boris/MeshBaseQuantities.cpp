@@ -17,6 +17,9 @@ void MeshBase::SetTempFromData(VEC<double>& data, const Rect& dstRect)
 	//copy values in data, as well as shape
 	Temp.copy_values(data, dstRect);
 
+	//cached material parameters are out of date for the new Temp (not updated by the heat solver if temperature is fixed)
+	invalidate_parameter_cache();
+
 #if COMPILECUDA == 1
 	//refresh gpu memory
 	if (pMeshBaseCUDA) pMeshBaseCUDA->Temp()->copy_from_cpuvec(Temp);
@@ -43,6 +43,9 @@ void Mesh::MoveMesh(double x_shift)
 
 	//3. shift Temp
 	if (Temp.linear_size()) CallModuleMethod(&HeatBase::MoveMesh_Heat, x_shift);
+
+	//4. cached material parameters are out of date if Temp has been shifted
+	if (Temp.linear_size()) invalidate_parameter_cache();
 }
 
 //set PBC for required VECs : should only be called from a demag module
@@ -432,4 +432,34 @@ bool MeshParams::update_meshparam_equations(PARAM_ paramID, vector_key<double>&
 	};
 
 	return run_on_param<bool>(paramID, code, userConstants, meshDimensions, T_Curie, base_temperature);
-}
\ No newline at end of file
+}
+
+//-------------------------Per-cell cache
+
+//recalculate out of date cached values of all parameters in the cells of M (see MatP::update_cache)
+void MeshParams::update_meshparam_cache(VEC_VC<DBL3>& M, VEC_VC<double>& Temp)
+{
+	auto code = [](auto& MatP_object, VEC_VC<DBL3>& M, VEC_VC<double>& Temp) -> void {
+
+		MatP_object.update_cache(M, Temp);
+	};
+
+	for (int index = 0; index < meshParams.size(); index++) {
+
+		run_on_param<void>((PARAM_)meshParams.get_ID_from_index(index), code, M, Temp);
+	}
+}
+
+//mark all cached parameter values out of date
+void MeshParams::invalidate_meshparam_cache(void)
+{
+	auto code = [](auto& MatP_object) -> void {
+
+		MatP_object.invalidate_cache();
+	};
+
+	for (int index = 0; index < meshParams.size(); index++) {
+
+		run_on_param<void>((PARAM_)meshParams.get_ID_from_index(index), code);
+	}
+}
@@ -296,6 +296,12 @@ public:
 
 	//update text equations for mesh parameters with user constants, mesh dimensions, Curie temperature, base temperature
 	bool update_meshparam_equations(PARAM_ paramID, vector_key<double>& userConstants, DBL3 meshDimensions);
+
+	//-------------------------Per-cell cache
+
+	//recalculate out of date cached values of all parameters in the cells of M (see MatP::update_cache), or mark all cached values out of date
+	void update_meshparam_cache(VEC_VC<DBL3>& M, VEC_VC<double>& Temp);
+	void invalidate_meshparam_cache(void);
 };
 
 //-------------------------Parameter control
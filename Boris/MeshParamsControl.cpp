@@ -25,6 +25,7 @@ void Mesh::SetBaseTemperature(double Temperature, bool clear_equation)
 
 	//1a. reset Temp VEC to base temperature
 	CallModuleMethod(&HeatBase::SetBaseTemperature, Temperature);
+	invalidate_parameter_cache();
 
 	//1b. Zeeman module might set field using a custom user equation where the base temperature is a parameter
 	CallModuleMethod(&ZeemanBase::SetBaseTemperature, Temperature);
@@ -39,6 +40,20 @@ void Mesh::SetBaseTemperature(double Temperature, bool clear_equation)
 	CallModuleMethod(&Transport::CalculateElectricalConductivity, true);
 }
 
+//----------------------------------- PARAMETERS CACHE
+
+//recalculate out of date cached values of parameters requested by modules
+void Mesh::update_parameter_cache(void)
+{
+	update_meshparam_cache(M, Temp);
+}
+
+//mark all cached parameter values out of date
+void Mesh::invalidate_parameter_cache(void)
+{
+	invalidate_meshparam_cache();
+}
+
 //----------------------------------- OTHERS
 
 //copy all parameters from another Mesh
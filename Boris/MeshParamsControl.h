@@ -55,7 +55,12 @@ void Mesh::update_parameters_full(const DBL3& position, const double& Temperatur
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) {
+
+		matp_value = matp.get_cached(mcell_idx);
+		update_parameters_mcoarse_spatial(mcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 
@@ -72,7 +77,8 @@ void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType>
 void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) matp_value = matp.get(M.cellidx_to_position(mcell_idx), pSMesh->GetStageTime());
+	if (matp.is_cached()) matp_value = matp.get_cached(mcell_idx);
+	else if (matp.is_sdep()) matp_value = matp.get(M.cellidx_to_position(mcell_idx), pSMesh->GetStageTime());
 }
 
 //SPATIAL AND TEMPERATURE DEPENDENCE - NO POSITION YET
@@ -81,7 +87,12 @@ void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) {
+
+		matp_value = matp.get_cached(mcell_idx);
+		update_parameters_mcoarse_full(mcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 		double Temperature = Temp[position];
@@ -107,7 +118,8 @@ void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& mat
 template <typename PType, typename SType>
 void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) matp_value = matp.get_cached(mcell_idx);
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 
@@ -124,6 +136,7 @@ void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& mat
 //UPDATER M COARSENESS - PUBLIC
 
 //Update parameter values if temperature dependent at the given cell index - M cell index; position not calculated
+//Parameters with up to date per-cell cached values (see update_parameter_cache) are read from the cache.
 template <typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse(int mcell_idx, MeshParam_List& ... params)
 {
@@ -170,6 +170,9 @@ BError FMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 {
 	BError error(std::string(CLASS_STR(FMesh)) + "(" + (*pSMesh).key_from_meshId(meshId) + ")");
 
+	//any configuration change (parameters, temperature, mesh dimensions) can make cached material parameters out of date
+	invalidate_parameter_cache();
+
 	///////////////////////////////////////////////////////
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
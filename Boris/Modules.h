@@ -19,6 +19,9 @@ private:
 
 	OmpReduction<DBL3> reduction;
 
+	//UpdateField split in 2 stages for the current iteration (see UpdateField_Async below)
+	bool async_update = false;
+
 protected:
 
 	//if the object couldn't be created properly in the constructor an error is set here
@@ -131,6 +134,20 @@ public:
 	void UpdateFieldCUDA(void) { if (pModuleCUDA) pModuleCUDA->UpdateField(); }
 #endif
 
+	//-------------------------- UpdateField : task-parallel evaluation
+
+	//Modules whose UpdateField is dominated by work which doesn't need Heff (e.g. ffts in demag convolutions) can have this work overlapped with UpdateField of other modules. In this case UpdateField is split in 2 stages:
+	//1. UpdateField_Async : compute contribution into storage held by the module. Must not read or write Heff, nor anything other modules write to in their UpdateField, since it runs concurrently with them.
+	//2. UpdateField_Complete : called after all other modules have been updated. Add contribution to Heff and return energy density as UpdateField would.
+	//Can_Async_UpdateField returns true if this split is possible in the current configuration, otherwise UpdateField is called as normal.
+	virtual bool Can_Async_UpdateField(void) { return false; }
+	virtual void UpdateField_Async(void) {}
+	virtual double UpdateField_Complete(void) { return 0.0; }
+
+	//set before starting the concurrent evaluation : return true if UpdateField is split for this iteration, in which case UpdateField must not be called. Reset after UpdateField_Complete.
+	bool Set_Async_Update(bool status) { async_update = status && Can_Async_UpdateField(); return async_update; }
+	bool Is_Async_Update(void) { return async_update; }
+
 	//-------------------------- Effective field and energy VECs
 
 	//Make sure memory is allocated correctly for display data if used, else free memory
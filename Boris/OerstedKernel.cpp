@@ -162,17 +162,17 @@ BError OerstedKernel::Calculate_Oersted_Kernels_3D(void)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	//lambda used to transform an input real tensor into an output real kernel
 	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel) -> void {
@@ -270,6 +270,9 @@ BError OerstedKernel::Calculate_Oersted_Kernels_3D(void)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
@@ -429,22 +429,22 @@ BError RoughnessKernel<Owner>::Calculate_Roughness_Kernels_2D(void)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -506,6 +506,9 @@ BError RoughnessKernel<Owner>::Calculate_Roughness_Kernels_2D(void)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_x_odiag);
 	fftw_destroy_plan(plan_fwd_y);
@@ -555,17 +558,17 @@ BError RoughnessKernel<Owner>::Calculate_Roughness_Kernels_3D(void)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		Get_FFTW_Planner_Flags());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -712,6 +715,9 @@ BError RoughnessKernel<Owner>::Calculate_Roughness_Kernels_3D(void)
 
 	//-------------- CLEANUP
 
+	//store wisdom for any new fftw plans
+	Save_FFTW_Wisdom();
+
 	fftw_destroy_plan(plan_fwd_x);
 	fftw_destroy_plan(plan_fwd_y);
 	fftw_destroy_plan(plan_fwd_z);
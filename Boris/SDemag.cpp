@@ -399,6 +399,16 @@ BError SDemag::Set_Default_n_status(bool status)
 	return error;
 }
 
+//discard evaluation speedup history so the next step does a fresh demag evaluation, also in the CUDA module if enabled
+void SDemag::Reset_Speedup_History(void)
+{
+	num_Hdemag_saved = 0;
+
+#if COMPILECUDA == 1
+	if (pModuleCUDA) dynamic_cast<SDemagCUDA*>(pModuleCUDA)->Reset_Speedup_History();
+#endif
+}
+
 //Set PBC images for supermesh demag
 BError SDemag::Set_PBC(INT3 demag_pbc_images_)
 {
@@ -1664,4 +1674,29 @@ double SDemag::UpdateField(void)
 	return energy;
 }
 
+//-------------------Task-parallel evaluation
+
+//as for supermesh convolution in UpdateField, but don't transfer out to Heff yet as other modules are being evaluated at the same time
+void SDemag::UpdateField_Async(void)
+{
+	//transfer values from invidual M meshes to sm_Vals
+	if (!antiferromagnetic_meshes_present) sm_Vals.transfer_in();
+	else sm_Vals.transfer_in_averaged();
+
+	//convolution with demag kernels, output overwrites in sm_Vals
+	energy = Convolute(sm_Vals, sm_Vals, true);
+
+	//finish off energy value
+	energy *= -MU0 / (2 * non_empty_cells);
+}
+
+double SDemag::UpdateField_Complete(void)
+{
+	//transfer to individual Heff meshes
+	if (!antiferromagnetic_meshes_present) sm_Vals.transfer_out();
+	else sm_Vals.transfer_out_duplicated();
+
+	return energy;
+}
+
 #endif
\ No newline at end of file
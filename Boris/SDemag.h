@@ -167,6 +167,11 @@ public:
 
 	double UpdateField(void);
 
+	//task-parallel evaluation : transfer in and convolution in async stage, transfer out to Heff in complete stage. Only available for supermesh convolution.
+	bool Can_Async_UpdateField(void) { return !use_multilayered_convolution; }
+	void UpdateField_Async(void);
+	double UpdateField_Complete(void);
+
 	//-------------------Setters
 
 	//change between demag calculation types : super-mesh (status = false) or multilayered (status = true)
@@ -194,6 +199,11 @@ public:
 	//Get PBC images for supermesh demag
 	INT3 Get_PBC(void) { return demag_pbc_images; }
 
+	//-------------------Checkpoint
+
+	//discard evaluation speedup history so the next step does a fresh demag evaluation (e.g. after loading a checkpoint)
+	void Reset_Speedup_History(void);
+
 #if COMPILECUDA == 1
 	cu_obj<cuVEC<cuReal3>>& GetDemagFieldCUDA(void) { return dynamic_cast<SDemagCUDA*>(pModuleCUDA)->GetDemagField(); }
 #endif
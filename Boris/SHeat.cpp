@@ -8,7 +8,7 @@
 
 SHeat::SHeat(SuperMesh *pSMesh_) :
 	Modules(),
-	ProgramStateNames(this, {VINFO(heat_dT)}, {})
+	ProgramStateNames(this, {VINFO(heat_dT), VINFO(hsolver_type), VINFO(heat_dT_maxerror)}, {})
 {
 	pSMesh = pSMesh_;
 
@@ -32,11 +32,15 @@ BError SHeat::Initialize(void)
 	//heat_dT must be set correctly using the magnetic time step
 	magnetic_dT = pSMesh->GetTimeStep();
 
+	implicit_warning_pending = false;
+	implicit_warning_reported = false;
+
 	//check meshes to set heat boundary flags (NF_CMBND flags for Temp)
 
 	//clear everything then rebuild
 	pHeat.clear();
 	pTemp.clear();
+	pTemp_l.clear();
 	CMBNDcontacts.clear();
 
 	//now build pHeat (and pTemp)
@@ -46,6 +50,7 @@ BError SHeat::Initialize(void)
 
 			pHeat.push_back(dynamic_cast<HeatBase*>((*pSMesh)[idx]->GetModule(MOD_HEAT)));
 			pTemp.push_back(&(*pSMesh)[idx]->Temp);
+			pTemp_l.push_back(&(*pSMesh)[idx]->Temp_l);
 		}
 	}
 
@@ -72,6 +77,12 @@ BError SHeat::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		//clear everything then rebuild
 		pHeat.clear();
 		pTemp.clear();
+		pTemp_l.clear();
+		T_bicgstab.Clear();
+
+		Temp_start.clear();
+		Temp_l_start.clear();
+		Temp_estimate.clear();
 
 		//now build pHeat (and pTemp)
 		for (int idx = 0; idx < pSMesh->size(); idx++) {
@@ -80,6 +91,7 @@ BError SHeat::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 				pHeat.push_back(dynamic_cast<HeatBase*>((*pSMesh)[idx]->GetModule(MOD_HEAT)));
 				pTemp.push_back(&(*pSMesh)[idx]->Temp);
+				pTemp_l.push_back(&(*pSMesh)[idx]->Temp_l);
 			}
 		}
 	}
@@ -105,6 +117,14 @@ BError SHeat::MakeCUDAModule(void)
 	pModuleCUDA = new SHeatCUDA(pSMesh, this);
 	error = pModuleCUDA->Error_On_Create();
 
+	//the CUDA heat solver only implements FTCS : revert to it, also making sure heat_dT isn't left enlarged by an implicit solver
+	if (!error && hsolver_type != HSOLVER_FTCS) {
+
+		hsolver_type = HSOLVER_FTCS;
+		heat_dT = minimum(heat_dT, (double)HSOLVER_FTCS_DEFAULTDT);
+		error(BWARNING_HEATSOLVERCUDA);
+	}
+
 #endif
 
 	return error;
@@ -116,6 +136,22 @@ double SHeat::UpdateField(void)
 	//also if heat_dT is set to zero skip the heat equation solver : this will maintain a fixed temperature
 	if (!pSMesh->CurrentTimeStepSolved() || heat_dT < MINTIMESTEP) return 0.0;
 
+	//adaptive time step : heat_dT is adjusted as the heat equation is advanced over magnetic_dT
+	if (hsolver_type == HSOLVER_ADAPTIVE) {
+
+		advance_heat_equation_adaptive();
+
+		//temperature has changed so any cached temperature dependent material parameters are out of date
+		for (int idx = 0; idx < (int)pSMesh->size(); idx++) {
+
+			(*pSMesh)[idx]->invalidate_parameter_cache();
+		}
+
+		magnetic_dT = pSMesh->GetTimeStep();
+
+		return 0.0;
+	}
+
 	double dT = heat_dT;
 
 	//number of sub_steps to cover magnetic_dT required when advancing in smaller heat_dT steps
@@ -133,6 +169,14 @@ double SHeat::UpdateField(void)
 			else continue;
 		}
 
+		//implicit schemes : solve for new Temp in all meshes at once, including CMBND cells
+		//with a fixed time step the solution must be accepted even if the solver didn't converge, so warn instead (reduce heat_dT, or use the adaptive scheme)
+		if (hsolver_type != HSOLVER_FTCS) {
+
+			if (!iterate_heat_equation_implicit(dT, (hsolver_type == HSOLVER_CN ? 0.5 : 1.0))) set_implicit_warning();
+			continue;
+		}
+
 		//1. solve Temp in each mesh separately (1 iteration each) - CMBND cells not set yet
 		for (int idx = 0; idx < (int)pHeat.size(); idx++) {
 
@@ -144,6 +188,12 @@ double SHeat::UpdateField(void)
 		set_cmbnd_values();
 	}
 
+	//temperature has changed so any cached temperature dependent material parameters are out of date
+	for (int idx = 0; idx < (int)pSMesh->size(); idx++) {
+
+		(*pSMesh)[idx]->invalidate_parameter_cache();
+	}
+
 	//3. update the magnetic dT that will be used next time around to increment the heat solver by
 	magnetic_dT = pSMesh->GetTimeStep();
 
@@ -151,6 +201,176 @@ double SHeat::UpdateField(void)
 	return 0.0;
 }
 
+//-------------------Setters
+
+void SHeat::set_heat_solver_type(int hsolver_type_)
+{
+	if (hsolver_type_ >= HSOLVER_FTCS && hsolver_type_ < HSOLVER_NUMOPTIONS) hsolver_type = hsolver_type_;
+}
+
+//advance Temp in all meshes by dT using implicit theta-method (0.5 : Crank-Nicolson, 1 : backward Euler), with CMBND cells also set. Solver starts from pinitial_guess if given, else from current Temp.
+bool SHeat::iterate_heat_equation_implicit(double dT, double theta, std::vector<std::vector<double>>* pinitial_guess)
+{
+	//1. set up implicit equation in each mesh : meshes without a temperature model are not advanced, but their CMBND cells are still set
+	std::vector<int> active(pHeat.size(), false);
+	std::vector<std::vector<double>*> diag_shift(pHeat.size(), nullptr);
+
+	for (int idx = 0; idx < (int)pHeat.size(); idx++) {
+
+		if (pHeat[idx]->Get_TMType() != TMTYPE_1TM && pHeat[idx]->Get_TMType() != TMTYPE_2TM) continue;
+
+		if (pHeat[idx]->PrimeHeatEquation_Implicit(dT, theta)) {
+
+			active[idx] = true;
+			diag_shift[idx] = &pHeat[idx]->heatEq_diag;
+		}
+		//not enough memory for implicit scheme in this mesh : fall back to FTCS
+		else if (pHeat[idx]->Get_TMType() == TMTYPE_1TM) pHeat[idx]->IterateHeatEquation_1TM(dT);
+		else pHeat[idx]->IterateHeatEquation_2TM(dT);
+	}
+
+	//2. solve for new Temp over all meshes, starting from current Temp or the initial guess (equation already set up using current Temp)
+	if (pinitial_guess) {
+
+		for (int idx = 0; idx < (int)pHeat.size(); idx++) {
+
+			if (active[idx]) pTemp[idx]->quantity_ref() = (*pinitial_guess)[idx];
+		}
+	}
+
+	int iterations = 0;
+
+	DBL2 residual = T_bicgstab.Solve<SHeat>(
+		pTemp, active, &SHeat::set_cmbnd_values, &SHeat::calculate_residual_heat, *this,
+		HSOLVER_IMPLICIT_TOLERANCE, HSOLVER_IMPLICIT_MAXITERS, iterations, diag_shift);
+
+	//3. advance lattice temperature for 2TM
+	for (int idx = 0; idx < (int)pHeat.size(); idx++) {
+
+		if (active[idx]) pHeat[idx]->CompleteHeatEquation_Implicit(dT, theta);
+	}
+
+	//same convergence condition as used by the solver, but written so it fails for non-finite residual
+	return residual.i <= HSOLVER_IMPLICIT_TOLERANCE * residual.j;
+}
+
+//advance Temp in all meshes by dT using Crank-Nicolson, and set error to maximum difference from embedded backward Euler solution as error estimate (infinite if not finite).
+//Return false if either solver didn't converge.
+bool SHeat::iterate_heat_equation_adaptive(double dT, double& error)
+{
+	//1. lower order solution : backward Euler, which also damps stiff modes so any Crank-Nicolson oscillations show up in the error estimate
+	bool converged = iterate_heat_equation_implicit(dT, 1.0);
+
+	Temp_estimate.resize(pTemp.size());
+	for (int idx = 0; idx < (int)pTemp.size(); idx++) Temp_estimate[idx] = pTemp[idx]->quantity_ref();
+
+	//2. higher order solution : Crank-Nicolson from the same starting values, with solver started from backward Euler solution
+	restore_step_start();
+	converged &= iterate_heat_equation_implicit(dT, 0.5, &Temp_estimate);
+
+	//3. error estimate : local error of backward Euler solution, so conservative for the Crank-Nicolson solution kept
+	error = 0.0;
+
+	for (int idx = 0; idx < (int)pTemp.size(); idx++) {
+
+		VEC_VC<double>& Temp = *pTemp[idx];
+
+		error_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+		for (int cell_idx = 0; cell_idx < Temp.linear_size(); cell_idx++) {
+
+			if (Temp.is_not_empty(cell_idx)) {
+
+				//max reduction ignores NaN values, so make sure they are counted
+				double difference = fabs(Temp[cell_idx] - Temp_estimate[idx][cell_idx]);
+				error_reduction.reduce_max(std::isfinite(difference) ? difference : std::numeric_limits<double>::infinity());
+			}
+		}
+
+		error = maximum(error, error_reduction.maximum());
+	}
+
+	return converged;
+}
+
+//advance Temp in all meshes by magnetic_dT using adaptive time step, adjusting heat_dT
+void SHeat::advance_heat_equation_adaptive(void)
+{
+	double time_remaining = magnetic_dT;
+
+	while (time_remaining > 0.0) {
+
+		//last step to reach magnetic_dT may be shorter than heat_dT
+		bool last_step = (heat_dT >= time_remaining);
+		double dT = (last_step ? time_remaining : heat_dT);
+
+		save_step_start();
+
+		//solver not converged, or non-finite error estimate : treated as failed step, to be retried with the smallest time step change factor
+		double error = 0.0;
+		bool solved = iterate_heat_equation_adaptive(dT, error) && std::isfinite(error);
+
+		//time step change factor : backward Euler local error scales as dT^2
+		double factor = (!solved ? HSOLVER_ADAPTIVE_MINFACTOR : (error > 0.0 ? HSOLVER_ADAPTIVE_SAFETY * sqrt(heat_dT_maxerror / error) : HSOLVER_ADAPTIVE_MAXFACTOR));
+		factor = maximum((double)HSOLVER_ADAPTIVE_MINFACTOR, minimum((double)HSOLVER_ADAPTIVE_MAXFACTOR, factor));
+
+		//reject step and try again with smaller time step
+		if ((!solved || error > heat_dT_maxerror) && dT > HSOLVER_ADAPTIVE_MINDT) {
+
+			restore_step_start();
+			heat_dT = maximum(dT * factor, (double)HSOLVER_ADAPTIVE_MINDT);
+			continue;
+		}
+
+		//failed step accepted at the minimum time step
+		if (!solved) set_implicit_warning();
+
+		//step accepted : a shortened last step should not reduce heat_dT unless the error requires it
+		if (last_step) {
+
+			heat_dT = (factor < 1.0 ? minimum(heat_dT, dT * factor) : maximum(heat_dT, dT * factor));
+			time_remaining = 0.0;
+		}
+		else {
+
+			heat_dT = dT * factor;
+			time_remaining -= dT;
+		}
+
+		heat_dT = maximum((double)HSOLVER_ADAPTIVE_MINDT, minimum((double)MAXTIMESTEP, heat_dT));
+	}
+}
+
+//save Temp and Temp_l values at start of step
+void SHeat::save_step_start(void)
+{
+	Temp_start.resize(pTemp.size());
+	Temp_l_start.resize(pTemp.size());
+
+	for (int idx = 0; idx < (int)pTemp.size(); idx++) {
+
+		Temp_start[idx] = pTemp[idx]->quantity_ref();
+		Temp_l_start[idx] = pTemp_l[idx]->quantity_ref();
+	}
+}
+
+//restore Temp and Temp_l values saved at start of step
+void SHeat::restore_step_start(void)
+{
+	for (int idx = 0; idx < (int)pTemp.size() && idx < (int)Temp_start.size(); idx++) {
+
+		pTemp[idx]->quantity_ref() = Temp_start[idx];
+		pTemp_l[idx]->quantity_ref() = Temp_l_start[idx];
+	}
+}
+
+//residual of implicit heat equation in mesh with given index, for current Temp values
+void SHeat::calculate_residual_heat(int mesh_idx, std::vector<double>& r)
+{
+	pHeat[mesh_idx]->CalculateHeatEquation_Residual(r);
+}
+
 //calculate and set values at composite media boundaries after all other cells have been computed and set
 void SHeat::set_cmbnd_values(void)
 {
@@ -2,6 +2,7 @@
 
 #include "BorisLib.h"
 #include "Modules.h"
+#include "Heat_Defs.h"
 
 
 
@@ -16,7 +17,7 @@ class HeatBase;
 
 class SHeat :
 	public Modules,
-	public ProgramState<SHeat, std::tuple<double>, std::tuple<>>
+	public ProgramState<SHeat, std::tuple<double, int, double>, std::tuple<>>
 {
 
 #if COMPILECUDA == 1
@@ -40,20 +41,61 @@ private:
 	//vector of pointers to all Temp - need this to set cmbnd flags (same ordering as first vector in CMBNDcontacts)
 	std::vector<VEC_VC<double>*> pTemp;
 
+	//vector of pointers to all Temp_l (same ordering as pTemp; empty VECs if not using 2TM)
+	std::vector<VEC_VC<double>*> pTemp_l;
+
 	//----------------------
 
 	//time step for the heat equation - if in a magnetic mesh must always be smaller or equal to dT (the magnetization equation time-step)
-	double heat_dT = 0.2e-12;
+	double heat_dT = HSOLVER_FTCS_DEFAULTDT;
 
 	//save the last magnetic dT used: when advancing the heat equation this is the time we need to advance by. 
 	//Update magnetic_dT after each heat equation advance (in case an adaptive time-step method is used for the magnetic part).
 	double magnetic_dT;
 
+	//time stepping scheme for the heat equation (HSOLVER_ enum) : with implicit schemes heat_dT is not limited by stability (CPU only)
+	int hsolver_type = HSOLVER_FTCS;
+
+	//Krylov solver for Temp over all heat meshes with CMBND conditions included in the operator (used with implicit schemes)
+	BiCGStabSolve<double> T_bicgstab;
+
+	//adaptive time step (HSOLVER_ADAPTIVE) : heat_dT is adjusted so the estimated temperature error in each step is below this value (K)
+	double heat_dT_maxerror = HSOLVER_ADAPTIVE_MAXERROR;
+
+	//adaptive time step : Temp and Temp_l values at the start of a step (to restore if rejected), and backward Euler solution used for error estimate
+	std::vector<std::vector<double>> Temp_start, Temp_l_start, Temp_estimate;
+
+	OmpReduction<double> error_reduction;
+
+	//implicit heat solver didn't converge in a time step which had to be accepted : warning to be reported (once per simulation run)
+	bool implicit_warning_pending = false, implicit_warning_reported = false;
+
 private:
 
 	//calculate and set values at composite media boundaries after all other cells have been computed and set
 	void set_cmbnd_values(void);
 
+	//advance Temp in all meshes by dT using implicit theta-method (0.5 : Crank-Nicolson, 1 : backward Euler), with CMBND cells also set. Solver starts from pinitial_guess if given, else from current Temp.
+	//Return false if the solver didn't converge (includes non-finite values).
+	bool iterate_heat_equation_implicit(double dT, double theta, std::vector<std::vector<double>>* pinitial_guess = nullptr);
+
+	//advance Temp in all meshes by dT using Crank-Nicolson, and set error to maximum difference from embedded backward Euler solution as error estimate (infinite if not finite).
+	//Return false if either solver didn't converge.
+	bool iterate_heat_equation_adaptive(double dT, double& error);
+
+	//implicit heat solver didn't converge in an accepted time step : set warning to be reported
+	void set_implicit_warning(void) { if (!implicit_warning_reported) implicit_warning_pending = true; }
+
+	//advance Temp in all meshes by magnetic_dT using adaptive time step, adjusting heat_dT
+	void advance_heat_equation_adaptive(void);
+
+	//save Temp and Temp_l values at start of step, or restore them
+	void save_step_start(void);
+	void restore_step_start(void);
+
+	//residual of implicit heat equation in mesh with given index, for current Temp values
+	void calculate_residual_heat(int mesh_idx, std::vector<double>& r);
+
 public:
 
 	SHeat(SuperMesh *pSMesh_);
@@ -80,10 +122,21 @@ public:
 
 	double get_heat_dT(void) { return heat_dT; }
 
+	int get_heat_solver_type(void) { return hsolver_type; }
+
+	double get_heat_dT_maxerror(void) { return heat_dT_maxerror; }
+
+	//return true (once per simulation run) if the implicit heat solver didn't converge in an accepted time step, so a warning can be shown
+	bool check_implicit_warning(void) { bool pending = implicit_warning_pending; if (pending) { implicit_warning_pending = false; implicit_warning_reported = true; } return pending; }
+
 	//-------------------Setters
 
 	void set_heat_dT(double dT) { heat_dT = dT; }
 
+	void set_heat_solver_type(int hsolver_type_);
+
+	void set_heat_dT_maxerror(double heat_dT_maxerror_) { if (heat_dT_maxerror_ > 0.0) heat_dT_maxerror = heat_dT_maxerror_; }
+
 };
 
 #else
@@ -118,10 +171,20 @@ public:
 
 	double get_heat_dT(void) { return 0.0; }
 
+	int get_heat_solver_type(void) { return 0; }
+
+	double get_heat_dT_maxerror(void) { return 0.0; }
+
+	bool check_implicit_warning(void) { return false; }
+
 	//-------------------Setters
 
 	void set_heat_dT(double dT) {}
 
+	void set_heat_solver_type(int hsolver_type_) {}
+
+	void set_heat_dT_maxerror(double heat_dT_maxerror_) {}
+
 };
 
 #endif
@@ -18,7 +18,7 @@ STransport::STransport(SuperMesh *pSMesh_) :
 	ProgramStateNames(this, { VINFO(electrode_rects), VINFO(electrode_potentials), 
 							  VINFO(ground_electrode_index), VINFO(potential), VINFO(current), VINFO(net_current), VINFO(resistance), VINFO(constant_current_source), 
 							  VINFO(errorMaxLaplace), VINFO(maxLaplaceIterations), VINFO(s_errorMax), VINFO(s_maxIterations), VINFO(SOR_damping),
-							  VINFO(V_equation), VINFO(I_equation) }, {})
+							  VINFO(V_equation), VINFO(I_equation), VINFO(tsolver_type) }, {})
 {
 	pSMesh = pSMesh_;
 
@@ -92,6 +92,10 @@ BError STransport::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		//clear everything then rebuild
 		pTransport.clear();
 		CMBNDcontacts.clear();
+
+		//previous solutions no longer valid for warm start
+		V_history.clear();
+		S_history.clear();
 		pV.clear();
 		pS.clear();
 		
@@ -209,6 +213,9 @@ double STransport::UpdateField(void)
 
 			recalculate_transport = false;
 
+			//start from extrapolation of previous solutions if this is better
+			extrapolate_transport_solution();
+
 			//solve only for charge current (V and Jc with continuous boundaries)
 			if (!pSMesh->SolveSpinCurrent()) solve_charge_transport_sor();
 			//solve both spin and charge currents (V, Jc, S with appropriate boundaries : continuous, except between N and F layers where interface conductivities are specified)
@@ -236,6 +243,8 @@ double STransport::UpdateField(void)
 				//in constant current mode we spend more iterations so the user should be aware of this
 				iters_to_conv += iters_to_conv_previous;
 			}
+
+			store_transport_solution();
 		}
 		else iters_to_conv = 0;
 	}
@@ -256,6 +265,111 @@ double STransport::UpdateField(void)
 	return 0.0;
 }
 
+//-------------------Warm start
+
+//set V (and S if spin transport solver enabled) to a polynomial extrapolation in time from previous converged solutions, but only keep it if the residual is reduced
+void STransport::extrapolate_transport_solution(void)
+{
+	double time = pSMesh->GetTime();
+
+	if (V_history.size() >= 2) {
+
+		double residual_norm = get_residual_norm_V();
+
+		if (V_history.extrapolate(pV, time) && get_residual_norm_V() > residual_norm) {
+
+			//extrapolation made it worse (e.g. abrupt change in potential) : start from previous solution instead
+			V_history.undo_extrapolate(pV);
+
+			if (!pSMesh->SolveSpinCurrent()) set_cmbnd_charge_transport();
+			else set_cmbnd_spin_transport_V();
+		}
+	}
+
+	if (pSMesh->SolveSpinCurrent() && S_history.size() >= 2) {
+
+		double residual_norm = get_residual_norm_S();
+
+		if (S_history.extrapolate(pS, time) && get_residual_norm_S() > residual_norm) {
+
+			S_history.undo_extrapolate(pS);
+			set_cmbnd_spin_transport_S();
+		}
+	}
+}
+
+//store current V (and S) as converged solutions at current time
+void STransport::store_transport_solution(void)
+{
+	double time = pSMesh->GetTime();
+
+	V_history.push(pV, time);
+
+	if (pSMesh->SolveSpinCurrent()) S_history.push(pS, time);
+	else S_history.clear();
+}
+
+//residual norm of Poisson equations for V (and S) over all transport meshes for current values - CMBND cells are set first
+double STransport::get_residual_norm_V(void)
+{
+	bool spin_solver = pSMesh->SolveSpinCurrent();
+
+	if (!spin_solver) set_cmbnd_charge_transport();
+	else set_cmbnd_spin_transport_V();
+
+	std::vector<double> r;
+	double residual_sq = 0.0;
+
+	for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+
+		r.resize(pV[idx]->linear_size());
+
+		if (!spin_solver) calculate_residual_charge_transport(idx, r);
+		else calculate_residual_spin_transport_V(idx, r);
+
+		double mesh_residual_sq = 0.0;
+
+#pragma omp parallel for reduction(+:mesh_residual_sq)
+		for (int cell_idx = 0; cell_idx < (int)r.size(); cell_idx++) {
+
+			mesh_residual_sq += r[cell_idx] * r[cell_idx];
+		}
+
+		residual_sq += mesh_residual_sq;
+	}
+
+	return sqrt(residual_sq);
+}
+
+double STransport::get_residual_norm_S(void)
+{
+	set_cmbnd_spin_transport_S();
+
+	std::vector<DBL3> r;
+	double residual_sq = 0.0;
+
+	for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+
+		if (pTransport[idx]->Get_STSolveType() == STSOLVE_NONE) continue;
+
+		r.resize(pS[idx]->linear_size());
+
+		calculate_residual_spin_transport_S(idx, r);
+
+		double mesh_residual_sq = 0.0;
+
+#pragma omp parallel for reduction(+:mesh_residual_sq)
+		for (int cell_idx = 0; cell_idx < (int)r.size(); cell_idx++) {
+
+			mesh_residual_sq += r[cell_idx] * r[cell_idx];
+		}
+
+		residual_sq += mesh_residual_sq;
+	}
+
+	return sqrt(residual_sq);
+}
+
 //-------------------
 
 //set fixed SOR damping values (for V and S solvers)
@@ -272,6 +386,13 @@ void STransport::SetSORDamping(DBL2 _SOR_damping)
 #endif
 }
 
+void STransport::SetChargeSolverType(int tsolver_type_)
+{
+	if (tsolver_type_ >= TSOLVER_SOR && tsolver_type_ < TSOLVER_NUMOPTIONS) tsolver_type = tsolver_type_;
+
+	recalculate_transport = true;
+}
+
 //-------------------
 
 DBL2 STransport::GetCurrent(void)
@@ -15,7 +15,7 @@ class SuperMesh;
 
 class STransport :
 	public Modules,
-	public ProgramState<STransport, std::tuple<vector_lut<Rect>, std::vector<double>, int, double, double, double, double, bool, double, int, double, int, DBL2, TEquation<double>, TEquation<double>>, std::tuple<>>
+	public ProgramState<STransport, std::tuple<vector_lut<Rect>, std::vector<double>, int, double, double, double, double, bool, double, int, double, int, DBL2, TEquation<double>, TEquation<double>, int>, std::tuple<>>
 {
 
 #if COMPILECUDA == 1
@@ -88,6 +88,17 @@ private:
 	//fixed SOR damping to use for V (first value) and S (second value) Poisson equations
 	DBL2 SOR_damping = DBL2(1.4, 0.5);
 
+	//solver used for the charge transport Poisson equation (TSOLVER_ in Transport_Defs.h) : SOR, or geometric multigrid
+	int tsolver_type = TSOLVER_SOR;
+
+	//Krylov solvers for V and S over all transport meshes with CMBND conditions included in the operator (used with TSOLVER_BICGSTAB)
+	BiCGStabSolve<double> V_bicgstab;
+	BiCGStabSolve<DBL3> S_bicgstab;
+
+	//converged V and S solutions from previous time steps, used to start the next solve from an extrapolated initial guess
+	VECHistory<double> V_history;
+	VECHistory<DBL3> S_history;
+
 	//after transport solver has relaxed below errorMaxLaplace, it only needs to be updated if relevant quantities change (e.g. potential, conductivity)
 	//When these changes occur this flag is set to true.
 	bool recalculate_transport = true;
@@ -109,12 +120,27 @@ private:
 
 	//-----Charge Transport only
 
-	//solve for V and Jc in all meshes using SOR
+	//solve for V and Jc in all meshes using SOR (or multigrid / BiCGStab as set by tsolver_type)
 	void solve_charge_transport_sor(void);
 
 	//calculate and set values at composite media boundaries for V (charge transport only) after all other cells have been computed and set
 	void set_cmbnd_charge_transport(void);
 
+	//-----Warm start
+
+	//set V (and S if spin transport solver enabled) to a polynomial extrapolation in time from previous converged solutions, but only keep it if the residual is reduced
+	void extrapolate_transport_solution(void);
+
+	//store current V (and S) as converged solutions at current time
+	void store_transport_solution(void);
+
+	//residual norm of Poisson equations for V (and S) over all transport meshes for current values - CMBND cells are set first
+	double get_residual_norm_V(void);
+	double get_residual_norm_S(void);
+
+	//residual of Poisson equation for V in transport mesh with given index (charge transport only) : call-back for Krylov solver
+	void calculate_residual_charge_transport(int mesh_idx, std::vector<double>& r);
+
 	//-----Spin and Charge Transport
 
 	//solve for V, Jc and S in all meshes using SOR for Poisson equation and FTCS for S equation
@@ -126,6 +152,10 @@ private:
 	//calculate and set values at composite media boundaries for S
 	void set_cmbnd_spin_transport_S(void);
 
+	//residual of Poisson equations for V and S in transport mesh with given index (when using spin transport solver) : call-backs for Krylov solver
+	void calculate_residual_spin_transport_V(int mesh_idx, std::vector<double>& r);
+	void calculate_residual_spin_transport_S(int mesh_idx, std::vector<DBL3>& r);
+
 	//functions to specify boundary conditions for interface conductance approach for charge : Jc_N = Jc_F = A + B * dV
 	double Afunc_V(int cell1_idx, int cell2_idx, DBL3 relpos_m1, DBL3 shift, DBL3 stencil, TransportBase& trans_sec, TransportBase& trans_pri) const;
 	double Bfunc_V(int cell1_idx, int cell2_idx, DBL3 relpos_m1, DBL3 shift, DBL3 stencil, TransportBase& trans_sec, TransportBase& trans_pri) const;
@@ -202,6 +232,9 @@ public:
 	//get fixed SOR damping values (for V and S solvers)
 	DBL2 GetSORDamping(void) { return SOR_damping; }
 
+	//get charge transport solver type (TSOLVER_)
+	int GetChargeSolverType(void) { return tsolver_type; }
+
 	//-------------------Setters
 
 	void Flag_Recalculate_Transport(void) { recalculate_transport = true; }
@@ -218,6 +251,9 @@ public:
 	//set fixed SOR damping values (for V and S solvers)
 	void SetSORDamping(DBL2 _SOR_damping);
 
+	//set charge transport solver type (TSOLVER_)
+	void SetChargeSolverType(int tsolver_type_);
+
 	//set text equation from std::string
 	BError SetPotentialEquation(std::string equation_string, int step);
 	BError SetCurrentEquation(std::string equation_string, int step);
@@ -325,6 +361,9 @@ public:
 	//get fixed SOR damping values (for V and S solvers)
 	DBL2 GetSORDamping(void) { return DBL2(); }
 
+	//get charge transport solver type (TSOLVER_)
+	int GetChargeSolverType(void) { return 0; }
+
 	//-------------------Setters
 
 	void Flag_Recalculate_Transport(void) {}
@@ -340,6 +379,9 @@ public:
 	//set fixed SOR damping values (for V and S solvers)
 	void SetSORDamping(DBL2 _SOR_damping) {}
 
+	//set charge transport solver type (TSOLVER_)
+	void SetChargeSolverType(int tsolver_type_) {}
+
 	//set text equation from std::string
 	BError SetPotentialEquation(std::string equation_string, int step) { return BError(); }
 	BError SetCurrentEquation(std::string equation_string, int step) { return BError(); }
@@ -11,32 +11,47 @@ void STransport::solve_charge_transport_sor(void)
 
 	iters_to_conv = 0;
 
-	do {
+	if (tsolver_type == TSOLVER_BICGSTAB) {
 
-		//get max error : the max change in V from one iteration to the next
-		max_error = DBL2();
+		//Krylov solver over all meshes at once : max_error is the normalized residual
+		std::vector<int> active(pTransport.size(), true);
 
-		//1. solve V in each mesh separately (1 iteration each) - but do not set CMBND cells yet
+		max_error = V_bicgstab.Solve<STransport>(
+			pV, active, &STransport::set_cmbnd_charge_transport, &STransport::calculate_residual_charge_transport, *this,
+			errorMaxLaplace, maxLaplaceIterations, iters_to_conv);
+
+		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+	}
+	else {
+
+		do {
+
+			//get max error : the max change in V from one iteration to the next
+			max_error = DBL2();
+
+			//1. solve V in each mesh separately (1 iteration each) - but do not set CMBND cells yet
 		
-		for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+			for (int idx = 0; idx < (int)pTransport.size(); idx++) {
 
-			DBL2 error;
+				DBL2 error;
 
-			error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+				if (tsolver_type == TSOLVER_SOR) error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+				else error = pTransport[idx]->IterateChargeSolver_MG(tsolver_type == TSOLVER_MGW ? 2 : 1);
 
-			if (error.first > max_error.first) max_error.first = error.first;
-			if (error.second > max_error.second) max_error.second = error.second;
-		}
+				if (error.first > max_error.first) max_error.first = error.first;
+				if (error.second > max_error.second) max_error.second = error.second;
+			}
 
-		//normalize error to maximum change
-		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+			//normalize error to maximum change
+			max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
 
-		//2. now set CMBND cells
-		set_cmbnd_charge_transport();
+			//2. now set CMBND cells
+			set_cmbnd_charge_transport();
 
-		iters_to_conv++;
+			iters_to_conv++;
 
-	} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
+		} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
+	}
 
 	//continue next iteration if iterations timeout reached - with this timeout built in the program doesn't block if errorMaxLaplace cannot be reached. 
 	if (iters_to_conv == maxLaplaceIterations) recalculate_transport = true;
@@ -51,6 +66,12 @@ void STransport::solve_charge_transport_sor(void)
 	energy = max_error.first;
 }
 
+//residual of Poisson equation for V in transport mesh with given index (charge transport only) : call-back for Krylov solver
+void STransport::calculate_residual_charge_transport(int mesh_idx, std::vector<double>& r)
+{
+	pTransport[mesh_idx]->CalculateChargeSolver_Residual(r);
+}
+
 //-------------------CMBND computation methods
 
 void STransport::set_cmbnd_charge_transport(void)
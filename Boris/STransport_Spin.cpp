@@ -21,32 +21,46 @@ void STransport::solve_spin_transport_sor(void)
 	
 	//1. Solve V everywhere for current S until convergence criteria hit
 
-	do {
+	if (tsolver_type == TSOLVER_BICGSTAB) {
 
-		//get max error : the max change in V from one iteration to the next
-		max_error = DBL2();
+		//Krylov solver over all meshes at once : max_error is the normalized residual
+		std::vector<int> active(pTransport.size(), true);
 
-		//solve V in each mesh separately (1 iteration each) - but do not set CMBND cells yet
-		for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+		max_error = V_bicgstab.Solve<STransport>(
+			pV, active, &STransport::set_cmbnd_spin_transport_V, &STransport::calculate_residual_spin_transport_V, *this,
+			errorMaxLaplace, maxLaplaceIterations, iters_to_conv);
 
-			DBL2 error;
+		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+	}
+	else {
 
-			if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) error = pTransport[idx]->IterateSpinSolver_Charge_SOR(SOR_damping.i);
-			else error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+		do {
 
-			if (error.first > max_error.first) max_error.first = error.first;
-			if (error.second > max_error.second) max_error.second = error.second;
-		}
+			//get max error : the max change in V from one iteration to the next
+			max_error = DBL2();
 
-		//normalize error to maximum change
-		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+			//solve V in each mesh separately (1 iteration each) - but do not set CMBND cells yet
+			for (int idx = 0; idx < (int)pTransport.size(); idx++) {
 
-		//now set CMBND cells for V
-		set_cmbnd_spin_transport_V();
+				DBL2 error;
+
+				if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) error = pTransport[idx]->IterateSpinSolver_Charge_SOR(SOR_damping.i);
+				else error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+
+				if (error.first > max_error.first) max_error.first = error.first;
+				if (error.second > max_error.second) max_error.second = error.second;
+			}
 
-		iters_to_conv++;
+			//normalize error to maximum change
+			max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
 
-	} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
+			//now set CMBND cells for V
+			set_cmbnd_spin_transport_V();
+
+			iters_to_conv++;
+
+		} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
+	}
 
 	//2. update E in all meshes
 	for (int idx = 0; idx < (int)pTransport.size(); idx++) {
@@ -66,31 +80,46 @@ void STransport::solve_spin_transport_sor(void)
 		if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) pTransport[idx]->PrimeSpinSolver_Spin();
 	}
 
-	do {
+	if (tsolver_type == TSOLVER_BICGSTAB) {
 
-		//get max error : the max change in |S| from one iteration to the next
-		max_error = DBL2();
+		//S only solved in meshes with a spin transport solver type set
+		std::vector<int> active(pTransport.size());
+		for (int idx = 0; idx < (int)pTransport.size(); idx++) active[idx] = (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE);
 
-		//solve S in each mesh separately (1 iteration each) - but do not set CMBND cells yet
-		for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+		max_error = S_bicgstab.Solve<STransport>(
+			pS, active, &STransport::set_cmbnd_spin_transport_S, &STransport::calculate_residual_spin_transport_S, *this,
+			s_errorMax, s_maxIterations, s_iters_to_conv);
 
-			DBL2 error;
+		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+	}
+	else {
 
-			if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) error = pTransport[idx]->IterateSpinSolver_Spin_SOR(SOR_damping.j);
+		do {
 
-			if (error.first > max_error.first) max_error.first = error.first;
-			if (error.second > max_error.second) max_error.second = error.second;
-		}
+			//get max error : the max change in |S| from one iteration to the next
+			max_error = DBL2();
 
-		//normalize error to maximum change
-		max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
+			//solve S in each mesh separately (1 iteration each) - but do not set CMBND cells yet
+			for (int idx = 0; idx < (int)pTransport.size(); idx++) {
+
+				DBL2 error;
 
-		//now set CMBND cells for S
-		set_cmbnd_spin_transport_S();
+				if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) error = pTransport[idx]->IterateSpinSolver_Spin_SOR(SOR_damping.j);
+
+				if (error.first > max_error.first) max_error.first = error.first;
+				if (error.second > max_error.second) max_error.second = error.second;
+			}
 
-		s_iters_to_conv++;
+			//normalize error to maximum change
+			max_error.first = (max_error.second > 0 ? max_error.first / max_error.second : max_error.first);
 
-	} while (max_error.first > s_errorMax && s_iters_to_conv < s_maxIterations);
+			//now set CMBND cells for S
+			set_cmbnd_spin_transport_S();
+
+			s_iters_to_conv++;
+
+		} while (max_error.first > s_errorMax && s_iters_to_conv < s_maxIterations);
+	}
 
 	//store the current max error in the energy term so it can be read if requested
 	energy = max_error.first;
@@ -99,6 +128,18 @@ void STransport::solve_spin_transport_sor(void)
 	recalculate_transport = true;
 }
 
+//residual of Poisson equations for V and S in transport mesh with given index (when using spin transport solver) : call-backs for Krylov solver
+void STransport::calculate_residual_spin_transport_V(int mesh_idx, std::vector<double>& r)
+{
+	if (pTransport[mesh_idx]->Get_STSolveType() != STSOLVE_NONE) pTransport[mesh_idx]->CalculateSpinSolver_Charge_Residual(r);
+	else pTransport[mesh_idx]->CalculateChargeSolver_Residual(r);
+}
+
+void STransport::calculate_residual_spin_transport_S(int mesh_idx, std::vector<DBL3>& r)
+{
+	pTransport[mesh_idx]->CalculateSpinSolver_Spin_Residual(r);
+}
+
 //-------------------CMBND computation methods
 
 //------------ V (electrical potential)
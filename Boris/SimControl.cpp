@@ -52,6 +52,9 @@ void Simulation::Simulate(void)
 #else
 			SMesh.AdvanceTime();
 #endif
+
+			//implicit heat solver didn't converge in an accepted time step : show warning (once per simulation run)
+			if (SMesh.CallModuleMethod(&SHeat::check_implicit_warning)) err_hndl.show_error(BError(BWARNING_HEATSOLVERCONVERGENCE));
 		}
 
 		//Display update (asynchronous only if cuda is enabled)
@@ -60,6 +63,9 @@ void Simulation::Simulate(void)
 		//Check conditions for advancing simulation schedule
 		CheckSimulationSchedule();
 
+		//save checkpoint if configured : after the schedule was checked, so stage and step are up to date for the next iteration
+		CheckCheckpointConditions();
+
 		//finished this iteration
 		simulationMutex.unlock();
 
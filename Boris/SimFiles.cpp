@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "Simulation.h"
+#include "CheckpointFile.h"
 
 BError Simulation::SaveSimulation(std::string fileName)
 {
@@ -22,6 +23,9 @@ BError Simulation::SaveSimulation(std::string fileName)
 
 		bdout.precision(CONVERSIONPRECISION);
 
+		//skip cell flags set by the active set must not be saved with the magnetization (active set state is not saved)
+		SMesh.SuspendActiveSet(true);
+
 		//before saving, switch CUDA off, so everything is stored and up to date in cpu memory
 		if (cudaEnabled) {
 
@@ -40,6 +44,8 @@ BError Simulation::SaveSimulation(std::string fileName)
 		}
 		else SaveObjectState(bdout);
 
+		SMesh.SuspendActiveSet(false);
+
 		bdout.close();
 
 		if (!error) currentSimulationFile = fileName;
@@ -175,4 +181,85 @@ BError Simulation::LoadSimulation(std::string fileName)
 	else return error(BERROR_COULDNOTLOADFILE);
 
 	return error;
-}
\ No newline at end of file
+}
+
+//Save / Load binary checkpoint (.bck) of full solver state (see CheckpointFile.h) for the currently loaded simulation : stage, step, ODE solvers state and mesh quantities evolved in time.
+//SaveCheckpoint doesn't stop the simulation so it can also be called from the simulation loop (see CheckCheckpointConditions)
+BError Simulation::SaveCheckpoint(std::string fileName)
+{
+	BError error(__FUNCTION__);
+
+	if (GetFileTermination(fileName) != ".bck")
+		fileName += ".bck";
+
+	if (!GetFilenameDirectory(fileName).length()) fileName = directory + fileName;
+
+	//with CUDA enabled, quantities held in gpu memory are copied to cpu memory when saved (see SuperMesh::Checkpoint_State) : CUDA is not switched off here since that would change the solver state (e.g. primed evaluation, demag speedup history)
+	CheckpointFile cpt(fileName, CHECKPOINT_SAVE, Program_Version);
+
+	cpt.value("stage_step", stage_step);
+	SMesh.Checkpoint_State(cpt);
+
+	if (!cpt.close()) error(BERROR_COULDNOTSAVEFILE);
+
+	return error;
+}
+
+//The checkpoint must have been saved for the same simulation configuration (load the simulation file first) : it is verified before loading, thus nothing is changed if it doesn't match.
+BError Simulation::LoadCheckpoint(std::string fileName)
+{
+	BError error(__FUNCTION__);
+
+	StopSimulation();
+
+	if (GetFileTermination(fileName) != ".bck")
+		fileName += ".bck";
+
+	if (!GetFilenameDirectory(fileName).length()) fileName = directory + fileName;
+
+	//with CUDA enabled the checkpoint is loaded in cpu memory then copied to gpu memory (see SuperMesh::Checkpoint_State) : CUDA is not switched off here since that would reset the solver state (e.g. primed evaluation)
+
+	//1. verify checkpoint matches the current simulation configuration without changing anything
+	{
+		CheckpointFile cpt(fileName, CHECKPOINT_VERIFY, Program_Version);
+
+		//only the chunk is verified here, stage_step value is checked when loading
+		INT2 checkpoint_stage_step;
+		cpt.value("stage_step", checkpoint_stage_step);
+		SMesh.Checkpoint_State(cpt);
+
+		if (!cpt.close()) {
+
+			if (cpt.is_version_mismatch()) error(BERROR_COULDNOTLOADFILE_VERSIONMISMATCH);
+			else error(BERROR_COULDNOTLOADFILE);
+
+			return error;
+		}
+	}
+
+	//2. load : set stage and step first (this also starts a new stage in the ODE solvers), then load the ODE solvers state and mesh quantities
+	{
+		CheckpointFile cpt(fileName, CHECKPOINT_LOAD, Program_Version);
+
+		INT2 checkpoint_stage_step;
+		cpt.value("stage_step", checkpoint_stage_step);
+
+		if (!cpt.good() || checkpoint_stage_step.major < 0 || checkpoint_stage_step.major >= simStages.size() ||
+			checkpoint_stage_step.minor < 0 || checkpoint_stage_step.minor > simStages[checkpoint_stage_step.major].number_of_steps()) {
+
+			return error(BERROR_COULDNOTLOADFILE);
+		}
+
+		stage_step = checkpoint_stage_step;
+		SetSimulationStageValue();
+
+		SMesh.Checkpoint_State(cpt);
+
+		//the checkpoint was verified so this shouldn't fail, but if it does the simulation state is not reliable
+		if (!cpt.close()) error(BERROR_COULDNOTLOADFILE_CRIT);
+	}
+
+	UpdateScreen();
+
+	return error;
+}
@@ -1012,4 +1012,15 @@ void Simulation::SetSimulationStageValue(int stage_index)
 	}
 	break;
 	}
-}
\ No newline at end of file
+}
+void Simulation::CheckCheckpointConditions(void)
+{
+	//Monte-Carlo algorithm state is not included in checkpoints
+	if (!checkpoint_iterations || simStages[stage_step.major].stage_type() == SS_MONTECARLO) return;
+
+	if (!(SMesh.GetIteration() % checkpoint_iterations)) {
+
+		BError error = SaveCheckpoint(checkpointFile);
+		if (error) err_hndl.show_error(error, true);
+	}
+}
@@ -1,5 +1,7 @@
 #include "stdafx.h"
 #include "Simulation.h"
+#include "ConvolutionData.h"
+#include "DemagKernelCache.h"
 
 //save/load flags: start_check_updates, start_scriptserver, log_errors
 void Simulation::Load_Startup_Flags(void)
@@ -55,6 +57,42 @@ void Simulation::Load_Startup_Flags(void)
 				if (bdin.getline(line, FILEROWCHARS)) OmpThreads = ToNum(std::string(line));
 				if (OmpThreads == 0 || OmpThreads > omp_get_num_procs()) OmpThreads = omp_get_num_procs();
 			}
+
+			//FFTW planning rigor
+			if (std::string(line) == "fftw_planning") {
+
+				if (bdin.getline(line, FILEROWCHARS)) {
+
+					int fftw_planning = ToNum(std::string(line));
+					if (fftw_planning >= 0 && fftw_planning < FFTWPLAN_NUMVALUES) ConvolutionData::Set_FFTW_Planning(fftw_planning);
+				}
+			}
+
+			//number of lines in blocked ffts
+			if (std::string(line) == "fft_block_lines") {
+
+				if (bdin.getline(line, FILEROWCHARS)) ConvolutionData::Set_FFT_Block_Lines(ToNum(std::string(line)));
+			}
+
+			//single precision convolution
+			if (std::string(line) == "fft_single_precision") {
+
+				if (bdin.getline(line, FILEROWCHARS)) ConvolutionData::Set_FFT_Single_Precision(ToNum(std::string(line)));
+			}
+
+			//threads for task-parallel module evaluation
+			if (std::string(line) == "task_parallel_threads") {
+
+				if (bdin.getline(line, FILEROWCHARS)) SMesh.Set_TaskParallel_Threads(ToNum(std::string(line)));
+			}
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+			//Demag kernel cache enabled?
+			if (std::string(line) == "demagkernelcache") {
+
+				if (bdin.getline(line, FILEROWCHARS)) DemagKernelCache::Set_Enabled(ToNum(std::string(line)));
+			}
+#endif
 		}
 
 		bdin.close();
@@ -98,6 +136,28 @@ void Simulation::Save_Startup_Flags(void)
 		if (OmpThreads == omp_get_num_procs()) bdout << 0 << std::endl;
 		else bdout << OmpThreads << std::endl;
 
+		//FFTW planning rigor
+		bdout << "fftw_planning" << std::endl;
+		bdout << ConvolutionData::Get_FFTW_Planning() << std::endl;
+
+		//number of lines in blocked ffts
+		bdout << "fft_block_lines" << std::endl;
+		bdout << ConvolutionData::Get_FFT_Block_Lines() << std::endl;
+
+		//single precision convolution
+		bdout << "fft_single_precision" << std::endl;
+		bdout << ConvolutionData::Get_FFT_Single_Precision() << std::endl;
+
+		//threads for task-parallel module evaluation
+		bdout << "task_parallel_threads" << std::endl;
+		bdout << SMesh.Get_TaskParallel_Threads() << std::endl;
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+		//Demag kernel cache enabled?
+		bdout << "demagkernelcache" << std::endl;
+		bdout << DemagKernelCache::Get_Enabled() << std::endl;
+#endif
+
 		bdout.close();
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "stdafx.h"
 #include "Simulation.h"
+#include "DemagKernelCache.h"
 
 #if GRAPHICS == 1
 
@@ -27,7 +28,8 @@ Simulation::Simulation(
 			VINFO(image_cropping), VINFO(displayTransparency), VINFO(displayThresholds), VINFO(displayThresholdTrigger),
 			VINFO(shape_rotation), VINFO(shape_repetitions), VINFO(shape_displacement), VINFO(shape_method),
 			VINFO(userConstants),
-			VINFO(command_buffer)
+			VINFO(command_buffer),
+			VINFO(checkpoint_iterations), VINFO(checkpointFile)
 		}, {})
 
 #else
@@ -55,7 +57,8 @@ Simulation::Simulation(
 			VINFO(image_cropping), VINFO(displayTransparency), VINFO(displayThresholds), VINFO(displayThresholdTrigger),
 			VINFO(shape_rotation), VINFO(shape_repetitions), VINFO(shape_displacement), VINFO(shape_method),
 			VINFO(userConstants),
-			VINFO(command_buffer)
+			VINFO(command_buffer),
+			VINFO(checkpoint_iterations), VINFO(checkpointFile)
 		}, {})
 
 #endif
@@ -535,6 +538,12 @@ Simulation::Simulation(
 	commands[CMD_EXCLUDEMULTICONVDEMAG].descr = "[tc0,0.5,0.5,1/tc]Set exclusion status (0 or 1) of named mesh from multi-layered demag convolution (focused mesh if not specified).";
 	commands[CMD_EXCLUDEMULTICONVDEMAG].limits = { { Any(), Any() }, { int(0), int(1) } };
 
+	commands.insert(CMD_DEMAGTREECODE, CommandSpecifier(CMD_DEMAGTREECODE), "demagtreecode");
+	commands[CMD_DEMAGTREECODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>demagtreecode</b> <i>(meshname) status (theta)</i>";
+	commands[CMD_DEMAGTREECODE].descr = "[tc0,0.5,0.5,1/tc]Set hierarchical (tree-code) demag evaluation status (0 or 1) in named mesh (focused mesh if not specified), which must have the demag module enabled. When enabled the demag field is computed using an octree over non-empty cells instead of the FFT convolution, so computation cost scales with the number of magnetic cells rather than the mesh volume : useful for sparse geometries. Near-field interactions use the exact demag tensor, whilst well-separated clusters of cells use dipole and quadrupole expansions. Optionally set the opening angle theta (default 0.5) : smaller values are more accurate but slower. Only available for micromagnetic meshes with cuda 0; not used with pbc (FFT convolution used instead).";
+	commands[CMD_DEMAGTREECODE].limits = { { Any(), Any() }, { int(0), int(1) }, { double(0.0), double(1.0) } };
+	commands[CMD_DEMAGTREECODE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status theta</i>";
+
 	commands.insert(CMD_GPUKERNELS, CommandSpecifier(CMD_GPUKERNELS), "gpukernels");
 	commands[CMD_GPUKERNELS].usage = "[tc0,0.5,0,1/tc]USAGE : <b>gpukernels</b> <i>status</i>";
 	commands[CMD_GPUKERNELS].descr = "[tc0,0.5,0.5,1/tc]When in CUDA mode calculate demagnetization kernels initialization on the GPU (1) or on the CPU (0).";
@@ -791,6 +800,22 @@ Simulation::Simulation(
 	commands[CMD_LOADSIM].descr = "[tc0,0.5,0.5,1/tc]Load simulation with given name.";
 	commands[CMD_LOADSIM].limits = { { Any(), Any() } };
 
+	commands.insert(CMD_SAVECHECKPOINT, CommandSpecifier(CMD_SAVECHECKPOINT), "savecheckpoint");
+	commands[CMD_SAVECHECKPOINT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>savecheckpoint</b> <i>(directory/)filename</i>";
+	commands[CMD_SAVECHECKPOINT].descr = "[tc0,0.5,0.5,1/tc]Save binary checkpoint (.bck file) of full solver state : stage, step, ODE solvers state (including evaluation method buffers, time step and random number generators) and mesh quantities evolved in time. If no name given, the checkpoint file name set with checkpointevery is used. To restart from a checkpoint load the simulation file first, then the checkpoint with loadcheckpoint.";
+	commands[CMD_SAVECHECKPOINT].limits = { { Any(), Any() } };
+
+	commands.insert(CMD_LOADCHECKPOINT, CommandSpecifier(CMD_LOADCHECKPOINT), "loadcheckpoint");
+	commands[CMD_LOADCHECKPOINT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>loadcheckpoint</b> <i>(directory/)filename</i>";
+	commands[CMD_LOADCHECKPOINT].descr = "[tc0,0.5,0.5,1/tc]Load binary checkpoint (.bck file) of full solver state. The currently loaded simulation must have the same configuration (meshes, dimensions, evaluation method) as when the checkpoint was saved, otherwise the checkpoint is not loaded. If no name given, the checkpoint file name set with checkpointevery is used.";
+	commands[CMD_LOADCHECKPOINT].limits = { { Any(), Any() } };
+
+	commands.insert(CMD_CHECKPOINTEVERY, CommandSpecifier(CMD_CHECKPOINTEVERY), "checkpointevery");
+	commands[CMD_CHECKPOINTEVERY].usage = "[tc0,0.5,0,1/tc]USAGE : <b>checkpointevery</b> <i>iterations (filename)</i>";
+	commands[CMD_CHECKPOINTEVERY].limits = { { int(0), Any() }, { Any(), Any() } };
+	commands[CMD_CHECKPOINTEVERY].descr = "[tc0,0.5,0.5,1/tc]Save a checkpoint every given number of iterations during a simulation (0 to disable, default), overwriting the previous one. Checkpoints are written to a temporary file first so the previous checkpoint is kept if saving fails. Optionally set the checkpoint file name (default checkpoint). Not used in Monte-Carlo stages.";
+	commands[CMD_CHECKPOINTEVERY].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>iterations</i>";
+
 	commands.insert(CMD_DEFAULT, CommandSpecifier(CMD_DEFAULT), "default");
 	commands[CMD_DEFAULT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>default</b>";
 	commands[CMD_DEFAULT].descr = "[tc0,0.5,0.5,1/tc]Reset program to default state.";
@@ -986,10 +1011,10 @@ Simulation::Simulation(
 	commands[CMD_SETCURRENTDENSITY].limits = { { Any(), Any() }, { Any(), Any() } };
 
 	commands.insert(CMD_TSOLVERCONFIG, CommandSpecifier(CMD_TSOLVERCONFIG), "tsolverconfig");
-	commands[CMD_TSOLVERCONFIG].usage = "[tc0,0.5,0,1/tc]USAGE : <b>tsolverconfig</b> <i>convergence_error (iters_timeout)</i>";
-	commands[CMD_TSOLVERCONFIG].limits = { { double(0.0), double(1.0) }, { int(1), Any() } };
-	commands[CMD_TSOLVERCONFIG].descr = "[tc0,0.5,0.5,1/tc]Set transport solver convergence error and iterations for timeout (if given, else use default).";
-	commands[CMD_TSOLVERCONFIG].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>convergence_error iters_timeout</i>";
+	commands[CMD_TSOLVERCONFIG].usage = "[tc0,0.5,0,1/tc]USAGE : <b>tsolverconfig</b> <i>convergence_error (iters_timeout (solver_type))</i>";
+	commands[CMD_TSOLVERCONFIG].limits = { { double(0.0), double(1.0) }, { int(1), Any() }, { int(0), int(TSOLVER_NUMOPTIONS - 1) } };
+	commands[CMD_TSOLVERCONFIG].descr = "[tc0,0.5,0.5,1/tc]Set transport solver convergence error and iterations for timeout (if given, else use default). Optionally also set the charge solver type (CPU only) : 0 - SOR (default), 1 - multigrid V-cycle, 2 - multigrid W-cycle, 3 - BiCGStab over all meshes (charge and spin solvers). With multigrid one iteration is one cycle. With BiCGStab convergence_error applies to the normalized residual.";
+	commands[CMD_TSOLVERCONFIG].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>convergence_error iters_timeout solver_type</i>";
 
 	commands.insert(CMD_SSOLVERCONFIG, CommandSpecifier(CMD_SSOLVERCONFIG), "ssolverconfig");
 	commands[CMD_SSOLVERCONFIG].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ssolverconfig</b> <i>s_convergence_error (s_iters_timeout)</i>";
@@ -1039,11 +1064,11 @@ Simulation::Simulation(
 	commands[CMD_TEMPERATURE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i> - temperature value for focused mesh.";
 
 	commands.insert(CMD_SETHEATDT, CommandSpecifier(CMD_SETHEATDT), "setheatdt");
-	commands[CMD_SETHEATDT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setheatdt</b> <i>value</i>";
-	commands[CMD_SETHEATDT].limits = { { double(0), double(MAXTIMESTEP) } };
-	commands[CMD_SETHEATDT].descr = "[tc0,0.5,0.5,1/tc]Set heat equation solver time step.";
+	commands[CMD_SETHEATDT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setheatdt</b> <i>value (solver_type (max_error))</i>";
+	commands[CMD_SETHEATDT].limits = { { double(0), double(MAXTIMESTEP) }, { int(0), int(HSOLVER_NUMOPTIONS - 1) }, { double(0), Any() } };
+	commands[CMD_SETHEATDT].descr = "[tc0,0.5,0.5,1/tc]Set heat equation solver time step. Optionally also set the time stepping scheme (CPU only : with CUDA enabled only FTCS can be set, and switching CUDA on reverts to FTCS) : 0 - FTCS (default, time step limited by stability), 1 - Crank-Nicolson, 2 - backward Euler, 3 - adaptive Crank-Nicolson. The implicit schemes are unconditionally stable, so the time step can be as large as the magnetic time step; backward Euler is preferred for very large time steps since it damps stiff modes. With the adaptive scheme the given value is the starting time step, which is then adjusted to keep the estimated temperature error in each step below max_error (K, default 0.1 K) - the current value is reported by the heat_dT output data.";
 	commands[CMD_SETHEATDT].unit = "s";
-	commands[CMD_SETHEATDT].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i> - heat equation time step.";
+	commands[CMD_SETHEATDT].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value solver_type max_error</i> - heat equation time step, time stepping scheme and maximum temperature error for adaptive time step.";
 
 	commands.insert(CMD_AMBIENTTEMPERATURE, CommandSpecifier(CMD_AMBIENTTEMPERATURE), "ambient");
 	commands[CMD_AMBIENTTEMPERATURE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ambient</b> <i>(meshname) ambient_temperature</i>";
@@ -1130,6 +1155,24 @@ Simulation::Simulation(
 	commands[CMD_LINKDTSPEEDUP].limits = { { int(0), int(1) } };
 	commands[CMD_LINKDTSPEEDUP].descr = "[tc0,0.5,0.5,1/tc]Links speedup time-step to ODE time-step if set, else speedup time-step is independently controlled.";
 
+	commands.insert(CMD_SPEEDUPTOLERANCE, CommandSpecifier(CMD_SPEEDUPTOLERANCE), "speeduptolerance");
+	commands[CMD_SPEEDUPTOLERANCE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>speeduptolerance</b> <i>value</i>";
+	commands[CMD_SPEEDUPTOLERANCE].limits = { { double(0.0), Any() } };
+	commands[CMD_SPEEDUPTOLERANCE].descr = "[tc0,0.5,0.5,1/tc]Set tolerance for adaptive evaluation speedup (0 to disable, default). When set, and evaluation speedup is at least linear, cuda 0 demag modules estimate the relative error of extrapolating the demag field from previous evaluations at every evaluation, using the difference between successive extrapolation orders. The order with smallest estimated error is used if within tolerance (up to the order set by evalspeedup), else the demag field is recomputed, so setdtspeedup and linkdtspeedup are not used by these modules. Number of skipped demag evaluations and latest estimated error are available as data outputs (speedup_skipped, speedup_err).";
+	commands[CMD_SPEEDUPTOLERANCE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i>";
+
+	commands.insert(CMD_MULTIRATE, CommandSpecifier(CMD_MULTIRATE), "multirate");
+	commands[CMD_MULTIRATE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>multirate</b> <i>substeps</i>";
+	commands[CMD_MULTIRATE].limits = { { int(1), Any() } };
+	commands[CMD_MULTIRATE].descr = "[tc0,0.5,0.5,1/tc]Set multi-rate time stepping for multiscale simulations (1 to disable, default). When set, and both micromagnetic and atomistic meshes are being evaluated, micromagnetic meshes are advanced with the set time step (adaptive if the evaluation method is), then atomistic meshes are advanced over the same time interval with the given number of equal sub-steps. With adaptive evaluation methods the atomistic sub-steps are error controlled (more sub-steps are used if needed), and the next micromagnetic time step is limited to the given number of atomistic time steps. Coupling fields computed on the super-mesh (e.g. demag) are exchanged at the start of every micromagnetic time step and held constant over the atomistic sub-steps; surface exchange in atomistic meshes uses the micromagnetic state at the end of the time step. Not used with cuda 1, nor with the ABM, SD and NCG evaluation methods.";
+	commands[CMD_MULTIRATE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>substeps</i>";
+
+	commands.insert(CMD_ACTIVESET, CommandSpecifier(CMD_ACTIVESET), "activeset");
+	commands[CMD_ACTIVESET].usage = "[tc0,0.5,0,1/tc]USAGE : <b>activeset</b> <i>tolerance (steps)</i>";
+	commands[CMD_ACTIVESET].limits = { { double(0.0), Any() }, { int(1), Any() } };
+	commands[CMD_ACTIVESET].descr = "[tc0,0.5,0.5,1/tc]Set active set tolerance for relaxation in micromagnetic meshes (0 to disable, default). When set, blocks of cells with maximum normalized torque |M x Heff| / |M|^2 below tolerance are frozen (not evaluated) for the given number of time steps (default 20), after which they are re-checked. Frozen blocks next to active blocks are reactivated. Tolerance is in mxh units and should be set below the mxh stopping condition. Intended for relaxation : not used with cuda 1, nor with moving mesh.";
+	commands[CMD_ACTIVESET].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>tolerance steps</i>";
+
 	commands.insert(CMD_CUDA, CommandSpecifier(CMD_CUDA), "cuda");
 	commands[CMD_CUDA].usage = "[tc0,0.5,0,1/tc]USAGE : <b>cuda</b> <i>status</i>";
 	commands[CMD_CUDA].descr = "[tc0,0.5,0.5,1/tc]Switch CUDA GPU computations on/off.";
@@ -1326,6 +1369,34 @@ Simulation::Simulation(
 	commands[CMD_THREADS].limits = { { int(0), Any(omp_get_num_procs()) } };
 	commands[CMD_THREADS].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>num_threads</i>";
 
+	commands.insert(CMD_FFTWPLANNING, CommandSpecifier(CMD_FFTWPLANNING), "fftwplanning");
+	commands[CMD_FFTWPLANNING].usage = "[tc0,0.5,0,1/tc]USAGE : <b>fftwplanning</b> <i>rigor</i>";
+	commands[CMD_FFTWPLANNING].descr = "[tc0,0.5,0.5,1/tc]Set planning rigor for FFTW plans used by cuda 0 convolution modules (demag, dipole-dipole, Oersted, roughness) : estimate, measure, patient (default), exhaustive. Plans are stored as wisdom files in the Boris Data directory, keyed by transform sizes and number of threads, so planning cost is only incurred once for each configuration.";
+	commands[CMD_FFTWPLANNING].limits = { { Any(), Any() } };
+	commands[CMD_FFTWPLANNING].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>rigor</i>";
+
+	commands.insert(CMD_FFTBLOCKING, CommandSpecifier(CMD_FFTBLOCKING), "fftblocking");
+	commands[CMD_FFTBLOCKING].usage = "[tc0,0.5,0,1/tc]USAGE : <b>fftblocking</b> <i>lines</i>";
+	commands[CMD_FFTBLOCKING].descr = "[tc0,0.5,0.5,1/tc]Set number of adjacent lines batched into a single fft for the y and z passes of cuda 0 3D convolutions (default 8). Batched lines are gathered into small contiguous panels, which avoids large strides through the fft scratch space. Set 0 to compute one line at a time instead.";
+	commands[CMD_FFTBLOCKING].limits = { { int(0), Any() } };
+	commands[CMD_FFTBLOCKING].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>lines</i>";
+
+	commands.insert(CMD_FFTSINGLEPRECISION, CommandSpecifier(CMD_FFTSINGLEPRECISION), "fftsingleprecision");
+	commands[CMD_FFTSINGLEPRECISION].usage = "[tc0,0.5,0,1/tc]USAGE : <b>fftsingleprecision</b> <i>status</i>";
+	commands[CMD_FFTSINGLEPRECISION].descr = "[tc0,0.5,0.5,1/tc]Enable (1) or disable (0, default) single precision convolution for cuda 0 demag and dipole-dipole modules. Kernels are still computed in double precision, but are stored in single precision, and ffts, kernel multiplications and scratch spaces are done in single precision, with the resulting fields added to the effective field in double precision. This roughly halves memory traffic in the convolution, at the cost of field accuracy (relative error around 1e-6).";
+	commands[CMD_FFTSINGLEPRECISION].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
+
+	commands.insert(CMD_TASKPARALLEL, CommandSpecifier(CMD_TASKPARALLEL), "taskparallel");
+	commands[CMD_TASKPARALLEL].usage = "[tc0,0.5,0,1/tc]USAGE : <b>taskparallel</b> <i>threads</i>";
+	commands[CMD_TASKPARALLEL].descr = "[tc0,0.5,0.5,1/tc]Set number of threads used to evaluate cuda 0 demag convolutions (demag, atomistic demag, supermesh demag) concurrently with all other effective field modules, which use the remaining threads. Set 0 (default) to evaluate all modules one after the other, each using all threads. Not used at steps where demag evaluation speedup extrapolates the field, or with multilayered convolution.";
+	commands[CMD_TASKPARALLEL].limits = { { int(0), Any(omp_get_num_procs()) } };
+	commands[CMD_TASKPARALLEL].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>threads</i>";
+
+	commands.insert(CMD_DEMAGKERNELCACHE, CommandSpecifier(CMD_DEMAGKERNELCACHE), "demagkernelcache");
+	commands[CMD_DEMAGKERNELCACHE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>demagkernelcache</b> <i>status</i>";
+	commands[CMD_DEMAGKERNELCACHE].descr = "[tc0,0.5,0.5,1/tc]Enable (1) or disable (0) the on-disk cache for cuda 0 demag kernels (demag and multilayered convolution). When enabled, computed kernels are stored in binary files in the Boris Data directory, keyed by mesh dimensions, cellsize ratios, shifts and pbc images, and loaded instead of being recomputed.";
+	commands[CMD_DEMAGKERNELCACHE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
+
 	commands.insert(CMD_SERVERPORT, CommandSpecifier(CMD_SERVERPORT), "serverport");
 	commands[CMD_SERVERPORT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>serverport</b> <i>port</i>";
 	commands[CMD_SERVERPORT].descr = "[tc0,0.5,0.5,1/tc]Set script server port.";
@@ -1926,6 +1997,8 @@ Simulation::Simulation(
 	dataDescriptor.push_back("heat_dT", DatumSpecifier("heat dT : ", 1, "s"), DATA_HEATDT);
 	dataDescriptor.push_back("mxh", DatumSpecifier("|mxh| : ", 1), DATA_MXH);
 	dataDescriptor.push_back("dmdt", DatumSpecifier("|dm/dt| : ", 1), DATA_DMDT);
+	dataDescriptor.push_back("speedup_skipped", DatumSpecifier("Skipped demag evaluations : ", 1), DATA_SPEEDUP_SKIPPED);
+	dataDescriptor.push_back("speedup_err", DatumSpecifier("Demag extrapolation error : ", 1), DATA_SPEEDUP_ERROR);
 	dataDescriptor.push_back("Ha", DatumSpecifier("Applied Field : ", 3, "A/m", false), DATA_HA);
 	dataDescriptor.push_back("<M>", DatumSpecifier("<M> : ", 3, "A/m", false, false), DATA_AVM);
 	dataDescriptor.push_back("<M>th", DatumSpecifier("<M>th : ", 3, "A/m", false, false), DATA_THAVM);
@@ -2062,17 +2135,26 @@ Simulation::Simulation(
 	odeEvalHandles.push_back("RKF56", EVAL_RKF56);
 	odeEvalHandles.push_back("RKCK45", EVAL_RKCK45);
 	odeEvalHandles.push_back("RKDP54", EVAL_RKDP54);
+	odeEvalHandles.push_back("LSRK43", EVAL_LSRK43);
+	odeEvalHandles.push_back("ROS2", EVAL_ROS2);
 	odeEvalHandles.push_back("SDesc", EVAL_SD);
+	odeEvalHandles.push_back("NCG", EVAL_NCG);
+
+	//FFTW planning rigor
+	fftwPlanningHandles.push_back("estimate", FFTWPLAN_ESTIMATE);
+	fftwPlanningHandles.push_back("measure", FFTWPLAN_MEASURE);
+	fftwPlanningHandles.push_back("patient", FFTWPLAN_PATIENT);
+	fftwPlanningHandles.push_back("exhaustive", FFTWPLAN_EXHAUSTIVE);
 
 	//Allowed evaluation methods for given ODE
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLG);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_SD), ODE_LLGSTATIC);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_SD), ODE_LLGSTATICSA);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLGSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLB);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLBSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLGSA);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLBSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLG);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2, EVAL_SD, EVAL_NCG), ODE_LLGSTATIC);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2, EVAL_SD, EVAL_NCG), ODE_LLGSTATICSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLGSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLB);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLBSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLGSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK43, EVAL_ROS2), ODE_LLBSA);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLG);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLGSTT);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLB);
@@ -2183,6 +2265,14 @@ Simulation::Simulation(
 	//Load options for startup first
 	Load_Startup_Flags();
 
+	//fftw wisdom files stored in Boris Data directory
+	ConvolutionData::Set_FFTW_Wisdom_Directory(GetUserDocumentsPath() + boris_data_directory);
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+	//demag kernel cache files also stored in Boris Data directory
+	DemagKernelCache::Set_Directory(GetUserDocumentsPath() + boris_data_directory);
+#endif
+
 	//---------------------------------------------------------------- SERVER START
 
 	server_port = server_port_;
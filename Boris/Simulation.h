@@ -75,7 +75,8 @@ class Simulation :
 	DBL4, DBL2, DBL2, int,
 	DBL3, INT3, DBL3, std::string,
 	vector_key<double>,
-	std::vector<std::string>>,
+	std::vector<std::string>,
+	int, std::string>,
 	std::tuple<> >
 {
 private:
@@ -240,6 +241,9 @@ private:
 	//Link EVAL_ entries with text handles (EVAL_ is the major id)
 	vector_lut<std::string> odeEvalHandles;
 
+	//Link FFTWPLAN_ entries with text handles (FFTWPLAN_ is the major id)
+	vector_lut<std::string> fftwPlanningHandles;
+
 	//handles and descriptors for simulation stages types, stop conditions and data saving conditions, indexed by SS_ and STOP_ respectively, as well as keys (handles)
 	vector_key_lut<StageDescriptor> stageDescriptors;
 	vector_key_lut<StageStopDescriptor> stageStopDescriptors;
@@ -307,6 +311,13 @@ private:
 	//this is used to execute a sequennce of commands, e.g. for more advanced data extraction during a data saving schedule
 	std::vector<std::string> command_buffer;
 
+	////////////////////////////////////////////////////////////////////////////////////
+	//CHECKPOINTS
+
+	//save checkpoint every given number of iterations during a simulation (0 to disable), overwriting the previous one in checkpointFile (in directory)
+	int checkpoint_iterations = 0;
+	std::string checkpointFile = "checkpoint";
+
 	////////////////////////////////////////////////////////////////////////////////////
 	//DP ARRAYS
 
@@ -388,6 +399,10 @@ private:
 	BError SaveSimulation(std::string fileName);
 	BError LoadSimulation(std::string fileName);
 
+	//Save / Load binary checkpoint of full solver state (.bck file) : the checkpoint can only be loaded for the same simulation configuration it was saved from.
+	BError SaveCheckpoint(std::string fileName);
+	BError LoadCheckpoint(std::string fileName);
+
 	//implement pure virtual method from ProgramState
 	void RepairObjectState(void) 
 	{ 
@@ -458,6 +473,9 @@ private:
 	//check if conditions for saving data have been met for curent stage
 	void CheckSaveDataConditions();
 
+	//check if a checkpoint must be saved at the current iteration
+	void CheckCheckpointConditions(void);
+
 	//-------------------------------------Console messages helper methods
 
 	//show usage for given console command
@@ -150,6 +150,18 @@ Any Simulation::GetDataValue(DatumConfig dConfig)
 	}
 	break;
 
+	case DATA_SPEEDUP_SKIPPED:
+	{
+		return Any(SMesh.Get_Speedup_Skipped());
+	}
+	break;
+
+	case DATA_SPEEDUP_ERROR:
+	{
+		return Any(SMesh.Get_Speedup_Error());
+	}
+	break;
+
 	case DATA_AVM:
 	{
 		if (!SMesh[dConfig.meshName]->is_atomistic()) {
@@ -189,6 +189,15 @@ private:
 	//this vector is calculated at initialization and has same size as pMesh vector
 	std::vector<double> energy_density_weights;
 
+	//-----Task-parallel module evaluation
+
+	//number of threads used for the async stage of modules which support it (e.g. demag convolutions), running concurrently with the other modules using the remaining threads. 0 to disable.
+	int task_parallel_threads = 0;
+
+	//modules split for task-parallel evaluation in the current iteration, with weights to use for their energy density contributions
+	std::vector<Modules*> pAsync_Modules;
+	std::vector<double> async_energy_density_weights;
+
 public:
 
 	//name of super-mesh for use in console (e.g. addmodule supermesh sdemag). It is also a reserved name : no other module can be named with this handle
@@ -268,9 +277,25 @@ public:
 	//called by Simulation to advance simulation by a time step
 	void AdvanceTime(void);
 
+	//update effective fields in all meshes and super-mesh modules, return total energy density contribution with individual meshes weighted
+	double UpdateFields(void);
+
+	//AdvanceTime with multi-rate time stepping : micromagnetic meshes advanced with the full time step, then atomistic meshes with sub-steps over the same interval
+	void AdvanceTime_MultiRate(void);
+
+	//as UpdateFields, but also save the super-mesh modules contributions to atomistic meshes effective fields, to be held over the atomistic sub-steps
+	double UpdateFields_MultiRate_Sync(void);
+
 	//Similar to AdvanceTime but only computes effective fields and does not run the ODE solver
 	void ComputeFields(void);
 
+	//update effective fields in all meshes and super-mesh modules, with the async stage of modules which support it running concurrently with all other modules (task_parallel_threads set)
+	//return total energy density contribution, with individual meshes weighted as in AdvanceTime
+	double UpdateFields_TaskParallel(void);
+
+	void Set_TaskParallel_Threads(int threads) { task_parallel_threads = (threads > 0 ? threads : 0); }
+	int Get_TaskParallel_Threads(void) { return task_parallel_threads; }
+
 	//iterate transport solver only, if available
 	void UpdateTransportSolver(void);
 
@@ -287,6 +312,11 @@ public:
 	void Iterate_MonteCarloCUDA(double acceptance_rate);
 #endif
 
+	//--------------------------------------------------------- CHECKPOINT : SuperMeshCheckpoint.cpp
+
+	//save, verify or load simulation state in binary checkpoint : ODE solver state, then for each mesh its dimensions (must match) and quantities evolved in time (magnetization, temperature, etc.)
+	void Checkpoint_State(CheckpointFile& cpt);
+
 	//----------------------------------- ODE SOLVER CONTROL  : SuperMeshODE.cpp
 
 	//Reset all ODE solvers in meshes with on ODE
@@ -295,6 +325,9 @@ public:
 	//set new stage for ODE solvers
 	void NewStageODE(void);
 
+	//discard demag evaluation speedup history in all demag modules, so the next demag field evaluation is a full one
+	void Reset_Demag_Speedup_History(void);
+
 	//set the ode and evaluation method. Any new ODE in a magnetic mesh will use these settings. Currently Micromagnetic and Atomistic ODEs use the same evaluation method.
 	BError SetODE(ODE_ setOde, EVAL_ evalMethod);
 	//same for the atomistic ODE. Currently Micromagnetic and Atomistic ODEs use the same evaluation method.
@@ -324,6 +357,28 @@ public:
 	//check evaluation speedup settings in ode solver
 	int GetEvaluationSpeedup(void);
 
+	//set tolerance for adaptive evaluation speedup mode (0 to disable)
+	void SetSpeedupTolerance(double tolerance);
+	double GetSpeedupTolerance(void);
+	bool Is_Speedup_Adaptive(void);
+
+	//multi-rate time stepping : number of atomistic sub-steps for every micromagnetic time step (1 to disable)
+	void SetMultiRateSubsteps(int substeps);
+	int GetMultiRateSubsteps(void);
+
+	//active set : freeze blocks of cells with torque below tolerance during relaxation (0 to disable), re-checking them after the given number of time steps
+	void SetActiveSet(double tolerance, int steps);
+	double GetActiveSetTolerance(void);
+	int GetActiveSetSteps(void);
+
+	//clear (suspend = true) or set again (suspend = false) skip cell flags set by the active set, e.g. so they are not saved with the magnetization
+	void SuspendActiveSet(bool suspend);
+
+	//report decision made by a demag module in adaptive evaluation speedup mode
+	void Speedup_Evaluation_Report(bool skipped, double error);
+	int Get_Speedup_Skipped(void);
+	double Get_Speedup_Error(void);
+
 	//is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 	bool CurrentTimeStepSolved(void);
 
@@ -516,6 +571,9 @@ public:
 	//Set/Get multilayered demag exclusion : will need to call UpdateConfiguration when the flag is changed, so the correct SDemag_Demag modules and related settings are set from the SDemag module.
 	BError Set_Demag_Exclusion(bool exclude_from_multiconvdemag, std::string meshName);
 
+	//Set hierarchical (tree-code) demag evaluation in named mesh, instead of FFT convolution : Demag module must be enabled in this mesh. Opening angle theta not changed if zero.
+	BError Set_Demag_TreeCode(bool status, double theta, std::string meshName);
+
 	//set link_stochastic flag in named mesh, or all meshes if supermesh handle given
 	BError SetLinkStochastic(bool link_stochastic, std::string meshName);
 
@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "SuperMesh.h"
+#include "CheckpointFile.h"
+#include "DemagBase.h"
+
+//--------------------------------------------------------- CHECKPOINT
+
+//save, verify or load simulation state in binary checkpoint : ODE solver state, then for each mesh its dimensions (must match) and quantities evolved in time (magnetization, temperature, etc.)
+//Effective fields are included so the first time step after loading starts from the same values (e.g. for evaluation methods which re-use the last evaluation).
+void SuperMesh::Checkpoint_State(CheckpointFile& cpt)
+{
+	odeSolver.Checkpoint_State(cpt, this);
+
+	for (int idx = 0; idx < pMesh.size(); idx++) {
+
+		std::string prefix = pMesh.get_key_from_index(idx) + "/";
+
+		cpt.check(prefix + "n", pMesh[idx]->n);
+
+#if COMPILECUDA == 1
+		//with CUDA enabled quantities evolved in time are held in gpu memory : copy them to cpu memory first without changing the gpu state
+		if (cpt.is_saving() && pMesh[idx]->pMeshBaseCUDA) {
+
+			pMesh[idx]->pMeshBaseCUDA->V()->copy_to_cpuvec(pMesh[idx]->V);
+			pMesh[idx]->pMeshBaseCUDA->S()->copy_to_cpuvec(pMesh[idx]->S);
+			pMesh[idx]->pMeshBaseCUDA->Temp()->copy_to_cpuvec(pMesh[idx]->Temp);
+			pMesh[idx]->pMeshBaseCUDA->Temp_l()->copy_to_cpuvec(pMesh[idx]->Temp_l);
+			pMesh[idx]->pMeshBaseCUDA->u_disp()->copy_to_cpuvec(pMesh[idx]->u_disp);
+
+			if (pMesh[idx]->is_atomistic()) {
+
+				Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+				paMesh->paMeshCUDA->M1()->copy_to_cpuvec(paMesh->M1);
+				paMesh->paMeshCUDA->Heff1()->copy_to_cpuvec(paMesh->Heff1);
+			}
+			else {
+
+				Mesh* pmMesh = dynamic_cast<Mesh*>(pMesh[idx]);
+
+				pmMesh->pMeshCUDA->M()->copy_to_cpuvec(pmMesh->M);
+				pmMesh->pMeshCUDA->M2()->copy_to_cpuvec(pmMesh->M2);
+				pmMesh->pMeshCUDA->Heff()->copy_to_cpuvec(pmMesh->Heff);
+				pmMesh->pMeshCUDA->Heff2()->copy_to_cpuvec(pmMesh->Heff2);
+			}
+		}
+#endif
+
+		cpt.vec(prefix + "V", pMesh[idx]->V);
+		cpt.vec(prefix + "S", pMesh[idx]->S);
+		cpt.vec(prefix + "Temp", pMesh[idx]->Temp);
+		cpt.vec(prefix + "Temp_l", pMesh[idx]->Temp_l);
+		cpt.vec(prefix + "u_disp", pMesh[idx]->u_disp);
+
+		//Temp may have been loaded
+		if (cpt.is_loading()) pMesh[idx]->invalidate_parameter_cache();
+
+		if (pMesh[idx]->is_atomistic()) {
+
+			Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+			cpt.vec(prefix + "M1", paMesh->M1);
+			cpt.vec(prefix + "Heff1", paMesh->Heff1);
+			cpt.vec(prefix + "Heff1_coupling", paMesh->Heff1_coupling);
+		}
+		else {
+
+			Mesh* pmMesh = dynamic_cast<Mesh*>(pMesh[idx]);
+
+			cpt.vec(prefix + "M", pmMesh->M);
+			cpt.vec(prefix + "M2", pmMesh->M2);
+			cpt.vec(prefix + "Heff", pmMesh->Heff);
+			cpt.vec(prefix + "Heff2", pmMesh->Heff2);
+		}
+
+#if COMPILECUDA == 1
+		//loaded in cpu memory : copy to gpu memory, without switching CUDA off and on since that would reset the solver state
+		if (cpt.is_loading() && pMesh[idx]->pMeshBaseCUDA) {
+
+			pMesh[idx]->pMeshBaseCUDA->V()->copy_from_cpuvec(pMesh[idx]->V);
+			pMesh[idx]->pMeshBaseCUDA->S()->copy_from_cpuvec(pMesh[idx]->S);
+			pMesh[idx]->pMeshBaseCUDA->Temp()->copy_from_cpuvec(pMesh[idx]->Temp);
+			pMesh[idx]->pMeshBaseCUDA->Temp_l()->copy_from_cpuvec(pMesh[idx]->Temp_l);
+			pMesh[idx]->pMeshBaseCUDA->u_disp()->copy_from_cpuvec(pMesh[idx]->u_disp);
+
+			if (pMesh[idx]->is_atomistic()) {
+
+				Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+				paMesh->paMeshCUDA->M1()->copy_from_cpuvec(paMesh->M1);
+				paMesh->paMeshCUDA->Heff1()->copy_from_cpuvec(paMesh->Heff1);
+			}
+			else {
+
+				Mesh* pmMesh = dynamic_cast<Mesh*>(pMesh[idx]);
+
+				pmMesh->pMeshCUDA->M()->copy_from_cpuvec(pmMesh->M);
+				pmMesh->pMeshCUDA->M2()->copy_from_cpuvec(pmMesh->M2);
+				pmMesh->pMeshCUDA->Heff()->copy_from_cpuvec(pmMesh->Heff);
+				pmMesh->pMeshCUDA->Heff2()->copy_from_cpuvec(pmMesh->Heff2);
+			}
+		}
+#endif
+
+		//demag evaluation speedup history, so extrapolation continues from the same saved evaluations
+		//with CUDA enabled the history is held in gpu memory and is not saved : a fresh demag evaluation is done after loading
+		bool history_valid = true;
+#if COMPILECUDA == 1
+		history_valid = !pMesh[idx]->pMeshBaseCUDA;
+#endif
+
+		for (int idx_mod = 0; idx_mod < (*pMesh[idx])().size(); idx_mod++) {
+
+			DemagBase* pDemagBase = dynamic_cast<DemagBase*>((*pMesh[idx])[idx_mod]);
+			if (pDemagBase) pDemagBase->Checkpoint_State(cpt, prefix + "demag/", history_valid);
+		}
+	}
+
+	//supermesh demag evaluation speedup history is not saved : force a fresh evaluation after loading
+	if (cpt.is_loading() && IsSuperMeshModuleSet(MODS_SDEMAG)) dynamic_cast<SDemag*>(pSMod(MODS_SDEMAG))->Reset_Speedup_History();
+}
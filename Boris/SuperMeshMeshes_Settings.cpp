@@ -724,6 +724,20 @@ BError SuperMesh::Set_Demag_Exclusion(bool exclude_from_multiconvdemag, std::str
 	return error;
 }
 
+//Set hierarchical (tree-code) demag evaluation in named mesh, instead of FFT convolution : Demag module must be enabled in this mesh. Opening angle theta not changed if zero.
+BError SuperMesh::Set_Demag_TreeCode(bool status, double theta, std::string meshName)
+{
+	BError error(__FUNCTION__);
+
+	if (!contains(meshName) || !pMesh[meshName]->MComputation_Enabled()) return error(BERROR_INCORRECTNAME);
+
+	if (!pMesh[meshName]->Is_Demag_Enabled()) return error(BERROR_INCORRECTMODCONFIG);
+
+	error = pMesh[meshName]->CallModuleMethod(&DemagBase::Set_TreeCode, status, theta);
+
+	return error;
+}
+
 //set link_stochastic flag in named mesh, or all meshes if supermesh handle given
 BError SuperMesh::SetLinkStochastic(bool link_stochastic, std::string meshName)
 {
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "SuperMesh.h"
+#include "DemagBase.h"
 
 //----------------------------------- ODE SOLVER CONTROL
 
@@ -7,6 +8,9 @@
 void SuperMesh::ResetODE(void) 
 { 
 	odeSolver.Reset();
+
+	//saved demag evaluations are not valid for the reset magnetization
+	Reset_Demag_Speedup_History();
 }
 
 //set new stage for ODE solvers
@@ -17,6 +21,24 @@ void SuperMesh::NewStageODE(void)
 	
 	//new stage in ode
 	odeSolver.NewStage();
+
+	//stage values (e.g. applied field) may change abruptly : don't extrapolate demag field from evaluations done in the previous stage
+	Reset_Demag_Speedup_History();
+}
+
+//discard demag evaluation speedup history in all demag modules, so the next demag field evaluation is a full one
+void SuperMesh::Reset_Demag_Speedup_History(void)
+{
+	for (int idx = 0; idx < pMesh.size(); idx++) {
+
+		for (int idx_mod = 0; idx_mod < (*pMesh[idx])().size(); idx_mod++) {
+
+			DemagBase* pDemagBase = dynamic_cast<DemagBase*>((*pMesh[idx])[idx_mod]);
+			if (pDemagBase) pDemagBase->Reset_Speedup_History();
+		}
+	}
+
+	if (IsSuperMeshModuleSet(MODS_SDEMAG)) dynamic_cast<SDemag*>(pSMod(MODS_SDEMAG))->Reset_Speedup_History();
 }
 
 //set the ode and evaluation method. Any new ODE in a magnetic mesh will use these settings. Currently Micromagnetic and Atomistic ODEs use the same evaluation method.
@@ -132,6 +154,83 @@ int SuperMesh::GetEvaluationSpeedup(void)
 	return odeSolver.GetEvaluationSpeedup();
 }
 
+//set tolerance for adaptive evaluation speedup mode (0 to disable)
+void SuperMesh::SetSpeedupTolerance(double tolerance)
+{
+	odeSolver.SetSpeedupTolerance(tolerance);
+
+	//previous demag evaluations saved for extrapolation must be discarded
+	UpdateConfiguration(UPDATECONFIG_ODE_SOLVER);
+}
+
+double SuperMesh::GetSpeedupTolerance(void)
+{
+	return odeSolver.GetSpeedupTolerance();
+}
+
+//multi-rate time stepping : number of atomistic sub-steps for every micromagnetic time step (1 to disable)
+void SuperMesh::SetMultiRateSubsteps(int substeps)
+{
+	odeSolver.SetMultiRateSubsteps(substeps);
+
+	//coupling fields not needed any more
+	if (odeSolver.GetMultiRateSubsteps() <= 1) {
+
+		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+			if (pMesh[idx]->is_atomistic()) dynamic_cast<Atom_Mesh*>(pMesh[idx])->Heff1_coupling.clear();
+		}
+	}
+}
+
+int SuperMesh::GetMultiRateSubsteps(void)
+{
+	return odeSolver.GetMultiRateSubsteps();
+}
+
+//active set : freeze blocks of cells with torque below tolerance during relaxation (0 to disable), re-checking them after the given number of time steps
+void SuperMesh::SetActiveSet(double tolerance, int steps)
+{
+	odeSolver.SetActiveSet(tolerance, steps);
+}
+
+double SuperMesh::GetActiveSetTolerance(void)
+{
+	return odeSolver.GetActiveSetTolerance();
+}
+
+int SuperMesh::GetActiveSetSteps(void)
+{
+	return odeSolver.GetActiveSetSteps();
+}
+
+//clear (suspend = true) or set again (suspend = false) skip cell flags set by the active set, e.g. so they are not saved with the magnetization
+void SuperMesh::SuspendActiveSet(bool suspend)
+{
+	odeSolver.SuspendActiveSet(suspend);
+}
+
+bool SuperMesh::Is_Speedup_Adaptive(void)
+{
+	return odeSolver.Is_Speedup_Adaptive();
+}
+
+//report decision made by a demag module in adaptive evaluation speedup mode
+void SuperMesh::Speedup_Evaluation_Report(bool skipped, double error)
+{
+	odeSolver.Speedup_Evaluation_Report(skipped, error);
+}
+
+int SuperMesh::Get_Speedup_Skipped(void)
+{
+	return odeSolver.Get_Speedup_Skipped();
+}
+
+double SuperMesh::Get_Speedup_Error(void)
+{
+	return odeSolver.Get_Speedup_Error();
+}
+
 //is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 bool SuperMesh::CurrentTimeStepSolved(void)
 {
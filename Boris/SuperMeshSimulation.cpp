@@ -83,12 +83,21 @@ BError SuperMesh::InitializeAllModulesCUDA(void)
 
 void SuperMesh::AdvanceTime(void)
 {
-	//Currently micromagnetic and atomistic meshes must have the same ODE evaluation method set, with the same time-step.
-	//In the future this will be changed to allow better performance, as it's possible in a multiscale simulation some micromagnetics meshes can be evaluated with a larger time-step compared to atomistic ones.
+	//Micromagnetic and atomistic meshes must have the same ODE evaluation method set. They use the same time-step, unless multi-rate time stepping is enabled,
+	//in which case atomistic meshes are advanced with a number of sub-steps for every micromagnetic time step.
 
 	//moving mesh algorithm, if enabled
 	odeSolver.MovingMeshAlgorithm(this);
 
+	//active set algorithm (freeze converged blocks in micromagnetic meshes), if enabled
+	odeSolver.ActiveSetAlgorithm();
+
+	if (odeSolver.Use_MultiRate()) {
+
+		AdvanceTime_MultiRate();
+		return;
+	}
+
 	do {
 
 		//prepare meshes for new iteration (typically involves setting some state flag)
@@ -97,25 +106,236 @@ void SuperMesh::AdvanceTime(void)
 			pMesh[idx]->PrepareNewIteration();
 		}
 
-		total_energy_density = 0.0;
+		total_energy_density = UpdateFields();
+
+		//energy minimizers with a line search need the total energy for the current evaluation
+		odeSolver.Set_Minimizer_Energy(total_energy_density);
+
+		//iterate ODE evaluation method - ODE solvers are called separately in the magnetic meshes. This is why the same evaluation method must be used in all the magnetic meshes, with the same time step.
+		odeSolver.Iterate();
+
+	} while (!odeSolver.TimeStepSolved());
+}
+
+//update effective fields in all meshes and super-mesh modules, return total energy density contribution with individual meshes weighted
+double SuperMesh::UpdateFields(void)
+{
+	if (task_parallel_threads) return UpdateFields_TaskParallel();
+
+	double energy_density = 0.0;
+
+	//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
+	}
+
+	//update effective field for super-mesh modules
+	for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+		//super-mesh modules contribute with equal weights as sum total of individual mesh energy densities -> i.e. we don't need to apply a weight here
+		energy_density += pSMod[idx]->UpdateField();
+	}
+
+	return energy_density;
+}
+
+//AdvanceTime with multi-rate time stepping : micromagnetic meshes advanced with the full time step, then atomistic meshes with sub-steps over the same interval
+void SuperMesh::AdvanceTime_MultiRate(void)
+{
+	//1. micromagnetic pass : all effective fields are computed as usual (atomistic meshes not advanced so their magnetization is held at the synchronization point value),
+	//but only micromagnetic ODE solvers are iterated, with the full time step. At the synchronization point (start of time step) save coupling fields for atomistic meshes.
+	odeSolver.MultiRate_Begin_Micromagnetic();
+
+	do {
 
-		//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
 		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
 
-			total_energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
+			pMesh[idx]->PrepareNewIteration();
+		}
+
+		if (odeSolver.Is_MultiRate_SyncPoint()) total_energy_density = UpdateFields_MultiRate_Sync();
+		else total_energy_density = UpdateFields();
+
+		odeSolver.Iterate();
+
+	} while (!odeSolver.TimeStepSolved());
+
+	//2. atomistic pass : cover the micromagnetic time step just solved with sub-steps (error controlled with adaptive methods). Only atomistic mesh modules are updated (e.g. surface exchange with micromagnetic meshes now at end of time step),
+	//with the saved super-mesh modules contributions added. Super-mesh modules, including the heat solver, are only updated in the micromagnetic pass.
+	odeSolver.MultiRate_Begin_Atomistic();
+
+	while (!odeSolver.MultiRate_Atomistic_Done()) {
+
+		odeSolver.MultiRate_Begin_Substep();
+
+		do {
+
+			for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+				if (!pMesh[idx]->is_atomistic()) continue;
+
+				pMesh[idx]->PrepareNewIteration();
+				pMesh[idx]->UpdateModules();
+
+				Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+				if (paMesh->Heff1_coupling.linear_size() == paMesh->Heff1.linear_size()) {
+
+#pragma omp parallel for
+					for (int cidx = 0; cidx < paMesh->Heff1.linear_size(); cidx++) {
+
+						paMesh->Heff1[cidx] += paMesh->Heff1_coupling[cidx];
+					}
+				}
+			}
+
+			odeSolver.Iterate();
+
+		} while (!odeSolver.TimeStepSolved());
+	}
+
+	odeSolver.MultiRate_End();
+}
+
+//as UpdateFields, but also save the super-mesh modules contributions to atomistic meshes effective fields, to be held over the atomistic sub-steps
+//the contributions are obtained as the change in Heff1 due to super-mesh modules, so these must be updated after the mesh modules (not task-parallel here)
+double SuperMesh::UpdateFields_MultiRate_Sync(void)
+{
+	double energy_density = 0.0;
+
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
+	}
+
+	//Heff1 before super-mesh modules update
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		if (!pMesh[idx]->is_atomistic()) continue;
+
+		Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+		if (paMesh->Heff1_coupling.linear_size() != paMesh->Heff1.linear_size()) paMesh->Heff1_coupling.resize(paMesh->Heff1.h, paMesh->Heff1.rect);
+
+#pragma omp parallel for
+		for (int cidx = 0; cidx < paMesh->Heff1.linear_size(); cidx++) {
+
+			paMesh->Heff1_coupling[cidx] = paMesh->Heff1[cidx];
+		}
+	}
+
+	for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+		energy_density += pSMod[idx]->UpdateField();
+	}
+
+	//coupling field is the change in Heff1
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		if (!pMesh[idx]->is_atomistic()) continue;
+
+		Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(pMesh[idx]);
+
+#pragma omp parallel for
+		for (int cidx = 0; cidx < paMesh->Heff1.linear_size(); cidx++) {
+
+			paMesh->Heff1_coupling[cidx] = paMesh->Heff1[cidx] - paMesh->Heff1_coupling[cidx];
+		}
+	}
+
+	return energy_density;
+}
+
+double SuperMesh::UpdateFields_TaskParallel(void)
+{
+	//1. mark modules whose UpdateField is split for this iteration
+	pAsync_Modules.clear();
+	async_energy_density_weights.clear();
+
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		pMesh[idx]->Set_Async_Modules(pAsync_Modules);
+		async_energy_density_weights.resize(pAsync_Modules.size(), energy_density_weights[idx]);
+	}
+
+	for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+		if (pSMod[idx]->Set_Async_Update(true)) {
+
+			pAsync_Modules.push_back(pSMod[idx]);
+			async_energy_density_weights.push_back(1.0);
+		}
+	}
+
+	double energy_density = 0.0;
+
+	//2. async stages on one group of threads, UpdateField of all other modules (in the usual order) on the remaining threads
+	int num_threads = omp_get_max_threads();
+	int async_threads = minimum(task_parallel_threads, num_threads - 1);
+
+	if (pAsync_Modules.size() && async_threads > 0) {
+
+		int max_active_levels = omp_get_max_active_levels();
+		omp_set_max_active_levels(2);
+
+#pragma omp parallel sections num_threads(2) reduction(+:energy_density)
+		{
+#pragma omp section
+			{
+				omp_set_num_threads(async_threads);
+
+				for (int idx = 0; idx < (int)pAsync_Modules.size(); idx++) {
+
+					pAsync_Modules[idx]->UpdateField_Async();
+				}
+			}
+
+#pragma omp section
+			{
+				omp_set_num_threads(num_threads - async_threads);
+
+				for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+					energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
+				}
+
+				for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+					if (!pSMod[idx]->Is_Async_Update()) energy_density += pSMod[idx]->UpdateField();
+				}
+			}
+		}
+
+		omp_set_max_active_levels(max_active_levels);
+	}
+	else {
+
+		//not enough threads to split : same stages, but one after the other
+		for (int idx = 0; idx < (int)pAsync_Modules.size(); idx++) {
+
+			pAsync_Modules[idx]->UpdateField_Async();
+		}
+
+		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+			energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
 		}
 
-		//update effective field for super-mesh modules
 		for (int idx = 0; idx < (int)pSMod.size(); idx++) {
 
-			//super-mesh modules contribute with equal weights as sum total of individual mesh energy densities -> i.e. we don't need to apply a weight here
-			total_energy_density += pSMod[idx]->UpdateField();
+			if (!pSMod[idx]->Is_Async_Update()) energy_density += pSMod[idx]->UpdateField();
 		}
+	}
 
-		//iterate ODE evaluation method - ODE solvers are called separately in the magnetic meshes. This is why the same evaluation method must be used in all the magnetic meshes, with the same time step.
-		odeSolver.Iterate();
+	//3. complete split modules, adding their contributions to Heff
+	for (int idx = 0; idx < (int)pAsync_Modules.size(); idx++) {
 
-	} while (!odeSolver.TimeStepSolved());
+		energy_density += pAsync_Modules[idx]->UpdateField_Complete() * async_energy_density_weights[idx];
+		pAsync_Modules[idx]->Set_Async_Update(false);
+	}
+
+	return energy_density;
 }
 
 #if COMPILECUDA == 1
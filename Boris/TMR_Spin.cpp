@@ -20,6 +20,12 @@ DBL2 TMR::IterateSpinSolver_Charge_SOR(double damping)
 	return pMesh->V.IteratePoisson_SOR<TMR>(&TMR::Evaluate_SpinSolver_delsqV_RHS, *this, damping);
 }
 
+//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+void TMR::CalculateSpinSolver_Charge_Residual(std::vector<double>& r)
+{
+	pMesh->V.Poisson_Residual<TMR>(&TMR::Evaluate_SpinSolver_delsqV_RHS, *this, r);
+}
+
 //before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes. Not needed for TMR.
 void TMR::PrimeSpinSolver_Charge(void)
 {
@@ -40,6 +46,12 @@ DBL2 TMR::IterateSpinSolver_Spin_SOR(double damping)
 	return pMesh->S.IteratePoisson_SOR<TMR>(&TMR::Evaluate_SpinSolver_delsqS_RHS, *this, damping);
 }
 
+//residual of Poisson equation for S, written in r : used by Krylov solver
+void TMR::CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r)
+{
+	pMesh->S.Poisson_Residual<TMR>(&TMR::Evaluate_SpinSolver_delsqS_RHS, *this, r);
+}
+
 //before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes. Not needed for TMR.
 void TMR::PrimeSpinSolver_Spin(void)
 {
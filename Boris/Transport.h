@@ -65,6 +65,9 @@ private:
 	//call-back method for Poisson equation to evaluate RHS
 	double Evaluate_SpinSolver_delsqV_RHS(int idx) const;
 
+	//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+	void CalculateSpinSolver_Charge_Residual(std::vector<double>& r);
+
 	//before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 	void PrimeSpinSolver_Spin(void);
 
@@ -75,6 +78,9 @@ private:
 	//call-back method for Poisson equation for S
 	DBL3 Evaluate_SpinSolver_delsqS_RHS(int idx) const;
 
+	//residual of Poisson equation for S, written in r : used by Krylov solver
+	void CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r);
+
 	//Non-homogeneous Neumann boundary condition for V' - call-back method for Poisson equation for V
 	DBL3 NHNeumann_Vdiff(int idx) const;
 
@@ -85,6 +85,20 @@ bool TransportBase::PrepareDisplayVEC_VC(DBL3 cellsize)
 	return false;
 }
 
+//-------------------Calculation Methods
+
+DBL2 TransportBase::IterateChargeSolver_MG(int gamma)
+{
+	V_mgsolve.SetVEC(&pMeshBase->V);
+
+	return V_mgsolve.Iterate<TransportBase>(&TransportBase::Evaluate_ChargeSolver_delsqV_RHS, *this, gamma);
+}
+
+void TransportBase::CalculateChargeSolver_Residual(std::vector<double>& r)
+{
+	pMeshBase->V.Poisson_Residual<TransportBase>(&TransportBase::Evaluate_ChargeSolver_delsqV_RHS, *this, r);
+}
+
 //-------------------Properties
 
 bool TransportBase::GInterface_Enabled(void)
@@ -121,6 +135,9 @@ void TransportBase::ClearFixedPotentialCells(void)
 {
 	pMeshBase->V.clear_dirichlet_flags();
 
+	//flags will change, so multigrid coarse levels must be rebuilt
+	V_mgsolve.Reset();
+
 #if COMPILECUDA == 1
 	if (pTransportBaseCUDA) pTransportBaseCUDA->ClearFixedPotentialCells();
 #endif
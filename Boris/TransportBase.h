@@ -51,6 +51,9 @@ protected:
 	mutable VEC<double> delsq_V_fixed;
 	mutable VEC<DBL3> delsq_S_fixed;
 
+	//multigrid solver for V (coarse levels only built if used)
+	MGSolve<double> V_mgsolve;
+
 protected:
 
 	//-------------------Auxiliary
@@ -78,6 +81,13 @@ protected:
 	//call-back method for Poisson equation to evaluate RHS
 	virtual double Evaluate_ChargeSolver_delsqV_RHS(int idx) const = 0;
 
+	//as for IterateChargeSolver_SOR but take a single geometric multigrid cycle (gamma = 1 : V-cycle, gamma = 2 : W-cycle) instead.
+	//Return un-normalized error (maximum change in quantity over the cycle) - first - and maximum value  -second - divide them to obtain normalized error
+	DBL2 IterateChargeSolver_MG(int gamma);
+
+	//residual of charge transport Poisson equation (F - delsq V) in this mesh, written in r : used by Krylov solver
+	void CalculateChargeSolver_Residual(std::vector<double>& r);
+
 	//Calculation Methods used by Spin Current Solver only
 
 	//before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
@@ -90,6 +100,9 @@ protected:
 	//call-back method for Poisson equation to evaluate RHS
 	virtual double Evaluate_SpinSolver_delsqV_RHS(int idx) const = 0;
 
+	//residual of Poisson equation for V (F - delsq V) within the spin current solver, written in r, using same boundary conditions as IterateSpinSolver_Charge_SOR : used by Krylov solver
+	virtual void CalculateSpinSolver_Charge_Residual(std::vector<double>& r) = 0;
+
 	//before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 	virtual void PrimeSpinSolver_Spin(void) = 0;
 
@@ -100,6 +113,9 @@ protected:
 	//call-back method for Poisson equation for S
 	virtual DBL3 Evaluate_SpinSolver_delsqS_RHS(int idx) const = 0;
 
+	//residual of Poisson equation for S (F - delsq S), written in r, using same boundary conditions as IterateSpinSolver_Spin_SOR : used by Krylov solver
+	virtual void CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r) = 0;
+
 	//Non-homogeneous Neumann boundary condition for V' - call-back method for Poisson equation for V
 	virtual DBL3 NHNeumann_Vdiff(int idx) const = 0;
 
@@ -24,6 +24,27 @@ enum STSOLVE_ {
 	STSOLVE_FERROMAGNETIC_ATOM
 };
 
+//charge transport solver type (CUDA solver always uses SOR) :
+
+//0. SOR
+
+//1. geometric multigrid V-cycle (red-black Gauss-Seidel smoothing)
+
+//2. geometric multigrid W-cycle (red-black Gauss-Seidel smoothing)
+
+//3. Jacobi preconditioned BiCGStab over all transport meshes, with composite media boundary conditions included in the operator (also used for spin accumulation in the spin transport solver)
+
+enum TSOLVER_ {
+
+	TSOLVER_SOR = 0,
+	TSOLVER_MGV = 1,
+	TSOLVER_MGW = 2,
+	TSOLVER_BICGSTAB = 3,
+
+	//number of options in this enum
+	TSOLVER_NUMOPTIONS
+};
+
 enum TMR_ {
 
 	TMR_NONE = -1,
@@ -29,6 +29,19 @@ DBL2 Transport::IterateSpinSolver_Charge_SOR(double damping)
 	}
 }
 
+//residual of Poisson equation for V within the spin current solver, written in r : used by Krylov solver
+void Transport::CalculateSpinSolver_Charge_Residual(std::vector<double>& r)
+{
+	if (IsZ((double)pMesh->iSHA) || stsolve == STSOLVE_FERROMAGNETIC || stsolve == STSOLVE_NONE) {
+
+		pMesh->V.Poisson_Residual<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, *this, r);
+	}
+	else {
+
+		pMesh->V.Poisson_Residual<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, &Transport::NHNeumann_Vdiff, *this, r);
+	}
+}
+
 //before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 void Transport::PrimeSpinSolver_Charge(void)
 {
@@ -184,6 +197,19 @@ DBL2 Transport::IterateSpinSolver_Spin_SOR(double damping)
 	}
 }
 
+//residual of Poisson equation for S, written in r : used by Krylov solver
+void Transport::CalculateSpinSolver_Spin_Residual(std::vector<DBL3>& r)
+{
+	if (IsZ((double)pMesh->SHA) || stsolve == STSOLVE_FERROMAGNETIC) {
+
+		pMesh->S.Poisson_Residual<Transport>(&Transport::Evaluate_SpinSolver_delsqS_RHS, *this, r);
+	}
+	else {
+
+		pMesh->S.Poisson_Residual<Transport>(&Transport::Evaluate_SpinSolver_delsqS_RHS, &Transport::NHNeumann_Sdiff, *this, r);
+	}
+}
+
 //before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
 void Transport::PrimeSpinSolver_Spin(void)
 {
@@ -228,31 +228,50 @@ double Zeeman::UpdateField(void)
 
 		double time = pSMesh->GetStageTime();
 
+		//for separable equations only the time factors need evaluating here
+		bool separable = UpdateSeparableFieldCache();
+		DBL3 H_time = (separable ? H_equation.evaluate_vector_separable_time(time) : DBL3());
+
 		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-#pragma omp parallel for reduction(+:energy)
-			for (int j = 0; j < pMesh->n.y; j++) {
-				for (int k = 0; k < pMesh->n.z; k++) {
-					for (int i = 0; i < pMesh->n.x; i++) {
+#pragma omp parallel
+			{
+				//the field equation is evaluated a row of cells at a time along x
+				std::vector<double> relpos_x(pMesh->n.x);
+				std::vector<DBL3> H_row(pMesh->n.x);
+				for (int i = 0; i < pMesh->n.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h.x;
+
+#pragma omp for reduction(+:energy)
+				for (int j = 0; j < pMesh->n.y; j++) {
+					for (int k = 0; k < pMesh->n.z; k++) {
+
+						if (separable) {
 
-						int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+							int idx_row = j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+							for (int i = 0; i < pMesh->n.x; i++) H_row[i] = H_equation_space[idx_row + i] & H_time;
+						}
+						else H_equation.evaluate_vector_batch(pMesh->n.x, H_row.data(), relpos_x.data(), (j + 0.5) * pMesh->h.y, (k + 0.5) * pMesh->h.z, time);
 
-						//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
-						double cHA = pMesh->cHA;
-						pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
+						for (int i = 0; i < pMesh->n.x; i++) {
 
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h;
-						DBL3 H = H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
+							int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
 
-						pMesh->Heff[idx] = (cHA * H);
-						pMesh->Heff2[idx] = (cHA * H);
+							//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
+							double cHA = pMesh->cHA;
+							pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
 
-						energy += (pMesh->M[idx] + pMesh->M2[idx]) * (cHA * H) / 2;
+							DBL3 H = H_row[i];
 
-						if (Module_Heff.linear_size()) Module_Heff[idx] = cHA * H;
-						if (Module_Heff2.linear_size()) Module_Heff2[idx] = cHA * H;
-						if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * (cHA * H);
-						if (Module_energy2.linear_size()) Module_energy2[idx] = -MU0 * pMesh->M2[idx] * (cHA * H);
+							pMesh->Heff[idx] = (cHA * H);
+							pMesh->Heff2[idx] = (cHA * H);
+
+							energy += (pMesh->M[idx] + pMesh->M2[idx]) * (cHA * H) / 2;
+
+							if (Module_Heff.linear_size()) Module_Heff[idx] = cHA * H;
+							if (Module_Heff2.linear_size()) Module_Heff2[idx] = cHA * H;
+							if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * (cHA * H);
+							if (Module_energy2.linear_size()) Module_energy2[idx] = -MU0 * pMesh->M2[idx] * (cHA * H);
+						}
 					}
 				}
 			}
@@ -260,26 +279,41 @@ double Zeeman::UpdateField(void)
 
 		else {
 
-#pragma omp parallel for reduction(+:energy)
-			for (int j = 0; j < pMesh->n.y; j++) {
-				for (int k = 0; k < pMesh->n.z; k++) {
-					for (int i = 0; i < pMesh->n.x; i++) {
+#pragma omp parallel
+			{
+				//the field equation is evaluated a row of cells at a time along x
+				std::vector<double> relpos_x(pMesh->n.x);
+				std::vector<DBL3> H_row(pMesh->n.x);
+				for (int i = 0; i < pMesh->n.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h.x;
+
+#pragma omp for reduction(+:energy)
+				for (int j = 0; j < pMesh->n.y; j++) {
+					for (int k = 0; k < pMesh->n.z; k++) {
 
-						int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+						if (separable) {
 
-						//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
-						double cHA = pMesh->cHA;
-						pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
+							int idx_row = j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+							for (int i = 0; i < pMesh->n.x; i++) H_row[i] = H_equation_space[idx_row + i] & H_time;
+						}
+						else H_equation.evaluate_vector_batch(pMesh->n.x, H_row.data(), relpos_x.data(), (j + 0.5) * pMesh->h.y, (k + 0.5) * pMesh->h.z, time);
 
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h;
-						DBL3 H = H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
+						for (int i = 0; i < pMesh->n.x; i++) {
 
-						pMesh->Heff[idx] = (cHA * H);
+							int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
 
-						energy += pMesh->M[idx] * (cHA * H);
+							//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
+							double cHA = pMesh->cHA;
+							pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
 
-						if (Module_Heff.linear_size()) Module_Heff[idx] = cHA * H;
-						if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * (cHA * H);
+							DBL3 H = H_row[i];
+
+							pMesh->Heff[idx] = (cHA * H);
+
+							energy += pMesh->M[idx] * (cHA * H);
+
+							if (Module_Heff.linear_size()) Module_Heff[idx] = cHA * H;
+							if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * (cHA * H);
+						}
 					}
 				}
 			}
@@ -547,6 +581,50 @@ void Zeeman::UpdateTEquationUserConstants(bool makeCuda)
 	}
 }
 
+//if H_equation is separable make sure H_equation_space is up to date and return true, else return false
+bool Zeeman::UpdateSeparableFieldCache(void)
+{
+	if (!H_equation.is_separable_vector()) {
+
+		//not separable : release cache memory if any
+		if (H_equation_space.linear_size()) H_equation_space.clear();
+		H_equation_space_version = -1;
+
+		return false;
+	}
+
+	//cached spatial factors are out of date if the equation was remade (e.g. user constants changed) or the mesh discretisation changed
+	if (H_equation_space_version == H_equation.get_version() && H_equation_space.n == pMesh->n && H_equation_space.h == pMesh->h) return true;
+
+	if (!H_equation_space.resize(pMesh->h, pMesh->meshRect) || H_equation_space.n != pMesh->n) {
+
+		H_equation_space.clear();
+		H_equation_space_version = -1;
+
+		return false;
+	}
+
+#pragma omp parallel
+	{
+		std::vector<double> relpos_x(pMesh->n.x);
+		for (int i = 0; i < pMesh->n.x; i++) relpos_x[i] = (i + 0.5) * pMesh->h.x;
+
+#pragma omp for
+		for (int j = 0; j < pMesh->n.y; j++) {
+			for (int k = 0; k < pMesh->n.z; k++) {
+
+				int idx_row = j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+
+				H_equation.evaluate_vector_separable_space_batch(pMesh->n.x, &H_equation_space[idx_row], relpos_x.data(), (j + 0.5) * pMesh->h.y, (k + 0.5) * pMesh->h.z, 0.0);
+			}
+		}
+	}
+
+	H_equation_space_version = H_equation.get_version();
+
+	return true;
+}
+
 //if base temperature changes we need to adjust Tb in H_equation if it's used.
 void Zeeman::SetBaseTemperature(double Temperature)
 {
@@ -31,11 +31,20 @@ private:
 	//pointer to supermesh
 	SuperMesh* pSMesh;
 
+	//if H_equation is separable as f(x, y, z) * g(t) then the spatial factors are cached here, so only g(t) needs evaluating at each step
+	VEC<DBL3> H_equation_space;
+
+	//H_equation version for which H_equation_space was computed
+	int H_equation_space_version = -1;
+
 private:
 
 	//Update TEquation object with user constants values
 	void UpdateTEquationUserConstants(bool makeCuda = true);
 
+	//if H_equation is separable make sure H_equation_space is up to date and return true, else return false
+	bool UpdateSeparableFieldCache(void);
+
 public:
 
 	Zeeman(Mesh *pMesh_);
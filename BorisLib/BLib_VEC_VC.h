@@ -22,6 +22,9 @@
 #include "VEC_VC_ngbrsum.h"
 #include "VEC_VC_Solve.h"
 #include "VEC_VC_CGSolve.h"
+#include "VEC_VC_MGSolve.h"
+#include "VEC_VC_BiCGStab.h"
+#include "VEC_VC_History.h"
 
 //CIRCULAR INCLUSION CHECK : PASSED 
 
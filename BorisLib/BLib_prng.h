@@ -60,6 +60,20 @@ public:
 		}
 	}
 
+	//get generator state (values and periods for all threads), e.g. for checkpointing
+	void get_state(std::vector<unsigned>& prn_, std::vector<unsigned>& period_) { prn_ = prn; period_ = period; }
+
+	//set generator state previously obtained with get_state : fails (state unchanged) if the number of threads is different
+	bool set_state(const std::vector<unsigned>& prn_, const std::vector<unsigned>& period_)
+	{
+		if (prn_.size() != prn.size() || period_.size() != period.size()) return false;
+
+		prn = prn_;
+		period = period_;
+
+		return true;
+	}
+
 	//unsigned integer value out : 0 to 2^32 - 1
 	unsigned randi(void)
 	{
@@ -192,6 +192,11 @@ private:
 	std::shared_ptr<Funcs_Special> pAlpha1 = nullptr;
 	std::shared_ptr<Funcs_Special> pAlpha2 = nullptr;
 
+	///////////////////////////////////////////////////////////
+
+	//incremented every time the equation changes, so values computed from it and cached elsewhere can be checked for staleness
+	int equation_version = 0;
+
 private:
 
 	/////////////////////////////////////////////////////////
@@ -302,6 +307,8 @@ private:
 	//clear allocated Function objects
 	void clear_Funcs(void)
 	{
+		equation_version++;
+
 		eq_component_1.clear_Funcs();
 		eq_component_2.clear_Funcs();
 		eq_component_3.clear_Funcs();
@@ -1010,6 +1017,8 @@ public:
 		eq_component_1.Set_SpecialFunction(type, pSpecialFunc);
 		eq_component_2.Set_SpecialFunction(type, pSpecialFunc);
 		eq_component_3.Set_SpecialFunction(type, pSpecialFunc);
+
+		equation_version++;
 	}
 
 	/////////////////////////////////////////////////////////
@@ -1051,4 +1060,91 @@ public:
 
 		return value;
 	}
+
+	/////////////////////////////////////////////////////////
+	//
+	// EVALUATE EQUATION FOR MANY POINTS
+
+	//User variables are given either as arrays with a value for each point, or as single values used for all points, e.g. for a row of cells along x:
+	//equation.evaluate_vector_batch(n.x, pH, px_values, y, z, time);
+
+	//evaluate scalar equation for n points, with results in pout[0] to pout[n - 1]
+	void evaluate_batch(int n, double* pout, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (n <= 0) return;
+
+		eq_component_1.evaluate_batch(n, pout, 1, bvars...);
+	}
+
+	//evaluate dual equation for n points, with results in pout[0] to pout[n - 1]
+	void evaluate_dual_batch(int n, DBL2* pout, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (n <= 0) return;
+
+		int out_stride = sizeof(DBL2) / sizeof(double);
+
+		eq_component_1.evaluate_batch(n, &pout[0].x, out_stride, bvars...);
+		eq_component_2.evaluate_batch(n, &pout[0].y, out_stride, bvars...);
+	}
+
+	//evaluate vector equation for n points, with results in pout[0] to pout[n - 1]
+	void evaluate_vector_batch(int n, DBL3* pout, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (n <= 0) return;
+
+		int out_stride = sizeof(DBL3) / sizeof(double);
+
+		eq_component_1.evaluate_batch(n, &pout[0].x, out_stride, bvars...);
+		eq_component_2.evaluate_batch(n, &pout[0].y, out_stride, bvars...);
+		eq_component_3.evaluate_batch(n, &pout[0].z, out_stride, bvars...);
+	}
+
+	/////////////////////////////////////////////////////////
+	//
+	// SEPARABLE EQUATIONS
+
+	//Equations of the form f(v0, ..., vN-1) * g(vN), where vN is the last user variable, can be evaluated by computing the space factor f once for all points of interest (cache it),
+	//then only evaluating the time factor g when vN changes, e.g. for equations in x, y, z, t : H * exp(-(x^2 + y^2) / w^2) * sin(2*PI*f*t).
+	//The cached space factor must be recomputed when the equation version changes (see get_version).
+
+	bool is_separable(void) const { return is_set() && eq_component_1.is_separable(); }
+	bool is_separable_vector(void) const { return is_set_vector() && eq_component_1.is_separable() && eq_component_2.is_separable() && eq_component_3.is_separable(); }
+
+	//evaluate time factor : value of scalar equation is space factor * time factor
+	double evaluate_separable_time(double time) const
+	{
+		return eq_component_1.evaluate_separable_time(time);
+	}
+
+	//evaluate time factors : value of vector equation is (space factors) & (time factors), i.e. component-wise product
+	DBL3 evaluate_vector_separable_time(double time) const
+	{
+		return DBL3(
+			eq_component_1.evaluate_separable_time(time),
+			eq_component_2.evaluate_separable_time(time),
+			eq_component_3.evaluate_separable_time(time));
+	}
+
+	//evaluate space factor for n points, as for evaluate_batch (the last user variable is not used)
+	void evaluate_separable_space_batch(int n, double* pout, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (n <= 0) return;
+
+		eq_component_1.evaluate_separable_space_batch(n, pout, 1, bvars...);
+	}
+
+	//evaluate space factors for n points, as for evaluate_vector_batch (the last user variable is not used)
+	void evaluate_vector_separable_space_batch(int n, DBL3* pout, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (n <= 0) return;
+
+		int out_stride = sizeof(DBL3) / sizeof(double);
+
+		eq_component_1.evaluate_separable_space_batch(n, &pout[0].x, out_stride, bvars...);
+		eq_component_2.evaluate_separable_space_batch(n, &pout[0].y, out_stride, bvars...);
+		eq_component_3.evaluate_separable_space_batch(n, &pout[0].z, out_stride, bvars...);
+	}
+
+	//incremented every time the equation is remade (e.g. user constants changed), or special functions change : values cached from this equation are out of date if the version differs
+	int get_version(void) const { return equation_version; }
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TEquation_Function.h"
+#include "TEquation_Program.h"
 #include "Funcs_Strings.h"
 
 template <typename ... BVarType>
@@ -15,6 +16,16 @@ private:
 	//the equation component with Function objects ready for run-time evaluation
 	std::vector< std::vector<EqComp::Function<BVarType...>*> > Funcs;
 
+	//the equation component compiled to flat register bytecode : used for evaluation if compiled
+	EqComp::Program program;
+
+	//separable factorization, if possible (see make_separable) : equation = sep_scale * space factor * time factor
+	//a factor program which is not compiled has value 1
+	EqComp::Program sep_space;
+	EqComp::Program sep_time;
+	double sep_scale = 1.0;
+	bool separable = false;
+
 	//text specifiers for user-defined function variables
 	std::vector<double>& varvec;
 
@@ -44,6 +55,147 @@ private:
 		}
 	}
 
+	//bit mask of user variables the branch at idx depends on (including all branches it depends on)
+	unsigned get_branch_variables(int idx) const
+	{
+		const std::vector<EqComp::FSPEC>& branch = eq_fspec[idx];
+
+		if (branch[0].is_binary_operator()) return get_branch_variables(branch[0].bin_idx1) | get_branch_variables(branch[0].bin_idx2);
+		else if ((branch[0].type == EqComp::FUNC_BVAR || branch[0].type == EqComp::FUNC_BVAR_PMUL) && branch[0].varlevel < 32) return (1u << branch[0].varlevel);
+		else return 0;
+	}
+
+	//copy the branch at idx, together with all branches it depends on, to the end of fspec_out. Return its index in fspec_out.
+	int copy_branch(int idx, std::vector< std::vector<EqComp::FSPEC> >& fspec_out) const
+	{
+		std::vector<EqComp::FSPEC> branch = eq_fspec[idx];
+
+		if (branch[0].is_binary_operator()) {
+
+			branch[0].bin_idx1 = copy_branch(eq_fspec[idx][0].bin_idx1, fspec_out);
+			branch[0].bin_idx2 = copy_branch(eq_fspec[idx][0].bin_idx2, fspec_out);
+		}
+
+		fspec_out.push_back(branch);
+
+		return fspec_out.size() - 1;
+	}
+
+	//split the branch at idx into factors if it is a product or quotient (recursively), collecting constant multipliers in scale. Factors in the denominator are marked with true.
+	void collect_factors(int idx, bool denominator, std::vector<std::pair<int, bool>>& factors, double& scale) const
+	{
+		const std::vector<EqComp::FSPEC>& branch = eq_fspec[idx];
+
+		//a branch with further unary functions after the binary operator is a single factor
+		if (branch.size() == 1 && (branch[0].type == EqComp::FUNC_MUL || branch[0].type == EqComp::FUNC_MUL_PMUL || branch[0].type == EqComp::FUNC_DIV || branch[0].type == EqComp::FUNC_DIV_PMUL)) {
+
+			if (branch[0].do_pmul) {
+
+				if (denominator) scale /= branch[0].param;
+				else scale *= branch[0].param;
+			}
+
+			bool is_div = (branch[0].type == EqComp::FUNC_DIV || branch[0].type == EqComp::FUNC_DIV_PMUL);
+
+			collect_factors(branch[0].bin_idx1, denominator, factors, scale);
+			collect_factors(branch[0].bin_idx2, (is_div ? !denominator : denominator), factors, scale);
+		}
+		else factors.push_back(std::pair<int, bool>(idx, denominator));
+	}
+
+	//build the product of given factors and compile it to program_out (cleared if there are no factors)
+	bool compile_factors(const std::vector<std::pair<int, bool>>& factors, EqComp::Program& program_out) const
+	{
+		program_out.clear();
+		if (!factors.size()) return true;
+
+		std::vector< std::vector<EqComp::FSPEC> > fspec_out;
+
+		//numerator first (start from 1 if there are only factors in the denominator)
+		int prod_idx = -1;
+		for (int idx = 0; idx < factors.size(); idx++) {
+
+			if (factors[idx].second) continue;
+
+			int factor_idx = copy_branch(factors[idx].first, fspec_out);
+
+			if (prod_idx >= 0) {
+
+				EqComp::FSPEC mul(EqComp::FUNC_MUL);
+				mul.bin_idx1 = prod_idx;
+				mul.bin_idx2 = factor_idx;
+				fspec_out.push_back(std::vector<EqComp::FSPEC>{ mul });
+				prod_idx = fspec_out.size() - 1;
+			}
+			else prod_idx = factor_idx;
+		}
+
+		if (prod_idx < 0) {
+
+			fspec_out.push_back(std::vector<EqComp::FSPEC>{ EqComp::FSPEC(EqComp::FUNC_CONST, 1.0) });
+			prod_idx = fspec_out.size() - 1;
+		}
+
+		//now divide by denominator factors
+		for (int idx = 0; idx < factors.size(); idx++) {
+
+			if (!factors[idx].second) continue;
+
+			int factor_idx = copy_branch(factors[idx].first, fspec_out);
+
+			EqComp::FSPEC div(EqComp::FUNC_DIV);
+			div.bin_idx1 = prod_idx;
+			div.bin_idx2 = factor_idx;
+			fspec_out.push_back(std::vector<EqComp::FSPEC>{ div });
+			prod_idx = fspec_out.size() - 1;
+		}
+
+		return program_out.compile(fspec_out);
+	}
+
+	//Try to factorize the equation as sep_scale * f(v0, ..., vN-1) * g(vN), where vN is the last user variable (e.g. t for equations in x, y, z, t).
+	//Only the top-level product (and quotient) structure is analyzed : every factor must depend either on vN only, or not at all on vN.
+	void make_separable(void)
+	{
+		separable = false;
+		sep_scale = 1.0;
+		sep_space.clear();
+		sep_time.clear();
+
+		//need at least 2 user variables in the variadic list
+		if (sizeof...(BVarType) < 2 || sizeof...(BVarType) > 32 || !program.is_compiled()) return;
+
+		unsigned time_mask = 1u << (sizeof...(BVarType) - 1);
+
+		std::vector<std::pair<int, bool>> factors;
+		collect_factors(eq_fspec.size() - 1, false, factors, sep_scale);
+
+		std::vector<std::pair<int, bool>> space_factors, time_factors;
+
+		for (int idx = 0; idx < factors.size(); idx++) {
+
+			unsigned mask = get_branch_variables(factors[idx].first);
+
+			if (mask & time_mask) {
+
+				//mixed factor : not separable
+				if (mask & ~time_mask) return;
+				time_factors.push_back(factors[idx]);
+			}
+			else space_factors.push_back(factors[idx]);
+		}
+
+		if (!compile_factors(space_factors, sep_space) || !compile_factors(time_factors, sep_time)) {
+
+			sep_space.clear();
+			sep_time.clear();
+			sep_scale = 1.0;
+			return;
+		}
+
+		separable = true;
+	}
+
 	//optimize eq_fspec so we reduce the number of operations
 	void optimize(void)
 	{
@@ -237,6 +389,12 @@ public:
 
 		Funcs.clear();
 		eq_fspec.clear();
+		program.clear();
+
+		sep_space.clear();
+		sep_time.clear();
+		sep_scale = 1.0;
+		separable = false;
 	}
 
 	/////////////////////////////////////////////////////////
@@ -297,6 +455,12 @@ public:
 			}
 		}
 
+		//finally compile to bytecode : if this fails the Function objects are used for evaluation instead
+		program.compile(eq_fspec);
+
+		//check if the equation can be evaluated as a product of spatial and time factors
+		make_separable();
+
 		return true;
 	}
 
@@ -325,16 +489,108 @@ public:
 				Funcs[idx][idx_tree]->Set_SpecialFunction(type, pSpecialFunc);
 			}
 		}
+
+		program.Set_SpecialFunction(type, pSpecialFunc);
+		sep_space.Set_SpecialFunction(type, pSpecialFunc);
+		sep_time.Set_SpecialFunction(type, pSpecialFunc);
 	}
 
 	/////////////////////////////////////////////////////////
 	//
 	// EVALUATE EQUATION
 
+	//can the bytecode program be used with the user variables currently available?
+	bool use_program(void) const
+	{
+		if (sizeof...(BVarType)) return program.is_compiled() && program.get_num_vars() <= (int)sizeof...(BVarType);
+		else return program.is_compiled() && program.get_num_vars() <= (int)varvec.size();
+	}
+
 	//evaluate scalar equation
 	double evaluate(BVarType... bvars) const
 	{
-		if (Funcs.size()) return Funcs.back().back()->evaluate(bvars...);
+		if (use_program()) {
+
+			if (sizeof...(BVarType)) {
+
+				double values[sizeof...(BVarType) + 1] = { (double)bvars..., 0.0 };
+				const double* pvars[sizeof...(BVarType) + 1];
+				for (int idx = 0; idx < sizeof...(BVarType); idx++) pvars[idx] = values + idx;
+
+				return program.evaluate(pvars);
+			}
+			else {
+
+				std::vector<const double*> pvars(varvec.size());
+				for (int idx = 0; idx < varvec.size(); idx++) pvars[idx] = varvec.data() + idx;
+
+				return program.evaluate(pvars.data());
+			}
+		}
+		else if (Funcs.size()) return Funcs.back().back()->evaluate(bvars...);
 		else return 0.0;
 	}
+
+	//evaluate scalar equation for n points, writing result for point idx in pout[idx * out_stride]
+	//each user variable is given either as an array with a value for each point, or as a single value used for all points
+	void evaluate_batch(int n, double* pout, int out_stride, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (use_program()) {
+
+			if (sizeof...(BVarType)) {
+
+				const double* pvars[sizeof...(BVarType) + 1] = { bvars.data()..., nullptr };
+				int pstrides[sizeof...(BVarType) + 1] = { bvars.stride()..., 0 };
+
+				program.evaluate_batch(n, pvars, pstrides, pout, out_stride);
+			}
+			else {
+
+				std::vector<const double*> pvars(varvec.size());
+				std::vector<int> pstrides(varvec.size(), 0);
+				for (int idx = 0; idx < varvec.size(); idx++) pvars[idx] = varvec.data() + idx;
+
+				program.evaluate_batch(n, pvars.data(), pstrides.data(), pout, out_stride);
+			}
+		}
+		else {
+
+			for (int idx = 0; idx < n; idx++) pout[idx * out_stride] = evaluate(bvars.get(idx)...);
+		}
+	}
+
+	/////////////////////////////////////////////////////////
+	//
+	// SEPARABLE EVALUATION
+
+	//the equation is sep_scale * space factor * time factor : see make_separable
+	bool is_separable(void) const { return separable; }
+
+	//evaluate time factor (including constant multiplier) for given value of the last user variable
+	double evaluate_separable_time(double time) const
+	{
+		if (!sep_time.is_compiled()) return sep_scale;
+
+		//the time factor only reads the last user variable
+		const double* pvars[sizeof...(BVarType) + 1];
+		for (int idx = 0; idx < sizeof...(BVarType) + 1; idx++) pvars[idx] = &time;
+
+		return sep_scale * sep_time.evaluate(pvars);
+	}
+
+	//evaluate space factor for n points, as for evaluate_batch (the last user variable is not used)
+	void evaluate_separable_space_batch(int n, double* pout, int out_stride, const typename EqComp::BatchVarOf<BVarType>::type& ... bvars) const
+	{
+		if (sep_space.is_compiled()) {
+
+			const double* pvars[sizeof...(BVarType) + 1] = { bvars.data()..., nullptr };
+			int pstrides[sizeof...(BVarType) + 1] = { bvars.stride()..., 0 };
+
+			sep_space.evaluate_batch(n, pvars, pstrides, pout, out_stride);
+		}
+		else {
+
+			for (int idx = 0; idx < n; idx++) pout[idx * out_stride] = 1.0;
+		}
+	}
 };
\ No newline at end of file
@@ -0,0 +1,458 @@
+#pragma once
+
+#include "TEquation_FSPEC.h"
+
+#include "Funcs_Math.h"
+#include "Obj_Math_Special.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+//number of points processed together by each instruction during batched evaluation
+#define EQPROG_BATCHBLOCK	64
+
+//maximum number of registers held on the stack during evaluation; programs needing more use heap storage
+#define EQPROG_STACKREGS	16
+
+//Flat register bytecode for an equation component, compiled from its fspec logical form.
+//
+//Every fspec branch has its value held in a register; branches start with a basis function (loads a register) or a binary operator (combines two registers),
+//and unary functions further down a branch work in place on the branch register. Registers are recycled as soon as binary operators consume them,
+//and branches which only depend on constants are folded at compile time.
+//
+//The program can be executed on a single point, or on arrays of points : in the latter case each instruction runs over a block of points at a time,
+//so the inner loops are simple enough for the compiler to vectorize.
+
+namespace EqComp {
+
+	//user variable values for batched evaluation : either an array (one value per point), or a single value broadcast over all points
+	struct BatchVar {
+
+		const double* pvalues = nullptr;
+		double value = 0.0;
+
+		BatchVar(const double* pvalues_) :
+			pvalues(pvalues_)
+		{}
+
+		BatchVar(double value_) :
+			value(value_)
+		{}
+
+		//start of values and stride between consecutive points (0 for broadcast value)
+		const double* data(void) const { return (pvalues ? pvalues : &value); }
+		int stride(void) const { return (pvalues ? 1 : 0); }
+
+		double get(int idx) const { return (pvalues ? pvalues[idx] : value); }
+	};
+
+	//map each user variable type in a parameter pack to a BatchVar argument
+	template <typename BVar>
+	struct BatchVarOf { typedef BatchVar type; };
+
+	//single bytecode instruction
+	struct Instruction {
+
+		//function type with any parameter multiplication removed (param is always applied instead)
+		FUNC_ op = FUNC_CONST;
+
+		//destination register and source register(s)
+		int dst = 0;
+		int src1 = 0;
+		int src2 = 0;
+
+		//user variable index for FUNC_BVAR
+		int varlevel = 0;
+
+		//multiplies the result; for FUNC_CONST this is the constant value
+		double param = 1.0;
+
+		//base or exponent value for FUNC_POWER_EXPCONST and FUNC_POWER_BASECONST
+		double base_or_exponent = 0.0;
+
+		//special function if needed
+		std::shared_ptr<Funcs_Special> pSpecial = nullptr;
+
+		Instruction(void) {}
+
+		Instruction(const FSPEC& fspec) :
+			varlevel(fspec.varlevel), param(fspec.param), base_or_exponent(fspec.base_or_exponent)
+		{
+			switch (fspec.type) {
+
+			//the PMUL variants directly follow their base function in FUNC_ (see FSPEC::make_pmul)
+			case FUNC_BVAR_PMUL: case FUNC_SIN_PMUL: case FUNC_SINC_PMUL: case FUNC_COS_PMUL: case FUNC_TAN_PMUL:
+			case FUNC_SINH_PMUL: case FUNC_COSH_PMUL: case FUNC_TANH_PMUL: case FUNC_SQRT_PMUL: case FUNC_EXP_PMUL:
+			case FUNC_ASIN_PMUL: case FUNC_ACOS_PMUL: case FUNC_ATAN_PMUL: case FUNC_ASINH_PMUL: case FUNC_ACOSH_PMUL: case FUNC_ATANH_PMUL:
+			case FUNC_LOG_PMUL: case FUNC_LN_PMUL: case FUNC_ABS_PMUL: case FUNC_SGN_PMUL: case FUNC_STEP_PMUL: case FUNC_SWAV_PMUL: case FUNC_TWAV_PMUL:
+			case FUNC_POWER_EXPCONST_PMUL: case FUNC_POWER_BASECONST_PMUL:
+			case FUNC_POW_PMUL: case FUNC_DIV_PMUL: case FUNC_MUL_PMUL: case FUNC_SUB_PMUL: case FUNC_ADD_PMUL:
+				op = (FUNC_)(fspec.type - 1);
+				break;
+
+			default:
+				op = fspec.type;
+				//parameter is only meaningful for parameter multiplication variants, constants and special functions
+				if (!fspec.do_pmul && fspec.type != FUNC_CONST && !is_special()) param = 1.0;
+				break;
+			}
+		}
+
+		bool is_special(void) const
+		{
+			return (op == FUNC_CURIEWEISS || op == FUNC_CURIEWEISS1 || op == FUNC_CURIEWEISS2 ||
+				op == FUNC_LONGRELSUS || op == FUNC_LONGRELSUS1 || op == FUNC_LONGRELSUS2 ||
+				op == FUNC_ALPHA1 || op == FUNC_ALPHA2);
+		}
+	};
+
+	class Program {
+
+	private:
+
+		std::vector<Instruction> instructions;
+
+		//number of registers needed, and register holding the final value
+		int num_regs = 0;
+		int out_reg = 0;
+
+		//number of user variables the program reads (highest varlevel + 1)
+		int num_vars = 0;
+
+		bool compiled = false;
+
+	private:
+
+		//execute single instruction over len points, with the registers laid out with given stride (register r for point i found at regs[r * stride + i])
+		//user variable v for point i is found at pvars[v][(offset + i) * pstrides[v]]; if pstrides is nullptr all variables are single values
+		static void execute_instruction(const Instruction& instr, double* regs, int stride, int len, const double* const* pvars, const int* pstrides, int offset)
+		{
+			double* pdst = regs + instr.dst * stride;
+			const double* psrc1 = regs + instr.src1 * stride;
+			const double* psrc2 = regs + instr.src2 * stride;
+			double param = instr.param;
+
+			auto unary = [&](auto f) -> void {
+
+				if (param == 1.0) for (int i = 0; i < len; i++) pdst[i] = f(psrc1[i]);
+				else for (int i = 0; i < len; i++) pdst[i] = param * f(psrc1[i]);
+			};
+
+			auto binary = [&](auto f) -> void {
+
+				if (param == 1.0) for (int i = 0; i < len; i++) pdst[i] = f(psrc1[i], psrc2[i]);
+				else for (int i = 0; i < len; i++) pdst[i] = param * f(psrc1[i], psrc2[i]);
+			};
+
+			auto special = [&](double default_value) -> void {
+
+				if (instr.pSpecial) for (int i = 0; i < len; i++) pdst[i] = param * instr.pSpecial->evaluate(psrc1[i]);
+				else for (int i = 0; i < len; i++) pdst[i] = default_value;
+			};
+
+			switch (instr.op) {
+
+			//BASIS FUNCTIONS
+
+			case FUNC_BVAR:
+			{
+				int vstride = (pstrides ? pstrides[instr.varlevel] : 0);
+				const double* pvar = pvars[instr.varlevel] + offset * vstride;
+
+				if (vstride == 1) for (int i = 0; i < len; i++) pdst[i] = param * pvar[i];
+				else if (vstride) for (int i = 0; i < len; i++) pdst[i] = param * pvar[i * vstride];
+				else for (int i = 0; i < len; i++) pdst[i] = param * pvar[0];
+			}
+			break;
+
+			case FUNC_CONST:
+				for (int i = 0; i < len; i++) pdst[i] = param;
+				break;
+
+			//UNARY FUNCTIONS
+
+			case FUNC_SIN: unary([](double x) { return sin(x); }); break;
+			case FUNC_SINC: unary([](double x) { return (x ? sin(x) / x : 1.0); }); break;
+			case FUNC_COS: unary([](double x) { return cos(x); }); break;
+			case FUNC_TAN: unary([](double x) { return tan(x); }); break;
+			case FUNC_SINH: unary([](double x) { return sinh(x); }); break;
+			case FUNC_COSH: unary([](double x) { return cosh(x); }); break;
+			case FUNC_TANH: unary([](double x) { return tanh(x); }); break;
+			case FUNC_SQRT: unary([](double x) { return sqrt(x); }); break;
+			case FUNC_EXP: unary([](double x) { return exp(x); }); break;
+			case FUNC_ASIN: unary([](double x) { return asin(x); }); break;
+			case FUNC_ACOS: unary([](double x) { return acos(x); }); break;
+			case FUNC_ATAN: unary([](double x) { return atan(x); }); break;
+			case FUNC_ASINH: unary([](double x) { return asinh(x); }); break;
+			case FUNC_ACOSH: unary([](double x) { return acosh(x); }); break;
+			case FUNC_ATANH: unary([](double x) { return atanh(x); }); break;
+			case FUNC_LN: unary([](double x) { return log(x); }); break;
+			case FUNC_LOG: unary([](double x) { return log10(x); }); break;
+			case FUNC_ABS: unary([](double x) { return fabs(x); }); break;
+			case FUNC_SGN: unary([](double x) { return (double)get_sign(x); }); break;
+			case FUNC_STEP: unary([](double x) { return (x < 0 ? 0.0 : 1.0); }); break;
+			case FUNC_SWAV: unary([](double x) { return (double)(-2 * (((int)floor(fabs(x) / PI) + (get_sign(x) < 0)) % 2) + 1); }); break;
+			case FUNC_TWAV:
+				unary([](double x) {
+					if ((int)floor(fabs(x) / PI) % 2) return (2 * fmod(fabs(x), PI) / PI - 1);
+					else return (1 - 2 * fmod(fabs(x), PI) / PI);
+				});
+				break;
+
+			case FUNC_POWER_EXPCONST:
+			{
+				double exponent = instr.base_or_exponent;
+				unary([&](double x) { return pow(x, exponent); });
+			}
+			break;
+
+			case FUNC_POWER_BASECONST:
+			{
+				double base = instr.base_or_exponent;
+				unary([&](double x) { return pow(base, x); });
+			}
+			break;
+
+			//SPECIAL FUNCTIONS
+
+			case FUNC_CURIEWEISS: case FUNC_CURIEWEISS1: case FUNC_CURIEWEISS2:
+			case FUNC_ALPHA1: case FUNC_ALPHA2:
+				special(1.0);
+				break;
+
+			case FUNC_LONGRELSUS: case FUNC_LONGRELSUS1: case FUNC_LONGRELSUS2:
+				special(0.0);
+				break;
+
+			//BINARY OPERATORS
+
+			case FUNC_ADD: binary([](double a, double b) { return a + b; }); break;
+			case FUNC_SUB: binary([](double a, double b) { return a - b; }); break;
+			case FUNC_MUL: binary([](double a, double b) { return a * b; }); break;
+			case FUNC_DIV: binary([](double a, double b) { return a / b; }); break;
+			case FUNC_POW: binary([](double a, double b) { return pow(a, b); }); break;
+
+			default:
+				for (int i = 0; i < len; i++) pdst[i] = 0.0;
+				break;
+			}
+		}
+
+		//evaluate instruction on constant inputs (used for constant folding)
+		static double fold(Instruction instr, double value1, double value2)
+		{
+			double regs[3] = { value1, value2, 0.0 };
+
+			instr.src1 = 0;
+			instr.src2 = 1;
+			instr.dst = 2;
+
+			execute_instruction(instr, regs, 1, 1, nullptr, nullptr, 0);
+
+			return regs[2];
+		}
+
+	public:
+
+		/////////////////////////////////////////////////////////
+		//
+		// COMPILE
+
+		void clear(void)
+		{
+			instructions.clear();
+			num_regs = 0;
+			out_reg = 0;
+			num_vars = 0;
+			compiled = false;
+		}
+
+		//compile from fspec (after it has been fixed and optimized by Equation_Component::make). Return false if fspec is not well-formed.
+		bool compile(const std::vector< std::vector<FSPEC> >& fspec)
+		{
+			clear();
+
+			if (!fspec.size()) return false;
+
+			//register holding each branch value (-1 if not held in a register)
+			std::vector<int> branch_reg(fspec.size(), -1);
+			//branches reduced to a constant value at compile time
+			std::vector<bool> branch_const(fspec.size(), false);
+			std::vector<double> branch_value(fspec.size(), 0.0);
+
+			std::vector<int> free_regs;
+
+			auto allocate = [&](void) -> int {
+
+				if (free_regs.size()) {
+
+					int reg = free_regs.back();
+					free_regs.pop_back();
+					return reg;
+				}
+				else return num_regs++;
+			};
+
+			//make sure the value of a branch is held in a register, loading it first if it was folded into a constant
+			auto materialize = [&](int branch_idx) -> int {
+
+				if (branch_const[branch_idx]) {
+
+					Instruction load;
+					load.param = branch_value[branch_idx];
+					load.dst = allocate();
+					instructions.push_back(load);
+
+					branch_reg[branch_idx] = load.dst;
+					branch_const[branch_idx] = false;
+				}
+
+				return branch_reg[branch_idx];
+			};
+
+			for (int idx = 0; idx < fspec.size(); idx++) {
+
+				if (!fspec[idx].size()) { clear(); return false; }
+
+				for (int idx_tree = 0; idx_tree < fspec[idx].size(); idx_tree++) {
+
+					const FSPEC& spec = fspec[idx][idx_tree];
+					Instruction instr(spec);
+
+					if (idx_tree == 0 && spec.is_binary_operator()) {
+
+						int bin_idx1 = spec.bin_idx1;
+						int bin_idx2 = spec.bin_idx2;
+
+						if (bin_idx1 < 0 || bin_idx1 >= idx || bin_idx2 < 0 || bin_idx2 >= idx || bin_idx1 == bin_idx2) { clear(); return false; }
+
+						if (branch_const[bin_idx1] && branch_const[bin_idx2]) {
+
+							branch_const[idx] = true;
+							branch_value[idx] = fold(instr, branch_value[bin_idx1], branch_value[bin_idx2]);
+							continue;
+						}
+
+						instr.src1 = materialize(bin_idx1);
+						instr.src2 = materialize(bin_idx2);
+						if (instr.src1 < 0 || instr.src2 < 0) { clear(); return false; }
+
+						//both operands are consumed here, so their registers can be reused, including for the result
+						free_regs.push_back(instr.src1);
+						free_regs.push_back(instr.src2);
+						branch_reg[bin_idx1] = -1;
+						branch_reg[bin_idx2] = -1;
+
+						instr.dst = allocate();
+						branch_reg[idx] = instr.dst;
+					}
+					else if (idx_tree == 0) {
+
+						if (spec.is_unary_function()) { clear(); return false; }
+
+						if (spec.is_constant()) {
+
+							branch_const[idx] = true;
+							branch_value[idx] = spec.param;
+							continue;
+						}
+
+						num_vars = maximum(num_vars, instr.varlevel + 1);
+
+						instr.dst = allocate();
+						branch_reg[idx] = instr.dst;
+					}
+					else {
+
+						if (!spec.is_unary_function()) { clear(); return false; }
+
+						//special functions are set after compilation so cannot be folded
+						if (branch_const[idx] && !instr.is_special()) {
+
+							branch_value[idx] = fold(instr, branch_value[idx], 0.0);
+							continue;
+						}
+
+						instr.src1 = materialize(idx);
+						if (instr.src1 < 0) { clear(); return false; }
+						instr.dst = instr.src1;
+					}
+
+					instructions.push_back(instr);
+				}
+			}
+
+			out_reg = materialize(fspec.size() - 1);
+			if (out_reg < 0) { clear(); return false; }
+
+			compiled = true;
+
+			return true;
+		}
+
+		bool is_compiled(void) const { return compiled; }
+
+		//number of user variables this program needs
+		int get_num_vars(void) const { return num_vars; }
+
+		/////////////////////////////////////////////////////////
+		//
+		// SET SPECIAL FUNCTIONS
+
+		void Set_SpecialFunction(FUNC_ type, std::shared_ptr<Funcs_Special> pSpecialFunc)
+		{
+			for (int idx = 0; idx < instructions.size(); idx++) {
+
+				if (instructions[idx].op == type) instructions[idx].pSpecial = pSpecialFunc;
+			}
+		}
+
+		/////////////////////////////////////////////////////////
+		//
+		// EVALUATE
+
+		//evaluate for a single point : user variable v has value *pvars[v]
+		double evaluate(const double* const* pvars) const
+		{
+			double stack_regs[EQPROG_STACKREGS];
+			std::vector<double> heap_regs;
+
+			double* regs = stack_regs;
+			if (num_regs > EQPROG_STACKREGS) { heap_regs.resize(num_regs); regs = heap_regs.data(); }
+
+			for (int idx = 0; idx < instructions.size(); idx++) {
+
+				execute_instruction(instructions[idx], regs, 1, 1, pvars, nullptr, 0);
+			}
+
+			return regs[out_reg];
+		}
+
+		//evaluate for n points : user variable v for point idx is found at pvars[v][idx * pstrides[v]]; result for point idx written to pout[idx * out_stride]
+		void evaluate_batch(int n, const double* const* pvars, const int* pstrides, double* pout, int out_stride) const
+		{
+			double stack_regs[EQPROG_STACKREGS * EQPROG_BATCHBLOCK];
+			std::vector<double> heap_regs;
+
+			double* regs = stack_regs;
+			if (num_regs > EQPROG_STACKREGS) { heap_regs.resize(num_regs * EQPROG_BATCHBLOCK); regs = heap_regs.data(); }
+
+			for (int offset = 0; offset < n; offset += EQPROG_BATCHBLOCK) {
+
+				int len = minimum(EQPROG_BATCHBLOCK, n - offset);
+
+				for (int idx = 0; idx < instructions.size(); idx++) {
+
+					execute_instruction(instructions[idx], regs, EQPROG_BATCHBLOCK, len, pvars, pstrides, offset);
+				}
+
+				const double* presult = regs + out_reg * EQPROG_BATCHBLOCK;
+				double* pout_block = pout + offset * out_stride;
+
+				if (out_stride == 1) for (int i = 0; i < len; i++) pout_block[i] = presult[i];
+				else for (int i = 0; i < len; i++) pout_block[i * out_stride] = presult[i];
+			}
+		}
+	};
+}
@@ -207,4 +207,7 @@ struct __ReIm3 {
 };
 
 //this is the most common type to use : double precision.
-typedef __ReIm3<double> ReIm3;
\ No newline at end of file
+typedef __ReIm3<double> ReIm3;
+
+//single precision : used for single precision ffts
+typedef __ReIm3<float> ReIm3F;
\ No newline at end of file
@@ -10,6 +10,8 @@
 /////////////////////////////////////////////////////////////////////
 
 template <typename VType> class CGSolve;
+template <typename VType> class MGSolve;
+template <typename VType> class BiCGStabSolve;
 
 struct CMBNDInfo;
 
@@ -24,6 +26,8 @@ class VEC_VC :
 {
 
 	friend CGSolve<VType>;
+	friend MGSolve<VType>;
+	friend BiCGStabSolve<VType>;
 
 //the following are used as masks for ngbrFlags. 32 bits in total (4 bytes for an int)
 
@@ -400,6 +404,9 @@ public:
 	//mark cells included in this rectangle (absolute coordinates) to be skipped during some computations (if status true, else clear the skip cells flags in this rectangle)
 	void set_skipcells(const Rect& rectangle, bool status = true);
 
+	//mark cell with given index to be skipped during some computations (if status true, else clear its skip cell flag)
+	void set_skipcell(int index, bool status = true) { if (status) ngbrFlags[index] |= NF_SKIPCELL; else ngbrFlags[index] &= ~NF_SKIPCELL; }
+
 	//clear all skip cell flags
 	void clear_skipcells(void);
 
@@ -854,4 +861,13 @@ public:
 	//Return un-normalized error (maximum change in VEC<VType>::quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	template <typename Owner, typename MType>
 	DBL2 IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<MType(const Owner&, int)> Tensor_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, double relaxation_param = 1.9);
+
+	//Residual of Poisson equation delsq V = F, i.e. F - delsq V, written in r (must have VEC<VType>::n.dim() size). Boundary conditions as for IteratePoisson_SOR.
+	//Residual is set to zero in empty cells and composite media boundary cells. Used by Krylov solvers to apply the operator matrix-free.
+	template <typename Owner>
+	void Poisson_Residual(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, std::vector<VType>& r);
+
+	//as above but using non-homogeneous Neumann boundary condition evaluated using the bdiff call-back method.
+	template <typename Owner>
+	void Poisson_Residual(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, std::vector<VType>& r);
 };
\ No newline at end of file
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "VEC_VC.h"
+
+//-------------------------------- Matrix-free BiCGStab Solver for multiple VEC_VC with composite media boundary conditions
+
+//Solves a Poisson-type problem delsq V = F over a number of VEC_VC (meshes) coupled through composite media boundary (CMBND) cells.
+//The unknowns are the values in all non-empty, non-CMBND cells of the participating VECs. CMBND cells are functions of the unknowns (set by the set_cmbnd call-back), so they are part of the operator.
+//With CMBND conditions the operator is not symmetric, so CG cannot be used : use BiCGStab, which only requires the operator to be applied, not its transpose.
+
+//The operator is applied matrix-free using the residual call-back, which must compute R(x) = F - delsq V for the current values in the VEC (after CMBND cells are set).
+//R(x) is affine in x : R(x) = b - A x. Thus b = R(0) (this contains Dirichlet values, non-homogeneous Neumann conditions, fixed RHS terms, etc.) and A p = R(0) - R(p).
+
+//Preconditioning : right preconditioning with Jacobi preconditioner, using the diagonal of the Laplace operator with the same boundary conditions as the SOR solver.
+//If the residual also contains a diagonal term, R(x) = F - delsq V + d * V (e.g. implicit time stepping of diffusion equations), d can be passed in as a diagonal shift so the preconditioner includes it.
+
+//BiCGStab flow (with M the preconditioner):
+
+//r = b - A x, r_hat = r, rho = alpha = omega = 1, v = p = 0
+//repeat:
+// rho_new = r_hat * r
+// beta = (rho_new / rho) * (alpha / omega)
+// p = r + beta * (p - omega * v)
+// y = M^-1 p, v = A y
+// alpha = rho_new / (r_hat * v)
+// x = x + alpha * y
+// s = r - alpha * v
+// z = M^-1 s, t = A z
+// omega = (t * s) / (t * t)
+// x = x + omega * z
+// r = s - omega * t
+//until |r| / |b| below tolerance
+
+template <typename VType>
+class BiCGStabSolve {
+
+private:
+
+	//VECs (meshes) over which the problem is solved
+	std::vector<VEC_VC<VType>*> pVEC;
+
+	//only VECs marked active contain unknowns (others are not modified, but their CMBND cells may still be set by the set_cmbnd call-back)
+	std::vector<int> active;
+
+	//auxiliary data used by BiCGStab solver, one vector for each VEC - see description above
+	std::vector<std::vector<VType>> x, b, r, r_hat, p, v, t, y, aux;
+
+	//inverse diagonal used for Jacobi preconditioner
+	std::vector<std::vector<double>> diag_inv;
+
+	//optional diagonal shift for each VEC (empty if not used)
+	std::vector<std::vector<double>*> pdiag_shift;
+
+private:
+
+	//allocate memory and calculate preconditioner for current VECs
+	void PrimeSolver(void);
+
+	//write values in vector (free cells only) to VECs
+	void set_values(std::vector<std::vector<VType>>& values);
+
+	//apply preconditioner : out = M^-1 in
+	void precondition(std::vector<std::vector<VType>>& in, std::vector<std::vector<VType>>& out);
+
+	//apply operator : out = A in = b - R(in), using aux for R(in)
+	template <typename Owner>
+	void apply_operator(std::function<void(Owner&)> set_cmbnd, std::function<void(Owner&, int, std::vector<VType>&)> residual, Owner& instance, std::vector<std::vector<VType>>& in, std::vector<std::vector<VType>>& out);
+
+	//dot product over free cells in all active VECs
+	double dot(std::vector<std::vector<VType>>& a, std::vector<std::vector<VType>>& c);
+
+	//a = a + mult * c, over free cells in all active VECs
+	void axpy(std::vector<std::vector<VType>>& a, double mult, std::vector<std::vector<VType>>& c);
+
+	bool is_free(int mesh_idx, int idx) { return (pVEC[mesh_idx]->ngbrFlags[idx] & NF_NOTEMPTY) && !(pVEC[mesh_idx]->ngbrFlags[idx] & NF_CMBND); }
+
+public:
+
+	BiCGStabSolve(void) {}
+
+	//free memory
+	void Clear(void);
+
+	//----POISSON EQUATION over all given VECs coupled through CMBND conditions
+
+	//Solve until relative residual norm |r| / |b| falls below tolerance, or max_iterations reached. The solution is left in the VECs (with CMBND cells set). Return number of iterations in iterations.
+	//set_cmbnd : set CMBND cells in all VECs from current values.
+	//residual : calculate R = F - delsq V in the VEC with given index for current values (zero in empty and CMBND cells).
+	//diag_shift : if given, diagonal term d in the residual for each VEC (same size as VEC), only used for preconditioning.
+	//Return residual norm - first - and norm of b - second - divide them to obtain normalized error
+	template <typename Owner>
+	DBL2 Solve(
+		std::vector<VEC_VC<VType>*>& pVEC_, std::vector<int>& active_,
+		std::function<void(Owner&)> set_cmbnd, std::function<void(Owner&, int, std::vector<VType>&)> residual, Owner& instance,
+		double tolerance, int max_iterations, int& iterations,
+		std::vector<std::vector<double>*> diag_shift = {});
+};
+
+//-------------------------------------------------------------------------------------------------
+
+template <typename VType>
+void BiCGStabSolve<VType>::Clear(void)
+{
+	pVEC.clear();
+	active.clear();
+	pdiag_shift.clear();
+
+	x.clear(); b.clear(); r.clear(); r_hat.clear(); p.clear(); v.clear(); t.clear(); y.clear(); aux.clear();
+	diag_inv.clear();
+}
+
+//allocate memory and calculate preconditioner for current VECs
+template <typename VType>
+void BiCGStabSolve<VType>::PrimeSolver(void)
+{
+	std::vector<std::vector<VType>>* vectors[] = { &x, &b, &r, &r_hat, &p, &v, &t, &y, &aux };
+
+	for (auto pvector : vectors) {
+
+		pvector->resize(pVEC.size());
+		for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) (*pvector)[mesh_idx].assign(pVEC[mesh_idx]->n.dim(), VType());
+	}
+
+	diag_inv.resize(pVEC.size());
+
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		VEC_VC<VType>& V = *pVEC[mesh_idx];
+
+		diag_inv[mesh_idx].assign(V.n.dim(), 0.0);
+		if (!active[mesh_idx]) continue;
+
+		bool using_extended_flags = V.ngbrFlags2.size();
+		std::vector<double>* pshift = (mesh_idx < (int)pdiag_shift.size() ? pdiag_shift[mesh_idx] : nullptr);
+
+		//Laplace operator diagonal with same weights as SOR solver : 2 for inner points, 6 for Dirichlet, 1 for Neumann
+#pragma omp parallel for
+		for (int idx = 0; idx < V.n.dim(); idx++) {
+
+			if (!is_free(mesh_idx, idx)) continue;
+
+			int flags = V.ngbrFlags[idx];
+			int flags2 = (using_extended_flags ? V.ngbrFlags2[idx] : 0);
+
+			double diag = 0.0;
+
+			if ((flags & NF_BOTHX) == NF_BOTHX) diag += 2 / (V.h.x*V.h.x);
+			else if (flags2 & NF2_DIRICHLETX) diag += 6 / (V.h.x*V.h.x);
+			else if (flags & NF_NGBRX) diag += 1 / (V.h.x*V.h.x);
+
+			if ((flags & NF_BOTHY) == NF_BOTHY) diag += 2 / (V.h.y*V.h.y);
+			else if (flags2 & NF2_DIRICHLETY) diag += 6 / (V.h.y*V.h.y);
+			else if (flags & NF_NGBRY) diag += 1 / (V.h.y*V.h.y);
+
+			if ((flags & NF_BOTHZ) == NF_BOTHZ) diag += 2 / (V.h.z*V.h.z);
+			else if (flags2 & NF2_DIRICHLETZ) diag += 6 / (V.h.z*V.h.z);
+			else if (flags & NF_NGBRZ) diag += 1 / (V.h.z*V.h.z);
+
+			if (pshift) diag += (*pshift)[idx];
+
+			//the Laplace operator diagonal is negative
+			if (diag > 0.0) diag_inv[mesh_idx][idx] = -1.0 / diag;
+		}
+	}
+}
+
+//write values in vector (free cells only) to VECs
+template <typename VType>
+void BiCGStabSolve<VType>::set_values(std::vector<std::vector<VType>>& values)
+{
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			if (is_free(mesh_idx, idx)) pVEC[mesh_idx]->quantity[idx] = values[mesh_idx][idx];
+		}
+	}
+}
+
+//apply preconditioner : out = M^-1 in
+template <typename VType>
+void BiCGStabSolve<VType>::precondition(std::vector<std::vector<VType>>& in, std::vector<std::vector<VType>>& out)
+{
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			out[mesh_idx][idx] = diag_inv[mesh_idx][idx] * in[mesh_idx][idx];
+		}
+	}
+}
+
+//apply operator : out = A in = b - R(in), using aux for R(in)
+template <typename VType>
+template <typename Owner>
+void BiCGStabSolve<VType>::apply_operator(
+	std::function<void(Owner&)> set_cmbnd, std::function<void(Owner&, int, std::vector<VType>&)> residual, Owner& instance,
+	std::vector<std::vector<VType>>& in, std::vector<std::vector<VType>>& out)
+{
+	set_values(in);
+	set_cmbnd(instance);
+
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+		residual(instance, mesh_idx, aux[mesh_idx]);
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			out[mesh_idx][idx] = b[mesh_idx][idx] - aux[mesh_idx][idx];
+		}
+	}
+}
+
+//dot product over free cells in all active VECs
+template <typename VType>
+double BiCGStabSolve<VType>::dot(std::vector<std::vector<VType>>& a, std::vector<std::vector<VType>>& c)
+{
+	double value = 0.0;
+
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+		double mesh_value = 0.0;
+
+		//values in non-free cells are always zero so no need to check
+#pragma omp parallel for reduction(+:mesh_value)
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			mesh_value += a[mesh_idx][idx] * c[mesh_idx][idx];
+		}
+
+		value += mesh_value;
+	}
+
+	return value;
+}
+
+//a = a + mult * c, over free cells in all active VECs
+template <typename VType>
+void BiCGStabSolve<VType>::axpy(std::vector<std::vector<VType>>& a, double mult, std::vector<std::vector<VType>>& c)
+{
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			a[mesh_idx][idx] += mult * c[mesh_idx][idx];
+		}
+	}
+}
+
+template <typename VType>
+template <typename Owner>
+DBL2 BiCGStabSolve<VType>::Solve(
+	std::vector<VEC_VC<VType>*>& pVEC_, std::vector<int>& active_,
+	std::function<void(Owner&)> set_cmbnd, std::function<void(Owner&, int, std::vector<VType>&)> residual, Owner& instance,
+	double tolerance, int max_iterations, int& iterations,
+	std::vector<std::vector<double>*> diag_shift)
+{
+	pVEC = pVEC_;
+	active = active_;
+	pdiag_shift = diag_shift;
+
+	PrimeSolver();
+
+	iterations = 0;
+
+	//1. starting point x from current values, and b = R(0)
+
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+		if (!active[mesh_idx]) continue;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+			if (is_free(mesh_idx, idx)) x[mesh_idx][idx] = pVEC[mesh_idx]->quantity[idx];
+		}
+	}
+
+	//y is all zero at this point
+	set_values(y);
+	set_cmbnd(instance);
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) if (active[mesh_idx]) residual(instance, mesh_idx, b[mesh_idx]);
+
+	double b_norm = sqrt(dot(b, b));
+
+	//2. r = b - A x = R(x)
+
+	set_values(x);
+	set_cmbnd(instance);
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) if (active[mesh_idx]) residual(instance, mesh_idx, r[mesh_idx]);
+
+	for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) r_hat[mesh_idx] = r[mesh_idx];
+
+	double r_norm = sqrt(dot(r, r));
+
+	//nothing to solve (e.g. no potential drop)
+	if (b_norm == 0.0) b_norm = 1.0;
+
+	double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+	while (r_norm / b_norm > tolerance && iterations < max_iterations) {
+
+		double rho_new = dot(r_hat, r);
+
+		//breakdown : restart with current residual as shadow residual
+		if (rho_new == 0.0 || omega == 0.0) {
+
+			for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+				r_hat[mesh_idx] = r[mesh_idx];
+				std::fill(p[mesh_idx].begin(), p[mesh_idx].end(), VType());
+				std::fill(v[mesh_idx].begin(), v[mesh_idx].end(), VType());
+			}
+
+			rho = alpha = omega = 1.0;
+			rho_new = dot(r_hat, r);
+
+			if (rho_new == 0.0) break;
+		}
+
+		double beta = (rho_new / rho) * (alpha / omega);
+		rho = rho_new;
+
+		//p = r + beta * (p - omega * v)
+		for (int mesh_idx = 0; mesh_idx < (int)pVEC.size(); mesh_idx++) {
+
+			if (!active[mesh_idx]) continue;
+
+#pragma omp parallel for
+			for (int idx = 0; idx < pVEC[mesh_idx]->n.dim(); idx++) {
+
+				p[mesh_idx][idx] = r[mesh_idx][idx] + beta * (p[mesh_idx][idx] - omega * v[mesh_idx][idx]);
+			}
+		}
+
+		//v = A M^-1 p
+		precondition(p, y);
+		apply_operator(set_cmbnd, residual, instance, y, v);
+
+		double r_hat_v = dot(r_hat, v);
+		if (r_hat_v == 0.0) { omega = 0.0; iterations++; continue; }
+
+		alpha = rho / r_hat_v;
+
+		//x = x + alpha * y, s = r - alpha * v (s stored in r)
+		axpy(x, alpha, y);
+		axpy(r, -alpha, v);
+
+		r_norm = sqrt(dot(r, r));
+		iterations++;
+
+		if (r_norm / b_norm <= tolerance) break;
+
+		//t = A M^-1 s
+		precondition(r, y);
+		apply_operator(set_cmbnd, residual, instance, y, t);
+
+		double t_t = dot(t, t);
+		omega = (t_t > 0.0 ? dot(t, r) / t_t : 0.0);
+
+		//x = x + omega * z, r = s - omega * t
+		axpy(x, omega, y);
+		axpy(r, -omega, t);
+
+		r_norm = sqrt(dot(r, r));
+	}
+
+	//3. leave solution in VECs, with CMBND cells set
+	set_values(x);
+	set_cmbnd(instance);
+
+	return DBL2(r_norm, b_norm);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "VEC_VC.h"
+
+//-------------------------------- Solution history for a set of VEC_VC, used to extrapolate initial guesses for iterative solvers
+
+//When a Poisson-type problem is solved repeatedly as the simulation time advances (e.g. transport solver under AC drive or during domain wall motion), the solution changes smoothly in time.
+//Store the last few converged solutions together with the times they were obtained at, then start the next solve from a polynomial (Lagrange) extrapolation through these samples.
+//With 2 samples this is a linear extrapolation, with 3 samples quadratic. Sample times need not be equidistant (adaptive time steps).
+
+template <typename VType>
+class VECHistory {
+
+private:
+
+	//stored samples, most recent first : samples[sample_idx][vec_idx] holds all values in the VEC with vec_idx
+	std::vector<std::vector<std::vector<VType>>> samples;
+
+	//times the samples were obtained at, most recent first
+	std::vector<double> times;
+
+	//values in VECs before last extrapolation, so it can be undone
+	std::vector<std::vector<VType>> backup;
+
+	//maximum number of samples to keep (polynomial order is one less)
+	int max_samples;
+
+private:
+
+	//check stored samples are compatible with the given VECs (same number of VECs with same sizes)
+	bool check_dimensions(std::vector<VEC_VC<VType>*>& pVEC);
+
+public:
+
+	VECHistory(int max_samples_ = 3) :
+		max_samples(max_samples_)
+	{}
+
+	//free memory
+	void clear(void) { samples.clear(); times.clear(); backup.clear(); }
+
+	int size(void) const { return (int)samples.size(); }
+
+	//store current values of all VECs as a new sample obtained at given time, discarding the oldest sample if needed.
+	//If the VEC dimensions have changed the history is cleared first. If the time is the same as that of the most recent sample, then the most recent sample is replaced.
+	void push(std::vector<VEC_VC<VType>*>& pVEC, double time);
+
+	//set values in VECs to the polynomial extrapolation at given time through all stored samples : return false (VECs unchanged) if less than 2 samples available
+	bool extrapolate(std::vector<VEC_VC<VType>*>& pVEC, double time);
+
+	//set values in VECs back to those before the last extrapolation
+	void undo_extrapolate(std::vector<VEC_VC<VType>*>& pVEC);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+template <typename VType>
+bool VECHistory<VType>::check_dimensions(std::vector<VEC_VC<VType>*>& pVEC)
+{
+	if (!samples.size()) return true;
+
+	if (samples[0].size() != pVEC.size()) return false;
+
+	for (int vec_idx = 0; vec_idx < (int)pVEC.size(); vec_idx++) {
+
+		if (samples[0][vec_idx].size() != pVEC[vec_idx]->linear_size()) return false;
+	}
+
+	return true;
+}
+
+template <typename VType>
+void VECHistory<VType>::push(std::vector<VEC_VC<VType>*>& pVEC, double time)
+{
+	//history not valid if dimensions changed or time was reset
+	if (!check_dimensions(pVEC) || (times.size() && time < times[0])) clear();
+
+	if (!times.size() || times[0] != time) {
+
+		//re-use memory of oldest sample if at maximum number of samples
+		if ((int)samples.size() == max_samples) {
+
+			std::rotate(samples.rbegin(), samples.rbegin() + 1, samples.rend());
+			std::rotate(times.rbegin(), times.rbegin() + 1, times.rend());
+		}
+		else {
+
+			samples.insert(samples.begin(), std::vector<std::vector<VType>>(pVEC.size()));
+			times.insert(times.begin(), 0.0);
+		}
+	}
+
+	times[0] = time;
+
+	for (int vec_idx = 0; vec_idx < (int)pVEC.size(); vec_idx++) {
+
+		samples[0][vec_idx].resize(pVEC[vec_idx]->linear_size());
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[vec_idx]->linear_size(); idx++) {
+
+			samples[0][vec_idx][idx] = (*pVEC[vec_idx])[idx];
+		}
+	}
+}
+
+template <typename VType>
+bool VECHistory<VType>::extrapolate(std::vector<VEC_VC<VType>*>& pVEC, double time)
+{
+	if (samples.size() < 2 || !check_dimensions(pVEC)) return false;
+
+	//Lagrange basis polynomials evaluated at time
+	std::vector<double> weights(samples.size(), 1.0);
+
+	for (int i = 0; i < (int)samples.size(); i++) {
+		for (int j = 0; j < (int)samples.size(); j++) {
+
+			if (i != j) weights[i] *= (time - times[j]) / (times[i] - times[j]);
+		}
+	}
+
+	backup.resize(pVEC.size());
+
+	for (int vec_idx = 0; vec_idx < (int)pVEC.size(); vec_idx++) {
+
+		backup[vec_idx].resize(pVEC[vec_idx]->linear_size());
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[vec_idx]->linear_size(); idx++) {
+
+			backup[vec_idx][idx] = (*pVEC[vec_idx])[idx];
+
+			VType value = VType();
+
+			for (int i = 0; i < (int)samples.size(); i++) value += weights[i] * samples[i][vec_idx][idx];
+
+			(*pVEC[vec_idx])[idx] = value;
+		}
+	}
+
+	return true;
+}
+
+template <typename VType>
+void VECHistory<VType>::undo_extrapolate(std::vector<VEC_VC<VType>*>& pVEC)
+{
+	if (backup.size() != pVEC.size()) return;
+
+	for (int vec_idx = 0; vec_idx < (int)pVEC.size(); vec_idx++) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC[vec_idx]->linear_size(); idx++) {
+
+			(*pVEC[vec_idx])[idx] = backup[vec_idx][idx];
+		}
+	}
+}
@@ -0,0 +1,662 @@
+#pragma once
+
+#include "VEC_VC.h"
+
+//-------------------------------- Geometric Multigrid Solver
+
+//Cell-centred geometric multigrid solver for Poisson equations delsq V = F on a VEC_VC, using the same discretization as IteratePoisson_SOR.
+//Long thin geometries (e.g. tracks) need O(N^2) SOR iterations to converge since the smooth error components are only damped very slowly; multigrid damps these on coarser grids.
+
+//MG Solver flow (one call to Iterate is one cycle, and replaces one IteratePoisson_SOR call):
+
+//1. Pre-smooth on the fine grid with red-black Gauss-Seidel, using IteratePoisson_SOR.
+//2. Compute fine residual r = F - delsq V in free cells (zero at empty and composite media boundary cells).
+//3. Restrict residual to the next coarse level by averaging over non-empty children (2 x 2 x 2 coarsening, semi-coarsening along dimensions too small to coarsen).
+//4. On each coarse level solve the correction equation delsq e = r : pre-smooth, restrict residual to the next level, recurse (once for V-cycle, twice for W-cycle), prolong, post-smooth.
+//   The coarsest level is relaxed with a larger number of sweeps.
+//5. Prolong the correction to the fine grid (linear interpolation) and add it to V in free cells.
+//6. Post-smooth on the fine grid.
+
+//Coarse operators are obtained by re-discretization on the coarse cellsize (coefficient quartered along each coarsened dimension).
+//Dirichlet cells use the same 6-2 stencil as the fine grid but with homogeneous values (the correction vanishes on electrodes). Robin conditions are treated as Neumann on coarse levels.
+//Coarse cells with only composite media boundary children (or fixed cells) have zero correction : CMBND cells are set by the outer iteration after each cycle, so in multi-mesh problems each mesh is solved with the interface held fixed for the duration of a cycle.
+
+//maximum number of coarse levels
+#define MGSOLVE_MAXLEVELS	16
+//stop coarsening when the number of cells in a level falls to this value or below
+#define MGSOLVE_MINCELLS	8
+//red-black Gauss-Seidel sweeps before and after coarse grid correction, on all levels
+#define MGSOLVE_PRESWEEPS	2
+#define MGSOLVE_POSTSWEEPS	2
+//sweeps on coarsest level
+#define MGSOLVE_COARSESWEEPS	32
+
+template <typename VType>
+class MGSolve {
+
+	friend VEC_VC<VType>;
+
+	struct MGLevel {
+
+		//dimensions of this level
+		SZ3 n;
+
+		//coarsening factors used to obtain this level from the previous one (1 or 2 along each dimension)
+		INT3 cf;
+
+		//operator coefficients along each dimension (1/h^2 for this level cellsize)
+		DBL3 c;
+
+		//flags using the same NF_ masks as VEC_VC : NF_NOTEMPTY, neighbor flags, and NF_CMBND for cells with fixed (zero) correction
+		std::vector<int> flags;
+
+		//NF2_DIRICHLET flags only (empty if not needed)
+		std::vector<int> flags2;
+
+		//correction and right hand side
+		std::vector<VType> e, b;
+	};
+
+private:
+
+	//The VEC_VC holding the fine grid for this MG Solver
+	VEC_VC<VType>* pV = nullptr;
+
+	//fine grid dimensions and cellsize for which levels were built
+	SZ3 n_fine;
+	DBL3 h_fine;
+
+	//coarse levels : levels[0] is obtained by coarsening the fine grid
+	std::vector<MGLevel> levels;
+
+	//fine grid residual, and fine grid values at start of cycle (used to calculate the error returned)
+	std::vector<VType> r, V_start;
+
+	OmpReduction<double> change_reduction, value_reduction;
+
+	//is the mg solver built and ready to iterate?
+	bool primed = false;
+
+private:
+
+	//build coarse levels from current fine grid flags
+	void PrimeSolver(void);
+
+	//build coarse level flags (neighbor, fixed and dirichlet flags) from parent level flags
+	void make_coarse_flags(MGLevel& level, const SZ3& n_p, const std::vector<int>& flags_p, const std::vector<int>& flags2_p);
+
+	//homogeneous stencil on a level : weighted sum of neighbors (ws) and total weight (tw), so delsq e = ws - tw * e[idx]
+	void level_stencil(const MGLevel& level, int idx, VType& ws, double& tw) const;
+
+	//red-black Gauss-Seidel sweeps on given level
+	void smooth(MGLevel& level, int sweeps);
+
+	//calculate residual on level (b - delsq e) and restrict it to next level rhs, also zeroing the next level correction
+	void restrict_residual(int lidx);
+
+	//add correction from level to its parent level values (parent is the fine grid V if lidx is 0)
+	void prolong_correction(int lidx, std::vector<VType>& e_p, const std::vector<int>& flags_p, const SZ3& n_p);
+
+	//restrict fine residual (already computed in r) to levels[0]
+	void restrict_fine_residual(void);
+
+	//solve correction equation on level lidx (gamma = 1 for V-cycle, 2 for W-cycle)
+	void cycle(int lidx, int gamma);
+
+public:
+
+	MGSolve(void) {}
+
+	MGSolve(VEC_VC<VType>* pV_) :
+		pV(pV_)
+	{}
+
+	//set fine grid to solve on
+	void SetVEC(VEC_VC<VType>* pV_) { if (pV != pV_) primed = false; pV = pV_; }
+
+	//must call this when fine grid flags change (shape, Dirichlet, CMBND flags) - coarse levels will be rebuilt on next iteration
+	void Reset(void) { primed = false; }
+
+	//free memory
+	void Clear(void) { levels.clear(); levels.shrink_to_fit(); r.clear(); r.shrink_to_fit(); V_start.clear(); V_start.shrink_to_fit(); primed = false; }
+
+	//----POISSON EQUATION with Dirichlet boundary conditions where set, and homogeneous Neumann boundary conditions, skipping composite media boundary cells.
+
+	//Take one multigrid cycle (gamma = 1 : V-cycle, gamma = 2 : W-cycle). Poisson_RHS as for IteratePoisson_SOR.
+	//Return un-normalized error (maximum change in V over the cycle) - first - and maximum value  -second - divide them to obtain normalized error
+	template <typename Owner>
+	DBL2 Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, int gamma = 1);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+template <typename VType>
+void MGSolve<VType>::make_coarse_flags(MGLevel& level, const SZ3& n_p, const std::vector<int>& flags_p, const std::vector<int>& flags2_p)
+{
+	SZ3& n = level.n;
+	INT3& cf = level.cf;
+
+	level.flags.assign(n.dim(), 0);
+	if (flags2_p.size()) level.flags2.assign(n.dim(), 0);
+	else level.flags2.clear();
+
+	//1. emptiness, fixed cells, and Dirichlet flags from children
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x*n.y);
+
+		bool not_empty = false, free = false;
+		int flags2 = 0;
+
+		for (int kc = k * cf.k; kc < minimum((k + 1) * cf.k, (int)n_p.k); kc++) {
+			for (int jc = j * cf.j; jc < minimum((j + 1) * cf.j, (int)n_p.j); jc++) {
+				for (int ic = i * cf.i; ic < minimum((i + 1) * cf.i, (int)n_p.i); ic++) {
+
+					int idx_p = ic + jc * n_p.x + kc * n_p.x*n_p.y;
+
+					if (!(flags_p[idx_p] & NF_NOTEMPTY)) continue;
+
+					not_empty = true;
+					if (!(flags_p[idx_p] & NF_CMBND)) free = true;
+
+					//keep Dirichlet flags only for children on the corresponding coarse cell face
+					if (flags2_p.size() && (flags2_p[idx_p] & NF2_DIRICHLET)) {
+
+						if (ic == i * cf.i) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETPX);
+						if (ic == minimum((i + 1) * cf.i, (int)n_p.i) - 1) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETNX);
+						if (jc == j * cf.j) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETPY);
+						if (jc == minimum((j + 1) * cf.j, (int)n_p.j) - 1) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETNY);
+						if (kc == k * cf.k) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETPZ);
+						if (kc == minimum((k + 1) * cf.k, (int)n_p.k) - 1) flags2 |= (flags2_p[idx_p] & NF2_DIRICHLETNZ);
+					}
+				}
+			}
+		}
+
+		if (not_empty) {
+
+			level.flags[idx] = NF_NOTEMPTY;
+			if (!free) level.flags[idx] |= NF_CMBND;
+			if (level.flags2.size()) level.flags2[idx] = flags2;
+		}
+	}
+
+	//2. neighbor flags
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if (!(level.flags[idx] & NF_NOTEMPTY)) continue;
+
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x*n.y);
+
+		if (i < n.x - 1 && (level.flags[idx + 1] & NF_NOTEMPTY)) level.flags[idx] |= NF_NPX;
+		if (i > 0 && (level.flags[idx - 1] & NF_NOTEMPTY)) level.flags[idx] |= NF_NNX;
+		if (j < n.y - 1 && (level.flags[idx + n.x] & NF_NOTEMPTY)) level.flags[idx] |= NF_NPY;
+		if (j > 0 && (level.flags[idx - n.x] & NF_NOTEMPTY)) level.flags[idx] |= NF_NNY;
+		if (k < n.z - 1 && (level.flags[idx + n.x*n.y] & NF_NOTEMPTY)) level.flags[idx] |= NF_NPZ;
+		if (k > 0 && (level.flags[idx - n.x*n.y] & NF_NOTEMPTY)) level.flags[idx] |= NF_NNZ;
+	}
+}
+
+//build coarse levels from current fine grid flags
+template <typename VType>
+void MGSolve<VType>::PrimeSolver(void)
+{
+	levels.clear();
+
+	n_fine = pV->n;
+	h_fine = pV->h;
+
+	r.assign(n_fine.dim(), VType());
+	V_start.assign(n_fine.dim(), VType());
+
+	SZ3 n_p = n_fine;
+	DBL3 c_p = DBL3(1.0 / (h_fine.x*h_fine.x), 1.0 / (h_fine.y*h_fine.y), 1.0 / (h_fine.z*h_fine.z));
+
+	while (levels.size() < MGSOLVE_MAXLEVELS && n_p.dim() > MGSOLVE_MINCELLS) {
+
+		//coarsen along all dimensions which have more than 1 cell
+		INT3 cf = INT3(n_p.x >= 2 ? 2 : 1, n_p.y >= 2 ? 2 : 1, n_p.z >= 2 ? 2 : 1);
+		if (cf == INT3(1)) break;
+
+		MGLevel level;
+
+		level.cf = cf;
+		level.n = SZ3((n_p.x + cf.i - 1) / cf.i, (n_p.y + cf.j - 1) / cf.j, (n_p.z + cf.k - 1) / cf.k);
+		level.c = DBL3(c_p.x / (cf.i*cf.i), c_p.y / (cf.j*cf.j), c_p.z / (cf.k*cf.k));
+
+		if (levels.size()) make_coarse_flags(level, n_p, levels.back().flags, levels.back().flags2);
+		else make_coarse_flags(level, n_p, pV->ngbrFlags, pV->ngbrFlags2);
+
+		level.e.assign(level.n.dim(), VType());
+		level.b.assign(level.n.dim(), VType());
+
+		n_p = level.n;
+		c_p = level.c;
+
+		levels.push_back(level);
+	}
+
+	primed = true;
+}
+
+//homogeneous stencil on a level : weighted sum of neighbors (ws) and total weight (tw), so delsq e = ws - tw * e[idx]
+template <typename VType>
+void MGSolve<VType>::level_stencil(const MGLevel& level, int idx, VType& ws, double& tw) const
+{
+	const SZ3& n = level.n;
+	const std::vector<int>& flags = level.flags;
+	const std::vector<VType>& e = level.e;
+
+	int flags2 = (level.flags2.size() ? level.flags2[idx] : 0);
+
+	ws = VType();
+	tw = 0.0;
+
+	//x direction
+	if ((flags[idx] & NF_BOTHX) == NF_BOTHX) {
+
+		tw += 2 * level.c.x;
+		ws += level.c.x * (e[idx - 1] + e[idx + 1]);
+	}
+	else if (flags2 & NF2_DIRICHLETX) {
+
+		if (flags[idx] & NF_NPX) { tw += 6 * level.c.x; ws += level.c.x * 2 * e[idx + 1]; }
+		else if (flags[idx] & NF_NNX) { tw += 6 * level.c.x; ws += level.c.x * 2 * e[idx - 1]; }
+		//single cell along this dimension : zero value on face half a cell away
+		else tw += 2 * level.c.x;
+	}
+	else if (flags[idx] & NF_NGBRX) {
+
+		tw += level.c.x;
+
+		if (flags[idx] & NF_NPX) ws += level.c.x * e[idx + 1];
+		else					 ws += level.c.x * e[idx - 1];
+	}
+
+	//y direction
+	if ((flags[idx] & NF_BOTHY) == NF_BOTHY) {
+
+		tw += 2 * level.c.y;
+		ws += level.c.y * (e[idx - n.x] + e[idx + n.x]);
+	}
+	else if (flags2 & NF2_DIRICHLETY) {
+
+		if (flags[idx] & NF_NPY) { tw += 6 * level.c.y; ws += level.c.y * 2 * e[idx + n.x]; }
+		else if (flags[idx] & NF_NNY) { tw += 6 * level.c.y; ws += level.c.y * 2 * e[idx - n.x]; }
+		else tw += 2 * level.c.y;
+	}
+	else if (flags[idx] & NF_NGBRY) {
+
+		tw += level.c.y;
+
+		if (flags[idx] & NF_NPY) ws += level.c.y * e[idx + n.x];
+		else					 ws += level.c.y * e[idx - n.x];
+	}
+
+	//z direction
+	if ((flags[idx] & NF_BOTHZ) == NF_BOTHZ) {
+
+		tw += 2 * level.c.z;
+		ws += level.c.z * (e[idx - n.x*n.y] + e[idx + n.x*n.y]);
+	}
+	else if (flags2 & NF2_DIRICHLETZ) {
+
+		if (flags[idx] & NF_NPZ) { tw += 6 * level.c.z; ws += level.c.z * 2 * e[idx + n.x*n.y]; }
+		else if (flags[idx] & NF_NNZ) { tw += 6 * level.c.z; ws += level.c.z * 2 * e[idx - n.x*n.y]; }
+		else tw += 2 * level.c.z;
+	}
+	else if (flags[idx] & NF_NGBRZ) {
+
+		tw += level.c.z;
+
+		if (flags[idx] & NF_NPZ) ws += level.c.z * e[idx + n.x*n.y];
+		else					 ws += level.c.z * e[idx - n.x*n.y];
+	}
+}
+
+//red-black Gauss-Seidel sweeps on given level
+template <typename VType>
+void MGSolve<VType>::smooth(MGLevel& level, int sweeps)
+{
+	SZ3& n = level.n;
+
+	for (int sweep = 0; sweep < sweeps; sweep++) {
+
+		//red-black : two passes will be taken
+		for (int rb = 0; rb < 2; rb++) {
+
+#pragma omp parallel for
+			for (int idx_jk = 0; idx_jk < n.y * n.z; idx_jk++) {
+
+				int j = idx_jk % n.y;
+				int k = (idx_jk / n.y) % n.z;
+
+				//same checkerboard pattern as IteratePoisson_SOR
+				bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+				for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < n.x; i += 2) {
+
+					int idx = i + j * n.x + k * n.x*n.y;
+
+					if ((level.flags[idx] & NF_CMBND) || !(level.flags[idx] & NF_NOTEMPTY)) continue;
+
+					VType ws;
+					double tw;
+					level_stencil(level, idx, ws, tw);
+
+					//isolated cell : no correction possible
+					if (tw > 0.0) level.e[idx] = (ws - level.b[idx]) / tw;
+				}
+			}
+		}
+	}
+}
+
+//restrict fine residual (already computed in r) to levels[0]
+template <typename VType>
+void MGSolve<VType>::restrict_fine_residual(void)
+{
+	MGLevel& level = levels[0];
+	SZ3& n = level.n;
+	INT3& cf = level.cf;
+
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		level.e[idx] = VType();
+		level.b[idx] = VType();
+
+		if ((level.flags[idx] & NF_CMBND) || !(level.flags[idx] & NF_NOTEMPTY)) continue;
+
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x*n.y);
+
+		VType sum = VType();
+		int count = 0;
+
+		for (int kc = k * cf.k; kc < minimum((k + 1) * cf.k, (int)n_fine.k); kc++) {
+			for (int jc = j * cf.j; jc < minimum((j + 1) * cf.j, (int)n_fine.j); jc++) {
+				for (int ic = i * cf.i; ic < minimum((i + 1) * cf.i, (int)n_fine.i); ic++) {
+
+					int idx_p = ic + jc * n_fine.x + kc * n_fine.x*n_fine.y;
+
+					if (!(pV->ngbrFlags[idx_p] & NF_NOTEMPTY)) continue;
+
+					sum += r[idx_p];
+					count++;
+				}
+			}
+		}
+
+		level.b[idx] = sum / count;
+	}
+}
+
+//calculate residual on level (b - delsq e) and restrict it to next level rhs, also zeroing the next level correction
+template <typename VType>
+void MGSolve<VType>::restrict_residual(int lidx)
+{
+	MGLevel& level_p = levels[lidx];
+	MGLevel& level = levels[lidx + 1];
+	SZ3& n_p = level_p.n;
+	SZ3& n = level.n;
+	INT3& cf = level.cf;
+
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		level.e[idx] = VType();
+		level.b[idx] = VType();
+
+		if ((level.flags[idx] & NF_CMBND) || !(level.flags[idx] & NF_NOTEMPTY)) continue;
+
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x*n.y);
+
+		VType sum = VType();
+		int count = 0;
+
+		for (int kc = k * cf.k; kc < minimum((k + 1) * cf.k, (int)n_p.k); kc++) {
+			for (int jc = j * cf.j; jc < minimum((j + 1) * cf.j, (int)n_p.j); jc++) {
+				for (int ic = i * cf.i; ic < minimum((i + 1) * cf.i, (int)n_p.i); ic++) {
+
+					int idx_p = ic + jc * n_p.x + kc * n_p.x*n_p.y;
+
+					if (!(level_p.flags[idx_p] & NF_NOTEMPTY)) continue;
+
+					//fixed cells have zero residual
+					if (!(level_p.flags[idx_p] & NF_CMBND)) {
+
+						VType ws;
+						double tw;
+						level_stencil(level_p, idx_p, ws, tw);
+
+						sum += level_p.b[idx_p] - (ws - tw * level_p.e[idx_p]);
+					}
+
+					count++;
+				}
+			}
+		}
+
+		level.b[idx] = sum / count;
+	}
+}
+
+//add correction from level to its parent level values (parent is the fine grid V if lidx is 0)
+template <typename VType>
+void MGSolve<VType>::prolong_correction(int lidx, std::vector<VType>& e_p, const std::vector<int>& flags_p, const SZ3& n_p)
+{
+	MGLevel& level = levels[lidx];
+	SZ3& n = level.n;
+	INT3& cf = level.cf;
+
+	bool using_dirichlet = level.flags2.size();
+
+#pragma omp parallel for
+	for (int idx_p = 0; idx_p < n_p.dim(); idx_p++) {
+
+		if ((flags_p[idx_p] & NF_CMBND) || !(flags_p[idx_p] & NF_NOTEMPTY)) continue;
+
+		int ic = idx_p % n_p.x;
+		int jc = (idx_p / n_p.x) % n_p.y;
+		int kc = idx_p / (n_p.x*n_p.y);
+
+		INT3 ijk = INT3(ic / cf.i, jc / cf.j, kc / cf.k);
+		int idx = ijk.i + ijk.j * n.x + ijk.k * n.x*n.y;
+
+		int flags2 = (using_dirichlet ? level.flags2[idx] : 0);
+
+		//linear interpolation weights along each dimension : own coarse cell (first) and nearest neighboring coarse cell (second) in direction s[d]
+		//if the neighbor is not available use own value (Neumann), or extrapolate to zero on the face for Dirichlet cells
+		DBL2 w[3];
+		int s[3];
+
+		int c_ijk[3] = { ic, jc, kc };
+		int cf_ijk[3] = { cf.i, cf.j, cf.k };
+		int ngbr_p[3] = { NF_NPX, NF_NPY, NF_NPZ };
+		int ngbr_n[3] = { NF_NNX, NF_NNY, NF_NNZ };
+		int diri_p[3] = { NF2_DIRICHLETNX, NF2_DIRICHLETNY, NF2_DIRICHLETNZ };
+		int diri_n[3] = { NF2_DIRICHLETPX, NF2_DIRICHLETPY, NF2_DIRICHLETPZ };
+
+		for (int d = 0; d < 3; d++) {
+
+			w[d] = DBL2(1.0, 0.0);
+			s[d] = 0;
+
+			if (cf_ijk[d] == 1) continue;
+
+			bool positive = c_ijk[d] % 2;
+
+			if (level.flags[idx] & (positive ? ngbr_p[d] : ngbr_n[d])) {
+
+				w[d] = DBL2(0.75, 0.25);
+				s[d] = (positive ? 1 : -1);
+			}
+			else if (flags2 & (positive ? diri_p[d] : diri_n[d])) w[d] = DBL2(0.5, 0.0);
+		}
+
+		VType correction = VType();
+
+		for (int c = 0; c < 2; c++) {
+			for (int b = 0; b < 2; b++) {
+				for (int a = 0; a < 2; a++) {
+
+					double weight = (a ? w[0].j : w[0].i) * (b ? w[1].j : w[1].i) * (c ? w[2].j : w[2].i);
+					if (!weight) continue;
+
+					int idx_ngbr = (ijk.i + a * s[0]) + (ijk.j + b * s[1]) * n.x + (ijk.k + c * s[2]) * n.x*n.y;
+
+					//off-axis neighbor could be empty even if on-axis neighbors are not
+					if (level.flags[idx_ngbr] & NF_NOTEMPTY) correction += weight * level.e[idx_ngbr];
+					else correction += weight * level.e[idx];
+				}
+			}
+		}
+
+		e_p[idx_p] += correction;
+	}
+}
+
+//solve correction equation on level lidx (gamma = 1 for V-cycle, 2 for W-cycle)
+template <typename VType>
+void MGSolve<VType>::cycle(int lidx, int gamma)
+{
+	if (lidx == levels.size() - 1) {
+
+		smooth(levels[lidx], MGSOLVE_COARSESWEEPS);
+		return;
+	}
+
+	smooth(levels[lidx], MGSOLVE_PRESWEEPS);
+
+	restrict_residual(lidx);
+
+	for (int g = 0; g < gamma; g++) cycle(lidx + 1, gamma);
+
+	prolong_correction(lidx + 1, levels[lidx].e, levels[lidx].flags, levels[lidx].n);
+
+	smooth(levels[lidx], MGSOLVE_POSTSWEEPS);
+}
+
+//Take one multigrid cycle (gamma = 1 : V-cycle, gamma = 2 : W-cycle). Poisson_RHS as for IteratePoisson_SOR.
+//Return un-normalized error (maximum change in V over the cycle) - first - and maximum value  -second - divide them to obtain normalized error
+template <typename VType>
+template <typename Owner>
+DBL2 MGSolve<VType>::Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, int gamma)
+{
+	if (!primed || pV->n != n_fine || pV->h != h_fine || pV->ngbrFlags.size() != n_fine.dim()) PrimeSolver();
+
+	SZ3& n = n_fine;
+	DBL3& h = h_fine;
+
+	std::vector<int>& ngbrFlags = pV->ngbrFlags;
+	std::vector<int>& ngbrFlags2 = pV->ngbrFlags2;
+	std::vector<VType>& V = pV->quantity;
+
+	bool using_extended_flags = ngbrFlags2.size();
+
+	std::copy(V.begin(), V.end(), V_start.begin());
+
+	//1. pre-smooth (red-black Gauss-Seidel)
+	for (int sweep = 0; sweep < MGSOLVE_PRESWEEPS; sweep++) pV->template IteratePoisson_SOR<Owner>(Poisson_RHS, instance, 1.0);
+
+	if (levels.size()) {
+
+		//2. fine residual r = F - delsq V, with same discretization as IteratePoisson_SOR
+#pragma omp parallel for
+		for (int idx = 0; idx < n.dim(); idx++) {
+
+			r[idx] = VType();
+
+			if ((ngbrFlags[idx] & NF_CMBND) || !(ngbrFlags[idx] & NF_NOTEMPTY)) continue;
+
+			VType delsq = VType();
+
+			//x direction
+			if ((ngbrFlags[idx] & NF_BOTHX) == NF_BOTHX) {
+
+				delsq += (V[idx - 1] + V[idx + 1] - 2 * V[idx]) / (h.x*h.x);
+			}
+			else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETX)) {
+
+				if (ngbrFlags2[idx] & NF2_DIRICHLETPX) delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETPX, idx) + 2 * V[idx + 1] - 6 * V[idx]) / (h.x*h.x);
+				else								  delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETNX, idx) + 2 * V[idx - 1] - 6 * V[idx]) / (h.x*h.x);
+			}
+			else if (ngbrFlags[idx] & NF_NGBRX) {
+
+				if (ngbrFlags[idx] & NF_NPX) delsq += (V[idx + 1] - V[idx]) / (h.x*h.x);
+				else						 delsq += (V[idx - 1] - V[idx]) / (h.x*h.x);
+			}
+
+			//y direction
+			if ((ngbrFlags[idx] & NF_BOTHY) == NF_BOTHY) {
+
+				delsq += (V[idx - n.x] + V[idx + n.x] - 2 * V[idx]) / (h.y*h.y);
+			}
+			else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETY)) {
+
+				if (ngbrFlags2[idx] & NF2_DIRICHLETPY) delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETPY, idx) + 2 * V[idx + n.x] - 6 * V[idx]) / (h.y*h.y);
+				else								  delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETNY, idx) + 2 * V[idx - n.x] - 6 * V[idx]) / (h.y*h.y);
+			}
+			else if (ngbrFlags[idx] & NF_NGBRY) {
+
+				if (ngbrFlags[idx] & NF_NPY) delsq += (V[idx + n.x] - V[idx]) / (h.y*h.y);
+				else						 delsq += (V[idx - n.x] - V[idx]) / (h.y*h.y);
+			}
+
+			//z direction
+			if ((ngbrFlags[idx] & NF_BOTHZ) == NF_BOTHZ) {
+
+				delsq += (V[idx - n.x*n.y] + V[idx + n.x*n.y] - 2 * V[idx]) / (h.z*h.z);
+			}
+			else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETZ)) {
+
+				if (ngbrFlags2[idx] & NF2_DIRICHLETPZ) delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETPZ, idx) + 2 * V[idx + n.x*n.y] - 6 * V[idx]) / (h.z*h.z);
+				else								  delsq += (4 * pV->get_dirichlet_value(NF2_DIRICHLETNZ, idx) + 2 * V[idx - n.x*n.y] - 6 * V[idx]) / (h.z*h.z);
+			}
+			else if (ngbrFlags[idx] & NF_NGBRZ) {
+
+				if (ngbrFlags[idx] & NF_NPZ) delsq += (V[idx + n.x*n.y] - V[idx]) / (h.z*h.z);
+				else						 delsq += (V[idx - n.x*n.y] - V[idx]) / (h.z*h.z);
+			}
+
+			r[idx] = Poisson_RHS(instance, idx) - delsq;
+		}
+
+		//3. restrict to first coarse level
+		restrict_fine_residual();
+
+		//4. coarse grid correction
+		for (int g = 0; g < gamma; g++) cycle(0, gamma);
+
+		//5. prolong to fine grid
+		prolong_correction(0, V, ngbrFlags, n);
+	}
+
+	//6. post-smooth
+	for (int sweep = 0; sweep < MGSOLVE_POSTSWEEPS; sweep++) pV->template IteratePoisson_SOR<Owner>(Poisson_RHS, instance, 1.0);
+
+	//maximum change over the cycle and maximum value
+	change_reduction.new_minmax_reduction();
+	value_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if ((ngbrFlags[idx] & NF_CMBND) || !(ngbrFlags[idx] & NF_NOTEMPTY)) continue;
+
+		change_reduction.reduce_max(GetMagnitude(V[idx] - V_start[idx]));
+		value_reduction.reduce_max(GetMagnitude(V[idx]));
+	}
+
+	return DBL2(change_reduction.maximum(), value_reduction.maximum());
+}
@@ -713,3 +713,29 @@ DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> P
 
 	return DBL2(VEC<VType>::magnitude_reduction.maximum(), VEC<VType>::magnitude_reduction2.maximum());
 }
+
+//-------------------------------- POISSON EQUATION RESIDUAL
+
+template <typename VType>
+template <typename Owner>
+void VEC_VC<VType>::Poisson_Residual(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, std::vector<VType>& r)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < VEC<VType>::n.dim(); idx++) {
+
+		if ((ngbrFlags[idx] & NF_CMBND) || !(ngbrFlags[idx] & NF_NOTEMPTY)) r[idx] = VType();
+		else r[idx] = Poisson_RHS(instance, idx) - delsq_diri(idx);
+	}
+}
+
+template <typename VType>
+template <typename Owner>
+void VEC_VC<VType>::Poisson_Residual(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, std::vector<VType>& r)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < VEC<VType>::n.dim(); idx++) {
+
+		if ((ngbrFlags[idx] & NF_CMBND) || !(ngbrFlags[idx] & NF_NOTEMPTY)) r[idx] = VType();
+		else r[idx] = Poisson_RHS(instance, idx) - delsq_diri_nneu(idx, bdiff(instance, idx));
+	}
+}